@@ -0,0 +1,48 @@
+//
+// bench.h - timing helpers for the Linux benchmarks of the portable modules
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+namespace bench
+{
+	// keeps the optimizer from dropping a result that is never used
+	template <typename T>
+	inline void keep(const T &value)
+	{
+		asm volatile("" : : "g"(&value) : "memory");
+	}
+
+	/*
+	** run f() iRuns times and print the best time per run and per item
+	** iItems is how many items one run works on
+	*/
+	template <typename F>
+	double run(const char *sName, int iRuns, double iItems, F f)
+	{
+		double best = 1e300;
+
+		for (int i = 0; i < iRuns; i++)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			f();
+			const double seconds =
+				std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			if (seconds < best)
+				best = seconds;
+		}
+
+		std::printf("%-44s %12.3f ms %12.1f ns/item\n", sName, best * 1e3, best * 1e9 / iItems);
+		return best;
+	}
+}
@@ -0,0 +1,97 @@
+//
+// chart_axis_bench.cpp - CChartAxis fitting and labelling across ranges
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "bench.h"
+#include "cui_raw/cui_rawImpl/CChartAxis/CChartAxis.h"
+
+#include <cfloat>
+#include <limits>
+
+int main()
+{
+	const int iCount = 20000;
+
+	struct range
+	{
+		const char *sName;
+		double dLow;
+		double dHigh;
+	};
+
+	const range ranges[] = {
+		{ "0 .. 10^7", 0, 1e7 },
+		{ "zero span", 5, 5 },
+		{ "negative only", -97, -3 },
+		{ "tiny step at 10^17", 1e17, 1e17 + 16 },
+		{ "denormals", 1e-310, 3e-310 },
+		{ "smallest denormal", 0, std::numeric_limits<double>::denorm_min() },
+		{ "0 .. largest double", 0, DBL_MAX },
+	};
+
+	// a new range on every paint, as when a chart's values change: the axis is fitted and
+	// its labels formatted each time
+	for (auto &it : ranges)
+	{
+		char sName[128];
+		std::snprintf(sName, sizeof(sName), "Calculate, %s", it.sName);
+
+		bench::run(sName, 3, iCount, [&]()
+		{
+			CChartAxis axis;
+			size_t iTotal = 0;
+
+			for (int i = 0; i < iCount; i++)
+			{
+				// alternate the line count so that every call fits the axis again
+				axis.Calculate(it.dLow, it.dHigh, 9 + i % 2);
+				iTotal += axis.Label(axis.Lines()).size();
+			}
+
+			bench::keep(iTotal);
+		});
+	}
+
+	// the same range on every paint: the axis and its labels are kept
+	bench::run("Calculate, unchanged range", 3, iCount * 10, [&]()
+	{
+		CChartAxis axis;
+		size_t iTotal = 0;
+
+		for (int i = 0; i < iCount * 10; i++)
+		{
+			axis.Calculate(0, 1e7, 10);
+			iTotal += axis.Label(3).size();
+		}
+
+		bench::keep(iTotal);
+	});
+
+	bench::run("NiceNumber", 3, iCount * 10, [&]()
+	{
+		double dTotal = 0;
+
+		for (int i = 0; i < iCount * 10; i++)
+			dTotal += CChartAxis::NiceNumber(1.0 + i, i % 2 == 0);
+
+		bench::keep(dTotal);
+	});
+
+	bench::run("NiceNumber, denormals", 3, iCount * 10, [&]()
+	{
+		double dTotal = 0;
+
+		for (int i = 0; i < iCount * 10; i++)
+			dTotal += CChartAxis::NiceNumber(1e-315 * (1 + i % 1000), i % 2 == 0);
+
+		bench::keep(dTotal);
+	});
+
+	return 0;
+}
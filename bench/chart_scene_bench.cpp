@@ -0,0 +1,119 @@
+//
+// chart_scene_bench.cpp - CChartScene layout builds against the IsValid check that saves them
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "bench.h"
+#include "cui_raw/cui_rawImpl/CChartScene/CChartScene.h"
+
+#include <cmath>
+#include <random>
+
+// a monospaced font, at roughly the cost of a cached GDI+ measurement being looked up
+static void measure(const std::wstring &sText, float fFontSize, float fLayoutWidth, float fLayoutHeight,
+	float &fWidth, float &fHeight)
+{
+	fWidth = sText.length() * fFontSize * 0.6f;
+	fHeight = fFontSize * 1.5f;
+
+	if (fLayoutWidth > 0 && fWidth > fLayoutWidth)
+	{
+		fHeight *= std::ceil(fWidth / fLayoutWidth);
+		fWidth = fLayoutWidth;
+	}
+
+	if (fLayoutHeight > 0 && fHeight > fLayoutHeight)
+		fHeight = fLayoutHeight;
+}
+
+int main()
+{
+	CChartScene::chart info;
+	info.fWidth = 800;
+	info.fHeight = 450;
+	info.sFontName = L"Segoe UI";
+	info.sTitle = L"Monthly totals";
+	info.sXaxisLabel = L"Month";
+	info.sYaxisLabel = L"Total";
+
+	std::mt19937 rng(5);
+	std::uniform_real_distribution<double> value(0, 1e4);
+
+	// a build is what every paint used to cost; IsValid is what a paint costs now unless the
+	// chart has been resized or its data changed
+	for (size_t iCount : { size_t(10), size_t(100), size_t(1000) })
+	{
+		std::vector<CChartScene::item> vItems(iCount);
+
+		for (size_t i = 0; i < iCount; i++)
+		{
+			vItems[i].dValue = value(rng);
+			vItems[i].iNumber = int(i + 1);
+			vItems[i].sLabel = L"item " + std::to_wstring(i + 1);
+		}
+
+		const int iBuilds = int(200000 / iCount);
+		char sName[128];
+
+		std::snprintf(sName, sizeof(sName), "BuildBarChart, %zu items", iCount);
+		bench::run(sName, 3, iBuilds, [&]()
+		{
+			CChartScene scene;
+
+			for (int i = 0; i < iBuilds; i++)
+				scene.BuildBarChart(info, vItems, measure);
+
+			bench::keep(scene.Bars().size());
+		});
+
+		std::snprintf(sName, sizeof(sName), "BuildPieChart, %zu items", iCount);
+		bench::run(sName, 3, iBuilds, [&]()
+		{
+			CChartScene scene;
+
+			for (int i = 0; i < iBuilds; i++)
+				scene.BuildPieChart(info, vItems, measure);
+
+			bench::keep(scene.Pie().vSlices.size());
+		});
+	}
+
+	{
+		const std::vector<std::wstring> vSeries = { L"cpu", L"memory", L"disk", L"network" };
+		const int iBuilds = 20000;
+
+		bench::run("BuildLineChart, 4 series", 3, iBuilds, [&]()
+		{
+			CChartScene scene;
+
+			for (int i = 0; i < iBuilds; i++)
+				scene.BuildLineChart(info, vSeries, measure);
+
+			bench::keep(scene.Legend().size());
+		});
+	}
+
+	{
+		CChartScene scene;
+		scene.BuildLineChart(info, { L"cpu" }, measure);
+
+		const int iChecks = 10000000;
+
+		bench::run("IsValid", 3, iChecks, [&]()
+		{
+			size_t iValid = 0;
+
+			for (int i = 0; i < iChecks; i++)
+				iValid += scene.IsValid(info);
+
+			bench::keep(iValid);
+		});
+	}
+
+	return 0;
+}
@@ -0,0 +1,132 @@
+//
+// date_gen_bench.cpp - the integer date_gen calendar against the old mktime path
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "bench.h"
+#include "cui.h"
+#include "reference/date_gen.h"
+#include "time_stamp/civil_date.h"
+
+#include <cstdlib>
+
+namespace date_gen = liblec::cui::date_gen;
+
+int main()
+{
+	const int iCount = 100000;
+
+	// mktime consults the time zone rules, so the old path costs more where there are any
+	for (const char *sZone : { "UTC", "Europe/London" })
+	{
+		setenv("TZ", sZone, 1);
+		tzset();
+		std::printf("TZ=%s\n", sZone);
+
+		bench::run("days_from_civil", 3, iCount, [&]()
+		{
+			int iTotal = 0;
+
+			for (int i = 0; i < iCount; i++)
+				iTotal += civil_date::days_from_civil(1950 + i % 100, 1 + i % 12, 1 + i % 28);
+
+			bench::keep(iTotal);
+		});
+
+		bench::run("mktime", 3, iCount, [&]()
+		{
+			std::time_t total = 0;
+
+			for (int i = 0; i < iCount; i++)
+			{
+				std::tm time_in = { 0, 0, 0, 1 + i % 28, i % 12, 50 + i % 100 };
+				total += std::mktime(&time_in);
+			}
+
+			bench::keep(total);
+		});
+
+		const double old_week = bench::run("get_week + get_month, old", 3, iCount, [&]()
+		{
+			int iTotal = 0;
+			reference::date_gen::date start, end;
+
+			for (int i = 0; i < iCount; i++)
+			{
+				const reference::date_gen::date dt{ 1 + i % 28, 1 + i % 12, 1950 + i % 100 };
+				reference::date_gen::get_week(dt, start, end);
+				iTotal += start.day;
+				reference::date_gen::get_month(dt, start, end);
+				iTotal += end.day;
+			}
+
+			bench::keep(iTotal);
+		});
+
+		const double new_week = bench::run("get_week + get_month, new", 3, iCount, [&]()
+		{
+			int iTotal = 0;
+			date_gen::date start, end;
+
+			for (int i = 0; i < iCount; i++)
+			{
+				const date_gen::date dt{ 1 + i % 28, 1 + i % 12, 1950 + i % 100 };
+				date_gen::get_week(dt, start, end);
+				iTotal += start.day;
+				date_gen::get_month(dt, start, end);
+				iTotal += end.day;
+			}
+
+			bench::keep(iTotal);
+		});
+
+		const double old_add = bench::run("add_days, old", 3, iCount, [&]()
+		{
+			int iTotal = 0;
+
+			for (int i = 0; i < iCount; i++)
+			{
+				reference::date_gen::date dt{ 1 + i % 28, 1 + i % 12, 1950 + i % 100 };
+				reference::date_gen::add_days(dt, i % 1000 - 500);
+				iTotal += dt.day;
+			}
+
+			bench::keep(iTotal);
+		});
+
+		const double new_add = bench::run("add_days, new", 3, iCount, [&]()
+		{
+			int iTotal = 0;
+
+			for (int i = 0; i < iCount; i++)
+			{
+				date_gen::date dt{ 1 + i % 28, 1 + i % 12, 1950 + i % 100 };
+				date_gen::add_days(dt, i % 1000 - 500);
+				iTotal += dt.day;
+			}
+
+			bench::keep(iTotal);
+		});
+
+		std::printf("get_week + get_month %.1fx faster, add_days %.1fx faster\n",
+			old_week / new_week, old_add / new_add);
+	}
+
+	// a year of days, as a calendar view fills itself
+	bench::run("for_each_day, 100 years", 3, 36525, [&]()
+	{
+		int iTotal = 0;
+
+		date_gen::for_each_day(date_gen::date{ 1, 1, 1950 }, date_gen::date{ 31, 12, 2049 },
+			[&](const date_gen::date &dt) { iTotal += dt.day; });
+
+		bench::keep(iTotal);
+	});
+
+	return 0;
+}
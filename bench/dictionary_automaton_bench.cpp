@@ -0,0 +1,82 @@
+//
+// dictionary_automaton_bench.cpp - finding embedded dictionary words against looking up every substring
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "bench.h"
+#include "password_corpus.h"
+
+int main()
+{
+	using namespace liblec::cui;
+
+	const size_t iCount = 100000;
+	const std::vector<password_pair> vPairs = bench::password_corpus(iCount);
+
+	// the automaton is built the first time it is needed
+	bench::run("build the automaton", 1, 1, [&]()
+	{
+		bench::keep(dictionary::GetAutomaton());
+	});
+
+	const dictionary_automaton* pAutomaton = dictionary::GetAutomaton();
+
+	if (!pAutomaton)
+	{
+		std::printf("cannot load the dictionary\n");
+		return 1;
+	}
+
+	size_t iCharacters = 0;
+
+	for (auto &it : vPairs)
+		iCharacters += it.password.length();
+
+	std::printf("%zu passwords, %.1f characters on average\n", iCount, double(iCharacters) / iCount);
+
+	std::vector<dictionary_match> matches;
+
+	const double automaton = bench::run("dictionary_automaton::find", 3, double(iCount), [&]()
+	{
+		size_t iTotal = 0;
+
+		for (auto &it : vPairs)
+		{
+			pAutomaton->find(it.password, matches);
+			iTotal += matches.size();
+		}
+
+		bench::keep(iTotal);
+	});
+
+	// what finding embedded words would cost without the automaton, ignoring case but
+	// without the substitutions
+	const double substrings = bench::run("every substring through the index", 3, double(iCount), [&]()
+	{
+		size_t iTotal = 0;
+		std::string sLower;
+
+		for (auto &it : vPairs)
+		{
+			sLower = it.password;
+
+			for (auto &c : sLower)
+				c = char(std::tolower((unsigned char)c));
+
+			for (size_t i = 0; i < sLower.length(); i++)
+				for (size_t n = dictionary_automaton::min_length;
+					n <= dictionary_automaton::max_length && i + n <= sLower.length(); n++)
+					iTotal += dictionary::SearchInDict(sLower.substr(i, n), true) == 1;
+		}
+
+		bench::keep(iTotal);
+	});
+
+	std::printf("the automaton is %.1fx faster\n", substrings / automaton);
+	return 0;
+}
@@ -0,0 +1,137 @@
+//
+// dictionary_bench.cpp - loading the password dictionary and looking words up in it
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "bench.h"
+#include "reference/dictionary_search.h"
+#include "password_rating/dictionary/dictionary.h"
+
+#include <fstream>
+#include <sstream>
+#include <random>
+
+int main()
+{
+	const std::string sWordList = std::string(CUI_ROOT) + "/resources/doc/dict.txt";
+
+	std::ifstream in(sWordList, std::ios::binary);
+	std::stringstream ss;
+	ss << in.rdbuf();
+	const std::string sText = ss.str();
+
+	if (sText.empty())
+	{
+		std::printf("cannot read %s\n", sWordList.c_str());
+		return 1;
+	}
+
+	// every word of the list, and as many words that are not in it
+	std::vector<std::string> vWords, vMisses;
+	std::istringstream lines(sText);
+
+	for (std::string sLine; std::getline(lines, sLine);)
+	{
+		if (!sLine.empty() && sLine.back() == '\r')
+			sLine.pop_back();
+
+		if (!sLine.empty())
+			vWords.push_back(sLine);
+	}
+
+	std::mt19937 rng(11);
+
+	for (size_t i = 0; i < vWords.size(); i++)
+		vMisses.push_back(vWords[rng() % vWords.size()] + "qx" + std::to_string(i));
+
+	std::printf("%zu words, %zu bytes\n", vWords.size(), sText.size());
+
+	// loading
+	dictionary_index index;
+	std::vector<char> vImage;
+
+	bench::run("build index from the word list", 5, double(vWords.size()), [&]()
+	{
+		index.build(sText.data(), sText.size());
+	});
+
+	index.save(vImage);
+
+	bench::run("attach compiled image, checksum verified", 5, double(vWords.size()), [&]()
+	{
+		dictionary_index attached;
+		bench::keep(attached.attach(vImage.data(), vImage.size(), true));
+	});
+
+	bench::run("attach compiled image, as a resource", 5, double(vWords.size()), [&]()
+	{
+		dictionary_index attached;
+		bench::keep(attached.attach(vImage.data(), vImage.size(), false));
+	});
+
+	bench::run("dictionary::LoadDict(dict.txt)", 5, double(vWords.size()), [&]()
+	{
+		bench::keep(dictionary::LoadDict(sWordList));
+	});
+
+	// lookups
+	bench::run("index, every word (case sensitive)", 5, double(vWords.size()), [&]()
+	{
+		size_t iFound = 0;
+
+		for (auto &it : vWords)
+			iFound += index.contains(it);
+
+		bench::keep(iFound);
+	});
+
+	bench::run("index, misses", 5, double(vMisses.size()), [&]()
+	{
+		size_t iFound = 0;
+
+		for (auto &it : vMisses)
+			iFound += index.contains(it);
+
+		bench::keep(iFound);
+	});
+
+	bench::run("SearchInDict, every word (case insensitive)", 5, double(vWords.size()), [&]()
+	{
+		int iFound = 0;
+
+		for (auto &it : vWords)
+			iFound += dictionary::SearchInDict(it, false);
+
+		bench::keep(iFound);
+	});
+
+	// the substring search is far too slow for the whole list
+	const size_t iSample = 500;
+
+	bench::run("old substring search, 500 words", 3, double(iSample), [&]()
+	{
+		int iFound = 0;
+
+		for (size_t i = 0; i < iSample; i++)
+			iFound += reference::SearchInDict(sText.c_str(), vWords[(i * 7919) % vWords.size()], false);
+
+		bench::keep(iFound);
+	});
+
+	bench::run("old substring search, 500 misses", 3, double(iSample), [&]()
+	{
+		int iFound = 0;
+
+		for (size_t i = 0; i < iSample; i++)
+			iFound += reference::SearchInDict(sText.c_str(), vMisses[i], false);
+
+		bench::keep(iFound);
+	});
+
+	return 0;
+}
@@ -0,0 +1,128 @@
+//
+// hit_grid_bench.cpp - CHitGrid against testing every rectangle on each mouse move
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "bench.h"
+#include "cui_raw/cui_rawImpl/CHitGrid/CHitGrid.h"
+
+#include <random>
+
+typedef CHitGrid::rect rect;
+
+namespace
+{
+	void compare(const char *sLayout, const std::vector<rect> &vRects)
+	{
+		const int iQueries = 200000;
+
+		std::printf("%s, %zu rectangles\n", sLayout, vRects.size());
+
+		CHitGrid grid;
+
+		// what a resize costs: the grid is cleared, refilled and laid out again
+		bench::run("  Clear + Add + Build", 5, 100, [&]()
+		{
+			for (int k = 0; k < 100; k++)
+			{
+				grid.Clear();
+
+				for (size_t i = 0; i < vRects.size(); i++)
+					grid.Add(vRects[i], i);
+
+				grid.Build();
+			}
+		});
+
+		std::vector<size_t> vIDs;
+
+		const double grid_time = bench::run("  Query", 3, iQueries, [&]()
+		{
+			size_t iTotal = 0;
+
+			for (int k = 0; k < iQueries; k++)
+			{
+				grid.Query(long(k * 7 % 1920), long(k * 13 % 1080), vIDs);
+				iTotal += vIDs.size();
+			}
+
+			bench::keep(iTotal);
+		});
+
+		// every rectangle, as OnWM_MOUSEMOVE hit tested before the grid
+		const double linear_time = bench::run("  every rectangle", 3, iQueries, [&]()
+		{
+			size_t iTotal = 0;
+
+			for (int k = 0; k < iQueries; k++)
+			{
+				const long x = long(k * 7 % 1920), y = long(k * 13 % 1080);
+				vIDs.clear();
+
+				for (size_t i = 0; i < vRects.size(); i++)
+				{
+					const rect &rc = vRects[i];
+
+					if (x >= rc.left && x < rc.right && y >= rc.top && y < rc.bottom)
+						vIDs.push_back(i);
+				}
+
+				iTotal += vIDs.size();
+			}
+
+			bench::keep(iTotal);
+		});
+
+		std::printf("%44s %.1fx faster\n", "", linear_time / grid_time);
+	}
+}
+
+int main()
+{
+	std::mt19937 rng(1);
+
+	// a page of icons
+	{
+		std::vector<rect> vRects;
+
+		for (long r = 0; r < 20; r++)
+			for (long c = 0; c < 16; c++)
+				vRects.push_back(rect{ 20 + c * 70, 80 + r * 50, 20 + c * 70 + 64, 80 + r * 50 + 44 });
+
+		compare("grid of icons", vRects);
+	}
+
+	// a dashboard of overlapping controls under a full window background
+	{
+		std::vector<rect> vRects;
+
+		for (int i = 0; i < 1000; i++)
+		{
+			const long x = long(rng() % 1800), y = long(rng() % 1000);
+			vRects.push_back(rect{ x, y, x + 1 + long(rng() % 200), y + 1 + long(rng() % 120) });
+		}
+
+		vRects.push_back(rect{ 0, 0, 1920, 1080 });
+		compare("random overlapping controls", vRects);
+	}
+
+	// a handful of large controls
+	{
+		std::vector<rect> vRects;
+
+		for (int i = 0; i < 50; i++)
+		{
+			const long x = long(rng() % 1800) - 100, y = long(rng() % 1000) - 50;
+			vRects.push_back(rect{ x, y, x + 1 + long(rng() % 300), y + 1 + long(rng() % 300) });
+		}
+
+		compare("few large controls", vRects);
+	}
+
+	return 0;
+}
@@ -0,0 +1,60 @@
+//
+// image_loader_bench.cpp - the CImageLoader stages a photo goes through before it is drawn
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "bench.h"
+#include "cui_raw/cui_rawImpl/CImageLoader/CImageLoader.h"
+
+#include <random>
+
+int main()
+{
+	// a 12 megapixel photo with some transparency, as a decoder would give it
+	CImageLoader::pixels photo;
+	photo.cx = 4000;
+	photo.cy = 3000;
+	photo.data.resize(size_t(photo.cx) * size_t(photo.cy));
+
+	std::mt19937 rng(12);
+
+	for (auto &it : photo.data)
+		it = std::uint32_t(rng()) | 0x80000000;
+
+	const double iPixels = double(photo.data.size());
+
+	// the copy it works on is timed with it
+	bench::run("Premultiply, 4000x3000", 3, iPixels, [&]()
+	{
+		CImageLoader::pixels image = photo;
+		CImageLoader::Premultiply(image);
+		bench::keep(image.data[0]);
+	});
+
+	CImageLoader::Premultiply(photo);
+
+	// the sizes image controls and thumbnails ask for; the time is per source pixel
+	const int targets[][2] = { { 1920, 1080 }, { 800, 600 }, { 200, 200 }, { 64, 64 } };
+
+	for (const auto &target : targets)
+	{
+		int cx = 0, cy = 0;
+		CImageLoader::Fit(photo.cx, photo.cy, target[0], target[1], cx, cy);
+
+		char sName[64];
+		std::snprintf(sName, sizeof(sName), "Resize, 4000x3000 to %dx%d", cx, cy);
+
+		bench::run(sName, 3, iPixels, [&]()
+		{
+			CImageLoader::pixels image = CImageLoader::Resize(photo, cx, cy);
+			bench::keep(image.data[0]);
+		});
+	}
+
+	return 0;
+}
@@ -0,0 +1,179 @@
+//
+// linechart_bench.cpp - streaming points into a line chart and the data side of repainting it
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "bench.h"
+#include "cui_raw/cui_rawImpl/LineChart/CLineChartSeries.h"
+#include "cui_raw/cui_rawImpl/LineChart/CLineChartDecimate.h"
+#include "cui_raw/cui_rawImpl/CChartAxis/CChartAxis.h"
+
+#include <string>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+	// cui_raw::barChartData
+	struct point
+	{
+		int iNumber;
+		std::wstring sLabel;
+		double dValue;
+	};
+
+	struct pointF { float X, Y; };
+
+	const int iPlotWidth = 800;
+	const int iPlotHeight = 300;
+
+	point make(int i)
+	{
+		return point{ i, L"", 50 + 40 * std::sin(i * 0.01) + (i % 7) };
+	}
+
+	// where LineChart.cpp puts point i of a series of iPoints points
+	pointF project(size_t i, size_t iPoints, double dValue, double dLower, double dUpper)
+	{
+		const double dxSep = double(iPlotWidth) / double(iPoints ? iPoints : 1);
+		const double dRatio = std::min(std::max((dValue - dLower) / (dUpper - dLower), 0.0), 1.0);
+		return pointF{ float(i * dxSep + dxSep / 2), float(iPlotHeight - dRatio * iPlotHeight) };
+	}
+
+	/*
+	** before the series were ring buffers: each new point meant reloading the whole series,
+	** and each paint scanned every point for the range and drew every point
+	*/
+	struct reload_chart
+	{
+		std::vector<point> vPoints;
+		std::vector<pointF> vDrawn;
+		CChartAxis axis;
+
+		void append(const std::vector<point> &vSource)
+		{
+			vPoints = vSource;
+		}
+
+		void paint()
+		{
+			double dMin = vPoints[0].dValue, dMax = vPoints[0].dValue;
+
+			for (auto &it : vPoints)
+			{
+				dMin = std::fmin(dMin, it.dValue);
+				dMax = std::fmax(dMax, it.dValue);
+			}
+
+			axis.Calculate(dMin, dMax, 10);
+
+			vDrawn.clear();
+
+			for (size_t i = 0; i < vPoints.size(); i++)
+				vDrawn.push_back(project(i, vPoints.size(), vPoints[i].dValue, axis.Lower(), axis.Upper()));
+
+			bench::keep(vDrawn);
+		}
+	};
+
+	// the ring-buffered series with the level of detail LineChart.cpp draws
+	struct stream_chart
+	{
+		ClinechartSeriesT<point> values;
+		std::vector<double> vValues;
+		std::vector<size_t> vLod;
+		std::vector<pointF> vDrawn;
+		CChartAxis axis;
+
+		explicit stream_chart(size_t iCapacity) : values(iCapacity) {}
+
+		void append(point pt)
+		{
+			values.Append(std::move(pt));
+		}
+
+		void paint()
+		{
+			double dMin = 0, dMax = 0;
+			values.GetRange(dMin, dMax);
+			axis.Calculate(dMin, dMax, 10);
+
+			// getLineLod
+			vValues.resize(values.Size());
+
+			for (size_t i = 0; i < vValues.size(); i++)
+				vValues[i] = values[i].dValue;
+
+			ClinechartDecimate::MinMax(vValues.data(), vValues.size(), iPlotWidth, vLod);
+
+			vDrawn.clear();
+
+			for (size_t i : vLod)
+				vDrawn.push_back(project(i, values.Size(), values[i].dValue, axis.Lower(), axis.Upper()));
+
+			bench::keep(vDrawn);
+		}
+	};
+}
+
+int main()
+{
+	for (size_t iCapacity : { size_t(1000), size_t(10000), size_t(100000), size_t(1000000) })
+	{
+		char sName[128];
+
+		// fewer frames for the larger series so the reloads finish in reasonable time
+		const int iFrames = int(std::min<size_t>(200, std::max<size_t>(10, 2000000 / iCapacity)));
+
+		// a window of iCapacity points that moves on by one point a frame
+		std::vector<point> vSource;
+
+		for (size_t i = 0; i < iCapacity; i++)
+			vSource.push_back(make(int(i)));
+
+		reload_chart before;
+		stream_chart after(iCapacity);
+
+		for (auto &it : vSource)
+			after.append(it);
+
+		std::snprintf(sName, sizeof(sName), "%zu points, reload + full paint", iCapacity);
+		bench::run(sName, 3, iFrames, [&]()
+		{
+			std::vector<point> vWindow = vSource;
+
+			for (int f = 0; f < iFrames; f++)
+			{
+				vWindow.erase(vWindow.begin());
+				vWindow.push_back(make(int(iCapacity) + f));
+				before.append(vWindow);
+				before.paint();
+			}
+		});
+
+		std::snprintf(sName, sizeof(sName), "%zu points, append + decimated paint", iCapacity);
+		bench::run(sName, 3, iFrames, [&]()
+		{
+			for (int f = 0; f < iFrames; f++)
+			{
+				after.append(make(int(iCapacity) + f));
+				after.paint();
+			}
+		});
+
+		std::snprintf(sName, sizeof(sName), "%zu points, append only", iCapacity);
+		bench::run(sName, 3, iFrames * 100.0, [&]()
+		{
+			for (int f = 0; f < iFrames * 100; f++)
+				after.append(make(f));
+		});
+	}
+
+	return 0;
+}
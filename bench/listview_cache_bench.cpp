@@ -0,0 +1,141 @@
+//
+// listview_cache_bench.cpp - a million row virtual listview through ClistviewCacheT
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "bench.h"
+#include "cui_raw/cui_rawImpl/CListView/CListViewCache.h"
+
+#include <random>
+
+typedef ClistviewCacheT<char> cache_t;
+
+namespace
+{
+	const int iRows = 1000000;
+	const int iColumns = 6;
+	const int iVisibleRows = 40;
+
+	// what an application's row provider does: format a row of its data
+	void provide(int iRowNumber, cache_t::row &cells)
+	{
+		char buffer[32];
+
+		for (size_t c = 0; c < cells.size(); c++)
+		{
+			std::snprintf(buffer, sizeof(buffer), "%d-%zu", iRowNumber, c * 7919 + 13);
+			cells[c].sText = buffer;
+			cells[c].bCustom = c == 0 && iRowNumber % 10 == 0;
+			cells[c].clrText = cells[c].bCustom ? 0x0000C0 : 0;
+		}
+	}
+}
+
+int main()
+{
+	cache_t cache;
+	cache.SetNumOfCols(iColumns);
+	cache.SetRowCount(iRows);
+	cache.SetProvider(provide);
+
+	const int iPages = iRows / iVisibleRows;
+	const double iCells = double(iPages) * iVisibleRows * iColumns;
+
+	std::printf("%d rows, %d columns, %d pages of %d rows\n", iRows, iColumns, iPages, iVisibleRows);
+
+	/*
+	** scrolling through every page: LVN_ODCACHEHINT for the page, then LVN_GETDISPINFO and
+	** the custom draw lookup for each cell
+	*/
+	bench::run("scroll, ClistviewCacheT", 3, iCells, [&]()
+	{
+		cache.Invalidate();
+		size_t iTotal = 0;
+
+		for (int p = 0; p < iPages; p++)
+		{
+			const int iTop = p * iVisibleRows;
+			cache.Hint(iTop, iTop + iVisibleRows - 1);
+
+			for (int r = iTop; r < iTop + iVisibleRows; r++)
+				for (int c = 0; c < iColumns; c++)
+				{
+					iTotal += cache.GetCell(r, c)->sText.size();
+					iTotal += cache.GetCell(r, c)->bCustom;
+				}
+		}
+
+		bench::keep(iTotal);
+	});
+
+	// without a cache every request would ask the provider for the row again; only the first
+	// twentieth of the rows, since that is slow
+	bench::run("scroll, provider per request", 3, iCells / 20, [&]()
+	{
+		cache_t::row cells(iColumns);
+		size_t iTotal = 0;
+
+		for (int p = 0; p < iPages / 20; p++)
+		{
+			const int iTop = p * iVisibleRows;
+
+			for (int r = iTop; r < iTop + iVisibleRows; r++)
+				for (int c = 0; c < iColumns; c++)
+				{
+					provide(r, cells);
+					iTotal += cells[c].sText.size();
+					provide(r, cells);
+					iTotal += cells[c].bCustom;
+				}
+		}
+
+		bench::keep(iTotal);
+	});
+
+	// repainting a page that is already cached, e.g. on hover
+	const int iRepaints = 20000;
+
+	bench::run("repaint a cached page", 3, double(iRepaints) * iVisibleRows * iColumns, [&]()
+	{
+		cache.Hint(5000, 5000 + iVisibleRows - 1);
+		size_t iTotal = 0;
+
+		for (int i = 0; i < iRepaints; i++)
+			for (int r = 5000; r < 5000 + iVisibleRows; r++)
+				for (int c = 0; c < iColumns; c++)
+					iTotal += cache.GetCell(r, c)->sText.size();
+
+		bench::keep(iTotal);
+	});
+
+	// jumping around, e.g. dragging the scroll thumb
+	std::mt19937 rng(3);
+	std::vector<int> vTops(20000);
+
+	for (auto &it : vTops)
+		it = int(rng() % (iRows - iVisibleRows));
+
+	bench::run("random pages", 3, double(vTops.size()) * iVisibleRows * iColumns, [&]()
+	{
+		size_t iTotal = 0;
+
+		for (const int iTop : vTops)
+		{
+			cache.Hint(iTop, iTop + iVisibleRows - 1);
+
+			for (int r = iTop; r < iTop + iVisibleRows; r++)
+				for (int c = 0; c < iColumns; c++)
+					iTotal += cache.GetCell(r, c)->sText.size();
+		}
+
+		bench::keep(iTotal);
+	});
+
+	std::printf("%zu hits, %zu misses\n", cache.Hits(), cache.Misses());
+	return 0;
+}
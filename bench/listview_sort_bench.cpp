@@ -0,0 +1,81 @@
+//
+// listview_sort_bench.cpp - ClistviewSortT against the comparator columns used to be sorted with
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "bench.h"
+#include "reference/listview_compare.h"
+#include "cui_raw/cui_rawImpl/CListView/CListViewSort.h"
+
+#include <random>
+#include <algorithm>
+
+typedef ClistviewSortT<char> sorter;
+
+namespace
+{
+	void compare(const char *sColumn, const std::vector<std::string> &vRows, sorter::enType type)
+	{
+		char sName[128];
+
+		// the old comparator, with ListView_SortItemsEx replaced by a stable sort of row numbers
+		std::snprintf(sName, sizeof(sName), "%s x%zu, old comparator", sColumn, vRows.size());
+		bench::run(sName, 3, double(vRows.size()), [&]()
+		{
+			std::vector<int> vOrder(vRows.size());
+			std::iota(vOrder.begin(), vOrder.end(), 0);
+			std::stable_sort(vOrder.begin(), vOrder.end(), [&](int a, int b)
+			{
+				return reference::listview_compare(vRows[a], vRows[b], true) < 0;
+			});
+			bench::keep(vOrder);
+		});
+
+		std::vector<const std::string*> vText;
+
+		for (auto &it : vRows)
+			vText.push_back(&it);
+
+		std::snprintf(sName, sizeof(sName), "%s x%zu, ClistviewSortT", sColumn, vRows.size());
+		bench::run(sName, 3, double(vRows.size()), [&]()
+		{
+			bench::keep(sorter::Sort(vText, type, true));
+		});
+	}
+}
+
+int main()
+{
+	std::mt19937 rng(1);
+
+	for (size_t iRows : { size_t(1000), size_t(10000), size_t(100000) })
+	{
+		std::vector<std::string> vNames(iRows), vNumbers(iRows), vDates(iRows);
+
+		for (size_t i = 0; i < iRows; i++)
+		{
+			vNames[i].resize(4 + rng() % 12);
+
+			for (auto &c : vNames[i])
+				c = char((rng() % 2 ? 'a' : 'A') + rng() % 26);
+
+			vNumbers[i] = std::to_string(int(rng() % 2000000) - 1000000);
+
+			char sDate[16];
+			std::snprintf(sDate, sizeof(sDate), "%04u-%02u-%02u",
+				1950 + unsigned(rng() % 100), 1 + unsigned(rng() % 12), 1 + unsigned(rng() % 28));
+			vDates[i] = sDate;
+		}
+
+		compare("text", vNames, sorter::String);
+		compare("integers", vNumbers, sorter::Int);
+		compare("dates", vDates, sorter::String);
+	}
+
+	return 0;
+}
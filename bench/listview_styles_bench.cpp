@@ -0,0 +1,146 @@
+//
+// listview_styles_bench.cpp - listview custom draw replayed against ClistviewStyles and the old lookup
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "bench.h"
+#include "reference/listview_custom_draw.h"
+#include "cui_raw/cui_rawImpl/CListView/CListViewStyles.h"
+
+#include <random>
+#include <algorithm>
+
+namespace
+{
+	const int iColumns = 8;
+	const int iVisibleRows = 40;	// the rows a repaint of a full height listview draws
+
+	// rows with a custom color in every seventh cell, and a bar chart in the last column
+	void make_rows(int iRows, std::vector<reference::listviewRow> &vRows,
+		std::vector<reference::listviewColumn> &vColumns)
+	{
+		std::mt19937 rng(1);
+
+		vColumns.assign(iColumns, reference::listviewColumn());
+
+		for (int c = 0; c < iColumns; c++)
+		{
+			vColumns[c].iColumnID = c;
+			vColumns[c].sColumnName = "column " + std::to_string(c);
+			vColumns[c].bBarChart = c == iColumns - 1;
+		}
+
+		vRows.assign(iRows, reference::listviewRow());
+
+		for (int r = 0; r < iRows; r++)
+		{
+			vRows[r].vItems.resize(iColumns);
+
+			for (int c = 0; c < iColumns; c++)
+			{
+				reference::listviewItem &item = vRows[r].vItems[c];
+				item.iRowNumber = r;
+				item.sColumnName = vColumns[c].sColumnName;
+				item.sItemData = std::to_string(rng() % 100000);
+				item.bCustom = (r * iColumns + c) % 7 == 0;
+				item.clrText = ClistviewStyles::rgb(200, 0, 0);
+			}
+		}
+	}
+
+	/*
+	** the draw stages of scrolling through the listview a page at a time: CDDS_PREPAINT, then
+	** CDDS_ITEMPREPAINT for each visible row and CDDS_SUBITEMPREPAINT for each of its cells
+	** lookup(iRow, iColumn) is the subitem stage; iStages subitem stages are replayed
+	*/
+	template <typename F>
+	void replay(int iRows, size_t iStages, F lookup)
+	{
+		for (size_t iPage = 0; iStages > 0; iPage++)
+		{
+			const int iTop = int((iPage * iVisibleRows) % size_t(iRows));
+
+			for (int r = iTop; r < iTop + iVisibleRows && r < iRows && iStages > 0; r++)
+				for (int c = 0; c < iColumns && iStages > 0; c++, iStages--)
+					lookup(r, c);
+		}
+	}
+}
+
+int main()
+{
+	for (int iRows : { 1000, 10000, 50000 })
+	{
+		std::vector<reference::listviewRow> vRows;
+		std::vector<reference::listviewColumn> vColumns;
+		make_rows(iRows, vRows, vColumns);
+
+		// the index as buildListviewStyles fills it
+		ClistviewStyles styles;
+		styles.Reset(iColumns);
+
+		for (const auto &column : vColumns)
+			styles.SetBarChart(column.iColumnID, column.bBarChart);
+
+		styles.Reserve(iRows);
+
+		for (int r = 0; r < iRows; r++)
+		{
+			styles.AddRow();
+
+			for (int c = 0; c < iColumns; c++)
+				styles.SetCell(r, c, vRows[r].vItems[c].bCustom, vRows[r].vItems[c].clrText);
+		}
+
+		std::printf("%d rows, %d columns\n", iRows, iColumns);
+
+		// every stage used to copy the whole data set, so the old lookup gets fewer stages
+		const size_t iOldStages = std::max<size_t>(8, 2000000 / (size_t(iRows) * iColumns));
+
+		const double old_time = bench::run("  old lookup, rows copied per stage", 3, double(iOldStages), [&]()
+		{
+			size_t iCustom = 0;
+
+			replay(iRows, iOldStages, [&](int r, int c)
+			{
+				std::uint32_t clrText = 0;
+				bool bBarChart = false;
+				iCustom += reference::custom_draw(vRows, vColumns, r, c, clrText, bBarChart);
+				iCustom += bBarChart;
+			});
+
+			bench::keep(iCustom);
+		});
+
+		const size_t iStages = 32000000;
+
+		const double new_time = bench::run("  ClistviewStyles::Get", 3, double(iStages), [&]()
+		{
+			size_t iCustom = 0;
+
+			replay(iRows, iStages, [&](int r, int c)
+			{
+				const ClistviewStyles::cellStyle *pStyle = styles.Get(r, c);
+
+				if (pStyle)
+				{
+					iCustom += (pStyle->flags & ClistviewStyles::custom) != 0;
+					iCustom += (pStyle->flags & ClistviewStyles::barchart) != 0;
+					iCustom += pStyle->clrText & 1;
+				}
+			});
+
+			bench::keep(iCustom);
+		});
+
+		std::printf("  per subitem stage: %.0fx faster\n",
+			(old_time / double(iOldStages)) / (new_time / double(iStages)));
+	}
+
+	return 0;
+}
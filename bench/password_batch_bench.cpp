@@ -0,0 +1,65 @@
+//
+// password_batch_bench.cpp - password_rating_batch throughput against rating one pair at a time
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "bench.h"
+#include "password_corpus.h"
+
+#include <thread>
+
+int main()
+{
+	using namespace liblec::cui;
+
+	const size_t iCount = 200000;
+	const std::vector<password_pair> vPairs = bench::password_corpus(iCount);
+
+	const unsigned iProcessors = std::max(1u, std::thread::hardware_concurrency());
+	std::printf("%zu pairs, %u processor(s)\n", iCount, iProcessors);
+
+	const double single = bench::run("password_rating, one pair at a time", 3, double(iCount), [&]()
+	{
+		int iTotal = 0;
+
+		for (auto &it : vPairs)
+			iTotal += password_rating(it.username, it.password).strength;
+
+		bench::keep(iTotal);
+	});
+
+	// the strengths are the same either way
+	const password_batch_quality check = password_rating_batch(vPairs, 0);
+	size_t iDifferent = 0;
+
+	for (size_t i = 0; i < iCount; i += 97)
+		iDifferent += check.strength[i] != password_rating(vPairs[i].username, vPairs[i].password).strength;
+
+	if (iDifferent)
+		std::printf("batch and single ratings differ for %zu sampled pairs\n", iDifferent);
+
+	std::vector<unsigned> vThreads = { 1, 2, 4, 8 };
+
+	if (iProcessors > 8)
+		vThreads.push_back(iProcessors);
+
+	for (unsigned iThreads : vThreads)
+	{
+		char sName[128];
+		std::snprintf(sName, sizeof(sName), "password_rating_batch, %u thread(s)", iThreads);
+
+		const double batch = bench::run(sName, 3, double(iCount), [&]()
+		{
+			bench::keep(password_rating_batch(vPairs, iThreads));
+		});
+
+		std::printf("%44s %12.0f pairs/s, %.2fx one at a time\n", "", iCount / batch, single / batch);
+	}
+
+	return iDifferent ? 1 : 0;
+}
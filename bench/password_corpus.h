@@ -0,0 +1,113 @@
+//
+// password_corpus.h - username/password pairs for the password rating benchmarks
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include "cui.h"
+#include "password_rating/dictionary/dictionary.h"
+
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+	// the word list the dictionary is loaded from
+	inline std::vector<std::string> word_list()
+	{
+		std::ifstream in(std::string(CUI_ROOT) + "/resources/doc/dict.txt", std::ios::binary);
+		std::vector<std::string> vWords;
+
+		for (std::string sLine; std::getline(in, sLine);)
+		{
+			if (!sLine.empty() && sLine.back() == '\r')
+				sLine.pop_back();
+
+			if (sLine.length() >= 3)
+				vWords.push_back(sLine);
+		}
+
+		return vWords;
+	}
+
+	/*
+	** pairs as a password audit sees them: dictionary words with digits and symbols around
+	** them, names with years, leet spellings, keyboard walks and random strings
+	** also loads the dictionary, since the dll's resource is not there on Linux
+	*/
+	inline std::vector<liblec::cui::password_pair> password_corpus(size_t iCount, unsigned iSeed = 7)
+	{
+		dictionary::LoadDict(std::string(CUI_ROOT) + "/resources/doc/dict.txt");
+
+		static const std::vector<std::string> vWords = word_list();
+		static const char* walks[] = { "qwerty", "asdfgh", "zxcvbn", "1qaz2wsx", "qazwsx", "123456" };
+		static const char symbols[] = "!@#$%^&*?_-.";
+		static const char alphabet[] =
+			"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789!@#$%^&*";
+
+		std::mt19937 rng(iSeed);
+		std::vector<liblec::cui::password_pair> vPairs(iCount);
+
+		for (auto &it : vPairs)
+		{
+			const std::string &sName = vWords[rng() % vWords.size()];
+			it.username = sName + std::to_string(rng() % 100);
+
+			std::string sPassword;
+
+			switch (rng() % 6)
+			{
+			case 0:
+				sPassword = vWords[rng() % vWords.size()] + std::to_string(rng() % 10000);
+				break;
+
+			case 1:
+				sPassword = sName + std::to_string(1950 + rng() % 70) + symbols[rng() % (sizeof(symbols) - 1)];
+				break;
+
+			case 2:
+				sPassword = vWords[rng() % vWords.size()];
+
+				for (auto &c : sPassword)
+				{
+					if (c == 'o') c = '0';
+					else if (c == 'a') c = '@';
+					else if (c == 'e') c = '3';
+				}
+				break;
+
+			case 3:
+				sPassword = std::string(walks[rng() % 6]) + walks[rng() % 6];
+				break;
+
+			case 4:
+				sPassword = vWords[rng() % vWords.size()] + symbols[rng() % (sizeof(symbols) - 1)] +
+					vWords[rng() % vWords.size()];
+				break;
+
+			default:
+				sPassword.resize(8 + rng() % 12);
+
+				for (auto &c : sPassword)
+					c = alphabet[rng() % (sizeof(alphabet) - 1)];
+				break;
+			}
+
+			if (rng() % 3 == 0 && !sPassword.empty())
+				sPassword[0] = char(std::toupper((unsigned char)sPassword[0]));
+
+			it.password = sPassword;
+		}
+
+		return vPairs;
+	}
+}
@@ -0,0 +1,96 @@
+//
+// password_entropy_bench.cpp - password_engine::entropy against the classic rater
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "bench.h"
+#include "password_corpus.h"
+#include "password_rating/password_entropy.h"
+
+int main()
+{
+	using namespace liblec::cui;
+
+	const size_t iCount = 100000;
+	const std::vector<password_pair> vPairs = bench::password_corpus(iCount);
+
+	std::printf("%zu pairs\n", iCount);
+
+	const double classic = bench::run("password_rating, classic", 3, double(iCount), [&]()
+	{
+		int iTotal = 0;
+
+		for (auto &it : vPairs)
+			iTotal += password_rating(it.username, it.password, password_engine::classic).strength;
+
+		bench::keep(iTotal);
+	});
+
+	const double entropy = bench::run("password_rating, entropy", 3, double(iCount), [&]()
+	{
+		int iTotal = 0;
+
+		for (auto &it : vPairs)
+			iTotal += password_rating(it.username, it.password, password_engine::entropy).strength;
+
+		bench::keep(iTotal);
+	});
+
+	// the estimate alone, without the summaries password_rating builds
+	password_entropy::scratch s;
+
+	const double estimate = bench::run("password_entropy::guesses_log10", 3, double(iCount), [&]()
+	{
+		double dTotal = 0;
+
+		for (auto &it : vPairs)
+		{
+			uint32_t issues = 0;
+			dTotal += password_entropy::guesses_log10(it.username, it.password, issues, s);
+		}
+
+		bench::keep(dTotal);
+	});
+
+	std::printf("entropy costs %.2fx classic, %.2fx for the estimate alone\n",
+		entropy / classic, estimate / classic);
+
+	// cost by password length, the matchers and the dynamic programming grow with it
+	const size_t lengths[][2] = { { 0, 8 }, { 9, 16 }, { 17, 32 }, { 33, 64 }, { 65, 256 } };
+
+	for (auto &range : lengths)
+	{
+		std::vector<const password_pair*> vBucket;
+
+		for (auto &it : vPairs)
+			if (it.password.length() >= range[0] && it.password.length() <= range[1])
+				vBucket.push_back(&it);
+
+		if (vBucket.empty())
+			continue;
+
+		char sName[128];
+		std::snprintf(sName, sizeof(sName), "entropy, %zu - %zu characters (%zu)",
+			range[0], range[1], vBucket.size());
+
+		bench::run(sName, 3, double(vBucket.size()), [&]()
+		{
+			double dTotal = 0;
+
+			for (auto p : vBucket)
+			{
+				uint32_t issues = 0;
+				dTotal += password_entropy::guesses_log10(p->username, p->password, issues, s);
+			}
+
+			bench::keep(dTotal);
+		});
+	}
+
+	return 0;
+}
@@ -0,0 +1,90 @@
+//
+// password_rater_bench.cpp - rating a password as it is typed, with password_rater and with full ratings
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "bench.h"
+#include "password_corpus.h"
+
+int main()
+{
+	using namespace liblec::cui;
+
+	const size_t iCount = 20000;
+	const std::vector<password_pair> vPairs = bench::password_corpus(iCount);
+
+	size_t iKeystrokes = 0;
+
+	for (auto &it : vPairs)
+		iKeystrokes += it.password.length();
+
+	std::printf("%zu passwords, %zu keystrokes\n", iCount, iKeystrokes);
+
+	// what a password edit control did on every change before password_rater
+	const double full = bench::run("password_rating per keystroke", 3, double(iKeystrokes), [&]()
+	{
+		int iTotal = 0;
+		std::string sTyped;
+
+		for (auto &it : vPairs)
+		{
+			sTyped.clear();
+
+			for (const char c : it.password)
+			{
+				sTyped.push_back(c);
+				iTotal += password_rating(it.username, sTyped, password_engine::classic).strength;
+			}
+		}
+
+		bench::keep(iTotal);
+	});
+
+	const double typed = bench::run("password_rater::push_back", 3, double(iKeystrokes), [&]()
+	{
+		int iTotal = 0;
+
+		for (auto &it : vPairs)
+		{
+			password_rater rater(it.username);
+
+			for (const char c : it.password)
+			{
+				rater.push_back(c);
+				iTotal += rater.strength();
+			}
+		}
+
+		bench::keep(iTotal);
+	});
+
+	// the edit control only hands over its whole text
+	const double assigned = bench::run("password_rater::assign", 3, double(iKeystrokes), [&]()
+	{
+		int iTotal = 0;
+		std::string sTyped;
+
+		for (auto &it : vPairs)
+		{
+			password_rater rater(it.username);
+			sTyped.clear();
+
+			for (const char c : it.password)
+			{
+				sTyped.push_back(c);
+				rater.assign(sTyped);
+				iTotal += rater.strength();
+			}
+		}
+
+		bench::keep(iTotal);
+	});
+
+	std::printf("password_rater is %.1fx faster typed, %.1fx assigned\n", full / typed, full / assigned);
+	return 0;
+}
@@ -0,0 +1,40 @@
+#
+# settings shared by the Linux tests and benchmarks of the portable modules
+#
+
+get_filename_component(CUI_ROOT ${CMAKE_CURRENT_LIST_DIR}/.. ABSOLUTE)
+
+if(NOT CMAKE_BUILD_TYPE)
+	set(CMAKE_BUILD_TYPE Release)
+endif()
+
+find_package(Threads REQUIRED)
+
+# the portable modules the tests and benchmarks are built with
+set(CUI_DICTIONARY
+	${CUI_ROOT}/password_rating/dictionary/dictionary.cpp
+	${CUI_ROOT}/password_rating/dictionary/dictionary_index.cpp
+	${CUI_ROOT}/password_rating/dictionary/dictionary_automaton.cpp
+	${CUI_ROOT}/password_rating/dictionary/mapped_file.cpp)
+
+set(CUI_PASSWORD_RATING
+	${CUI_ROOT}/password_rating/password_rating.cpp
+	${CUI_ROOT}/password_rating/password_entropy.cpp
+	${CUI_DICTIONARY})
+
+set(CUI_UNIQUE_STRING
+	${CUI_ROOT}/unique_string/unique_string.cpp
+	${CUI_ROOT}/unique_string/random_stream.cpp)
+
+set(CUI_TIME_STAMP
+	${CUI_ROOT}/time_stamp/time_stamp.cpp)
+
+# the sources are compiled as they are in the dll; __declspec is the only MSVC-ism in the
+# exported headers
+function(cui_portable_target name)
+	set_target_properties(${name} PROPERTIES CXX_STANDARD 17 CXX_STANDARD_REQUIRED ON)
+	target_compile_definitions(${name} PRIVATE CUI_EXPORTS CUI_ROOT="${CUI_ROOT}")
+	target_compile_options(${name} PRIVATE "-D__declspec(x)=")
+	target_include_directories(${name} PRIVATE ${CUI_ROOT} ${CUI_ROOT}/test)
+	target_link_libraries(${name} PRIVATE Threads::Threads)
+endfunction()
@@ -0,0 +1,67 @@
+//
+// shadow_bench.cpp - the shadow bitmap of a resized window, by CShadowImage and by the old algorithm
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "bench.h"
+#include "reference/make_shadow.h"
+#include "cui_raw/cui_rawImpl/CShadow/CShadowImage.h"
+
+#include <vector>
+#include <algorithm>
+
+int main()
+{
+	// window sizes, with the default shadow and the softest one the properties allow
+	const int sizes[][2] = { { 400, 300 }, { 1024, 768 }, { 1920, 1080 } };
+	const int sharpness[] = { 5, 20 };
+
+	for (const auto &size : sizes)
+	{
+		const int cx = size[0], cy = size[1];
+
+		// a plain window region is a single rectangle
+		const std::vector<CShadowImage::rect> vRegion = { { 0, 0, cx, cy } };
+
+		for (const int nSharpness : sharpness)
+		{
+			CShadowImage::properties shadow;
+			shadow.nSize = 0;
+			shadow.nSharpness = nSharpness;
+			shadow.nDarkness = 100;
+			shadow.nxOffset = 5;
+			shadow.nyOffset = 5;
+			shadow.clr = 0;
+
+			std::vector<std::uint32_t> vBits((size_t)cx * cy);
+			const double iPixels = double(vBits.size());
+
+			// the bitmap is cleared before each shadow is made, as UpdateShadow does
+			char sName[64];
+			std::snprintf(sName, sizeof(sName), "old, %dx%d, sharpness %d", cx, cy, nSharpness);
+
+			bench::run(sName, 3, iPixels, [&]()
+			{
+				std::fill(vBits.begin(), vBits.end(), 0);
+				reference::make_shadow(vBits.data(), cx, cy, vRegion, shadow);
+				bench::keep(vBits[0]);
+			});
+
+			std::snprintf(sName, sizeof(sName), "CShadowImage, %dx%d, sharpness %d", cx, cy, nSharpness);
+
+			bench::run(sName, 10, iPixels, [&]()
+			{
+				std::fill(vBits.begin(), vBits.end(), 0);
+				CShadowImage::Make(vBits.data(), cx, cy, vRegion, shadow);
+				bench::keep(vBits[0]);
+			});
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,63 @@
+//
+// similarity_bench.cpp - similarity() against the old implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "bench.h"
+#include "password_corpus.h"
+#include "reference/similarity.h"
+
+#include <string_view>
+
+// password_rating.cpp
+float similarity(std::string_view str1, std::string_view str2);
+
+int main()
+{
+	using namespace liblec::cui;
+
+	const size_t iCount = 100000;
+	const std::vector<password_pair> vPairs = bench::password_corpus(iCount);
+
+	std::printf("%zu pairs\n", iCount);
+
+	const double old_time = bench::run("old similarity", 3, double(iCount), [&]()
+	{
+		float fTotal = 0;
+
+		for (auto &it : vPairs)
+			fTotal += reference::similarity(it.username, it.password);
+
+		bench::keep(fTotal);
+	});
+
+	const double new_time = bench::run("similarity", 3, double(iCount), [&]()
+	{
+		float fTotal = 0;
+
+		for (auto &it : vPairs)
+			fTotal += similarity(it.username, it.password);
+
+		bench::keep(fTotal);
+	});
+
+	std::printf("similarity is %.1fx faster\n", old_time / new_time);
+
+	// what rating costs with it
+	bench::run("password_rating, classic", 3, double(iCount), [&]()
+	{
+		int iTotal = 0;
+
+		for (auto &it : vPairs)
+			iTotal += password_rating(it.username, it.password, password_engine::classic).strength;
+
+		bench::keep(iTotal);
+	});
+
+	return 0;
+}
@@ -0,0 +1,192 @@
+//
+// time_stamp_bench.cpp - allocation-free date_gen formatting and the cached local time
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "bench.h"
+#include "cui.h"
+#include "reference/date_gen.h"
+
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace date_gen = liblec::cui::date_gen;
+
+namespace
+{
+	// run f(iCount) on iThreads threads at once, and print the time per call on each thread
+	template <typename F>
+	void threaded(const char *sName, unsigned iThreads, int iCount, F f)
+	{
+		char sName_[128];
+		std::snprintf(sName_, sizeof(sName_), "%s, %u thread(s)", sName, iThreads);
+
+		bench::run(sName_, 3, iCount, [&]()
+		{
+			std::vector<std::thread> vThreads;
+
+			for (unsigned i = 0; i < iThreads; i++)
+				vThreads.emplace_back([&]() { f(iCount); });
+
+			for (auto &it : vThreads)
+				it.join();
+		});
+	}
+}
+
+int main()
+{
+	// a zone with rules, as on a user's machine
+	setenv("TZ", "Europe/London", 1);
+	tzset();
+
+	const int iCount = 1000000;
+
+	bench::run("time_stamp, old", 3, iCount, [&]()
+	{
+		int iTotal = 0;
+
+		for (int i = 0; i < iCount; i++)
+			iTotal += reference::date_gen::time_stamp()[15];
+
+		bench::keep(iTotal);
+	});
+
+	bench::run("time_stamp, string", 3, iCount, [&]()
+	{
+		int iTotal = 0;
+
+		for (int i = 0; i < iCount; i++)
+			iTotal += date_gen::time_stamp()[15];
+
+		bench::keep(iTotal);
+	});
+
+	bench::run("time_stamp, buffer", 3, iCount, [&]()
+	{
+		int iTotal = 0;
+		std::array<char, 17> buffer;
+
+		for (int i = 0; i < iCount; i++)
+		{
+			date_gen::time_stamp(buffer);
+			iTotal += buffer[15];
+		}
+
+		bench::keep(iTotal);
+	});
+
+	bench::run("today, old", 3, iCount, [&]()
+	{
+		int iTotal = 0;
+
+		for (int i = 0; i < iCount; i++)
+			iTotal += reference::date_gen::today().day;
+
+		bench::keep(iTotal);
+	});
+
+	bench::run("today, cached local time", 3, iCount, [&]()
+	{
+		int iTotal = 0;
+
+		for (int i = 0; i < iCount; i++)
+			iTotal += date_gen::today().day;
+
+		bench::keep(iTotal);
+	});
+
+	// localtime takes the C runtime's time zone lock; the cache is per thread
+	const unsigned iThreads = std::max(2u, std::thread::hardware_concurrency());
+
+	threaded("time_stamp, old", iThreads, iCount / 4, [](int n)
+	{
+		int iTotal = 0;
+
+		for (int i = 0; i < n; i++)
+			iTotal += reference::date_gen::time_stamp()[15];
+
+		bench::keep(iTotal);
+	});
+
+	threaded("time_stamp, buffer", iThreads, iCount / 4, [](int n)
+	{
+		int iTotal = 0;
+		std::array<char, 17> buffer;
+
+		for (int i = 0; i < n; i++)
+		{
+			date_gen::time_stamp(buffer);
+			iTotal += buffer[15];
+		}
+
+		bench::keep(iTotal);
+	});
+
+	bench::run("to_string, old", 3, iCount, [&]()
+	{
+		int iTotal = 0;
+
+		for (int i = 0; i < iCount; i++)
+			iTotal += reference::date_gen::to_string({ 1 + i % 28, 1 + i % 12, 2000 + i % 30 })[7];
+
+		bench::keep(iTotal);
+	});
+
+	bench::run("to_string, string", 3, iCount, [&]()
+	{
+		int iTotal = 0;
+
+		for (int i = 0; i < iCount; i++)
+			iTotal += date_gen::to_string(date_gen::date{ 1 + i % 28, 1 + i % 12, 2000 + i % 30 })[7];
+
+		bench::keep(iTotal);
+	});
+
+	bench::run("to_string, buffer", 3, iCount, [&]()
+	{
+		int iTotal = 0;
+		std::array<char, 8> buffer;
+
+		for (int i = 0; i < iCount; i++)
+		{
+			date_gen::to_string(date_gen::date{ 1 + i % 28, 1 + i % 12, 2000 + i % 30 }, buffer);
+			iTotal += buffer[7];
+		}
+
+		bench::keep(iTotal);
+	});
+
+	std::vector<std::string> vDates;
+
+	for (int i = 0; i < 1000; i++)
+		vDates.push_back(date_gen::to_string(date_gen::date{ 1 + i % 28, 1 + i % 12, 2000 + i % 30 }));
+
+	bench::run("from_string, old", 3, iCount, [&]()
+	{
+		int iTotal = 0;
+
+		for (int i = 0; i < iCount; i++)
+			iTotal += reference::date_gen::from_string(vDates[i % vDates.size()]).day;
+
+		bench::keep(iTotal);
+	});
+
+	bench::run("from_string, new", 3, iCount, [&]()
+	{
+		int iTotal = 0;
+
+		for (int i = 0; i < iCount; i++)
+			iTotal += date_gen::from_string(vDates[i % vDates.size()]).day;
+
+		bench::keep(iTotal);
+	});
+
+	return 0;
+}
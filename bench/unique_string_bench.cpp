@@ -0,0 +1,70 @@
+//
+// unique_string_bench.cpp - the cost of a unique string, with and without allocating
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "bench.h"
+#include "cui.h"
+
+int main()
+{
+	using namespace liblec::cui;
+
+	const int iCount = 1000000;
+
+	bench::run("unique_string()", 3, iCount, [&]()
+	{
+		size_t iTotal = 0;
+
+		for (int i = 0; i < iCount; i++)
+			iTotal += unique_string()[0];
+
+		bench::keep(iTotal);
+	});
+
+	for (auto version : { uuid_version::v4, uuid_version::v7 })
+	{
+		std::array<char, 36> buffer;
+
+		bench::run(version == uuid_version::v4 ? "unique_string(buffer), v4" : "unique_string(buffer), v7",
+			3, iCount, [&]()
+		{
+			size_t iTotal = 0;
+
+			for (int i = 0; i < iCount; i++)
+			{
+				unique_string(buffer, version);
+				iTotal += buffer[0];
+			}
+
+			bench::keep(iTotal);
+		});
+	}
+
+	bench::run("unique_strings(1000)", 3, iCount, [&]()
+	{
+		size_t iTotal = 0;
+
+		for (int i = 0; i < iCount / 1000; i++)
+			iTotal += unique_strings(1000).size();
+
+		bench::keep(iTotal);
+	});
+
+	bench::run("unique_string_short()", 3, iCount, [&]()
+	{
+		size_t iTotal = 0;
+
+		for (int i = 0; i < iCount; i++)
+			iTotal += unique_string_short()[0];
+
+		bench::keep(iTotal);
+	});
+
+	return 0;
+}
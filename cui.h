@@ -38,6 +38,9 @@
 
 #include <string>
 #include <vector>
+#include <cstdint>
+#include <functional>
+#include <array>
 
 namespace liblec
 {
@@ -57,12 +60,216 @@ namespace liblec
 			std::string rating_summary;
 			std::string issues_summary;
 			std::vector<std::string> issues;
+
+			/// <summary>
+			/// Base 10 logarithm of the estimated number of guesses needed to find the
+			/// password. Only set by password_engine::entropy.
+			/// </summary>
+			double guesses_log10 = 0;
+		};
+
+		/// <summary>
+		/// Password scoring engines.
+		/// </summary>
+		enum class password_engine {
+			/// <summary>
+			/// Score from character class counts and their mix, with penalties for
+			/// similarity to the username, duplicates and dictionary words.
+			/// </summary>
+			classic,
+
+			/// <summary>
+			/// Score from the estimated number of guesses needed to find the password,
+			/// given the dictionary words, username, keyboard patterns, repeats,
+			/// sequences and dates it is made of.
+			/// </summary>
+			entropy,
 		};
 
 		password_quality cui_api password_rating(const std::string& username,
 			const std::string& password);
 
+		password_quality cui_api password_rating(const std::string& username,
+			const std::string& password, password_engine engine);
+
+		/// <summary>
+		/// Password issues, as bit flags, in the order in which password_rating lists them.
+		/// </summary>
+		namespace password_issue {
+			enum : uint32_t {
+				too_similar = 1u << 0,				// Username and password too similar
+				no_lowercase = 1u << 1,				// No lowercase characters
+				few_lowercase = 1u << 2,			// Few lowercase characters
+				no_uppercase = 1u << 3,				// No uppercase characters
+				few_uppercase = 1u << 4,			// Few uppercase characters
+				no_special = 1u << 5,				// No special characters
+				few_special = 1u << 6,				// Few special characters
+				no_digits = 1u << 7,				// No digits
+				few_digits = 1u << 8,				// Few digits
+				duplicates = 1u << 9,				// Duplicate characters
+				dictionary_words = 1u << 10,		// Dictionary words
+				dictionary_words_leet = 1u << 11,	// Dictionary words with common substitutions
+				dictionary_attack = 1u << 12,		// Password vulnerable to dictionary attack
+				no_dictionary = 1u << 13,			// Failed to open dictionary resource
+				keyboard_patterns = 1u << 14,		// Keyboard patterns (entropy engine)
+				repeats = 1u << 15,					// Repeated characters (entropy engine)
+				sequences = 1u << 16,				// Sequences (entropy engine)
+				dates = 1u << 17,					// Dates or years (entropy engine)
+			};
+		}
+
+		/// <summary>
+		/// Get the descriptions of a set of password issues, as password_rating lists them.
+		/// </summary>
+		std::vector<std::string> cui_api password_issues(uint32_t issues);
+
+		struct password_pair {
+			std::string username;
+			std::string password;
+		};
+
+		/// <summary>
+		/// Ratings of a batch of passwords, one entry per pair in each array.
+		/// </summary>
+		struct password_batch_quality {
+			std::vector<uint8_t> strength;	// 0 - 100, as in password_quality
+			std::vector<uint32_t> issues;	// password_issue flags
+		};
+
+		/// <summary>
+		/// Rate a batch of username/password pairs, in parallel.
+		/// </summary>
+		/// 
+		/// <param name="pairs">
+		/// The pairs to rate.
+		/// </param>
+		/// 
+		/// <param name="count">
+		/// The number of pairs.
+		/// </param>
+		/// 
+		/// <param name="thread_count">
+		/// The number of threads to use. If zero, one thread per processor is used.
+		/// </param>
+		/// 
+		/// <returns>
+		/// Returns the ratings, in the order of the pairs. The strengths are those
+		/// password_rating would give.
+		/// </returns>
+		password_batch_quality cui_api password_rating_batch(const password_pair* pairs,
+			size_t count, unsigned thread_count = 0);
+
+		password_batch_quality cui_api password_rating_batch(const std::vector<password_pair>& pairs,
+			unsigned thread_count = 0);
+
+		/// <summary>
+		/// Password rater for a password that is typed one character at a time, e.g. to update
+		/// a password strength bar as the user types. The rater keeps what the classic engine
+		/// looks at from one edit to the next, so that typing or deleting a character at the end
+		/// of the password costs O(length of username) rather than a full rating. The ratings
+		/// are the same as password_rating with password_engine::classic gives.
+		/// </summary>
+		class cui_api password_rater
+		{
+		public:
+			password_rater();
+			password_rater(const std::string& username);
+			~password_rater();
+
+			/// <summary>
+			/// Set the username the password is compared with. The password is kept.
+			/// </summary>
+			void set_username(const std::string& username);
+
+			/// <summary>
+			/// Add a character to the end of the password.
+			/// </summary>
+			void push_back(char c);
+
+			/// <summary>
+			/// Remove the last character of the password. Does nothing if the password is empty.
+			/// </summary>
+			void pop_back();
+
+			/// <summary>
+			/// Set the whole password, e.g. the text of an edit control after it changes. Only
+			/// the characters after the part the old and new passwords have in common are
+			/// rated again.
+			/// </summary>
+			void assign(const std::string& password);
+
+			/// <summary>
+			/// Clear the password.
+			/// </summary>
+			void clear();
+
+			const std::string& password() const;
+
+			/// <summary>
+			/// Strength of the password, 0 - 100.
+			/// </summary>
+			int strength() const;
+
+			/// <summary>
+			/// Issues with the password, as password_issue flags.
+			/// </summary>
+			uint32_t issues() const;
+
+			/// <summary>
+			/// Full rating of the password, as password_rating gives it.
+			/// </summary>
+			password_quality quality() const;
+
+		private:
+			class password_rater_impl;
+			password_rater_impl* d_;
+
+			password_rater(const password_rater&);
+			password_rater& operator=(const password_rater&);
+		}; // password_rater
+
+		/// <summary>
+		/// UUID versions for unique_string (RFC 9562).
+		/// </summary>
+		enum class uuid_version {
+			/// <summary>
+			/// Random UUID, as UuidCreate makes.
+			/// </summary>
+			v4,
+
+			/// <summary>
+			/// UUID that starts with the Unix time in milliseconds, so that ids sort in the
+			/// order they were made. Ids a thread makes within the same millisecond still
+			/// sort in order.
+			/// </summary>
+			v7,
+		};
+
+		/// <summary>
+		/// Make a unique string, a UUID in the form 1b4e28ba-2fa1-41d2-883f-0016d3cca427.
+		/// The random bits come from a per-thread ChaCha20 stream keyed from the system's
+		/// cryptographic random number generator.
+		/// </summary>
 		std::string cui_api unique_string();
+		std::string cui_api unique_string(uuid_version version);
+
+		/// <summary>
+		/// Write a unique string to a buffer, without allocating. The buffer is not null
+		/// terminated.
+		/// </summary>
+		void cui_api unique_string(std::array<char, 36>& buffer,
+			uuid_version version = uuid_version::v4);
+
+		/// <summary>
+		/// Make n unique strings at once.
+		/// </summary>
+		std::vector<std::string> cui_api unique_strings(size_t n,
+			uuid_version version = uuid_version::v4);
+
+		/// <summary>
+		/// Make a short unique string: 8 random hexadecimal digits, like the first group
+		/// of unique_string.
+		/// </summary>
 		std::string cui_api unique_string_short();
 
 		namespace date_gen {
@@ -77,7 +284,21 @@ namespace liblec
 			/// </summary>
 			std::string cui_api time_stamp();
 
+			/// <summary>
+			/// Write a timestamp of the current local time, in the form of time_stamp(), to a
+			/// buffer, without allocating. The buffer is not null terminated.
+			/// </summary>
+			void cui_api time_stamp(std::array<char, 17>& buffer);
+
 			std::string cui_api to_string(const date& dt);
+
+			/// <summary>
+			/// Write a date in the form 20190802 to a buffer, without allocating. The buffer
+			/// is not null terminated. Returns false, leaving the buffer as it is, if the
+			/// date does not fit in eight digits.
+			/// </summary>
+			bool cui_api to_string(const date& dt, std::array<char, 8>& buffer);
+
 			date cui_api from_string(const std::string& dt);
 			date cui_api today();
 			date cui_api last_day_of_month(const date& dt);
@@ -86,6 +307,18 @@ namespace liblec
 			void cui_api get_week(const date& dt, date& start, date& end);
 			void cui_api get_month(const date& dt, date& start, date& end);
 			void cui_api get_year(const date& dt, date& start, date& end);
+
+			/// <summary>
+			/// Number of days from one date to another; negative if to is before from.
+			/// </summary>
+			int cui_api days_between(const date& from, const date& to);
+
+			/// <summary>
+			/// Call fn for every day from first to last, both included, in order. Does
+			/// nothing if last is before first.
+			/// </summary>
+			void cui_api for_each_day(const date& first, const date& last,
+				const std::function<void(const date&)>& fn);
 		}
 
 		struct file_type
@@ -144,6 +144,9 @@ bool liblec::cui::gui_raw::cui_raw::addFont(const std::basic_string<TCHAR> &sFon
 	if (status == Gdiplus::Status::Ok)
 	{
 		d->m_font_collection_files.push_back(sFontFullPath);
+
+		// cached fonts may have been resolved before this font was available
+		d->m_gdiplus_cache.Clear();
 		return true;
 	}
 	else
@@ -1117,7 +1120,7 @@ bool cui_raw::setText(
 				// replace all occurences of the ampersand with double ampersand
 				replaceString(d->m_Pages.at(sPageName + sPageLessKey).m_TextControls.at(iUniqueID).sTextDisplay, _T("&"), _T("&&"));
 
-				InvalidateRect(d->m_Pages.at(sPageName + sPageLessKey).m_TextControls.at(iUniqueID).hWnd, NULL, TRUE);
+				cui_rawImpl::invalidateText(d->m_Pages.at(sPageName + sPageLessKey).m_TextControls.at(iUniqueID));
 
 				return true;
 			}
@@ -1183,7 +1186,7 @@ bool cui_raw::setText(
 				// replace all occurences of the ampersand with double ampersand
 				replaceString(d->m_Pages.at(sPageName + sPageLessKey).m_TextControls.at(iUniqueID).sTextDisplay, _T("&"), _T("&&"));
 
-				InvalidateRect(d->m_Pages.at(sPageName + sPageLessKey).m_TextControls.at(iUniqueID).hWnd, NULL, TRUE);
+				cui_rawImpl::invalidateText(d->m_Pages.at(sPageName + sPageLessKey).m_TextControls.at(iUniqueID));
 
 				return true;
 			}
@@ -1603,6 +1606,7 @@ void cui_raw::addListview(const std::basic_string<TCHAR> &sPageName,
 	cui_rawImpl::listviewControl control;
 	control.iUniqueID = iUniqueID;
 	control.vColumns = vColumns;
+	cui_rawImpl::buildListviewColumnIndex(control);
 	control.sFontName = sFontName;
 	control.iFontSize = iFontSize;
 	control.coords.left = rc.left;
@@ -1651,70 +1655,80 @@ bool cui_raw::addListviewRow(const std::basic_string<TCHAR> &sPageName,
 	std::basic_string<TCHAR> &sErr
 )
 {
-	std::basic_string<TCHAR> sPageLessKey;
+	if (!addListviewRow(sPageName, iUniqueID, listviewRow(vRow), bScrollToBottom, sErr))
+		return false;
 
-	if (sPageName.empty())
-		sPageLessKey = d->m_sTitle;
+	// write the row number back
+	const cui_rawImpl::listviewControl *pControl = d->findListview(sPageName, iUniqueID);
+
+	if (pControl)
+	{
+		const int iRowNumber = (int)pControl->vData.size() - 1;
 
+		for (auto &it : vRow.vItems)
+			it.iRowNumber = iRowNumber;
+	}
+
+	return true;
+} // addListviewRow
+
+bool cui_raw::addListviewRow(const std::basic_string<TCHAR> &sPageName,
+	int iUniqueID,
+	listviewRow &&vRow,
+	bool bScrollToBottom,
+	std::basic_string<TCHAR> &sErr
+)
+{
 	try
 	{
-		if (d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.find(iUniqueID) != d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.end())
+		cui_rawImpl::listviewControl *pControl = d->findListview(sPageName, iUniqueID);
+
+		if (pControl)
 		{
-			try
+			if (pControl->bVirtual)
 			{
-				// insert list view row
-				int iNumberOfRows = d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).pClistview->Get_NumOfRows();
+				sErr = _T("Operation not supported by virtual listview");
+				return false;
+			}
 
-				for (auto &it : vRow.vItems)
-				{
-					int iColumnNumber = -1;
+			// insert list view row
+			int iNumberOfRows = pControl->pClistview->Get_NumOfRows();
 
-					// determine column number
-					for (size_t iColumnNames = 0; iColumnNames < d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vColumns.size(); iColumnNames++)
-					{
-						if (d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vColumns[iColumnNames].sColumnName == it.sColumnName)
-						{
-							iColumnNumber = d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vColumns[iColumnNames].iColumnID;
-							break;
-						}
-					}
-
-					// insert item
-					if (iColumnNumber != -1)	// failsafe in-case there's a typo in the column name
-					{
-						d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).pClistview->InsertItem(iNumberOfRows, iColumnNumber, it.sItemData);
-					}
-				}
+			for (auto &it : vRow.vItems)
+			{
+				// determine column number
+				int iColumnNumber = cui_rawImpl::getListviewColumnNumber(*pControl, it.sColumnName);
 
-				int iRowNumber = d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vData.size();
+				// insert item
+				if (iColumnNumber != -1)	// failsafe in-case there's a typo in the column name
+					pControl->pClistview->InsertItem(iNumberOfRows, iColumnNumber, it.sItemData);
+			}
 
-				for (auto &it : vRow.vItems)
-					it.iRowNumber = iRowNumber;
+			int iRowNumber = pControl->vData.size();
 
-				d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vData.push_back(vRow);
+			for (auto &it : vRow.vItems)
+				it.iRowNumber = iRowNumber;
 
-				// scroll to bottom
-				if (bScrollToBottom)
-				{
-					RECT rc;
-					ListView_GetViewRect(d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).hWnd, &rc);
-					int iHeight = rc.bottom - rc.top;
-					ListView_Scroll(d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).hWnd, 0, iHeight);
-				}
+			pControl->vData.push_back(std::move(vRow));
+			cui_rawImpl::addListviewStylesRow(*pControl, pControl->vData.back());
 
-				return true;
-			}
-			catch (std::exception &e)
+			// scroll to bottom
+			if (bScrollToBottom)
 			{
-				std::string m_sErr = e.what();
-				sErr = std::basic_string<TCHAR>(m_sErr.begin(), m_sErr.end());
-				return false;
+				RECT rc;
+				ListView_GetViewRect(pControl->hWnd, &rc);
+				int iHeight = rc.bottom - rc.top;
+				ListView_Scroll(pControl->hWnd, 0, iHeight);
 			}
+
+			return true;
 		}
 	}
 	catch (std::exception &e)
 	{
 		std::string m_sErr = e.what();
+		sErr = std::basic_string<TCHAR>(m_sErr.begin(), m_sErr.end());
+		return false;
 	}
 
 	sErr = _T("Listview control not found");
@@ -1727,71 +1741,161 @@ bool cui_raw::repopulateListview(const std::basic_string<TCHAR> &sPageName,
 	std::basic_string<TCHAR> &sErr
 )
 {
-	std::basic_string<TCHAR> sPageLessKey;
+	// number the rows here so that the row numbers are written back to vData
+	int iRow = 0;
+	for (auto &it : vData)
+	{
+		for (auto &m_it : it.vItems)
+			m_it.iRowNumber = iRow;
 
-	if (sPageName.empty())
-		sPageLessKey = d->m_sTitle;
+		iRow++;
+	}
 
+	return repopulateListview(sPageName, iUniqueID, std::vector<listviewRow>(vData), sErr);
+} // repopulateListview
+
+bool cui_raw::repopulateListview(const std::basic_string<TCHAR> &sPageName,
+	int iUniqueID,
+	std::vector<listviewRow> &&vData,
+	std::basic_string<TCHAR> &sErr
+)
+{
 	try
 	{
-		if (d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.find(iUniqueID) != d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.end())
+		cui_rawImpl::listviewControl *pControl = d->findListview(sPageName, iUniqueID);
+
+		if (pControl)
 		{
-			try
+			if (pControl->bVirtual)
 			{
-				// clear list view
-				d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).pClistview->Clear();
-				d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vData.clear();
+				sErr = _T("Operation not supported by virtual listview");
+				return false;
+			}
 
-				// populate listview
-				int iRow = 0;
-				for (auto &it : vData)
+			// clear list view
+			pControl->pClistview->Clear();
+			pControl->vData.clear();
+
+			// populate listview
+			int iRow = 0;
+			for (auto &it : vData)
+			{
+				for (auto &m_it : it.vItems)
 				{
-					for (auto &m_it : it.vItems)
-					{
-						m_it.iRowNumber = iRow;
+					m_it.iRowNumber = iRow;
 
-						std::basic_string<TCHAR> sColumnName = m_it.sColumnName;
-						std::basic_string<TCHAR> sItemData = m_it.sItemData;
+					// determine column number
+					int iColumnNumber = cui_rawImpl::getListviewColumnNumber(*pControl, m_it.sColumnName);
 
-						int iRowNumber = m_it.iRowNumber;
-						int iColumnNumber = -1;
+					// insert item
+					if (iColumnNumber != -1)	// failsafe in-case there's a typo in the column name
+						pControl->pClistview->InsertItem(iRow, iColumnNumber, m_it.sItemData);
+				}
 
-						// determine column number
-						for (size_t iColumnNames = 0; iColumnNames < d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vColumns.size(); iColumnNames++)
-						{
-							if (d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vColumns[iColumnNames].sColumnName == sColumnName)
-							{
-								iColumnNumber = d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vColumns[iColumnNames].iColumnID;
-								break;
-							}
-						}
+				iRow++;
+			}
 
-						// insert item
-						if (iColumnNumber != -1)	// failsafe in-case there's a typo in the column name
-						{
-							d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).pClistview->InsertItem(iRowNumber, iColumnNumber, sItemData);
-						}
-					}
+			// update data
+			pControl->vData = std::move(vData);
+			cui_rawImpl::buildListviewStyles(*pControl);
 
-					iRow++;
-				}
+			return true;
+		}
+	}
+	catch (std::exception &e)
+	{
+		std::string m_sErr = e.what();
+		sErr = std::basic_string<TCHAR>(m_sErr.begin(), m_sErr.end());
+		return false;
+	}
 
-				// update data
-				d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vData = vData;
+	sErr = _T("Listview control not found");
+	return false;
+} // repopulateListview
 
-				return true;
-			}
-			catch (std::exception &e)
+bool cui_raw::repopulateListview(const std::basic_string<TCHAR> &sPageName,
+	int iUniqueID,
+	const std::vector<listviewColumnData> &vColumnData,
+	std::basic_string<TCHAR> &sErr
+)
+{
+	try
+	{
+		cui_rawImpl::listviewControl *pControl = d->findListview(sPageName, iUniqueID);
+
+		if (pControl)
+		{
+			if (pControl->bVirtual)
 			{
-				std::string m_sErr = e.what();
-				sErr = std::basic_string<TCHAR>(m_sErr.begin(), m_sErr.end());
+				sErr = _T("Operation not supported by virtual listview");
 				return false;
 			}
+
+			// resolve each column once
+			struct source
+			{
+				const listviewColumnData *pColumn;
+				int iColumnNumber;
+			};
+
+			std::vector<source> vSources;
+			vSources.reserve(vColumnData.size());
+
+			size_t iRows = 0;
+
+			for (const auto &it : vColumnData)
+			{
+				int iColumnNumber = cui_rawImpl::getListviewColumnNumber(*pControl, it.sColumnName);
+
+				if (iColumnNumber == -1)
+					continue;	// failsafe in-case there's a typo in the column name
+
+				vSources.push_back({ &it, iColumnNumber });
+
+				if (it.vItems.size() > iRows)
+					iRows = it.vItems.size();
+			}
+
+			// clear list view
+			pControl->pClistview->Clear();
+			pControl->vData.clear();
+			pControl->vData.resize(iRows);
+
+			// populate listview row by row so that rows are only inserted once
+			for (size_t iRow = 0; iRow < iRows; iRow++)
+			{
+				std::vector<listviewItem> &vItems = pControl->vData[iRow].vItems;
+				vItems.reserve(vSources.size());
+
+				for (const auto &src : vSources)
+				{
+					if (iRow >= src.pColumn->vItems.size())
+						continue;	// short column, leave cell empty
+
+					const std::basic_string<TCHAR> &sItemData = src.pColumn->vItems[iRow];
+
+					pControl->pClistview->InsertItem((int)iRow, src.iColumnNumber, sItemData);
+
+					listviewItem item;
+					item.iRowNumber = (int)iRow;
+					item.sColumnName = src.pColumn->sColumnName;
+					item.sItemData = sItemData;
+					item.bCustom = false;
+					item.clrText = RGB(0, 0, 0);
+					vItems.push_back(std::move(item));
+				}
+			}
+
+			cui_rawImpl::buildListviewStyles(*pControl);
+
+			return true;
 		}
 	}
 	catch (std::exception &e)
 	{
 		std::string m_sErr = e.what();
+		sErr = std::basic_string<TCHAR>(m_sErr.begin(), m_sErr.end());
+		return false;
 	}
 
 	sErr = _T("Listview control not found");
@@ -1805,201 +1909,255 @@ bool cui_raw::updateListViewItem(const std::basic_string<TCHAR> &sPageName,
 	std::basic_string<TCHAR> &sErr
 )
 {
-	std::basic_string<TCHAR> sPageLessKey;
-
-	if (sPageName.empty())
-		sPageLessKey = d->m_sTitle;
-
 	try
 	{
-		if (d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.find(iUniqueID) != d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.end())
+		cui_rawImpl::listviewControl *pControl = d->findListview(sPageName, iUniqueID);
+
+		if (pControl)
 		{
-			try
+			if (pControl->bVirtual)
 			{
-				int iColumnNumber = -1;
+				sErr = _T("Operation not supported by virtual listview");
+				return false;
+			}
 
-				int iUniqueColumnNumber = -1;
+			// determine column number
+			const int iColumnNumber = cui_rawImpl::getListviewColumnNumber(*pControl, item.sColumnName);
 
-				// determine column number
-				for (size_t iColumnNames = 0; iColumnNames < d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vColumns.size(); iColumnNames++)
+			// determine unique column number
+			const int iUniqueColumnNumber = cui_rawImpl::getListviewColumnNumber(*pControl, pControl->sUniqueColumnName);
+
+			int iRowNumber = item.iRowNumber;	// this will have changed if listview has been sorted ...
+
+			// determine proper row number
+			if (iUniqueColumnNumber != -1)
+			{
+				// get the unique value of the target row
+				const std::basic_string<TCHAR> *pUniqueValue = nullptr;
+
+				for (auto &it : row.vItems)
 				{
-					if (d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vColumns[iColumnNames].sColumnName == item.sColumnName)
-					{
-						iColumnNumber = d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vColumns[iColumnNames].iColumnID;
-						break;
-					}
+					if (it.sColumnName == pControl->sUniqueColumnName)
+						pUniqueValue = &it.sItemData;
 				}
 
-				// determine unique column number
-				for (size_t iColumnNames = 0; iColumnNames < d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vColumns.size(); iColumnNames++)
+				// get number of rows
+				const int iRows = pControl->pClistview->Get_NumOfRows();
+
+				for (int iRow = 0; pUniqueValue && iRow < iRows; iRow++)
 				{
-					if (
-						d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vColumns[iColumnNames].sColumnName ==
-						d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).sUniqueColumnName)
+					TCHAR buf[1024];
+					ListView_GetItemText(pControl->hWnd, iRow, iUniqueColumnNumber, buf, _countof(buf));
+
+					if (*pUniqueValue == buf)
 					{
-						iUniqueColumnNumber = d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vColumns[iColumnNames].iColumnID;
+						// this is our target row
+						iRowNumber = iRow;
 						break;
 					}
 				}
+			}
 
-				int iRowNumber = item.iRowNumber;	// this will have changed if listview has been sorted ...
+			// update item
+			if (iColumnNumber != -1)	// failsafe in-case there's a typo in the column name
+			{
+				pControl->pClistview->UpdateItem(iRowNumber, iColumnNumber, item.sItemData);
+				pControl->styles.SetCell(iRowNumber, iColumnNumber, item.bCustom, item.clrText);
 
-													// determine proper row number
+				// update entry
+				bool updated = false;
+				for (auto &it : pControl->vData)
 				{
-					// get number of columns
-					const int iCols = d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).pClistview->Get_NumOfCols();
-
-					// get number of rows
-					const int iRows = d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).pClistview->Get_NumOfRows();
-
-					LVITEM lv = { 0 };
-
-					HWND m_hlistview = d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).hWnd;
-
-					for (int iRow = 0; iRow < iRows; iRow++)
+					for (auto &m_it : it.vItems)
 					{
-						lv.mask = LVIF_TEXT;
-						lv.iItem = iRow;
-
-						bool bMatch = false;
-
-						for (int iCol = 0; iCol < iCols; iCol++)
-						{
-							if (iCol == iUniqueColumnNumber)
-							{
-								lv.iSubItem = iCol;
-
-								TCHAR buf[1024];
-								ListView_GetItemText(m_hlistview, iRow, iCol, buf, _countof(buf));
-
-								// insert information into matrix
-								std::basic_string<TCHAR> sText(buf);
-
-								// check if this text is in our target row
-								for (auto &it : row.vItems)
-								{
-									if (it.sColumnName != d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).sUniqueColumnName)
-										continue;
-
-									if (it.sItemData == sText)
-										bMatch = true;
-								}
-							}
-						}
+						if (m_it.iRowNumber != iRowNumber)
+							break;
 
-						if (bMatch)
+						if (m_it.sColumnName == item.sColumnName)
 						{
-							// this is our target row
-							iRowNumber = iRow;
+							m_it = item;	// do the update
+							updated = true;
 							break;
 						}
 					}
+
+					if (updated)
+						break;
 				}
+			}
 
-				// update item
-				if (iColumnNumber != -1)	// failsafe in-case there's a typo in the column name
-				{
-					d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).pClistview->UpdateItem(iRowNumber, iColumnNumber, item.sItemData);
+			return true;
+		}
+	}
+	catch (std::exception &e)
+	{
+		std::string m_sErr = e.what();
+		sErr = std::basic_string<TCHAR>(m_sErr.begin(), m_sErr.end());
+		return false;
+	}
 
-					// update entry
-					bool updated = false;
-					for (auto &it : d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vData)
-					{
-						for (auto &m_it : it.vItems)
-						{
-							if (m_it.iRowNumber != iRowNumber)
-								break;
+	sErr = _T("Listview control not found");
+	return false;
+} // updateListViewItem
 
-							if (m_it.sColumnName == item.sColumnName)
-							{
-								m_it = item;	// do the update
-								updated = true;
-								break;
-							}
-						}
+bool cui_raw::removeListViewRow(const std::basic_string<TCHAR> &sPageName,
+	int iUniqueID,
+	int iRowNumber,
+	std::basic_string<TCHAR> &sErr
+)
+{
+	try
+	{
+		cui_rawImpl::listviewControl *pControl = d->findListview(sPageName, iUniqueID);
 
-						if (updated)
-							break;
+		if (pControl)
+		{
+			if (pControl->bVirtual)
+			{
+				sErr = _T("Operation not supported by virtual listview");
+				return false;
+			}
+
+			std::vector<listviewRow> vData_new;
+			vData_new.reserve(pControl->vData.size());
+
+			for (auto &it : pControl->vData)
+			{
+				bool bSkip = false;
+
+				for (auto &m_it : it.vItems)
+				{
+					if (m_it.iRowNumber == iRowNumber)
+					{
+						bSkip = true;
+						break;
 					}
 				}
 
-				return true;
+				if (!bSkip)
+					vData_new.push_back(std::move(it));
 			}
-			catch (std::exception &e)
+
+			pControl->pClistview->RemoveRow(iRowNumber);
+			pControl->styles.RemoveRow(iRowNumber);
+
+			// update items
+			int m_iNewRowNumber = 0;
+			for (auto &it : vData_new)
 			{
-				std::string m_sErr = e.what();
-				sErr = std::basic_string<TCHAR>(m_sErr.begin(), m_sErr.end());
-				return false;
+				for (auto &m_it : it.vItems)
+					m_it.iRowNumber = m_iNewRowNumber;
+
+				m_iNewRowNumber++;
 			}
+
+			pControl->vData.swap(vData_new);
+
+			return true;
 		}
 	}
 	catch (std::exception &e)
 	{
 		std::string m_sErr = e.what();
+		sErr = std::basic_string<TCHAR>(m_sErr.begin(), m_sErr.end());
+		return false;
 	}
 
 	sErr = _T("Listview control not found");
 	return false;
-} // updateListViewItem
+} // removeListViewRow
 
-bool cui_raw::removeListViewRow(const std::basic_string<TCHAR> &sPageName,
+void cui_raw::addVirtualListview(const std::basic_string<TCHAR> &sPageName,
 	int iUniqueID,
-	int iRowNumber,
-	std::basic_string<TCHAR> &sErr
+	std::vector<listviewColumn> vColumns,
+	int iRowCount,
+	listviewRowProvider pRowProvider,
+	void *pData,
+	std::vector<contextMenuItem> vContextMenu,
+	const std::basic_string<TCHAR> &sFontName, double iFontSize,
+	RECT rc,
+	cui_raw::onResize resize,
+	bool bBorder,
+	bool bGridLines
 )
 {
+	scaleRECT(rc, d->m_DPIScale);
+
+	cui_rawImpl::listviewControl control;
+	control.iUniqueID = iUniqueID;
+	control.vColumns = vColumns;
+	cui_rawImpl::buildListviewColumnIndex(control);
+	control.sFontName = sFontName;
+	control.iFontSize = iFontSize;
+	control.coords.left = rc.left;
+	control.coords.top = rc.top;
+	control.coords.right = rc.right;
+	control.coords.bottom = rc.bottom;
+	control.vContextMenu = vContextMenu;
+	control.bSortByClickingColumn = false;
+	control.bBorder = bBorder;
+	control.bGridLines = bGridLines;
+	control.resize = resize;
+	control.d = d;
+	control.bVirtual = true;
+	control.iRowCount = iRowCount > 0 ? iRowCount : 0;
+	control.pRowProvider = pRowProvider;
+	control.pRowProviderData = pData;
+
 	std::basic_string<TCHAR> sPageLessKey;
 
 	if (sPageName.empty())
+	{
 		sPageLessKey = d->m_sTitle;
+		control.bPageLess = true;
+	}
+	else
+		control.bPageLess = false;
 
 	try
 	{
-		if (d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.find(iUniqueID) != d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.end())
+		if (d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.find(iUniqueID) == d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.end())	// do not duplicate IDs
 		{
-			try
-			{
-				std::vector<listviewRow> vData_new;
-
-				for (auto &it : d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vData)
-				{
-					bool bSkip = false;
-
-					for (auto &m_it : it.vItems)
-					{
-						if (m_it.iRowNumber == iRowNumber)
-						{
-							bSkip = true;
-							break;
-						}
-					}
-
-					if (!bSkip)
-						vData_new.push_back(it);
-				}
+			d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.insert(std::pair<int, cui_rawImpl::listviewControl>(iUniqueID, control));
+			d->handleTabControls(sPageName + sPageLessKey, iUniqueID);
+		}
+	}
+	catch (std::exception &e)
+	{
+		std::string m_sErr = e.what();
+	}
+} // addVirtualListview
 
-				d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).pClistview->RemoveRow(iRowNumber);
+bool cui_raw::setListviewRowCount(const std::basic_string<TCHAR> &sPageName,
+	int iUniqueID,
+	int iRowCount,
+	std::basic_string<TCHAR> &sErr
+)
+{
+	try
+	{
+		cui_rawImpl::listviewControl *pControl = d->findListview(sPageName, iUniqueID);
 
-				// update items
-				int m_iNewRowNumber = 0;
-				for (auto &it : vData_new)
-				{
-					for (auto &m_it : it.vItems)
-						m_it.iRowNumber = m_iNewRowNumber;
+		if (pControl)
+		{
+			if (!pControl->bVirtual)
+			{
+				sErr = _T("Listview is not a virtual listview");
+				return false;
+			}
 
-					m_iNewRowNumber++;
-				}
+			pControl->iRowCount = iRowCount > 0 ? iRowCount : 0;
 
-				d->m_Pages.at(sPageName + sPageLessKey).m_listviewControls.at(iUniqueID).vData = vData_new;
+			// drop cached rows and let the control request the visible rows again
+			pControl->cache.SetRowCount(pControl->iRowCount);
 
-				return true;
-			}
-			catch (std::exception &e)
+			if (IsWindow(pControl->hWnd))
 			{
-				std::string m_sErr = e.what();
-				sErr = std::basic_string<TCHAR>(m_sErr.begin(), m_sErr.end());
-				return false;
+				ListView_SetItemCountEx(pControl->hWnd, pControl->iRowCount, 0);
+				InvalidateRect(pControl->hWnd, NULL, FALSE);
 			}
+
+			return true;
 		}
 	}
 	catch (std::exception &e)
@@ -2009,7 +2167,7 @@ bool cui_raw::removeListViewRow(const std::basic_string<TCHAR> &sPageName,
 
 	sErr = _T("Listview control not found");
 	return false;
-} // removeListViewRow
+} // setListviewRowCount
 
 bool cui_raw::getListview(const std::basic_string<TCHAR> &sPageName,
 	int iUniqueID,
@@ -2462,9 +2620,14 @@ bool cui_raw::setToggleButton(
 		{
 			try
 			{
-				d->m_Pages.at(sPageName + sPageLessKey).m_ToggleButtonControls.at(iUniqueID).bOn = bOn;
-				InvalidateRect(d->m_Pages.at(sPageName + sPageLessKey).m_ToggleButtonControls.at(iUniqueID).hWnd, NULL, FALSE);
-				UpdateWindow(d->m_Pages.at(sPageName + sPageLessKey).m_ToggleButtonControls.at(iUniqueID).hWnd);
+				cui_rawImpl::ToggleButtonControl &control = d->m_Pages.at(sPageName + sPageLessKey).m_ToggleButtonControls.at(iUniqueID);
+
+				if (control.bOn != bOn)
+				{
+					control.bOn = bOn;
+					cui_rawImpl::invalidateToggleButton(control, !bOn);
+					UpdateWindow(control.hWnd);
+				}
 
 				return true;
 			}
@@ -2606,7 +2769,7 @@ bool cui_raw::setSelector(
 
 				if (iSelectorItemID != d->m_Pages.at(sPageName + sPageLessKey).m_SelectorControls.at(iUniqueID).iOldSelectedItem)
 				{
-					InvalidateRect(d->m_Pages.at(sPageName + sPageLessKey).m_SelectorControls.at(iUniqueID).hWnd, NULL, FALSE);
+					cui_rawImpl::invalidateSelector(d->m_Pages.at(sPageName + sPageLessKey).m_SelectorControls.at(iUniqueID));
 					UpdateWindow(d->m_Pages.at(sPageName + sPageLessKey).m_SelectorControls.at(iUniqueID).hWnd);
 				}
 
@@ -2687,7 +2850,16 @@ bool cui_raw::setProgressBar(const std::basic_string<TCHAR> &sPageName,
 					clrBar != d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).clrBar)
 				{
 					d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).clrBar = clrBar;
-					InvalidateRect(d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).hWnd, NULL, FALSE);
+
+					// repaint the bar in its new color
+					if (d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).bBusy)
+						cui_rawImpl::invalidateProgressBusy(d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID),
+							d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).iBusyPerc,
+							d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).iBusyPerc);
+					else
+						cui_rawImpl::invalidateProgress(d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID),
+							0, d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).iPercentage);
+
 					UpdateWindow(d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).hWnd);
 				}
 
@@ -2704,8 +2876,13 @@ bool cui_raw::setProgressBar(const std::basic_string<TCHAR> &sPageName,
 				d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).bBusy = bBusyNew;
 
 				if (bBusyOld != bBusyNew)
+				{
 					d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).iPercentage = iPercentage;
 
+					// switching between a busy bar and a normal one changes all of the bar
+					cui_rawImpl::invalidateProgress(d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID), 0, 100);
+				}
+
 				if (iPercentage >= 0)
 				{
 					// move progress bar in multiple steps for aesthetic purposes
@@ -2730,9 +2907,11 @@ bool cui_raw::setProgressBar(const std::basic_string<TCHAR> &sPageName,
 
 						double dStepPerc = (dEndPerc - dStartPerc) / double(iSteps);
 
+						const double dPerc = d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).iPercentage;
 						d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).iPercentage += dStepPerc;
 
-						InvalidateRect(d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).hWnd, NULL, FALSE);
+						cui_rawImpl::invalidateProgress(d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID),
+							dPerc, d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).iPercentage);
 						UpdateWindow(d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).hWnd);
 					}
 				}
@@ -2741,7 +2920,9 @@ bool cui_raw::setProgressBar(const std::basic_string<TCHAR> &sPageName,
 					if (m_iPerc == -1)
 					{
 						// change the progress style to a "busy" one
-						InvalidateRect(d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).hWnd, NULL, FALSE);
+						cui_rawImpl::invalidateProgressBusy(d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID),
+							d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).iBusyPerc,
+							d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).iBusyPerc);
 						UpdateWindow(d->m_Pages.at(sPageName + sPageLessKey).m_ProgressControls.at(iUniqueID).hWnd);
 					}
 				}
@@ -3604,12 +3785,12 @@ bool cui_raw::barChartReload(const std::basic_string<TCHAR> &sPageName, int iUni
 			{
 				d->m_Pages.at(sPageName + sPageLessKey).m_BarChartControls.at(iUniqueID).bInfoCaptured = false;	// important to ensure control parameters are reset	
 				d->m_Pages.at(sPageName + sPageLessKey).m_BarChartControls.at(iUniqueID).bAutoScale = bAutoScale;
-				d->m_Pages.at(sPageName + sPageLessKey).m_BarChartControls.at(iUniqueID).sChartName = sChartName;
-				d->m_Pages.at(sPageName + sPageLessKey).m_BarChartControls.at(iUniqueID).sXaxisLabel = sXaxisLabel;
-				d->m_Pages.at(sPageName + sPageLessKey).m_BarChartControls.at(iUniqueID).sYaxisLabel = sYaxisLabel;
+				d->m_Pages.at(sPageName + sPageLessKey).m_BarChartControls.at(iUniqueID).sChartName = std::move(sChartName);
+				d->m_Pages.at(sPageName + sPageLessKey).m_BarChartControls.at(iUniqueID).sXaxisLabel = std::move(sXaxisLabel);
+				d->m_Pages.at(sPageName + sPageLessKey).m_BarChartControls.at(iUniqueID).sYaxisLabel = std::move(sYaxisLabel);
 				d->m_Pages.at(sPageName + sPageLessKey).m_BarChartControls.at(iUniqueID).iLowerLimit = iLowerLimit;
 				d->m_Pages.at(sPageName + sPageLessKey).m_BarChartControls.at(iUniqueID).iUpperLimit = iUpperLimit;
-				d->m_Pages.at(sPageName + sPageLessKey).m_BarChartControls.at(iUniqueID).vValues = vValues;
+				d->m_Pages.at(sPageName + sPageLessKey).m_BarChartControls.at(iUniqueID).vValues = std::move(vValues);
 
 				if (/*bAutoColor*/true)
 				{
@@ -3753,7 +3934,7 @@ void cui_raw::addLineChart(const std::basic_string<TCHAR> &sPageName, int iUniqu
 	control.iLowerLimit = iLowerLimit;
 	control.iUpperLimit = iUpperLimit;
 	control.bAutoScale = bAutoScale;
-	control.vLines = vLines;
+	cui_rawImpl::setLineChartLines(control, std::move(vLines));
 
 	if (autocolor)
 	{
@@ -3929,12 +4110,12 @@ bool cui_raw::lineChartReload(const std::basic_string<TCHAR> &sPageName, int iUn
 			{
 				d->m_Pages.at(sPageName + sPageLessKey).m_LineChartControls.at(iUniqueID).bInfoCaptured = false;	// important to ensure control parameters are reset	
 				d->m_Pages.at(sPageName + sPageLessKey).m_LineChartControls.at(iUniqueID).bAutoScale = bAutoScale;
-				d->m_Pages.at(sPageName + sPageLessKey).m_LineChartControls.at(iUniqueID).sChartName = sChartName;
-				d->m_Pages.at(sPageName + sPageLessKey).m_LineChartControls.at(iUniqueID).sXaxisLabel = sXaxisLabel;
-				d->m_Pages.at(sPageName + sPageLessKey).m_LineChartControls.at(iUniqueID).sYaxisLabel = sYaxisLabel;
+				d->m_Pages.at(sPageName + sPageLessKey).m_LineChartControls.at(iUniqueID).sChartName = std::move(sChartName);
+				d->m_Pages.at(sPageName + sPageLessKey).m_LineChartControls.at(iUniqueID).sXaxisLabel = std::move(sXaxisLabel);
+				d->m_Pages.at(sPageName + sPageLessKey).m_LineChartControls.at(iUniqueID).sYaxisLabel = std::move(sYaxisLabel);
 				d->m_Pages.at(sPageName + sPageLessKey).m_LineChartControls.at(iUniqueID).iLowerLimit = iLowerLimit;
 				d->m_Pages.at(sPageName + sPageLessKey).m_LineChartControls.at(iUniqueID).iUpperLimit = iUpperLimit;
-				d->m_Pages.at(sPageName + sPageLessKey).m_LineChartControls.at(iUniqueID).vLines = vLines;
+				cui_rawImpl::setLineChartLines(d->m_Pages.at(sPageName + sPageLessKey).m_LineChartControls.at(iUniqueID), std::move(vLines));
 
 				if (/*bAutoColor*/true)
 				{
@@ -3969,6 +4150,130 @@ bool cui_raw::lineChartReload(const std::basic_string<TCHAR> &sPageName, int iUn
 	return false;
 }
 
+bool cui_raw::lineChartAppend(const std::basic_string<TCHAR> &sPageName, int iUniqueID,
+	const std::basic_string<TCHAR> &sSeriesName,
+	std::vector<barChartData> vValues,
+	std::basic_string<TCHAR> &sErr
+)
+{
+	std::basic_string<TCHAR> sPageLessKey;
+
+	if (sPageName.empty())
+		sPageLessKey = d->m_sTitle;
+
+	try
+	{
+		auto &controls = d->m_Pages.at(sPageName + sPageLessKey).m_LineChartControls;
+		auto it = controls.find(iUniqueID);
+
+		if (it != controls.end())
+		{
+			cui_rawImpl::LineChartControl &control = it->second;
+
+			cui_rawImpl::chartLine *pLine = nullptr;
+
+			for (auto &line : control.vLines)
+			{
+				if (line.sSeriesName == sSeriesName)
+				{
+					pLine = &line;
+					break;
+				}
+			}
+
+			bool bNewLine = false;
+
+			if (!pLine)
+			{
+				// add a new series
+				cui_rawImpl::chartLine line;
+				line.sSeriesName = sSeriesName;
+				line.clrLine = randomColor(true);
+				line.values.SetCapacity(control.iMaxPoints);
+				control.vLines.push_back(std::move(line));
+
+				pLine = &control.vLines.back();
+				bNewLine = true;
+			}
+
+			for (auto &value : vValues)
+			{
+				// number points on from those already appended
+				value.iNumber = (int)pLine->values.Appended() + 1;
+				pLine->values.Append(std::move(value));
+			}
+
+			if (bNewLine || !control.bLayoutCaptured)
+			{
+				// the series labels change, repaint everything
+				control.bInfoCaptured = false;
+
+				if (IsWindow(control.hWnd))
+					InvalidateRect(control.hWnd, NULL, FALSE);
+			}
+			else
+			{
+				// only the plot changes; leave painting to the next WM_PAINT so that
+				// appends that come in quick succession are drawn once
+				control.bPointInfoStale = true;
+
+				if (IsWindow(control.hWnd))
+					InvalidateRect(control.hWnd, &control.rcPlot, FALSE);
+			}
+
+			return true;
+		}
+	}
+	catch (std::exception &e)
+	{
+		std::string m_sErr = e.what();
+	}
+
+	sErr = _T("Line chart control not found");
+	return false;
+} // lineChartAppend
+
+bool cui_raw::lineChartMaxPointsSet(const std::basic_string<TCHAR> &sPageName, int iUniqueID,
+	int iMaxPoints,
+	std::basic_string<TCHAR> &sErr
+)
+{
+	std::basic_string<TCHAR> sPageLessKey;
+
+	if (sPageName.empty())
+		sPageLessKey = d->m_sTitle;
+
+	try
+	{
+		auto &controls = d->m_Pages.at(sPageName + sPageLessKey).m_LineChartControls;
+		auto it = controls.find(iUniqueID);
+
+		if (it != controls.end())
+		{
+			cui_rawImpl::LineChartControl &control = it->second;
+
+			control.iMaxPoints = iMaxPoints > 0 ? (size_t)iMaxPoints : 0;
+
+			for (auto &line : control.vLines)
+				line.values.SetCapacity(control.iMaxPoints);
+
+			control.bInfoCaptured = false;
+
+			if (IsWindow(control.hWnd))
+				InvalidateRect(control.hWnd, NULL, FALSE);
+
+			return true;
+		}
+	}
+	catch (std::exception &e)
+	{
+		std::string m_sErr = e.what();
+	}
+
+	sErr = _T("Line chart control not found");
+	return false;
+} // lineChartMaxPointsSet
+
 bool cui_raw::lineChartSave(const std::basic_string<TCHAR> &sPageName,
 	int iUniqueID,
 	imgFormat format,
@@ -4203,8 +4508,8 @@ bool cui_raw::pieChartReload(const std::basic_string<TCHAR> &sPageName, int iUni
 			{
 				d->m_Pages.at(sPageName + sPageLessKey).m_PieChartControls.at(iUniqueID).bInfoCaptured = false;	// important to ensure control parameters are reset	
 				d->m_Pages.at(sPageName + sPageLessKey).m_PieChartControls.at(iUniqueID).bAutoColor = bAutoColor;
-				d->m_Pages.at(sPageName + sPageLessKey).m_PieChartControls.at(iUniqueID).sChartName = sChartName;
-				d->m_Pages.at(sPageName + sPageLessKey).m_PieChartControls.at(iUniqueID).vData = vData;
+				d->m_Pages.at(sPageName + sPageLessKey).m_PieChartControls.at(iUniqueID).sChartName = std::move(sChartName);
+				d->m_Pages.at(sPageName + sPageLessKey).m_PieChartControls.at(iUniqueID).vData = std::move(vData);
 				d->m_Pages.at(sPageName + sPageLessKey).m_PieChartControls.at(iUniqueID).hoverEffect = hoverEffect;
 				d->m_Pages.at(sPageName + sPageLessKey).m_PieChartControls.at(iUniqueID).bDoughnut = bDoughnut;
 
@@ -5227,17 +5532,20 @@ bool cui_raw::changeImage(const std::basic_string<TCHAR> &sPageName,
 				d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).iPNGResource = 0;
 				d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).GdiplusBitmap_res.Load(-1, _T("PNG"), sErr, d->m_hResModule);
 
-				// attempt to load image from file
-				bRes = d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).GdiplusBitmap.Load(sNewFileName.c_str(), sErr);
+				// the image is loaded in the background when the control is painted, so just check that the file is there
+				if (GetFileAttributes(sNewFileName.c_str()) == INVALID_FILE_ATTRIBUTES)
+				{
+					sErr = GetLastErrorInfo(GetLastError());
+					bRes = false;
+				}
 
 				if (bRes)
 				{
-					// delete the display bitmap so that it can be redrawn
-					if (d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).m_pDisplaybitmap)
-					{
-						delete d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).m_pDisplaybitmap;
-						d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).m_pDisplaybitmap = NULL;
-					}
+					// set the new file; the image on show stays until the new one has been loaded
+					d->m_image_loader.Cancel(reinterpret_cast<std::uintptr_t>(d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).hWnd));
+					d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).sFileName = sNewFileName;
+					d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).bLoadFailed = false;
+					d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).sizeLoaded = { 0, 0 };
 
 					// change the text if the user so desires
 					if (bChangeText)
@@ -5293,8 +5601,9 @@ bool cui_raw::changeImage(const std::basic_string<TCHAR> &sPageName,
 
 				if (IDC_PNG != 0)
 				{
-					// remove image
-					d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).GdiplusBitmap.Load(_T(""), sErr);
+					// remove image from file
+					d->m_image_loader.Cancel(reinterpret_cast<std::uintptr_t>(d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).hWnd));
+					d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).sFileName.clear();
 
 					// set PNG resource
 					d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).iPNGResource = IDC_PNG;
@@ -5377,7 +5686,8 @@ bool cui_raw::changeImageText(const std::basic_string<TCHAR> &sPageName,
 					{
 						LPRECT rcUpdate = NULL;
 
-						if (d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).m_pDisplaybitmap)
+						// images from files are laid out afresh on every paint
+						if (d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).m_pDisplaybitmap && d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).iPNGResource)
 						{
 							delete d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).m_pDisplaybitmap;
 							d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).m_pDisplaybitmap = NULL;
@@ -5519,10 +5829,19 @@ bool cui_raw::updateImage(const std::basic_string<TCHAR> &sPageName,
 	{
 		if (d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.find(iUniqueID) != d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.end())
 		{
-			if (d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).m_pDisplaybitmap)
+			if (d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).iPNGResource)
 			{
-				delete d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).m_pDisplaybitmap;
-				d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).m_pDisplaybitmap = NULL;
+				if (d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).m_pDisplaybitmap)
+				{
+					delete d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).m_pDisplaybitmap;
+					d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).m_pDisplaybitmap = NULL;
+				}
+			}
+			else
+			{
+				// load the image from file again; the one on show stays until it's ready
+				d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).bLoadFailed = false;
+				d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).sizeLoaded = { 0, 0 };
 			}
 
 			InvalidateRect(d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).hWnd, NULL, TRUE);
@@ -5581,10 +5900,16 @@ bool cui_raw::saveImage(const std::basic_string<TCHAR> &sPageName,
 
 				bool bRes = true;
 
-				if (d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).GdiplusBitmap)
+				if (!d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).iPNGResource &&
+					!d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).sFileName.empty())
 				{
+					// the control only keeps a display sized copy of the image, so read the file again
+					CGdiPlusBitmap bitmap;
+					bRes = bitmap.Load(d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).sFileName.c_str(), sErr);
+
 					// attempt to save image to file
-					bRes = CImageConv::GDIPLUSBITMAPtoFILE(d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).GdiplusBitmap, sFullPath, m_format, maxSize, sErr);
+					if (bRes)
+						bRes = CImageConv::GDIPLUSBITMAPtoFILE(bitmap, sFullPath, m_format, maxSize, sErr);
 				}
 				else
 					if (d->m_Pages.at(sPageName + sPageLessKey).m_ImageControls.at(iUniqueID).GdiplusBitmap_res)
@@ -5972,9 +6297,30 @@ bool cui_raw::setStarRating(
 				if (iRating > d->m_Pages.at(sPageName + sPageLessKey).m_StarRatingControls.at(iUniqueID).iHighestRating)
 					iRating = d->m_Pages.at(sPageName + sPageLessKey).m_StarRatingControls.at(iUniqueID).iHighestRating;
 
-				d->m_Pages.at(sPageName + sPageLessKey).m_StarRatingControls.at(iUniqueID).iRating = iRating;
+				cui_rawImpl::StarRatingControl &control = d->m_Pages.at(sPageName + sPageLessKey).m_StarRatingControls.at(iUniqueID);
+
+				const int iOldRating = control.iRating;
+				control.iRating = iRating;
+
+				if (control.rcStars.empty())
+					InvalidateRect(control.hWnd, NULL, TRUE);	// not painted yet
+				else
+				{
+					// repaint just the stars that are turned on or off
+					RECT rcUpdate = { 0 };
+
+					for (size_t i = 0; i < control.rcStars.size(); i++)
+					{
+						if (((int)i < iOldRating) != ((int)i < iRating))
+							UnionRect(&rcUpdate, &rcUpdate, &control.rcStars[i].rc);
+					}
 
-				InvalidateRect(d->m_Pages.at(sPageName + sPageLessKey).m_StarRatingControls.at(iUniqueID).hWnd, NULL, TRUE);
+					if (!IsRectEmpty(&rcUpdate))
+					{
+						InflateRect(&rcUpdate, 1, 1);
+						InvalidateRect(control.hWnd, &rcUpdate, TRUE);
+					}
+				}
 
 				return true;
 			}
@@ -6661,6 +7007,40 @@ double cui_raw::getDPIScale()
 	return d->m_DPIScale;
 } // getDPIScale
 
+void cui_raw::resetGdiPlusCache()
+{
+	d->m_gdiplus_cache.Clear();
+} // resetGdiPlusCache
+
+void cui_raw::getGdiPlusCacheStats(gdiPlusCacheStats &stats)
+{
+	const CGdiPlusCache::stats stats_ = d->m_gdiplus_cache.GetStats();
+
+	stats.iFontHits = stats_.iFontHits;
+	stats.iFontMisses = stats_.iFontMisses;
+	stats.iBrushHits = stats_.iBrushHits;
+	stats.iBrushMisses = stats_.iBrushMisses;
+	stats.iFonts = stats_.iFonts;
+	stats.iBrushes = stats_.iBrushes;
+} // getGdiPlusCacheStats
+
+void cui_raw::setShadowCacheCapacity(size_t iBytes)
+{
+	CShadowCache::SetCapacity(iBytes);
+} // setShadowCacheCapacity
+
+void cui_raw::getShadowCacheStats(shadowCacheStats &stats)
+{
+	const CShadowCache::stats stats_ = CShadowCache::GetStats();
+
+	stats.iHits = stats_.iHits;
+	stats.iMisses = stats_.iMisses;
+	stats.iEvictions = stats_.iEvictions;
+	stats.iEntries = stats_.iEntries;
+	stats.iBytes = stats_.iBytes;
+	stats.iCapacity = stats_.iCapacity;
+} // getShadowCacheStats
+
 void* cui_raw::getState()
 {
 	return d->pState_user;
@@ -353,6 +353,33 @@ namespace liblec
 					std::vector<listviewItem> vItems;
 				};
 
+				/// <summary>
+				/// Listview column data, for populating a listview one column at a time.
+				/// </summary>
+				struct listviewColumnData
+				{
+					/// <summary>
+					/// Name of the column.
+					/// </summary>
+					std::basic_string<TCHAR> sColumnName;
+
+					/// <summary>
+					/// The column's cells, one per row, starting from row 0.
+					/// </summary>
+					std::vector<std::basic_string<TCHAR>> vItems;
+				};
+
+				/// <summary>
+				/// Row provider for virtual listviews.
+				/// </summary>
+				/// 
+				/// <remarks>
+				/// Called with the number of the row to be displayed (counted from 0). The provider fills
+				/// in row.vItems, which are matched to columns by listviewItem::sColumnName. pData is the
+				/// pointer that was passed to addVirtualListview().
+				/// </remarks>
+				typedef void(*listviewRowProvider)(int iRowNumber, listviewRow &row, void *pData);
+
 				/// <summary>
 				/// Context menu item description.
 				/// </summary>
@@ -1581,6 +1608,21 @@ namespace liblec
 					std::basic_string<TCHAR> &sErr
 				);
 
+				/// <summary>
+				/// Add a row to a listview control, taking ownership of the row's data.
+				/// </summary>
+				/// 
+				/// <remarks>
+				/// Same as the overload above except that vRow is moved into the listview instead of
+				/// being copied, and the row number is not written back.
+				/// </remarks>
+				bool addListviewRow(const std::basic_string<TCHAR> &sPageName,
+					int iUniqueID,
+					listviewRow &&vRow,
+					bool bScrollToBottom,
+					std::basic_string<TCHAR> &sErr
+				);
+
 				/// <summary>
 				/// Repopulate a listview control.
 				/// </summary>
@@ -1614,6 +1656,55 @@ namespace liblec
 					std::basic_string<TCHAR> &sErr
 				);
 
+				/// <summary>
+				/// Repopulate a listview control, taking ownership of the data.
+				/// </summary>
+				/// 
+				/// <remarks>
+				/// Same as the overload above except that vData is moved into the listview instead of
+				/// being copied, and row numbers are not written back.
+				/// </remarks>
+				bool repopulateListview(const std::basic_string<TCHAR> &sPageName,
+					int iUniqueID,
+					std::vector<listviewRow> &&vData,
+					std::basic_string<TCHAR> &sErr
+				);
+
+				/// <summary>
+				/// Repopulate a listview control from column data.
+				/// </summary>
+				/// 
+				/// <param name="sPageName">
+				/// The page containing the control.
+				/// </param>
+				/// 
+				/// <param name="iUniqueID">
+				/// The unique ID of the control.
+				/// </param>
+				/// 
+				/// <param name="vColumnData">
+				/// The data to add to the listview control, one entry per column.
+				/// </param>
+				/// 
+				/// <param name="sErr">
+				/// Error information if function fails and returns false.
+				/// </param>
+				/// 
+				/// <returns>
+				/// Returns true if successful, else false.
+				/// </returns>
+				/// 
+				/// <remarks>
+				/// Each column name is resolved once. The number of rows is that of the longest column;
+				/// cells missing from shorter columns are left empty. Items are added without custom
+				/// text colors. Columns with names that are not in the listview are ignored.
+				/// </remarks>
+				bool repopulateListview(const std::basic_string<TCHAR> &sPageName,
+					int iUniqueID,
+					const std::vector<listviewColumnData> &vColumnData,
+					std::basic_string<TCHAR> &sErr
+				);
+
 				/// <summary>
 				/// Get data contained in a listview control.
 				/// </summary>
@@ -1745,6 +1836,122 @@ namespace liblec
 					std::basic_string<TCHAR> &sErr
 				);
 
+				/// <summary>
+				/// Add a virtual listview control to the window.
+				/// </summary>
+				/// 
+				/// <param name="sPageName">
+				/// The page into which the control is to be placed.
+				/// </param>
+				/// 
+				/// <param name="iUniqueID">
+				/// The unique ID of the control.
+				/// </param>
+				/// 
+				/// <param name="vColumns">
+				/// The columns to add to the listview control.
+				/// </param>
+				/// 
+				/// <param name="iRowCount">
+				/// The number of rows in the listview control.
+				/// </param>
+				/// 
+				/// <param name="pRowProvider">
+				/// The function that supplies the contents of a row when it is displayed.
+				/// </param>
+				/// 
+				/// <param name="pData">
+				/// Pointer passed back to pRowProvider.
+				/// </param>
+				/// 
+				/// <param name="vContextMenu">
+				/// The context menu to display when user right clicks an entry in the listview control.
+				/// </param>
+				/// 
+				/// <param name="sFontName">
+				/// The font to be used for the text.
+				/// </param>
+				/// 
+				/// <param name="iFontSize">
+				/// The size of the font, in points.
+				/// </param>
+				/// 
+				/// <param name="rc">
+				/// The rectangular coordinates of the control, in pixels.
+				/// </param>
+				/// 
+				/// <param name="resize">
+				/// The behavior of the control when the window is resized.
+				/// </param>
+				/// 
+				/// <param name="bBorder">
+				/// Whether to draw a border around the control.
+				/// </param>
+				/// 
+				/// <param name="bGridLines">
+				/// Whether to display gridlines in the listview control.
+				/// </param>
+				/// 
+				/// <returns>
+				/// No return value.
+				/// </returns>
+				/// 
+				/// <remarks>
+				/// A virtual listview does not store its rows. Text is requested from pRowProvider only
+				/// for the rows that are on screen, and recently displayed rows are cached. Sorting by
+				/// clicking columns is not available, and addListviewRow(), repopulateListview(),
+				/// updateListViewItem() and removeListViewRow() fail on virtual listviews. Use
+				/// setListviewRowCount() when the application's data changes.
+				/// </remarks>
+				void addVirtualListview(
+					const std::basic_string<TCHAR> &sPageName, int iUniqueID,
+					std::vector<listviewColumn> vColumns,
+					int iRowCount,
+					listviewRowProvider pRowProvider,
+					void *pData,
+					std::vector<contextMenuItem> vContextMenu,
+					const std::basic_string<TCHAR> &sFontName, double iFontSize,
+					RECT rc,
+					onResize resize,
+					bool bBorder,
+					bool bGridLines
+				);
+
+				/// <summary>
+				/// Set the number of rows in a virtual listview.
+				/// </summary>
+				/// 
+				/// <param name="sPageName">
+				/// The page containing the control.
+				/// </param>
+				/// 
+				/// <param name="iUniqueID">
+				/// The unique ID of the control.
+				/// </param>
+				/// 
+				/// <param name="iRowCount">
+				/// The number of rows.
+				/// </param>
+				/// 
+				/// <param name="sErr">
+				/// Error information if function fails and returns false.
+				/// </param>
+				/// 
+				/// <returns>
+				/// Returns true if successful, else false.
+				/// </returns>
+				/// 
+				/// <remarks>
+				/// Cached rows are discarded and the visible rows are requested again from the row
+				/// provider, so this is also the way to refresh a virtual listview after its data
+				/// has changed.
+				/// </remarks>
+				bool setListviewRowCount(const std::basic_string<TCHAR> &sPageName,
+					int iUniqueID,
+					int iRowCount,
+					std::basic_string<TCHAR> &sErr
+				);
+
 				/// <summary>
 				/// Add an edit control to the window.
 				/// </summary>
@@ -3245,6 +3452,75 @@ namespace liblec
 					std::basic_string<TCHAR> &sErr
 				);
 
+				/// <summary>
+				/// Append points to a line chart series.
+				/// </summary>
+				/// 
+				/// <param name="sPageName">
+				/// The page containing the control.
+				/// </param>
+				/// 
+				/// <param name="iUniqueID">
+				/// The unique ID of the control.
+				/// </param>
+				/// 
+				/// <param name="sSeriesName">
+				/// The name of the series. A new series is added if there is no series with this name.
+				/// </param>
+				/// 
+				/// <param name="vValues">
+				/// The points to append. Points are numbered on from the points already appended to the
+				/// series, so barChartData::iNumber is ignored.
+				/// </param>
+				/// 
+				/// <param name="sErr">
+				/// Error information if function fails and returns false.
+				/// </param>
+				/// 
+				/// <returns>
+				/// Returns true if successful, else false.
+				/// </returns>
+				/// 
+				/// <remarks>
+				/// If a maximum number of points has been set with lineChartMaxPointsSet() the oldest
+				/// points are dropped to make room. Only the plot area is repainted, and not until the
+				/// control next processes WM_PAINT, so frequent appends are cheap.
+				/// </remarks>
+				bool lineChartAppend(const std::basic_string<TCHAR> &sPageName, int iUniqueID,
+					const std::basic_string<TCHAR> &sSeriesName,
+					std::vector<barChartData> vValues,
+					std::basic_string<TCHAR> &sErr
+				);
+
+				/// <summary>
+				/// Set the maximum number of points in each line chart series.
+				/// </summary>
+				/// 
+				/// <param name="sPageName">
+				/// The page containing the control.
+				/// </param>
+				/// 
+				/// <param name="iUniqueID">
+				/// The unique ID of the control.
+				/// </param>
+				/// 
+				/// <param name="iMaxPoints">
+				/// The maximum number of points, 0 for no limit. Series with more points lose their
+				/// oldest points.
+				/// </param>
+				/// 
+				/// <param name="sErr">
+				/// Error information if function fails and returns false.
+				/// </param>
+				/// 
+				/// <returns>
+				/// Returns true if successful, else false.
+				/// </returns>
+				bool lineChartMaxPointsSet(const std::basic_string<TCHAR> &sPageName, int iUniqueID,
+					int iMaxPoints,
+					std::basic_string<TCHAR> &sErr
+				);
+
 				struct pieChartData
 				{
 					/// <summary>
@@ -5342,6 +5618,59 @@ namespace liblec
 				/// </returns>
 				double getDPIScale();
 
+				/// <summary>
+				/// Destroy the fonts and brushes cached for painting controls.
+				/// </summary>
+				/// 
+				/// <remarks>
+				/// Call this after fonts have been loaded without addFont(), so that controls
+				/// pick them up the next time they are painted. addFont() does this itself.
+				/// </remarks>
+				void resetGdiPlusCache();
+
+				struct gdiPlusCacheStats
+				{
+					unsigned long long iFontHits = 0;
+					unsigned long long iFontMisses = 0;
+					unsigned long long iBrushHits = 0;
+					unsigned long long iBrushMisses = 0;
+					size_t iFonts = 0;		// number of fonts in the cache
+					size_t iBrushes = 0;	// number of brushes in the cache
+				};
+
+				/// <summary>
+				/// Get the hit and miss counters of the cache of fonts and brushes used for painting
+				/// controls.
+				/// </summary>
+				void getGdiPlusCacheStats(gdiPlusCacheStats &stats);
+
+				/// <summary>
+				/// Set the memory limit of the shadow bitmap cache.
+				/// </summary>
+				/// 
+				/// <remarks>
+				/// Shadow bitmaps are shared by every window in the process and are reused
+				/// whenever a window of the same size, region and shadow properties needs a
+				/// shadow. The least recently used bitmaps are dropped to stay within the limit.
+				/// The default limit is 32MB; 0 disables the cache.
+				/// </remarks>
+				void setShadowCacheCapacity(size_t iBytes);
+
+				struct shadowCacheStats
+				{
+					unsigned long long iHits = 0;
+					unsigned long long iMisses = 0;
+					unsigned long long iEvictions = 0;
+					size_t iEntries = 0;	// number of bitmaps in the cache
+					size_t iBytes = 0;		// memory used by the bitmaps
+					size_t iCapacity = 0;	// memory limit, in bytes
+				};
+
+				/// <summary>
+				/// Get the statistics of the shadow bitmap cache.
+				/// </summary>
+				void getShadowCacheStats(shadowCacheStats &stats);
+
 				/// <summary>
 				/// Set user state information.
 				/// </summary>
@@ -605,6 +605,9 @@ void cui_rawImpl::AddControls(HWND hWnd, std::basic_string<TCHAR> sPage, cui_raw
 				if (it.second.bBorder)
 					dwStyle |= WS_BORDER;
 
+				if (it.second.bVirtual)
+					dwStyle |= LVS_OWNERDATA;
+
 				it.second.hWnd = CreateWindow(WC_LISTVIEW, _T(""), dwStyle,
 					it.second.coords.left,
 					it.second.coords.top,
@@ -677,34 +680,40 @@ void cui_rawImpl::AddControls(HWND hWnd, std::basic_string<TCHAR> sPage, cui_raw
 				{
 					for (auto &item : row.vItems)
 					{
-						std::basic_string<TCHAR> sColumnName = item.sColumnName;
-						std::basic_string<TCHAR> sItemData = item.sItemData;
-
 						// ignore user supplied row number
 						item.iRowNumber = iRowNumber;
 
-						int iColumnNumber = -1;
-
 						// determine column number
-						for (size_t i = 0; i < it.second.vColumns.size(); i++)
-						{
-							if (it.second.vColumns[i].sColumnName == sColumnName)
-							{
-								iColumnNumber = it.second.vColumns[i].iColumnID;
-								break;
-							}
-						}
+						int iColumnNumber = getListviewColumnNumber(it.second, item.sColumnName);
 
 						// insert item
 						if (iColumnNumber != -1) // failsafe in-case there's a typo in column name
 						{
-							it.second.pClistview->InsertItem(iRowNumber, iColumnNumber, sItemData);
+							it.second.pClistview->InsertItem(iRowNumber, iColumnNumber, item.sItemData);
 						}
 					}
 
 					iRowNumber++;
 				}
 
+				// build the style index used for custom drawing
+				buildListviewStyles(it.second);
+
+				if (it.second.bVirtual)
+				{
+					// rows are fetched from the row provider when they are displayed
+					listviewControl *pControl = &it.second;
+
+					it.second.cache.SetNumOfCols((int)it.second.vColumns.size());
+					it.second.cache.SetProvider([pControl](int iRowNumber, ClistviewCache::row &cells)
+					{
+						fetchVirtualListviewRow(*pControl, iRowNumber, cells);
+					});
+					it.second.cache.SetRowCount(it.second.iRowCount);
+
+					ListView_SetItemCountEx(it.second.hWnd, it.second.iRowCount, LVSICF_NOINVALIDATEALL);
+				}
+
 				// subclass listview control so we can do some mumbo-jumbo!!!
 				SetWindowLongPtr(it.second.hWnd, GWLP_USERDATA, (LONG_PTR)&it.second);
 				it.second.PrevProc =
@@ -1466,15 +1475,8 @@ void cui_rawImpl::AddControls(HWND hWnd, std::basic_string<TCHAR> sPage, cui_raw
 					bool bRes = it.second.GdiplusBitmap_res.Load(it.second.iPNGResource,
 						_T("PNG"), sErr, resource_module);
 				}
-				else
-					if (!it.second.sFileName.empty())
-					{
-						// attempt to load image from file
 
-						// TO-DO: implement error response
-						std::basic_string<TCHAR> sErr;
-						it.second.GdiplusBitmap.Load(it.second.sFileName.c_str(), sErr);
-					}
+				// images from files are loaded in the background once the control is painted
 
 				// subclass control so we can do custom drawing
 				SetWindowLongPtr(it.second.hWnd, GWLP_USERDATA, (LONG_PTR)&it.second);
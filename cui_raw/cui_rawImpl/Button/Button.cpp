@@ -43,13 +43,8 @@ LRESULT CALLBACK cui_rawImpl::BtnProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM
 		int cx = itemRect.right - itemRect.left;
 		int cy = itemRect.bottom - itemRect.top;
 
-		// use double buffering to avoid flicker
-		HDC hdc = CreateCompatibleDC(dc);
-
-		if (!p_control->hbm_buffer)
-			p_control->hbm_buffer = CreateCompatibleBitmap(dc, cx, cy);
-
-		HBITMAP hbmOld = SelectBitmap(hdc, p_control->hbm_buffer);
+		// use double buffering to avoid flicker; only the part being painted is drawn
+		HDC hdc = p_control->d->m_paint_buffer.Acquire(dc, cx, cy, ps.rcPaint);
 
 		RECT outerRect = itemRect;
 
@@ -171,12 +166,13 @@ LRESULT CALLBACK cui_rawImpl::BtnProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM
 			p_font = nullptr;
 		}
 
-		BitBlt(dc, 0, 0, cx, cy, hdc, 0, 0, SRCCOPY);
+		BitBlt(dc, ps.rcPaint.left, ps.rcPaint.top,
+			ps.rcPaint.right - ps.rcPaint.left, ps.rcPaint.bottom - ps.rcPaint.top,
+			hdc, ps.rcPaint.left, ps.rcPaint.top, SRCCOPY);
 
 		EndPaint(hWnd, &ps);
 
-		SelectBitmap(hdc, hbmOld);
-		DeleteDC(hdc);
+		p_control->d->m_paint_buffer.Release(hdc);
 	}
 	break;
 
@@ -190,26 +186,8 @@ LRESULT CALLBACK cui_rawImpl::BtnProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM
 	}
 	break;
 
-	case WM_DESTROY:
-	{
-		// delete buffer, we're done
-		if (p_control->hbm_buffer)
-		{
-			DeleteBitmap(p_control->hbm_buffer);
-			p_control->hbm_buffer = NULL;
-		}
-	}
-	break;
-
 	case WM_SIZE:
 	{
-		// delete buffer, we need it recreated
-		if (p_control->hbm_buffer)
-		{
-			DeleteBitmap(p_control->hbm_buffer);
-			p_control->hbm_buffer = NULL;
-		}
-
 		InvalidateRect(hWnd, NULL, TRUE);
 	}
 	break;
@@ -0,0 +1,351 @@
+//
+// CChartAxis.cpp - chart value axis implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "CChartAxis.h"
+
+#include <cmath>
+#include <cfloat>
+#include <cstdio>
+#include <utility>
+
+/*
+** limits on the labels
+** at least one decimal place, as the charts have always shown, and no more than a double can
+** resolve; values from dMaxFixed up are shown in exponent notation, as are steps that would
+** need more than iMaxDecimals decimal places
+*/
+static const int iMinDecimals = 1;
+static const int iMaxDecimals = 15;
+static const double dMaxFixed = 1e15;
+
+/*
+** limits on the values
+** below dMinNormalized the power of ten of a value underflows, so NiceNumber scales it up
+** by dDenormalScale first
+*/
+static const double dMinNormalized = 1e-290;
+static const double dDenormalScale = 1e300;
+
+/*
+** decimal exponent of a positive number, e.g. 2 for 500 and -3 for 0.002
+*/
+static int exponentOf(double dValue)
+{
+	// allow for log10 of an exact power of ten coming out a hair high or low
+	return (int)std::floor(std::log10(dValue) + 1e-9);
+} // exponentOf
+
+CChartAxis::CChartAxis() :
+	m_bAuto(false),
+	m_dLowest(0),
+	m_dHighest(0),
+	m_iMaxLines(0),
+	m_dLower(0),
+	m_dUpper(0),
+	m_dStep(0),
+	m_iLines(0),
+	m_iDecimals(iMinDecimals),
+	m_bExponent(false)
+{
+}
+
+CChartAxis::~CChartAxis()
+{
+}
+
+double CChartAxis::NiceNumber(double dValue, bool bRound)
+{
+	if (!(dValue > 0) || !std::isfinite(dValue))
+		return dValue;
+
+	// the power of ten of a denormal number is too small for a double; scale it up and back
+	if (dValue < dMinNormalized)
+		return NiceNumber(dValue * dDenormalScale, bRound) / dDenormalScale;
+
+	const double dExponent = std::floor(std::log10(dValue));
+	const double dPower = std::pow(10.0, dExponent);
+	const double dFraction = dValue / dPower;	// [1, 10), give or take rounding
+
+	double dNice = 10;
+
+	if (bRound)
+	{
+		if (dFraction < 1.5)
+			dNice = 1;
+		else if (dFraction < 3)
+			dNice = 2;
+		else if (dFraction < 7)
+			dNice = 5;
+	}
+	else
+	{
+		if (dFraction <= 1)
+			dNice = 1;
+		else if (dFraction <= 2)
+			dNice = 2;
+		else if (dFraction <= 5)
+			dNice = 5;
+	}
+
+	return dNice * dPower;
+} // NiceNumber
+
+bool CChartAxis::Calculate(double dLowest, double dHighest, int iMaxLines)
+{
+	if (!std::isfinite(dLowest) || !std::isfinite(dHighest))
+		return false;
+
+	if (dLowest > dHighest)
+		std::swap(dLowest, dHighest);
+
+	if (iMaxLines < 1)
+		iMaxLines = 1;
+
+	// nothing to do if the axis was fitted to the same range
+	if (m_bAuto && m_iLines > 0 &&
+		dLowest == m_dLowest && dHighest == m_dHighest && iMaxLines == m_iMaxLines)
+		return true;
+
+	double dLow = dLowest;
+	double dHigh = dHighest;
+
+	if (dLow == dHigh)
+	{
+		// widen a single value so that it sits inside the axis, without going past the
+		// largest double
+		double dMargin = dLow == 0 ? 1 : std::fabs(dLow) / 10;
+
+		// a tenth of the smallest denormals is nothing
+		if (dLow - dMargin == dLow)
+			dMargin = std::fabs(dLow);
+
+		dLow = std::fmax(dLow - dMargin, -DBL_MAX);
+		dHigh = std::fmin(dHigh + dMargin, DBL_MAX);
+	}
+
+	const double dRange = dHigh - dLow;
+
+	if (!std::isfinite(dRange))
+		return false;
+
+	// Heckbert: a nice step for about iMaxLines intervals over a nice range, then limits on
+	// multiples of the step; moving the limits out to the step can add an interval at each
+	// end, so step up through the nice numbers until the count is within bounds
+	// near the largest double the nice range does not exist, and the range is used as it is
+	double dNiceRange = NiceNumber(dRange, false);
+
+	if (!std::isfinite(dNiceRange))
+		dNiceRange = dRange;
+
+	double dStep = NiceNumber(dNiceRange / iMaxLines, true);
+	double dLower = 0, dUpper = 0, dLines = 0;
+
+	for (;;)
+	{
+		dLower = std::floor(dLow / dStep) * dStep;
+		dUpper = std::ceil(dHigh / dStep) * dStep;
+		dLines = std::floor((dUpper - dLower) / dStep + 0.5);
+
+		// once the step covers the range there are at most two intervals, which a larger
+		// step cannot improve on when the range straddles a multiple of it
+		if (dLines <= iMaxLines || dStep >= dRange)
+			break;
+
+		const double dNext = NiceNumber(dStep * 1.5, false);
+
+		// the step cannot grow past the largest double
+		if (!(dNext > dStep) || !std::isfinite(dNext))
+			break;
+
+		dStep = dNext;
+	}
+
+	if (!std::isfinite(dLower) || !std::isfinite(dUpper) || !std::isfinite(dUpper - dLower))
+	{
+		// the limits on multiples of the step are past the largest double; use the range as
+		// it is
+		dLower = dLow;
+		dUpper = dHigh;
+		dLines = iMaxLines + 1;
+	}
+
+	// when the step is close to the resolution of the values the products above can round
+	// to the wrong side of them
+	dLower = std::fmin(dLower, dLow);
+	dUpper = std::fmax(dUpper, dHigh);
+
+	if (dLines > iMaxLines)
+	{
+		// only one interval allowed, or no nice step fits; give up on a nice step
+		dStep = (dUpper - dLower) / iMaxLines;
+		dLines = iMaxLines;
+
+		// among the smallest denormals the step can be below the smallest double
+		if (!(dStep > 0))
+		{
+			dStep = dUpper - dLower;
+			dLines = 1;
+		}
+	}
+
+	if (dLines < 1)
+	{
+		// the step is below the resolution of the values; use the range as it is
+		dLower = dLow;
+		dUpper = dHigh;
+		dStep = dRange;
+		dLines = 1;
+	}
+
+	m_bAuto = true;
+	m_dLowest = dLowest;
+	m_dHighest = dHighest;
+	m_iMaxLines = iMaxLines;
+
+	m_dLower = dLower;
+	m_dUpper = dUpper;
+	m_dStep = dStep;
+	m_iLines = (int)dLines;
+
+	makeLabels();
+	return true;
+} // Calculate
+
+bool CChartAxis::SetLimits(double dLower, double dUpper, int iLines)
+{
+	if (!std::isfinite(dLower) || !std::isfinite(dUpper) || iLines < 1)
+		return false;
+
+	const double dStep = (dUpper - dLower) / iLines;
+
+	// limits further apart than the largest double
+	if (!std::isfinite(dStep))
+		return false;
+
+	if (!m_bAuto && m_iLines == iLines && m_dLower == dLower && m_dUpper == dUpper)
+		return true;
+
+	m_bAuto = false;
+	m_dLower = dLower;
+	m_dUpper = dUpper;
+	m_dStep = dStep;
+	m_iLines = iLines;
+
+	makeLabels();
+	return true;
+} // SetLimits
+
+double CChartAxis::Lower() const
+{
+	return m_dLower;
+}
+
+double CChartAxis::Upper() const
+{
+	return m_dUpper;
+}
+
+double CChartAxis::Step() const
+{
+	return m_dStep;
+}
+
+int CChartAxis::Lines() const
+{
+	return m_iLines;
+}
+
+double CChartAxis::Value(int i) const
+{
+	const double dValue = i >= m_iLines ? m_dUpper : m_dLower + i * m_dStep;
+
+	// don't let rounding turn the zero line into a tiny negative number, and don't show an
+	// upper limit rounded up to zero from below as -0
+	// (scaled up rather than the step down, which underflows for denormal steps)
+	if (std::fabs(dValue) * 1e9 < std::fabs(m_dStep))
+		return 0;
+
+	return dValue;
+} // Value
+
+const std::wstring &CChartAxis::Label(int i) const
+{
+	static const std::wstring sEmpty;
+
+	if (i < 0 || i >= (int)m_vLabels.size())
+		return sEmpty;
+
+	return m_vLabels[i];
+} // Label
+
+std::wstring CChartAxis::Format(double dValue, int iDecimals, bool bExponent)
+{
+	if (iDecimals < 0)
+		iDecimals = 0;
+
+	if (iDecimals > iMaxDecimals)
+		iDecimals = iMaxDecimals;
+
+	// enough for the largest double in fixed notation
+	char buffer[512];
+	const int iLength = snprintf(buffer, sizeof(buffer), bExponent ? "%.*e" : "%.*f", iDecimals, dValue);
+
+	if (iLength <= 0)
+		return std::wstring();
+
+	const size_t iCount = iLength < (int)sizeof(buffer) ? (size_t)iLength : sizeof(buffer) - 1;
+	return std::wstring(buffer, buffer + iCount);
+} // Format
+
+void CChartAxis::makeLabels()
+{
+	const double dStep = std::fabs(m_dStep);
+	const double dMagnitude = std::fmax(std::fabs(m_dLower), std::fabs(m_dUpper));
+
+	// as many decimal places as it takes to tell the gridlines apart
+	const int iStepExponent = dStep > 0 ? exponentOf(dStep) : 0;
+
+	m_bExponent = dMagnitude >= dMaxFixed || -iStepExponent > iMaxDecimals;
+
+	if (m_bExponent)
+	{
+		// digits of the mantissa, from the largest value down to the step
+		const int iExponent = dMagnitude > 0 ? exponentOf(dMagnitude) : iStepExponent;
+		m_iDecimals = dStep > 0 ? iExponent - iStepExponent : iMinDecimals;
+	}
+	else
+		m_iDecimals = -iStepExponent;
+
+	if (m_iDecimals < iMinDecimals)
+		m_iDecimals = iMinDecimals;
+
+	if (m_iDecimals > iMaxDecimals)
+		m_iDecimals = iMaxDecimals;
+
+	m_vLabels.resize(m_iLines + 1);
+
+	for (;;)
+	{
+		for (int i = 0; i <= m_iLines; i++)
+			m_vLabels[i] = Format(Value(i), m_iDecimals, m_bExponent);
+
+		// limits that are not multiples of the step, as when no nice step fits, can need
+		// another decimal place to tell neighbouring gridlines apart
+		bool bDistinct = true;
+
+		for (int i = 1; i <= m_iLines && bDistinct; i++)
+			bDistinct = m_vLabels[i] != m_vLabels[i - 1];
+
+		if (bDistinct || m_iDecimals >= iMaxDecimals)
+			break;
+
+		m_iDecimals++;
+	}
+} // makeLabels
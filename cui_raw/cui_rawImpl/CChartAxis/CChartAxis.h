@@ -0,0 +1,87 @@
+//
+// CChartAxis.h - chart value axis interface
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/*
+** CChartAxis - value axis shared by the bar and line charts
+** picks "nice" limits and a nice step (1, 2 or 5 times a power of ten) that cover a range of
+** values, after Heckbert's "Nice numbers for graph labels" (Graphics Gems, 1990), with no more
+** than a given number of gridlines whatever the magnitude of the values
+** the labels of the gridlines are formatted with just enough decimal places for the step, in
+** exponent notation for very large values or very small steps, and are kept until the axis
+** changes, so repainting a chart does not format them again
+** the class has no platform dependencies
+*/
+class CChartAxis
+{
+public:
+	CChartAxis();
+	~CChartAxis();
+
+	/*
+	** fit the axis to a range of values, with at most iMaxLines gridline intervals
+	** a range with no width is widened around its value
+	** returns false if the range is not finite, in which case the axis is left as it was
+	*/
+	bool Calculate(double dLowest, double dHighest, int iMaxLines);
+
+	/*
+	** set the limits of the axis directly, with iLines equal intervals
+	** returns false if the limits are not finite or iLines is less than 1
+	*/
+	bool SetLimits(double dLower, double dUpper, int iLines);
+
+	double Lower() const;
+	double Upper() const;
+	double Step() const;
+
+	// number of gridline intervals; there are Lines() + 1 gridlines
+	int Lines() const;
+
+	// value of gridline i, from 0 at the lower limit to Lines() at the upper limit
+	double Value(int i) const;
+
+	// label of gridline i
+	const std::wstring &Label(int i) const;
+
+	/*
+	** format a value with a given number of decimal places, in fixed or exponent notation
+	** decimal places outside 0 - 15 are clamped
+	*/
+	static std::wstring Format(double dValue, int iDecimals, bool bExponent = false);
+
+	/*
+	** round a number to 1, 2, 5 or 10 times a power of ten
+	** bRound rounds to the nearest such number, else the smallest such number that is not less
+	** than dValue is returned
+	*/
+	static double NiceNumber(double dValue, bool bRound);
+
+private:
+	void makeLabels();
+
+	// what the axis was calculated from, so that unchanged input is not recalculated
+	bool m_bAuto;
+	double m_dLowest, m_dHighest;
+	int m_iMaxLines;
+
+	double m_dLower, m_dUpper, m_dStep;
+	int m_iLines;
+
+	// how the labels are formatted
+	int m_iDecimals;
+	bool m_bExponent;
+
+	std::vector<std::wstring> m_vLabels;
+}; // CChartAxis
@@ -0,0 +1,495 @@
+//
+// CChartScene.cpp - retained chart layout implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "CChartScene.h"
+
+#include <algorithm>
+#include <cmath>
+
+/*
+** font sizes of the parts of a chart that don't follow the control's font size
+*/
+static const float fTitleFontSize = 11;
+static const float fAxisLabelFontSize = 9;
+static const float fLegendFontSize = 7;
+
+/*
+** legend items are blocks of iItemHeight with iMargin between them
+*/
+static const int iItemHeight = 18;
+static const int iMargin = 2;
+
+/*
+** double to int (rounds off instead of truncating)
+*/
+static int double2int(double in)
+{
+	return (int)(0.5 + in);
+}
+
+/*
+** measure a string for a layout
+** the width is padded a little so that GDI+ does not trim the last character, but is kept
+** within the layout
+*/
+static void measureText(const CChartScene::measureFunc &measure, const CChartScene::text &t,
+	float fLayoutWidth, float fLayoutHeight, float &fWidth, float &fHeight)
+{
+	fWidth = 0;
+	fHeight = 0;
+	measure(t.sText, t.fFontSize, fLayoutWidth, fLayoutHeight, fWidth, fHeight);
+
+	if (fWidth < fLayoutWidth)
+		fWidth = std::min(fWidth * 1.01f, fLayoutWidth);
+} // measureText
+
+/*
+** place a string of a given size within its layout rectangle
+** fPercH and fPercV position it from the left and top (0) to the right and bottom (100)
+** the string is made no larger than the layout
+*/
+static void alignText(CChartScene::text &t, float fWidth, float fHeight, float fPercH, float fPercV)
+{
+	const CChartScene::rect &rcLayout = t.rcLayout;
+
+	fWidth = std::min(fWidth, rcLayout.width);
+	fHeight = std::min(fHeight, rcLayout.height);
+
+	t.rcText.x = rcLayout.x + (fPercH * (rcLayout.width - fWidth)) / 100.0f;
+	t.rcText.y = rcLayout.y + (fPercV * (rcLayout.height - fHeight)) / 100.0f;
+	t.rcText.width = fWidth;
+	t.rcText.height = fHeight;
+} // alignText
+
+static CChartScene::rect makeRect(long left, long top, long right, long bottom)
+{
+	CChartScene::rect rc;
+	rc.x = static_cast<float>(left);
+	rc.y = static_cast<float>(top);
+	rc.width = static_cast<float>(right - left);
+	rc.height = static_cast<float>(bottom - top);
+	return rc;
+} // makeRect
+
+bool CChartScene::rect::intersects(const rect &rc) const
+{
+	if (width <= 0 || height <= 0 || rc.width <= 0 || rc.height <= 0)
+		return false;
+
+	return x < rc.right() && rc.x < right() && y < rc.bottom() && rc.y < bottom();
+} // intersects
+
+CChartScene::CChartScene() :
+	m_bValid(false)
+{
+}
+
+CChartScene::~CChartScene()
+{
+}
+
+bool CChartScene::IsValid(const chart &info) const
+{
+	return m_bValid &&
+		info.fWidth == m_info.fWidth &&
+		info.fHeight == m_info.fHeight &&
+		info.fFontSize == m_info.fFontSize &&
+		info.dFontScale == m_info.dFontScale &&
+		info.sFontName == m_info.sFontName;
+} // IsValid
+
+const CChartScene::frame &CChartScene::Frame() const
+{
+	return m_frame;
+}
+
+const CChartAxis &CChartScene::Axis() const
+{
+	return m_axis;
+}
+
+const std::vector<CChartScene::gridLine> &CChartScene::GridLines() const
+{
+	return m_vGridLines;
+}
+
+const std::vector<CChartScene::text> &CChartScene::Categories() const
+{
+	return m_vCategories;
+}
+
+const std::vector<CChartScene::bar> &CChartScene::Bars() const
+{
+	return m_vBars;
+}
+
+const CChartScene::pie &CChartScene::Pie() const
+{
+	return m_pie;
+}
+
+const std::vector<CChartScene::legendItem> &CChartScene::Legend() const
+{
+	return m_vLegend;
+}
+
+void CChartScene::clear(const chart &info)
+{
+	m_info = info;
+	m_frame = frame();
+	m_frame.rcClient.width = info.fWidth;
+	m_frame.rcClient.height = info.fHeight;
+	m_vGridLines.clear();
+	m_vCategories.clear();
+	m_vBars.clear();
+	m_pie = pie();
+	m_vLegend.clear();
+} // clear
+
+void CChartScene::buildFrame(const chart &info, const measureFunc &measure)
+{
+	const int iWidth = static_cast<int>(info.fWidth);
+	const int iHeight = static_cast<int>(info.fHeight);
+
+	float fWidth = 0, fHeight = 0;
+
+	// title, across the top
+	text &title = m_frame.title;
+	title.sText = info.sTitle;
+	title.fFontSize = fTitleFontSize;
+	title.rcLayout.x = 2;
+	title.rcLayout.y = 2;
+	title.rcLayout.width = static_cast<float>(iWidth - 4);
+
+	measureText(measure, title, title.rcLayout.width, 0, fWidth, fHeight);
+	title.rcLayout.height = fHeight;
+	alignText(title, fWidth, fHeight, 50, 50);
+
+	const float top = title.rcLayout.bottom();
+
+	// x-axis label, across the bottom
+	text &xAxis = m_frame.xAxisLabel;
+	xAxis.sText = info.sXaxisLabel;
+	xAxis.fFontSize = fAxisLabelFontSize;
+	xAxis.rcLayout.width = static_cast<float>(iWidth - 2 * 4);
+
+	measureText(measure, xAxis, xAxis.rcLayout.width, 0, fWidth, fHeight);
+	xAxis.rcLayout.x = 4;
+	xAxis.rcLayout.y = static_cast<float>(iHeight - 4) - fHeight;
+	xAxis.rcLayout.height = fHeight;
+	alignText(xAxis, fWidth, fHeight, 50, 50);
+
+	const float bottom = xAxis.rcLayout.y;
+
+	// y-axis label, up the left hand side
+	text &yAxis = m_frame.yAxisLabel;
+	yAxis.sText = info.sYaxisLabel;
+	yAxis.fFontSize = fAxisLabelFontSize;
+	yAxis.bVertical = true;
+
+	measureText(measure, yAxis, 0, 0, fWidth, fHeight);
+	yAxis.rcLayout.x = 4;
+	yAxis.rcLayout.y = top + 4.0f;
+	yAxis.rcLayout.width = fHeight;
+	yAxis.rcLayout.height = bottom - top - 4.0f * 2.0f;
+
+	// the string is centered on the layout before it is rotated
+	const float fCenterX = yAxis.rcLayout.x + yAxis.rcLayout.width / 2;
+	const float fCenterY = yAxis.rcLayout.y + yAxis.rcLayout.height / 2;
+	yAxis.rcText.x = fCenterX - fWidth / 2;
+	yAxis.rcText.y = fCenterY - fHeight / 2;
+	yAxis.rcText.width = fWidth;
+	yAxis.rcText.height = fHeight;
+
+	const float left = yAxis.rcLayout.right();
+
+	// legend, down the right hand side
+	float fLegendWidth = static_cast<float>(iWidth / 8);
+	fLegendWidth = fLegendWidth > 100.0f ? fLegendWidth : 100.0f;
+
+	m_frame.rcLegend.x = static_cast<float>(iWidth) - fLegendWidth - 4.0f;
+	m_frame.rcLegend.y = top + 4.0f;
+	m_frame.rcLegend.width = fLegendWidth;
+	m_frame.rcLegend.height = bottom - top - 4.0f * 2.0f;
+
+	const float right = m_frame.rcLegend.x;
+
+	// the plot, with room for the axis markers to its left and below it
+	const long iLeft = static_cast<long>(left);
+	const long iTop = static_cast<long>(top) + 8;
+	const long iRight = static_cast<long>(right);
+	const long iBottom = static_cast<long>(bottom);
+
+	int marker_Y_width = iWidth / 20;
+	marker_Y_width = marker_Y_width > 50 ? marker_Y_width : 50;
+
+	int marker_X_height = iHeight / 20;
+	marker_X_height = marker_X_height > 20 ? marker_X_height : 20;
+
+	// a chart too small for its frame gets an empty plot rather than one turned inside out
+	const long iPlotLeft = iLeft + marker_Y_width;
+	const long iPlotBottom = std::max(iTop, iBottom - marker_X_height);
+
+	m_frame.rcMarkers = makeRect(iLeft, iTop, std::max(iLeft, static_cast<long>(iWidth)), std::max(iTop, iBottom));
+	m_frame.rcPlot = makeRect(iPlotLeft, iTop, std::max(iPlotLeft, iRight), iPlotBottom);
+} // buildFrame
+
+void CChartScene::buildAxis(const chart &info, const std::vector<item> &vItems, const measureFunc &measure)
+{
+	if (vItems.empty())
+		return;
+
+	const rect &rcPlot = m_frame.rcPlot;
+	const rect &rcMarkers = m_frame.rcMarkers;
+
+	double dMin = vItems[0].dValue;
+	double dMax = vItems[0].dValue;
+
+	for (const auto &it : vItems)
+	{
+		dMin = std::fmin(it.dValue, dMin);
+		dMax = std::fmax(it.dValue, dMax);
+	}
+
+	// no more gridlines than there is room for, at a minimum spacing of iMinLineSpacing
+	const int iMinLineSpacing = 20;
+	const int iMaxLines = std::max(1, std::min(10, static_cast<int>(rcPlot.height) / iMinLineSpacing));
+
+	if (!info.bAutoScale || !m_axis.Calculate(dMin, dMax, iMaxLines))
+		m_axis.SetLimits(info.dLowerLimit, info.dUpperLimit, 10);
+
+	// gridlines and their labels
+	const double dySep = double(rcPlot.height) / m_axis.Lines();
+	const float fMarkerWidth = rcPlot.x - rcMarkers.x;
+
+	m_vGridLines.resize(m_axis.Lines() + 1);
+
+	for (int i = 0; i <= m_axis.Lines(); i++)
+	{
+		const double dY = (double)rcPlot.bottom() - (i * dySep);
+
+		gridLine &line = m_vGridLines[i];
+		line.fY = static_cast<float>(dY);
+		line.fLeft = rcPlot.x;
+		line.fRight = rcPlot.right();
+
+		text &label = line.label;
+		label.sText = m_axis.Label(i);
+		label.fFontSize = info.fFontSize;
+		label.rcLayout.x = rcMarkers.x;
+		label.rcLayout.y = static_cast<float>(dY);
+		label.rcLayout.width = fMarkerWidth;
+		label.rcLayout.height = static_cast<float>(dySep);
+
+		float fWidth = 0, fHeight = 0;
+		measureText(measure, label, label.rcLayout.width, label.rcLayout.height, fWidth, fHeight);
+
+		label.rcLayout.height = fHeight;
+		label.rcLayout.y = static_cast<float>(dY) - fHeight / 2.0f;
+		alignText(label, fWidth, fHeight, 50, 50);
+	}
+
+	const double dxSep = double(rcPlot.width) / (double)vItems.size();
+
+	// label every bar with its number if every label fits (important for aesthetics)
+	bool bFits = true;
+
+	for (const auto &it : vItems)
+	{
+		float fWidth = 0, fHeight = 0;
+		measure(std::to_wstring(it.iNumber), info.fFontSize, 0, 0, fWidth, fHeight);
+
+		if (double(fWidth) >= (dxSep / 1.5))
+		{
+			bFits = false;
+			break;
+		}
+	}
+
+	const double dLowerLimit = m_axis.Lower();
+	const double dUpperLimit = m_axis.Upper();
+
+	if (bFits)
+		m_vCategories.resize(vItems.size());
+
+	m_vBars.resize(vItems.size());
+
+	for (size_t i = 0; i < vItems.size(); i++)
+	{
+		const long iX = static_cast<long>(rcPlot.x) + long(i * dxSep);
+		const rect rcColumn = makeRect(iX, static_cast<long>(rcPlot.bottom()),
+			iX + long(dxSep), static_cast<long>(rcMarkers.bottom()));
+
+		if (bFits)
+		{
+			text &label = m_vCategories[i];
+			label.sText = std::to_wstring(vItems[i].iNumber);
+			label.fFontSize = info.fFontSize;
+			label.rcLayout = rcColumn;
+
+			float fWidth = 0, fHeight = 0;
+			measureText(measure, label, label.rcLayout.width, label.rcLayout.height, fWidth, fHeight);
+
+			label.rcLayout.height = fHeight;
+			alignText(label, fWidth, fHeight, 50, 50);
+		}
+
+		double dRatioOfRange = (vItems[i].dValue - dLowerLimit) / (dUpperLimit - dLowerLimit);
+
+		// don't permit negative
+		if (dRatioOfRange < 0)
+			dRatioOfRange = 0;
+
+		// don't permit excess
+		if (dRatioOfRange > 1)
+			dRatioOfRange = 1;
+
+		const long iBottom = static_cast<long>(rcPlot.bottom());
+		const long iTop = double2int((double)iBottom - dRatioOfRange * double(rcPlot.height));
+
+		bar &b = m_vBars[i];
+		b.rc = makeRect(double2int((double)rcColumn.x + (dxSep / 4)), iTop,
+			double2int((double)rcColumn.right() - (dxSep / 4)), iBottom);
+		b.sTooltip = vItems[i].sLabel + L" - " + CChartAxis::Format(vItems[i].dValue, 1);
+	}
+} // buildAxis
+
+void CChartScene::buildLegend(const rect &rcLegend, float fFitHeight,
+	const std::vector<std::wstring> &vLabels, const measureFunc &measure)
+{
+	// check if items fit in the given space
+	if (((iItemHeight + iMargin) * static_cast<int>(vLabels.size())) > static_cast<int>(fFitHeight))
+		return;
+
+	m_vLegend.resize(vLabels.size());
+
+	const long iLeftBorder = static_cast<long>(rcLegend.x);
+	const long iRight = static_cast<long>(rcLegend.right()) - 5;
+	long iBottom = static_cast<long>(rcLegend.bottom());
+
+	// the first item goes at the top, so work up from the bottom
+	for (size_t i = vLabels.size(); i-- > 0; )
+	{
+		legendItem &item = m_vLegend[i];
+		item.rcBlock = makeRect(iLeftBorder, iBottom - iItemHeight, iLeftBorder + iItemHeight, iBottom);
+
+		text &label = item.label;
+		label.sText = vLabels[i];
+		label.fFontSize = fLegendFontSize;
+		label.rcLayout = makeRect(iLeftBorder + iItemHeight + 5, iBottom - iItemHeight, iRight, iBottom);
+
+		float fWidth = 0, fHeight = 0;
+		measureText(measure, label, label.rcLayout.width, label.rcLayout.height, fWidth, fHeight);
+		alignText(label, fWidth, fHeight, 0, 50);
+
+		item.rcHot = makeRect(iLeftBorder, iBottom - iItemHeight, iRight, iBottom);
+
+		iBottom -= (iItemHeight + iMargin);
+	}
+} // buildLegend
+
+void CChartScene::BuildBarChart(const chart &info, const std::vector<item> &vItems, const measureFunc &measure)
+{
+	clear(info);
+	buildFrame(info, measure);
+	buildAxis(info, vItems, measure);
+
+	std::vector<std::wstring> vLabels;
+	vLabels.reserve(vItems.size());
+
+	for (const auto &it : vItems)
+		vLabels.push_back(it.sLabel);
+
+	buildLegend(m_frame.rcLegend, m_frame.rcPlot.height, vLabels, measure);
+	m_bValid = true;
+} // BuildBarChart
+
+void CChartScene::BuildLineChart(const chart &info, const std::vector<std::wstring> &vSeries,
+	const measureFunc &measure)
+{
+	clear(info);
+	buildFrame(info, measure);
+	buildLegend(m_frame.rcLegend, m_frame.rcPlot.height, vSeries, measure);
+	m_bValid = true;
+} // BuildLineChart
+
+void CChartScene::BuildPieChart(const chart &info, const std::vector<item> &vItems, const measureFunc &measure)
+{
+	clear(info);
+
+	const int iBorderWidth = 1;
+
+	// the chart sits inside the border
+	const long iLeft = iBorderWidth;
+	const long iTop = iBorderWidth;
+	const long iRight = static_cast<long>(info.fWidth) - iBorderWidth;
+	const long iBottom = static_cast<long>(info.fHeight) - iBorderWidth;
+
+	// legend, down the right hand side
+	float fLegendWidth = static_cast<float>(iRight - iLeft) / 8;
+	fLegendWidth = fLegendWidth > 100.0f ? fLegendWidth : 100.0f;
+
+	m_frame.rcLegend.x = static_cast<float>(iRight) - fLegendWidth - 4.0f;
+	m_frame.rcLegend.y = static_cast<float>(iTop) + 4.0f;
+	m_frame.rcLegend.width = fLegendWidth;
+	m_frame.rcLegend.height = static_cast<float>(iBottom - iTop) - 4.0f * 2.0f;
+
+	m_frame.rcPlot = makeRect(iLeft, iTop, iRight, iBottom);
+
+	// the pie, as large as it can be to the left of the legend
+	const long iPieRight = static_cast<long>(m_frame.rcLegend.x);
+	const int iWidth = iPieRight - iLeft;
+	const int iHeight = iBottom - iTop;
+	const int side = std::min(iWidth, iHeight);
+
+	m_pie.rc.x = static_cast<float>(iLeft + (iWidth - side) / 2);
+	m_pie.rc.y = static_cast<float>(iTop + (iHeight - side) / 2);
+	m_pie.rc.width = static_cast<float>(side);
+	m_pie.rc.height = static_cast<float>(side);
+
+	double dTotal = 0;
+
+	for (const auto &it : vItems)
+		dTotal += it.dValue;
+
+	m_pie.bEmpty = !(dTotal > 0);
+	m_pie.vSlices.resize(vItems.size());
+
+	float angle = 270;
+
+	for (size_t i = 0; i < vItems.size(); i++)
+	{
+		slice &s = m_pie.vSlices[i];
+		s.fAngle = angle;
+		s.fSweep = 0;
+
+		double dPercentage = 0;
+
+		if (dTotal > 0)
+		{
+			s.fSweep = float(360) * float(vItems[i].dValue) / float(dTotal);
+			dPercentage = 100 * vItems[i].dValue / dTotal;
+		}
+
+		// tooltip in the form "itemLabel (percentage%)"
+		s.sTooltip = vItems[i].sLabel + L" (" + CChartAxis::Format(dPercentage, 1) + L"%)";
+
+		angle += s.fSweep;
+	}
+
+	std::vector<std::wstring> vLabels;
+	vLabels.reserve(vItems.size());
+
+	for (const auto &it : vItems)
+		vLabels.push_back(it.sLabel);
+
+	buildLegend(m_frame.rcLegend, m_frame.rcLegend.height, vLabels, measure);
+	m_bValid = true;
+} // BuildPieChart
@@ -0,0 +1,195 @@
+//
+// CChartScene.h - retained chart layout interface
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include "../CChartAxis/CChartAxis.h"
+
+/*
+** CChartScene - the layout of a chart control, kept between paints
+** holds the geometry of everything a chart draws (title, axis labels, gridlines, bars, pie
+** slices and the legend) together with the strings it draws, already formatted, so that a
+** paint only has to render it; the scene is built again only when the data, the size of the
+** control or its fonts change
+** hover states are not part of the scene: a chart renders its items hot or not from the
+** same geometry, so a hover change only needs the affected items repainted
+** text is measured through a function supplied by the caller
+** the class has no platform dependencies
+*/
+class CChartScene
+{
+public:
+	struct rect
+	{
+		float x = 0;
+		float y = 0;
+		float width = 0;
+		float height = 0;
+
+		float right() const { return x + width; }
+		float bottom() const { return y + height; }
+
+		// whether two rectangles overlap; rectangles with no area overlap nothing
+		bool intersects(const rect &rc) const;
+	};
+
+	// a string and where it is drawn
+	struct text
+	{
+		std::wstring sText;
+		float fFontSize = 0;
+		rect rcLayout;			// the space given to the string
+		rect rcText;			// the string, aligned within rcLayout
+		bool bVertical = false;	// drawn rotated 90 degrees anti-clockwise about the center of
+								// rcLayout; rcText is then the string before rotation
+	};
+
+	// horizontal gridline of the value axis and its label
+	struct gridLine
+	{
+		float fY = 0;
+		float fLeft = 0;
+		float fRight = 0;
+		text label;
+	};
+
+	struct bar
+	{
+		rect rc;
+		std::wstring sTooltip;
+	};
+
+	// pie chart slice, with angles in degrees clockwise from the x-axis as in GDI+
+	struct slice
+	{
+		float fAngle = 0;
+		float fSweep = 0;
+		std::wstring sTooltip;
+	};
+
+	struct legendItem
+	{
+		rect rcBlock;	// the colored block
+		text label;
+		rect rcHot;		// the block and the label, for hit testing
+	};
+
+	// what a chart is laid out for
+	struct chart
+	{
+		float fWidth = 0;			// client area
+		float fHeight = 0;
+		std::wstring sFontName;
+		float fFontSize = 9;		// font size of the axis markers
+		double dFontScale = 1;		// scale the fonts are created for
+		std::wstring sTitle;
+		std::wstring sXaxisLabel;
+		std::wstring sYaxisLabel;
+		bool bAutoScale = true;
+		double dLowerLimit = 0;		// value axis limits when not autoscaling
+		double dUpperLimit = 0;
+	};
+
+	struct item
+	{
+		double dValue = 0;
+		int iNumber = 0;
+		std::wstring sLabel;
+	};
+
+	/*
+	** measures a string drawn with a given font size within a layout of a given width and height,
+	** where 0 means no limit, and writes back the width and height of the string
+	*/
+	typedef std::function<void(const std::wstring &sText, float fFontSize,
+		float fLayoutWidth, float fLayoutHeight, float &fWidth, float &fHeight)> measureFunc;
+
+	// the frame of a bar or line chart: everything but the plot and the legend items
+	struct frame
+	{
+		rect rcClient;
+		text title;
+		text xAxisLabel;
+		text yAxisLabel;
+		rect rcLegend;		// space for the legend
+		rect rcMarkers;		// the plot and the axis markers around it
+		rect rcPlot;		// the plot itself
+	};
+
+	struct pie
+	{
+		rect rc;			// the square the pie is drawn in
+		std::vector<slice> vSlices;
+		bool bEmpty = true;	// nothing to show; the values add up to zero
+	};
+
+	CChartScene();
+	~CChartScene();
+
+	/*
+	** whether the scene was built for a chart of this size and these fonts
+	** the data is not compared; a chart builds the scene again itself when its data changes,
+	** along with the hit testing information it keeps (see bInfoCaptured in cui_rawImpl)
+	*/
+	bool IsValid(const chart &info) const;
+
+	/*
+	** lay out a bar chart, one bar per item
+	** the legend is laid out for the item labels if it fits
+	*/
+	void BuildBarChart(const chart &info, const std::vector<item> &vItems, const measureFunc &measure);
+
+	/*
+	** lay out a pie chart, one slice per item, starting at the top and going clockwise
+	** the title and axis labels are not used
+	*/
+	void BuildPieChart(const chart &info, const std::vector<item> &vItems, const measureFunc &measure);
+
+	/*
+	** lay out the frame of a line chart and its legend
+	** the plot is drawn by the line chart itself, in Frame().rcMarkers
+	*/
+	void BuildLineChart(const chart &info, const std::vector<std::wstring> &vSeries,
+		const measureFunc &measure);
+
+	const frame &Frame() const;
+	const CChartAxis &Axis() const;
+	const std::vector<gridLine> &GridLines() const;
+
+	// labels under the bars; empty if they don't all fit
+	const std::vector<text> &Categories() const;
+
+	const std::vector<bar> &Bars() const;
+	const pie &Pie() const;
+
+	// one item per bar, slice or series; empty if they don't all fit
+	const std::vector<legendItem> &Legend() const;
+
+private:
+	void clear(const chart &info);
+	void buildFrame(const chart &info, const measureFunc &measure);
+	void buildAxis(const chart &info, const std::vector<item> &vItems, const measureFunc &measure);
+	void buildLegend(const rect &rcLegend, float fFitHeight, const std::vector<std::wstring> &vLabels,
+		const measureFunc &measure);
+
+	bool m_bValid;
+	chart m_info;	// what the scene was built for
+
+	frame m_frame;
+	CChartAxis m_axis;
+	std::vector<gridLine> m_vGridLines;
+	std::vector<text> m_vCategories;
+	std::vector<bar> m_vBars;
+	pie m_pie;
+	std::vector<legendItem> m_vLegend;
+}; // CChartScene
@@ -0,0 +1,182 @@
+//
+// CChartSceneRender.cpp - chart layout rendering implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "CChartSceneRender.h"
+#include "../../clrAdjust/clrAdjust.h"
+
+#include <cmath>
+
+CChartScene::measureFunc CChartSceneRender::Measurer(Gdiplus::Graphics &graphics, CGdiPlusCache &cache,
+	const std::basic_string<TCHAR> &sFontName)
+{
+	return [&graphics, &cache, sFontName](const std::wstring &sText, float fFontSize,
+		float fLayoutWidth, float fLayoutHeight, float &fWidth, float &fHeight)
+	{
+		Gdiplus::Font* p_font = cache.GetFont(sFontName, fFontSize);
+
+		Gdiplus::RectF layoutRect(0, 0, fLayoutWidth, fLayoutHeight);
+		Gdiplus::RectF text_rect;
+		graphics.MeasureString(sText.c_str(), -1, p_font, layoutRect, &text_rect);
+
+		fWidth = text_rect.Width;
+		fHeight = text_rect.Height;
+	};
+} // Measurer
+
+RECT CChartSceneRender::Bounds(const CChartScene::rect &rc, int iMargin)
+{
+	RECT rect;
+	rect.left = static_cast<LONG>(std::floor(rc.x)) - iMargin;
+	rect.top = static_cast<LONG>(std::floor(rc.y)) - iMargin;
+	rect.right = static_cast<LONG>(std::ceil(rc.right())) + iMargin;
+	rect.bottom = static_cast<LONG>(std::ceil(rc.bottom())) + iMargin;
+	return rect;
+} // Bounds
+
+CChartScene::rect CChartSceneRender::Convert(const RECT &rc)
+{
+	CChartScene::rect rect;
+	rect.x = static_cast<float>(rc.left);
+	rect.y = static_cast<float>(rc.top);
+	rect.width = static_cast<float>(rc.right - rc.left);
+	rect.height = static_cast<float>(rc.bottom - rc.top);
+	return rect;
+} // Convert
+
+Gdiplus::RectF CChartSceneRender::Convert(const CChartScene::rect &rc)
+{
+	return Gdiplus::RectF(rc.x, rc.y, rc.width, rc.height);
+} // Convert
+
+void CChartSceneRender::DrawLabel(Gdiplus::Graphics &graphics, CGdiPlusCache &cache,
+	const std::basic_string<TCHAR> &sFontName, const CChartScene::text &t, COLORREF clrText,
+	Gdiplus::StringTrimming trimming, const CChartScene::rect &rcPaint)
+{
+	if (t.sText.empty() || !t.rcLayout.intersects(rcPaint))
+		return;
+
+	Gdiplus::Font* p_font = cache.GetFont(sFontName, t.fFontSize);
+	Gdiplus::SolidBrush* p_text_brush = cache.GetBrush(clrText);
+
+	if (t.bVertical)
+	{
+		// rotate about the center of the layout
+		Gdiplus::REAL x = t.rcLayout.x + (t.rcLayout.width / 2);
+		Gdiplus::REAL y = t.rcLayout.y + (t.rcLayout.height / 2);
+
+		graphics.TranslateTransform(x, y);		// set rotation point
+		graphics.RotateTransform(-90);			// rotate text
+		graphics.TranslateTransform(-x, -y);	// reset translate transform
+
+		Gdiplus::PointF pt(t.rcText.x, t.rcText.y);
+		graphics.DrawString(t.sText.c_str(), (INT)t.sText.length(), p_font, pt, p_text_brush);
+		graphics.ResetTransform();
+		return;
+	}
+
+	Gdiplus::StringFormat format;
+	format.SetAlignment(Gdiplus::StringAlignment::StringAlignmentNear);
+	format.SetTrimming(trimming);
+	format.SetFormatFlags(Gdiplus::StringFormatFlags::StringFormatFlagsNoWrap);
+
+	graphics.DrawString(t.sText.c_str(), -1, p_font, Convert(t.rcText), &format, p_text_brush);
+} // DrawLabel
+
+void CChartSceneRender::DrawFrame(Gdiplus::Graphics &graphics, CGdiPlusCache &cache,
+	const std::basic_string<TCHAR> &sFontName, const CChartScene &scene, bool bBorder,
+	const CChartScene::rect &rcPaint)
+{
+	const CChartScene::frame &frame = scene.Frame();
+
+	if (bBorder)
+	{
+		// one stroke, left to the clip to cut down to the paint
+		CChartScene::rect rcBorder = frame.rcClient;
+		rcBorder.x += 1;
+		rcBorder.y += 1;
+		rcBorder.width -= 2;
+		rcBorder.height -= 2;
+
+		Gdiplus::Color color;
+		color.SetFromCOLORREF(RGB(200, 200, 200));
+		Gdiplus::Pen pen(color, 1);
+		pen.SetAlignment(Gdiplus::PenAlignment::PenAlignmentCenter);
+		graphics.DrawRectangle(&pen, Convert(rcBorder));
+	}
+
+	DrawLabel(graphics, cache, sFontName, frame.title, RGB(0, 120, 200),
+		Gdiplus::StringTrimming::StringTrimmingEllipsisCharacter, rcPaint);
+
+	DrawLabel(graphics, cache, sFontName, frame.xAxisLabel, RGB(0, 0, 0),
+		Gdiplus::StringTrimming::StringTrimmingEllipsisCharacter, rcPaint);
+
+	DrawLabel(graphics, cache, sFontName, frame.yAxisLabel, RGB(0, 0, 0),
+		Gdiplus::StringTrimming::StringTrimmingEllipsisCharacter, rcPaint);
+} // DrawFrame
+
+void CChartSceneRender::DrawAxis(Gdiplus::Graphics &graphics, CGdiPlusCache &cache,
+	const std::basic_string<TCHAR> &sFontName, const CChartScene &scene,
+	const CChartScene::rect &rcPaint)
+{
+	Gdiplus::Color color;
+	color.SetFromCOLORREF(RGB(200, 200, 200));
+	Gdiplus::Pen pen(color, 1.0f);
+	pen.SetAlignment(Gdiplus::PenAlignment::PenAlignmentCenter);
+
+	for (const auto &it : scene.GridLines())
+	{
+		// a gridline is a pixel high
+		CChartScene::rect rcLine;
+		rcLine.x = it.fLeft;
+		rcLine.y = it.fY - 1;
+		rcLine.width = it.fRight - it.fLeft;
+		rcLine.height = 2;
+
+		if (rcLine.intersects(rcPaint))
+			graphics.DrawLine(&pen, Gdiplus::PointF(it.fLeft, it.fY), Gdiplus::PointF(it.fRight, it.fY));
+
+		DrawLabel(graphics, cache, sFontName, it.label, RGB(0, 0, 0),
+			Gdiplus::StringTrimming::StringTrimmingEllipsisCharacter, rcPaint);
+	}
+
+	for (const auto &it : scene.Categories())
+		DrawLabel(graphics, cache, sFontName, it, RGB(0, 0, 0),
+			Gdiplus::StringTrimming::StringTrimmingEllipsisCharacter, rcPaint);
+} // DrawAxis
+
+void CChartSceneRender::DrawLegendItem(Gdiplus::Graphics &graphics, CGdiPlusCache &cache,
+	const std::basic_string<TCHAR> &sFontName, const CChartScene::legendItem &item,
+	COLORREF clr, bool bHot, bool bPressed, const CChartScene::rect &rcPaint)
+{
+	if (!item.rcHot.intersects(rcPaint))
+		return;
+
+	if (bHot)
+	{
+		if (bPressed)
+			clr = clrDarken(clr, 40);
+		else
+			clr = clrDarken(clr, 25);
+	}
+
+	// paint item block
+	Gdiplus::RectF rect_block = Convert(item.rcBlock);
+
+	if (bHot)
+		rect_block.Inflate(-4, -4);
+	else
+		rect_block.Inflate(-5, -5);
+
+	graphics.FillRectangle(cache.GetBrush(clr), rect_block);
+
+	// write text
+	DrawLabel(graphics, cache, sFontName, item.label, RGB(0, 0, 0),
+		Gdiplus::StringTrimming::StringTrimmingWord, rcPaint);
+} // DrawLegendItem
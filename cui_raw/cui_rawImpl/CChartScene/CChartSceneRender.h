@@ -0,0 +1,59 @@
+//
+// CChartSceneRender.h - chart layout rendering interface
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <Windows.h>
+#include <GdiPlus.h>
+#include "CChartScene.h"
+#include "../CGdiPlusCache/CGdiPlusCache.h"
+
+/*
+** CChartSceneRender - draws the parts of a CChartScene that the charts have in common
+** every function takes the rectangle being painted and skips what lies outside it, so that a
+** chart can repaint just the part of itself that changed
+*/
+class CChartSceneRender
+{
+public:
+	/*
+	** measure strings with GDI+ in the font of a chart control
+	** graphics and cache must outlive the returned function
+	*/
+	static CChartScene::measureFunc Measurer(Gdiplus::Graphics &graphics, CGdiPlusCache &cache,
+		const std::basic_string<TCHAR> &sFontName);
+
+	// the pixels a scene rectangle touches, grown by iMargin on every side
+	static RECT Bounds(const CChartScene::rect &rc, int iMargin = 0);
+
+	static CChartScene::rect Convert(const RECT &rc);
+
+	static Gdiplus::RectF Convert(const CChartScene::rect &rc);
+
+	// draw a string of the scene
+	static void DrawLabel(Gdiplus::Graphics &graphics, CGdiPlusCache &cache,
+		const std::basic_string<TCHAR> &sFontName, const CChartScene::text &t, COLORREF clrText,
+		Gdiplus::StringTrimming trimming, const CChartScene::rect &rcPaint);
+
+	// draw the border, title and axis labels of a bar or line chart
+	static void DrawFrame(Gdiplus::Graphics &graphics, CGdiPlusCache &cache,
+		const std::basic_string<TCHAR> &sFontName, const CChartScene &scene, bool bBorder,
+		const CChartScene::rect &rcPaint);
+
+	// draw the gridlines of the value axis with their labels, and the category labels
+	static void DrawAxis(Gdiplus::Graphics &graphics, CGdiPlusCache &cache,
+		const std::basic_string<TCHAR> &sFontName, const CChartScene &scene,
+		const CChartScene::rect &rcPaint);
+
+	// draw a legend item; a hot item is darker and its block larger
+	static void DrawLegendItem(Gdiplus::Graphics &graphics, CGdiPlusCache &cache,
+		const std::basic_string<TCHAR> &sFontName, const CChartScene::legendItem &item,
+		COLORREF clr, bool bHot, bool bPressed, const CChartScene::rect &rcPaint);
+}; // CChartSceneRender
@@ -0,0 +1,101 @@
+//
+// CGdiPlusCache.cpp - GDI+ font and brush cache implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "CGdiPlusCache.h"
+
+CGdiPlusCache::CGdiPlusCache(Gdiplus::PrivateFontCollection &font_collection) :
+	m_font_collection(font_collection)
+{
+}
+
+CGdiPlusCache::~CGdiPlusCache()
+{
+	Clear();
+}
+
+Gdiplus::Font* CGdiPlusCache::GetFont(const std::basic_string<TCHAR> &sFontName,
+	Gdiplus::REAL size,
+	INT style)
+{
+	const font_key key(sFontName, size, style);
+
+	auto it = m_fonts.find(key);
+
+	if (it != m_fonts.end())
+	{
+		m_stats.iFontHits++;
+		return it->second;
+	}
+
+	m_stats.iFontMisses++;
+
+	// try the installed fonts first
+	Gdiplus::FontFamily ffm(sFontName.c_str());
+	Gdiplus::Font* p_font = new Gdiplus::Font(&ffm, size, style);
+
+	if (p_font->GetLastStatus() != Gdiplus::Status::Ok)
+	{
+		// try the private font collection
+		delete p_font;
+		p_font = nullptr;
+		p_font = new Gdiplus::Font(sFontName.c_str(),
+			size, style, Gdiplus::UnitPoint, &m_font_collection);
+	}
+
+	m_fonts[key] = p_font;
+	return p_font;
+} // GetFont
+
+Gdiplus::SolidBrush* CGdiPlusCache::GetBrush(COLORREF clr)
+{
+	auto it = m_brushes.find(clr);
+
+	if (it != m_brushes.end())
+	{
+		m_stats.iBrushHits++;
+		return it->second;
+	}
+
+	m_stats.iBrushMisses++;
+
+	Gdiplus::Color color;
+	color.SetFromCOLORREF(clr);
+
+	Gdiplus::SolidBrush* p_brush = new Gdiplus::SolidBrush(color);
+	m_brushes[clr] = p_brush;
+	return p_brush;
+} // GetBrush
+
+void CGdiPlusCache::Clear()
+{
+	for (auto &it : m_fonts)
+	{
+		delete it.second;
+		it.second = nullptr;
+	}
+
+	m_fonts.clear();
+
+	for (auto &it : m_brushes)
+	{
+		delete it.second;
+		it.second = nullptr;
+	}
+
+	m_brushes.clear();
+} // Clear
+
+CGdiPlusCache::stats CGdiPlusCache::GetStats() const
+{
+	stats m_stats_ = m_stats;
+	m_stats_.iFonts = m_fonts.size();
+	m_stats_.iBrushes = m_brushes.size();
+	return m_stats_;
+} // GetStats
@@ -0,0 +1,80 @@
+//
+// CGdiPlusCache.h - GDI+ font and brush cache interface
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <Windows.h>
+#include <GdiPlus.h>
+#include <string>
+#include <map>
+#include <tuple>
+
+/*
+** CGdiPlusCache - GDI+ font and brush cache
+** fonts and brushes are created the first time they are asked for and kept until the
+** cache is cleared, so that paint handlers don't have to create and destroy them on
+** every WM_PAINT
+** objects returned are owned by the cache and must not be deleted or modified
+** the cache is not thread safe; use it from the UI thread only
+*/
+class CGdiPlusCache
+{
+public:
+	CGdiPlusCache(Gdiplus::PrivateFontCollection &font_collection);
+	~CGdiPlusCache();
+
+	struct stats
+	{
+		unsigned long long iFontHits = 0;
+		unsigned long long iFontMisses = 0;
+		unsigned long long iBrushHits = 0;
+		unsigned long long iBrushMisses = 0;
+		size_t iFonts = 0;		// number of fonts in the cache
+		size_t iBrushes = 0;	// number of brushes in the cache
+	};
+
+	/*
+	** get a font
+	** the font is looked up among the installed fonts first and then in the private
+	** font collection, the same way the paint handlers do it
+	** size is in points, so a cached font does not depend on the DPI of the device it draws on
+	*/
+	Gdiplus::Font* GetFont(const std::basic_string<TCHAR> &sFontName,
+		Gdiplus::REAL size,
+		INT style = Gdiplus::FontStyle::FontStyleRegular);
+
+	/*
+	** get a solid brush
+	*/
+	Gdiplus::SolidBrush* GetBrush(COLORREF clr);
+
+	/*
+	** destroy all cached fonts and brushes
+	** call this whenever the font collection changes
+	** hit and miss counters are kept
+	*/
+	void Clear();
+
+	// get hit and miss counters
+	stats GetStats() const;
+
+private:
+	Gdiplus::PrivateFontCollection &m_font_collection;
+
+	// (font name, size, style)
+	typedef std::tuple<std::basic_string<TCHAR>, Gdiplus::REAL, INT> font_key;
+
+	std::map<font_key, Gdiplus::Font*> m_fonts;
+	std::map<COLORREF, Gdiplus::SolidBrush*> m_brushes;
+	stats m_stats;
+
+	CGdiPlusCache(const CGdiPlusCache&) = delete;
+	CGdiPlusCache& operator=(const CGdiPlusCache&) = delete;
+}; // CGdiPlusCache
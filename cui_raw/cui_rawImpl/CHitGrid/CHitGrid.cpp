@@ -0,0 +1,155 @@
+//
+// CHitGrid.cpp - hit test grid implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "CHitGrid.h"
+
+/*
+** limits on the size of the grid
+** cells start at iMinCellSize and double until the grid has no more than iMaxCells cells
+*/
+static const long iMinCellSize = 32;
+static const long iMaxCells = 64 * 64;
+
+CHitGrid::CHitGrid() :
+	m_iLeft(0),
+	m_iTop(0),
+	m_iCellSize(iMinCellSize),
+	m_iColumns(0),
+	m_iRows(0)
+{
+}
+
+CHitGrid::~CHitGrid()
+{
+}
+
+void CHitGrid::Clear()
+{
+	m_vItems.clear();
+	m_vCellStart.clear();
+	m_vCellItems.clear();
+	m_iColumns = m_iRows = 0;
+}
+
+void CHitGrid::Add(const rect &rc, size_t iID)
+{
+	if (rc.right <= rc.left || rc.bottom <= rc.top)
+		return;
+
+	item it;
+	it.rc = rc;
+	it.iID = iID;
+	m_vItems.push_back(it);
+}
+
+void CHitGrid::Build()
+{
+	m_vCellStart.clear();
+	m_vCellItems.clear();
+	m_iColumns = m_iRows = 0;
+
+	if (m_vItems.empty())
+		return;
+
+	// bounds of all the rectangles
+	rect bounds = m_vItems[0].rc;
+
+	for (const auto &it : m_vItems)
+	{
+		if (it.rc.left < bounds.left) bounds.left = it.rc.left;
+		if (it.rc.top < bounds.top) bounds.top = it.rc.top;
+		if (it.rc.right > bounds.right) bounds.right = it.rc.right;
+		if (it.rc.bottom > bounds.bottom) bounds.bottom = it.rc.bottom;
+	}
+
+	m_iLeft = bounds.left;
+	m_iTop = bounds.top;
+	m_iCellSize = iMinCellSize;
+
+	for (;;)
+	{
+		m_iColumns = (bounds.right - bounds.left + m_iCellSize - 1) / m_iCellSize;
+		m_iRows = (bounds.bottom - bounds.top + m_iCellSize - 1) / m_iCellSize;
+
+		if (m_iColumns * m_iRows <= iMaxCells)
+			break;
+
+		m_iCellSize *= 2;
+	}
+
+	const size_t iCells = static_cast<size_t>(m_iColumns * m_iRows);
+
+	// count the items in each cell, then place them; items are placed in the order they
+	// were added so that queries return them in that order
+	m_vCellStart.assign(iCells + 1, 0);
+
+	auto cellRange = [&](const rect &rc, long &c0, long &c1, long &r0, long &r1)
+	{
+		c0 = (rc.left - m_iLeft) / m_iCellSize;
+		c1 = (rc.right - 1 - m_iLeft) / m_iCellSize;
+		r0 = (rc.top - m_iTop) / m_iCellSize;
+		r1 = (rc.bottom - 1 - m_iTop) / m_iCellSize;
+	};
+
+	for (const auto &it : m_vItems)
+	{
+		long c0, c1, r0, r1;
+		cellRange(it.rc, c0, c1, r0, r1);
+
+		for (long r = r0; r <= r1; r++)
+			for (long c = c0; c <= c1; c++)
+				m_vCellStart[static_cast<size_t>(r * m_iColumns + c) + 1]++;
+	}
+
+	for (size_t c = 0; c < iCells; c++)
+		m_vCellStart[c + 1] += m_vCellStart[c];
+
+	m_vCellItems.resize(m_vCellStart[iCells]);
+	std::vector<size_t> vNext(m_vCellStart.begin(), m_vCellStart.end() - 1);
+
+	for (size_t i = 0; i < m_vItems.size(); i++)
+	{
+		long c0, c1, r0, r1;
+		cellRange(m_vItems[i].rc, c0, c1, r0, r1);
+
+		for (long r = r0; r <= r1; r++)
+			for (long c = c0; c <= c1; c++)
+				m_vCellItems[vNext[static_cast<size_t>(r * m_iColumns + c)]++] = i;
+	}
+}
+
+void CHitGrid::Query(long x, long y, std::vector<size_t> &vIDs) const
+{
+	vIDs.clear();
+
+	if (m_iColumns == 0 || x < m_iLeft || y < m_iTop)
+		return;
+
+	const long c = (x - m_iLeft) / m_iCellSize;
+	const long r = (y - m_iTop) / m_iCellSize;
+
+	if (c >= m_iColumns || r >= m_iRows)
+		return;
+
+	const size_t iCell = static_cast<size_t>(r * m_iColumns + c);
+
+	for (size_t i = m_vCellStart[iCell]; i < m_vCellStart[iCell + 1]; i++)
+	{
+		const item &it = m_vItems[m_vCellItems[i]];
+
+		if (x >= it.rc.left && x < it.rc.right && y >= it.rc.top && y < it.rc.bottom)
+			vIDs.push_back(it.iID);
+	}
+}
+
+size_t CHitGrid::Size() const
+{
+	return m_vItems.size();
+}
@@ -0,0 +1,76 @@
+//
+// CHitGrid.h - hit test grid interface
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+/*
+** CHitGrid - uniform grid over a set of rectangles, for finding the rectangles under a point
+** without testing every one of them
+** the rectangles are added, then laid out with Build, after which Query returns the
+** rectangles that contain a point by looking at a single cell of the grid
+** rectangles are half open, as with PtInRect: the right and bottom edges are outside
+** the class has no platform dependencies
+*/
+class CHitGrid
+{
+public:
+	struct rect
+	{
+		long left = 0;
+		long top = 0;
+		long right = 0;
+		long bottom = 0;
+	};
+
+	CHitGrid();
+	~CHitGrid();
+
+	// remove all rectangles
+	void Clear();
+
+	/*
+	** add a rectangle; iID is what Query returns for it
+	** empty rectangles are ignored
+	*/
+	void Add(const rect &rc, size_t iID);
+
+	// lay the rectangles out in the grid; to be called after adding them and before querying
+	void Build();
+
+	/*
+	** get the IDs of the rectangles that contain a point, in the order the rectangles were added
+	** vIDs is cleared first
+	*/
+	void Query(long x, long y, std::vector<size_t> &vIDs) const;
+
+	// number of rectangles
+	size_t Size() const;
+
+private:
+	struct item
+	{
+		rect rc;
+		size_t iID;
+	};
+
+	std::vector<item> m_vItems;
+
+	// the grid: the items in cell c are m_vCellItems[m_vCellStart[c]] to
+	// m_vCellItems[m_vCellStart[c + 1] - 1], in the order they were added
+	std::vector<size_t> m_vCellStart;
+	std::vector<size_t> m_vCellItems;
+
+	long m_iLeft, m_iTop;	// top left corner of the grid
+	long m_iCellSize;		// width and height of a cell
+	long m_iColumns, m_iRows;
+}; // CHitGrid
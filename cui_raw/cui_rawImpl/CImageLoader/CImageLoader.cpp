@@ -0,0 +1,414 @@
+//
+// CImageLoader.cpp - background image loader implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "CImageLoader.h"
+
+#include <algorithm>
+#include <cmath>
+
+CImageLoader::CImageLoader(decodeFunc decode, notifyFunc notify,
+	size_t iThreads, size_t iMaxInFlight) :
+	m_decode(decode),
+	m_notify(notify),
+	m_iThreads(iThreads),
+	m_iMaxInFlight(std::max<size_t>(iMaxInFlight, 1))
+{
+	if (m_iThreads == 0)
+	{
+		// leave a processor for the UI thread, and don't let decoding take over the machine
+		const size_t iProcessors = std::thread::hardware_concurrency();
+		m_iThreads = std::min<size_t>(std::max<size_t>(iProcessors, 2) - 1, 4);
+	}
+}
+
+CImageLoader::~CImageLoader()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStop = true;
+		m_pending.clear();
+	}
+
+	m_cvWork.notify_all();
+
+	// a worker in the middle of an image finishes it first
+	for (auto &it : m_vThreads)
+		it.join();
+}
+
+void CImageLoader::Request(std::uintptr_t key, const std::wstring &sFileName, int cx, int cy)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		auto same = [&](const job &j)
+		{
+			return j.sFileName == sFileName && j.cx == cx && j.cy == cy;
+		};
+
+		// the same image is already on its way, or waiting to be collected
+		auto it_ready = m_ready.find(key);
+
+		if (it_ready != m_ready.end() && same(it_ready->second.request))
+			return;
+
+		auto it = m_current.find(key);
+
+		if (it != m_current.end())
+		{
+			if (same(it->second))
+				return;
+
+			// drop the request this one replaces; a worker busy with it will throw its image away
+			const unsigned long long iTicket = it->second.iTicket;
+
+			m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(),
+				[iTicket](const job &j) { return j.iTicket == iTicket; }), m_pending.end());
+		}
+
+		if (m_ready.erase(key))
+			m_iInFlight--;
+
+		job j;
+		j.key = key;
+		j.sFileName = sFileName;
+		j.cx = cx;
+		j.cy = cy;
+		j.iTicket = m_iNextTicket++;
+
+		m_current[key] = j;
+		m_pending.push_back(j);
+
+		if (m_vThreads.empty())
+		{
+			for (size_t i = 0; i < m_iThreads; i++)
+				m_vThreads.push_back(std::thread(&CImageLoader::worker, this));
+		}
+	}
+
+	m_cvWork.notify_one();
+} // Request
+
+void CImageLoader::Cancel(std::uintptr_t key)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		auto it = m_current.find(key);
+
+		if (it != m_current.end())
+		{
+			const unsigned long long iTicket = it->second.iTicket;
+
+			m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(),
+				[iTicket](const job &j) { return j.iTicket == iTicket; }), m_pending.end());
+
+			m_current.erase(it);
+		}
+
+		if (!m_ready.erase(key))
+			return;
+
+		m_iInFlight--;
+	}
+
+	m_cvWork.notify_one();
+} // Cancel
+
+bool CImageLoader::Collect(std::uintptr_t key, pixels &image)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		auto it = m_ready.find(key);
+
+		if (it == m_ready.end())
+			return false;
+
+		image = std::move(it->second.image);
+		m_ready.erase(it);
+		m_iInFlight--;
+	}
+
+	m_cvWork.notify_one();
+	return true;
+} // Collect
+
+bool CImageLoader::current(const job &j)
+{
+	// called with the lock held
+	auto it = m_current.find(j.key);
+	return !m_bStop && it != m_current.end() && it->second.iTicket == j.iTicket;
+} // current
+
+void CImageLoader::worker()
+{
+	for (;;)
+	{
+		job j;
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+
+			m_cvWork.wait(lock, [this]()
+			{
+				return m_bStop || (!m_pending.empty() && m_iInFlight < m_iMaxInFlight);
+			});
+
+			if (m_bStop)
+				return;
+
+			j = m_pending.front();
+			m_pending.pop_front();
+			m_iInFlight++;
+		}
+
+		pixels image;
+
+		if (!m_decode(j.sFileName, image) || image.cx <= 0 || image.cy <= 0 ||
+			image.data.size() != size_t(image.cx) * size_t(image.cy))
+			image = pixels();
+
+		bool bCancelled = false;
+
+		{
+			// don't resize an image nobody wants anymore
+			std::lock_guard<std::mutex> lock(m_mutex);
+			bCancelled = !current(j);
+		}
+
+		if (!bCancelled && !image.data.empty())
+		{
+			Premultiply(image);
+
+			int iWidth = 0, iHeight = 0;
+			Fit(image.cx, image.cy, j.cx, j.cy, iWidth, iHeight);
+
+			if (iWidth <= 0 || iHeight <= 0)
+				image = pixels();
+			else
+				if (iWidth != image.cx || iHeight != image.cy)
+					image = Resize(image, iWidth, iHeight);
+		}
+
+		bool bNotify = false;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			if (current(j))
+			{
+				m_current.erase(j.key);
+				m_ready[j.key] = result{ j, std::move(image) };
+				bNotify = true;
+			}
+			else
+				m_iInFlight--;
+		}
+
+		if (bNotify)
+			m_notify(j.key);
+		else
+			m_cvWork.notify_one();
+	}
+} // worker
+
+void CImageLoader::Premultiply(pixels &image)
+{
+	for (auto &it : image.data)
+	{
+		const std::uint32_t a = it >> 24;
+
+		if (a == 255)
+			continue;
+
+		const std::uint32_t r = (((it >> 16) & 0xFF) * a + 127) / 255;
+		const std::uint32_t g = (((it >> 8) & 0xFF) * a + 127) / 255;
+		const std::uint32_t b = ((it & 0xFF) * a + 127) / 255;
+
+		it = (a << 24) | (r << 16) | (g << 8) | b;
+	}
+} // Premultiply
+
+void CImageLoader::Fit(int iWidth, int iHeight, int cx, int cy, int &iWidthOut, int &iHeightOut)
+{
+	iWidthOut = 0;
+	iHeightOut = 0;
+
+	if (iWidth <= 0 || iHeight <= 0 || cx <= 0 || cy <= 0)
+		return;
+
+	if (iWidth <= cx && iHeight <= cy)
+	{
+		// the image fits as it is
+		iWidthOut = iWidth;
+		iHeightOut = iHeight;
+		return;
+	}
+
+	const double ratio = double(iWidth) / double(iHeight);
+
+	if (iWidth == iHeight)
+		iWidthOut = iHeightOut = std::min(cx, cy);
+	else
+		if (iWidth > iHeight)
+		{
+			// use the width of the target and adjust the height to keep the aspect ratio
+			iWidthOut = cx;
+			iHeightOut = int(cx / ratio);
+
+			if (iHeightOut > cy)
+			{
+				iHeightOut = cy;
+				iWidthOut = int(cy * ratio);
+			}
+		}
+		else
+		{
+			// use the height of the target and adjust the width to keep the aspect ratio
+			iHeightOut = cy;
+			iWidthOut = int(cy * ratio);
+
+			if (iWidthOut > cx)
+			{
+				iWidthOut = cx;
+				iHeightOut = int(cx / ratio);
+			}
+		}
+
+	// a thin image still shows as a line
+	iWidthOut = std::max(iWidthOut, 1);
+	iHeightOut = std::max(iHeightOut, 1);
+} // Fit
+
+namespace
+{
+	// the source pixels a target pixel covers, and how much of each
+	struct span
+	{
+		int iFirst = 0;
+		std::vector<float> weights;
+	};
+
+	std::vector<span> spans(int iSource, int iTarget)
+	{
+		std::vector<span> v(iTarget);
+		const double dScale = double(iSource) / double(iTarget);
+
+		for (int i = 0; i < iTarget; i++)
+		{
+			const double d0 = i * dScale;
+			const double d1 = (i + 1) * dScale;
+
+			const int iFirst = std::min(int(d0), iSource - 1);
+			const int iLast = std::max(std::min(int(std::ceil(d1)), iSource) - 1, iFirst);
+
+			v[i].iFirst = iFirst;
+
+			double dTotal = 0;
+
+			for (int k = iFirst; k <= iLast; k++)
+			{
+				// pixels at the edges count for the part of them that is covered
+				const double dWeight = std::max(std::min(d1, double(k + 1)) - std::max(d0, double(k)), 0.0);
+				v[i].weights.push_back(float(dWeight));
+				dTotal += dWeight;
+			}
+
+			if (dTotal > 0)
+			{
+				for (auto &it : v[i].weights)
+					it = float(it / dTotal);
+			}
+			else
+				v[i].weights.assign(v[i].weights.size(), 1.0f / v[i].weights.size());
+		}
+
+		return v;
+	}
+
+	std::uint32_t channel(float f)
+	{
+		return std::uint32_t(std::min(std::max(f + 0.5f, 0.0f), 255.0f));
+	}
+}
+
+CImageLoader::pixels CImageLoader::Resize(const pixels &image, int cx, int cy)
+{
+	pixels out;
+
+	if (cx <= 0 || cy <= 0 || image.cx <= 0 || image.cy <= 0 ||
+		image.data.size() != size_t(image.cx) * size_t(image.cy))
+		return out;
+
+	const std::vector<span> vX = spans(image.cx, cx);
+	const std::vector<span> vY = spans(image.cy, cy);
+
+	// shrink every row across, four channels per pixel
+	std::vector<float> rows(size_t(image.cy) * size_t(cx) * 4);
+
+	for (int y = 0; y < image.cy; y++)
+	{
+		const std::uint32_t* pSource = &image.data[size_t(y) * image.cx];
+		float* pRow = &rows[size_t(y) * cx * 4];
+
+		for (int x = 0; x < cx; x++)
+		{
+			float a = 0, r = 0, g = 0, b = 0;
+			const span &s = vX[x];
+
+			for (size_t k = 0; k < s.weights.size(); k++)
+			{
+				const std::uint32_t p = pSource[s.iFirst + k];
+				const float w = s.weights[k];
+
+				a += w * (p >> 24);
+				r += w * ((p >> 16) & 0xFF);
+				g += w * ((p >> 8) & 0xFF);
+				b += w * (p & 0xFF);
+			}
+
+			pRow[x * 4 + 0] = a;
+			pRow[x * 4 + 1] = r;
+			pRow[x * 4 + 2] = g;
+			pRow[x * 4 + 3] = b;
+		}
+	}
+
+	// then shrink the rows down
+	out.cx = cx;
+	out.cy = cy;
+	out.data.resize(size_t(cx) * size_t(cy));
+
+	std::vector<float> sum(size_t(cx) * 4);
+
+	for (int y = 0; y < cy; y++)
+	{
+		std::fill(sum.begin(), sum.end(), 0.0f);
+		const span &s = vY[y];
+
+		for (size_t k = 0; k < s.weights.size(); k++)
+		{
+			const float* pRow = &rows[size_t(s.iFirst + k) * cx * 4];
+			const float w = s.weights[k];
+
+			for (size_t i = 0; i < sum.size(); i++)
+				sum[i] += w * pRow[i];
+		}
+
+		std::uint32_t* pOut = &out.data[size_t(y) * cx];
+
+		for (int x = 0; x < cx; x++)
+			pOut[x] = (channel(sum[x * 4 + 0]) << 24) | (channel(sum[x * 4 + 1]) << 16) |
+			(channel(sum[x * 4 + 2]) << 8) | channel(sum[x * 4 + 3]);
+	}
+
+	return out;
+} // Resize
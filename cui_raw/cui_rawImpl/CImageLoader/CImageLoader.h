@@ -0,0 +1,127 @@
+//
+// CImageLoader.h - background image loader interface
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+/*
+** CImageLoader - decodes image files and resizes them for display on worker threads
+** a control asks for its image with Request and carries on painting a placeholder; when the
+** image is ready the notify function is called (on the worker thread) and the control takes
+** the image with Collect on its own thread
+** at most iMaxInFlight images are being worked on or waiting to be collected at any one time,
+** so that a page of large photos doesn't hold all of them in memory at once
+** the stages (premultiply, fit, resize) don't depend on the platform; only the decoder does
+*/
+class CImageLoader
+{
+public:
+	// 32 bit pixels, 0xAARRGGBB, rows top to bottom with no padding in between
+	struct pixels
+	{
+		int cx = 0;
+		int cy = 0;
+		std::vector<std::uint32_t> data;
+	};
+
+	/*
+	** decode an image file into pixels that are not premultiplied
+	** called on a worker thread; return false if the file cannot be read
+	*/
+	typedef std::function<bool(const std::wstring &sFileName, pixels &image)> decodeFunc;
+
+	// called on a worker thread when the image for key can be collected
+	typedef std::function<void(std::uintptr_t key)> notifyFunc;
+
+	/*
+	** iThreads is the number of worker threads, 0 to decide from the number of processors
+	** the threads are only started when the first image is requested
+	*/
+	CImageLoader(decodeFunc decode, notifyFunc notify,
+		size_t iThreads = 0, size_t iMaxInFlight = 16);
+	~CImageLoader();
+
+	/*
+	** load sFileName fitted into cx by cy, keeping its aspect ratio and never enlarging it
+	** a request replaces any earlier one for the same key; asking again for an image that is
+	** already on its way does nothing
+	*/
+	void Request(std::uintptr_t key, const std::wstring &sFileName, int cx, int cy);
+
+	// forget the request for key, including an image that is ready but not collected
+	void Cancel(std::uintptr_t key);
+
+	/*
+	** take the image for key
+	** returns false if there is nothing to take; an empty image means the file could not be read
+	*/
+	bool Collect(std::uintptr_t key, pixels &image);
+
+	// multiply the color channels by alpha
+	static void Premultiply(pixels &image);
+
+	/*
+	** the size an iWidth by iHeight image is drawn at in a cx by cy rectangle
+	** the rules are those of ResizeGdiplusBitmap without stretching or enlarging
+	*/
+	static void Fit(int iWidth, int iHeight, int cx, int cy, int &iWidthOut, int &iHeightOut);
+
+	/*
+	** resize premultiplied pixels by averaging the area each target pixel covers
+	** meant for shrinking; enlarging gives blocky pixels
+	*/
+	static pixels Resize(const pixels &image, int cx, int cy);
+
+private:
+	struct job
+	{
+		std::uintptr_t key = 0;
+		std::wstring sFileName;
+		int cx = 0;
+		int cy = 0;
+		unsigned long long iTicket = 0;	// tells a job apart from the ones that replaced it
+	};
+
+	struct result
+	{
+		job request;
+		pixels image;
+	};
+
+	void worker();
+	bool current(const job &j);
+
+	decodeFunc m_decode;
+	notifyFunc m_notify;
+	size_t m_iThreads;
+	const size_t m_iMaxInFlight;
+
+	std::mutex m_mutex;
+	std::condition_variable m_cvWork;
+	std::vector<std::thread> m_vThreads;
+	std::deque<job> m_pending;					// requests no worker has taken yet
+	std::map<std::uintptr_t, job> m_current;	// the live request of every key, pending or running
+	std::map<std::uintptr_t, result> m_ready;	// images waiting to be collected
+	size_t m_iInFlight = 0;						// running jobs plus images waiting to be collected
+	unsigned long long m_iNextTicket = 1;
+	bool m_bStop = false;
+
+	CImageLoader(const CImageLoader&) = delete;
+	CImageLoader& operator=(const CImageLoader&) = delete;
+}; // CImageLoader
@@ -0,0 +1,86 @@
+//
+// CImageLoaderGdiplus.cpp - GDI+ side of the background image loader, implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "CImageLoaderGdiplus.h"
+
+bool CImageLoaderGdiplus::Decode(const std::wstring &sFileName, CImageLoader::pixels &image)
+{
+	Gdiplus::Bitmap bitmap(sFileName.c_str());
+
+	if (bitmap.GetLastStatus() != Gdiplus::Ok)
+		return false;
+
+	const INT cx = static_cast<INT>(bitmap.GetWidth());
+	const INT cy = static_cast<INT>(bitmap.GetHeight());
+
+	if (cx <= 0 || cy <= 0)
+		return false;
+
+	image.cx = cx;
+	image.cy = cy;
+	image.data.resize(size_t(cx) * size_t(cy));
+
+	// have GDI+ convert straight into our buffer
+	Gdiplus::BitmapData data;
+	data.Width = cx;
+	data.Height = cy;
+	data.Stride = cx * 4;
+	data.PixelFormat = PixelFormat32bppARGB;
+	data.Scan0 = image.data.data();
+	data.Reserved = NULL;
+
+	Gdiplus::Rect rect(0, 0, cx, cy);
+
+	if (bitmap.LockBits(&rect, Gdiplus::ImageLockModeRead | Gdiplus::ImageLockModeUserInputBuf,
+		PixelFormat32bppARGB, &data) != Gdiplus::Ok)
+	{
+		image = CImageLoader::pixels();
+		return false;
+	}
+
+	bitmap.UnlockBits(&data);
+	return true;
+} // Decode
+
+Gdiplus::Bitmap* CImageLoaderGdiplus::ToBitmap(const CImageLoader::pixels &image)
+{
+	if (image.cx <= 0 || image.cy <= 0 ||
+		image.data.size() != size_t(image.cx) * size_t(image.cy))
+		return NULL;
+
+	Gdiplus::Bitmap* p_bitmap = new Gdiplus::Bitmap(image.cx, image.cy, PixelFormat32bppPARGB);
+
+	if (p_bitmap->GetLastStatus() != Gdiplus::Ok)
+	{
+		delete p_bitmap;
+		return NULL;
+	}
+
+	Gdiplus::BitmapData data;
+	data.Width = image.cx;
+	data.Height = image.cy;
+	data.Stride = image.cx * 4;
+	data.PixelFormat = PixelFormat32bppPARGB;
+	data.Scan0 = const_cast<std::uint32_t*>(image.data.data());
+	data.Reserved = NULL;
+
+	Gdiplus::Rect rect(0, 0, image.cx, image.cy);
+
+	if (p_bitmap->LockBits(&rect, Gdiplus::ImageLockModeWrite | Gdiplus::ImageLockModeUserInputBuf,
+		PixelFormat32bppPARGB, &data) != Gdiplus::Ok)
+	{
+		delete p_bitmap;
+		return NULL;
+	}
+
+	// unlocking copies the pixels into the bitmap
+	p_bitmap->UnlockBits(&data);
+	return p_bitmap;
+} // ToBitmap
@@ -0,0 +1,35 @@
+//
+// CImageLoaderGdiplus.h - GDI+ side of the background image loader, interface
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <Windows.h>
+#include <GdiPlus.h>
+#include "CImageLoader.h"
+
+/*
+** CImageLoaderGdiplus - decodes images for CImageLoader and turns what it makes into GDI+ bitmaps
+** GDI+ must be initialized before any calls
+*/
+class CImageLoaderGdiplus
+{
+public:
+	/*
+	** decode an image file; a CImageLoader::decodeFunc
+	** safe to call on a worker thread; the file is closed before returning
+	*/
+	static bool Decode(const std::wstring &sFileName, CImageLoader::pixels &image);
+
+	/*
+	** make a premultiplied GDI+ bitmap of image
+	** returns NULL if it cannot be made; the caller owns the bitmap
+	*/
+	static Gdiplus::Bitmap* ToBitmap(const CImageLoader::pixels &image);
+}; // CImageLoaderGdiplus
@@ -437,3 +437,50 @@ void Clistview::GetInfo(
 
 	return;
 } // GetInfo
+
+// get column type
+Clistview::enType Clistview::GetColType(int iColNumber)
+{
+	if (iColNumber < 0 || iColNumber >= (int)m_vColTypes.size())
+		return String;
+
+	return m_vColTypes[iColNumber];
+} // GetColType
+
+// compare the ranks assigned by Reorder
+int CALLBACK Clistview::CompareRank(LPARAM lParam1, LPARAM lParam2, LPARAM lParamSort)
+{
+	return (lParam1 < lParam2) ? -1 : (lParam1 > lParam2 ? 1 : 0);
+} // CompareRank
+
+/*
+** reorder the rows of the list view in a single pass
+*/
+bool Clistview::Reorder(
+	const std::vector<int> &vOrder	// new row order
+)
+{
+	const int iRows = Get_NumOfRows();
+
+	if ((int)vOrder.size() != iRows)
+		return false;
+
+	// tag each row with its new position
+	LVITEM item = { 0 };
+	item.mask = LVIF_PARAM;
+
+	for (int iRow = 0; iRow < iRows; iRow++)
+	{
+		if (vOrder[iRow] < 0 || vOrder[iRow] >= iRows)
+			return false;
+
+		item.iItem = vOrder[iRow];
+		item.lParam = iRow;
+		ListView_SetItem(m_hlistview, &item);
+	}
+
+	// let the control move the rows; the comparison only looks at the tags
+	ListView_SortItems(m_hlistview, CompareRank, 0);
+
+	return true;
+} // Reorder
@@ -140,6 +140,18 @@ public:
 	*/
 	void ResizeWH();
 
+	/*
+	** reorder the rows of the list view in a single pass
+	** vOrder[i] is the current row number of the row that is to become row i
+	** item state (selection, focus) moves with the rows
+	*/
+	bool Reorder(
+		const std::vector<int> &vOrder	// new row order
+	);
+
+	// get column type
+	enType GetColType(int iColNumber);
+
 	// get number of columns
 	int Get_NumOfCols();
 
@@ -147,6 +159,8 @@ public:
 	int Get_NumOfRows();
 
 private:
+	static int CALLBACK CompareRank(LPARAM lParam1, LPARAM lParam2, LPARAM lParamSort);
+
 	HWND m_hlistview;		// list view handle
 	int m_iNumOfCols;		// number of columns
 	int m_iPrevRow;			// previous row
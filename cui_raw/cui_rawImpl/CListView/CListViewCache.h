@@ -0,0 +1,200 @@
+//
+// CListViewCache.h - virtual listview row cache - interface and implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <functional>
+
+/*
+** ClistviewCacheT - row cache for virtual (owner-data) listviews
+** rows are fetched on demand from a row provider and kept in a fixed number of
+** direct-mapped slots, so lookups are O(1) and memory use is bounded regardless
+** of the number of rows in the listview
+** the class has no platform dependencies
+*/
+template <typename CharT>
+class ClistviewCacheT
+{
+public:
+	struct cell
+	{
+		std::basic_string<CharT> sText;
+		bool bCustom = false;			// whether the cell has a custom text color
+		unsigned long clrText = 0;		// custom text color (COLORREF)
+	};
+
+	// cells of a row, indexed by column number
+	typedef std::vector<cell> row;
+
+	// fills in the cells of the given row; cells is sized to the number of columns
+	// and cleared before the call
+	typedef std::function<void(int iRowNumber, row &cells)> provider;
+
+	ClistviewCacheT(size_t iSlots = 512) :
+		m_iRowCount(0),
+		m_iNumOfCols(0),
+		m_iHits(0),
+		m_iMisses(0)
+	{
+		m_vSlots.resize(iSlots > 0 ? iSlots : 1);
+	}
+
+	/*
+	** set the row provider
+	*/
+	void SetProvider(provider pProvider)
+	{
+		m_pProvider = pProvider;
+		Invalidate();
+	}
+
+	/*
+	** set the number of columns
+	*/
+	void SetNumOfCols(int iNumOfCols)
+	{
+		m_iNumOfCols = iNumOfCols > 0 ? iNumOfCols : 0;
+		Invalidate();
+	}
+
+	/*
+	** set the number of rows
+	** all cached rows are dropped since the underlying data has changed
+	*/
+	void SetRowCount(int iRowCount)
+	{
+		m_iRowCount = iRowCount > 0 ? iRowCount : 0;
+		Invalidate();
+	}
+
+	// get number of rows
+	int GetRowCount() const { return m_iRowCount; }
+
+	// get number of columns
+	int GetNumOfCols() const { return m_iNumOfCols; }
+
+	/*
+	** drop all cached rows
+	** slot storage is kept so that refetching does not reallocate
+	*/
+	void Invalidate()
+	{
+		for (auto &it : m_vSlots)
+			it.iRowNumber = -1;
+	}
+
+	/*
+	** drop a single cached row
+	*/
+	void Invalidate(int iRowNumber)
+	{
+		if (iRowNumber < 0)
+			return;
+
+		slot &s = m_vSlots[iRowNumber % m_vSlots.size()];
+
+		if (s.iRowNumber == iRowNumber)
+			s.iRowNumber = -1;
+	}
+
+	/*
+	** prefetch the rows the listview is about to display (inclusive range)
+	** rows beyond the cache capacity are not prefetched
+	*/
+	void Hint(int iFrom, int iTo)
+	{
+		if (iFrom < 0)
+			iFrom = 0;
+
+		if (iTo >= m_iRowCount)
+			iTo = m_iRowCount - 1;
+
+		if (iTo - iFrom + 1 > (int)m_vSlots.size())
+			iTo = iFrom + (int)m_vSlots.size() - 1;
+
+		for (int iRow = iFrom; iRow <= iTo; iRow++)
+			GetRow(iRow);
+	}
+
+	/*
+	** get a row, fetching it from the provider if it is not cached
+	** returns nullptr if the row is out of range or there is no provider
+	*/
+	const row* GetRow(int iRowNumber)
+	{
+		if (iRowNumber < 0 || iRowNumber >= m_iRowCount || !m_pProvider)
+			return nullptr;
+
+		slot &s = m_vSlots[iRowNumber % m_vSlots.size()];
+
+		if (s.iRowNumber == iRowNumber)
+		{
+			m_iHits++;
+			return &s.cells;
+		}
+
+		m_iMisses++;
+
+		// reuse the slot's cells
+		s.cells.resize(m_iNumOfCols);
+
+		for (auto &it : s.cells)
+		{
+			it.sText.clear();
+			it.bCustom = false;
+			it.clrText = 0;
+		}
+
+		m_pProvider(iRowNumber, s.cells);
+
+		// the provider is not allowed to change the number of columns
+		s.cells.resize(m_iNumOfCols);
+
+		s.iRowNumber = iRowNumber;
+		return &s.cells;
+	}
+
+	/*
+	** get a cell
+	** returns nullptr if the cell is out of range
+	*/
+	const cell* GetCell(int iRowNumber, int iColNumber)
+	{
+		if (iColNumber < 0 || iColNumber >= m_iNumOfCols)
+			return nullptr;
+
+		const row* pRow = GetRow(iRowNumber);
+
+		if (!pRow)
+			return nullptr;
+
+		return &(*pRow)[iColNumber];
+	}
+
+	// cache statistics
+	size_t Hits() const { return m_iHits; }
+	size_t Misses() const { return m_iMisses; }
+
+private:
+	struct slot
+	{
+		int iRowNumber = -1;
+		row cells;
+	};
+
+	provider m_pProvider;
+	std::vector<slot> m_vSlots;
+	int m_iRowCount;
+	int m_iNumOfCols;
+	size_t m_iHits;
+	size_t m_iMisses;
+}; // ClistviewCacheT
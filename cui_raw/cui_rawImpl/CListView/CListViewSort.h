@@ -0,0 +1,306 @@
+//
+// CListViewSort.h - listview column sort engine - interface and implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <numeric>
+#include <cstdlib>
+#include <cwctype>
+#include <cctype>
+
+// the parallel sort needs the C++17 parallel algorithms; without them (or outside MSVC, where
+// libstdc++ needs TBB for them) the rows are sorted on the calling thread
+#if defined(_MSC_VER) && defined(__cpp_lib_parallel_algorithm)
+#include <execution>
+#define CLISTVIEWSORT_PARALLEL
+#endif
+
+/*
+** ClistviewSortT - sorts the rows of a listview column
+** each row is decorated once with a typed key (integer, floating point, date or
+** case-folded string) and row indices are then sorted on the keys, so no text is
+** parsed or compared through the control during the sort
+** the class has no platform dependencies
+**
+** "ascending" keeps the direction the listview has always sorted in on the first click of a
+** column: text from Z to A, numbers from high to low and dates newest first, with empty cells
+** last; descending reverses it
+** numbers and dates used to be compared as text, they are now compared by value
+*/
+template <typename CharT>
+class ClistviewSortT
+{
+public:
+	typedef std::basic_string<CharT> string_type;
+
+	enum enType
+	{
+		String,		// detect integers and dates, otherwise compare case-insensitively
+		Char,		// compare case-insensitively
+		Int,		// compare as integers
+		Float,		// compare as floating point numbers
+	};
+
+	/*
+	** sort rows
+	** vText[i] is the text of row i in the sort column (nullptr is treated as empty)
+	** returns the new order of the rows: the element at position i is the old row number
+	** of the row that is to become row i
+	*/
+	static std::vector<int> Sort(
+		const std::vector<const string_type*> &vText,	// text of each row in the sort column
+		enType type,		// column type
+		bool bAscending		// sort direction
+	)
+	{
+		const size_t iRows = vText.size();
+
+		// decorate each row with its key
+		std::vector<key> vKeys(iRows);
+
+		switch (type)
+		{
+		case Int:
+			// integer keys if every non-empty entry is an integer, so that large values keep
+			// their precision; otherwise an entry with a decimal point still sorts as a number
+			if (!decorate(vText, vKeys, parseInt, true))
+				decorate(vText, vKeys, parseFloat);
+			break;
+
+		case Float:
+			decorate(vText, vKeys, parseFloat);
+			break;
+
+		case Char:
+			decorate(vText, vKeys, nullptr);
+			break;
+
+		case String:
+		default:
+			// use a numeric or date key only if every non-empty entry qualifies
+			if (!decorate(vText, vKeys, parseInt, true) &&
+				!decorate(vText, vKeys, parseDate, true))
+				decorate(vText, vKeys, nullptr);
+			break;
+		}
+
+		// sort row indices on the keys
+		std::vector<int> vOrder(iRows);
+		std::iota(vOrder.begin(), vOrder.end(), 0);
+
+		auto less = [&vKeys](int a, int b) { return compare(vKeys[a], vKeys[b]) < 0; };
+		auto greater = [&vKeys](int a, int b) { return compare(vKeys[b], vKeys[a]) < 0; };
+
+#if defined(CLISTVIEWSORT_PARALLEL)
+		if (bAscending)
+			std::stable_sort(std::execution::par, vOrder.begin(), vOrder.end(), less);
+		else
+			std::stable_sort(std::execution::par, vOrder.begin(), vOrder.end(), greater);
+#else
+		if (bAscending)
+			std::stable_sort(vOrder.begin(), vOrder.end(), less);
+		else
+			std::stable_sort(vOrder.begin(), vOrder.end(), greater);
+#endif
+
+		return vOrder;
+	} // Sort
+
+private:
+	struct key
+	{
+		// 0 = text, 1 = number or date, 2 = empty
+		unsigned char cls = 2;
+		double value = 0;
+		long long iValue = 0;
+		bool bInteger = false;
+		string_type sFolded;
+	};
+
+	// parses a cell into a key, returns false if the cell is not of the parser's type
+	typedef bool(*parser)(const string_type &s, key &k);
+
+	/*
+	** decorate rows with keys
+	** cells that the parser does not accept get a case-folded text key
+	** if bAllOrNothing is true the function stops and returns false as soon as a
+	** non-empty cell is rejected
+	*/
+	static bool decorate(const std::vector<const string_type*> &vText,
+		std::vector<key> &vKeys, parser parse, bool bAllOrNothing = false)
+	{
+		for (size_t i = 0; i < vText.size(); i++)
+		{
+			key &k = vKeys[i];
+			k = key();
+
+			if (!vText[i] || vText[i]->empty())
+				continue;
+
+			const string_type &s = *vText[i];
+
+			if (parse && parse(s, k))
+			{
+				k.cls = 1;
+				continue;
+			}
+
+			if (bAllOrNothing && parse)
+				return false;
+
+			k.cls = 0;
+			k.sFolded.resize(s.length());
+
+			for (size_t j = 0; j < s.length(); j++)
+				k.sFolded[j] = fold(s[j]);
+		}
+
+		return true;
+	} // decorate
+
+	// the order of an ascending sort ... largest first within each class
+	static int compare(const key &a, const key &b)
+	{
+		if (a.cls != b.cls)
+			return a.cls < b.cls ? -1 : 1;
+
+		if (a.cls == 1)
+		{
+			if (a.bInteger && b.bInteger)
+				return a.iValue > b.iValue ? -1 : (a.iValue < b.iValue ? 1 : 0);
+
+			return a.value > b.value ? -1 : (a.value < b.value ? 1 : 0);
+		}
+
+		if (a.cls == 0)
+			return b.sFolded.compare(a.sFolded);
+
+		return 0;
+	} // compare
+
+	static CharT fold(CharT c)
+	{
+		if (sizeof(CharT) == 1)
+			return (CharT)std::tolower((unsigned char)c);
+		else
+			return (CharT)std::towlower((std::wint_t)c);
+	}
+
+	static bool isDigit(CharT c) { return c >= '0' && c <= '9'; }
+
+	// optional sign followed by digits, nothing else
+	static bool parseInt(const string_type &s, key &k)
+	{
+		size_t i = 0;
+		bool bNegative = false;
+
+		if (i < s.length() && (s[i] == '-' || s[i] == '+'))
+			bNegative = (s[i++] == '-');
+
+		if (i == s.length() || s.length() - i > 18)
+			return false;
+
+		long long iValue = 0;
+
+		for (; i < s.length(); i++)
+		{
+			if (!isDigit(s[i]))
+				return false;
+
+			iValue = iValue * 10 + (s[i] - '0');
+		}
+
+		k.iValue = bNegative ? -iValue : iValue;
+		k.value = (double)k.iValue;
+		k.bInteger = true;
+		return true;
+	} // parseInt
+
+	static bool parseFloat(const string_type &s, key &k)
+	{
+		// numbers are plain ASCII so a narrow copy is enough for strtod
+		std::string sNarrow;
+		sNarrow.reserve(s.length());
+
+		for (auto c : s)
+		{
+			if ((unsigned)c > 127)
+				return false;
+
+			sNarrow += (char)c;
+		}
+
+		const char *pStart = sNarrow.c_str();
+		char *pEnd = nullptr;
+		const double value = std::strtod(pStart, &pEnd);
+
+		if (pEnd == pStart)
+			return false;
+
+		// allow trailing spaces only
+		while (*pEnd == ' ')
+			pEnd++;
+
+		if (*pEnd != 0)
+			return false;
+
+		k.value = value;
+		return true;
+	} // parseFloat
+
+	// yyyy-mm-dd, yyyy/mm/dd, dd-mm-yyyy and dd/mm/yyyy
+	static bool parseDate(const string_type &s, key &k)
+	{
+		if (s.length() != 10)
+			return false;
+
+		auto number = [&s](size_t iPos, size_t iLen, int &iValue)
+		{
+			iValue = 0;
+
+			for (size_t i = iPos; i < iPos + iLen; i++)
+			{
+				if (!isDigit(s[i]))
+					return false;
+
+				iValue = iValue * 10 + (s[i] - '0');
+			}
+
+			return true;
+		};
+
+		int iYear = 0, iMonth = 0, iDay = 0;
+
+		if ((s[4] == '-' || s[4] == '/') && s[7] == s[4])
+		{
+			if (!number(0, 4, iYear) || !number(5, 2, iMonth) || !number(8, 2, iDay))
+				return false;
+		}
+		else
+			if ((s[2] == '-' || s[2] == '/') && s[5] == s[2])
+			{
+				if (!number(0, 2, iDay) || !number(3, 2, iMonth) || !number(6, 4, iYear))
+					return false;
+			}
+			else
+				return false;
+
+		if (iMonth < 1 || iMonth > 12 || iDay < 1 || iDay > 31)
+			return false;
+
+		k.iValue = (long long)iYear * 10000 + iMonth * 100 + iDay;
+		k.value = (double)k.iValue;
+		k.bInteger = true;
+		return true;
+	} // parseDate
+}; // ClistviewSortT
@@ -0,0 +1,150 @@
+//
+// CListViewStyles.cpp - listview cell style index - implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "CListViewStyles.h"
+#include <algorithm>
+
+// constructor
+ClistviewStyles::ClistviewStyles()
+{
+	m_iNumOfCols = 0;
+	m_iNumOfRows = 0;
+}
+
+// destructor
+ClistviewStyles::~ClistviewStyles()
+{
+}
+
+/*
+** reset the index for the given number of columns
+*/
+void ClistviewStyles::Reset(int iNumOfCols)
+{
+	m_iNumOfCols = iNumOfCols > 0 ? iNumOfCols : 0;
+	m_iNumOfRows = 0;
+	m_vColFlags.assign(m_iNumOfCols, none);
+	m_vCells.clear();
+} // Reset
+
+/*
+** flag a column as a bar chart column
+*/
+void ClistviewStyles::SetBarChart(int iColNumber, bool bBarChart)
+{
+	if (iColNumber < 0 || iColNumber >= m_iNumOfCols)
+		return;
+
+	if (bBarChart)
+		m_vColFlags[iColNumber] |= barchart;
+	else
+		m_vColFlags[iColNumber] &= ~barchart;
+
+	// update existing rows
+	for (int iRow = 0; iRow < m_iNumOfRows; iRow++)
+	{
+		cellStyle &cell = m_vCells[(size_t)iRow * m_iNumOfCols + iColNumber];
+
+		if (bBarChart)
+			cell.flags |= barchart;
+		else
+			cell.flags &= ~barchart;
+	}
+} // SetBarChart
+
+/*
+** reserve space for the given number of rows
+*/
+void ClistviewStyles::Reserve(int iNumOfRows)
+{
+	if (iNumOfRows > 0)
+		m_vCells.reserve((size_t)iNumOfRows * m_iNumOfCols);
+} // Reserve
+
+/*
+** append a row with default styles
+*/
+int ClistviewStyles::AddRow()
+{
+	for (int iCol = 0; iCol < m_iNumOfCols; iCol++)
+	{
+		cellStyle cell;
+		cell.flags = m_vColFlags[iCol];
+		m_vCells.push_back(cell);
+	}
+
+	return m_iNumOfRows++;
+} // AddRow
+
+/*
+** set the style of a cell
+*/
+void ClistviewStyles::SetCell(
+	int iRowNumber,		// row number
+	int iColNumber,		// column number
+	bool bCustom,		// whether the cell has a custom text color
+	std::uint32_t clrText	// custom text color
+)
+{
+	if (iRowNumber < 0 || iColNumber < 0 ||
+		iColNumber >= m_iNumOfCols || iRowNumber >= m_iNumOfRows)
+		return;
+
+	cellStyle &cell = m_vCells[(size_t)iRowNumber * m_iNumOfCols + iColNumber];
+
+	if (bCustom)
+	{
+		cell.flags |= custom;
+		cell.clrText = clrText;
+	}
+	else
+	{
+		cell.flags &= ~custom;
+		cell.clrText = rgb(0, 0, 0);
+	}
+} // SetCell
+
+/*
+** remove row from index
+*/
+void ClistviewStyles::RemoveRow(int iRowNumber)
+{
+	if (iRowNumber < 0 || iRowNumber >= m_iNumOfRows)
+		return;
+
+	auto first = m_vCells.begin() + (size_t)iRowNumber * m_iNumOfCols;
+	m_vCells.erase(first, first + m_iNumOfCols);
+	m_iNumOfRows--;
+} // RemoveRow
+
+/*
+** reorder rows
+*/
+void ClistviewStyles::Reorder(const std::vector<int> &vOrder)
+{
+	if ((int)vOrder.size() != m_iNumOfRows)
+		return;
+
+	std::vector<cellStyle> vCells(m_vCells.size());
+
+	for (int iRow = 0; iRow < m_iNumOfRows; iRow++)
+	{
+		const int iOldRow = vOrder[iRow];
+
+		if (iOldRow < 0 || iOldRow >= m_iNumOfRows)
+			return;	// invalid order, leave index untouched
+
+		std::copy(m_vCells.begin() + (size_t)iOldRow * m_iNumOfCols,
+			m_vCells.begin() + (size_t)(iOldRow + 1) * m_iNumOfCols,
+			vCells.begin() + (size_t)iRow * m_iNumOfCols);
+	}
+
+	m_vCells.swap(vCells);
+} // Reorder
@@ -0,0 +1,118 @@
+//
+// CListViewStyles.h - listview cell style index - interface
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/*
+** ClistviewStyles - per-cell custom draw information for a listview
+** cells are kept in a flat row-major array so that the custom draw handler
+** can find a cell's style with a single index calculation
+** colors are COLORREF values (0x00BBGGRR) held as std::uint32_t, so that the index has no
+** Windows dependencies
+*/
+class ClistviewStyles
+{
+public:
+	enum enFlags : unsigned char
+	{
+		none = 0,
+		custom = 1,		// cell has a custom text color
+		barchart = 2,	// cell belongs to a bar chart column
+	};
+
+	// the RGB macro, for colors in the index
+	static constexpr std::uint32_t rgb(unsigned char r, unsigned char g, unsigned char b)
+	{
+		return std::uint32_t(r) | (std::uint32_t(g) << 8) | (std::uint32_t(b) << 16);
+	}
+
+	struct cellStyle
+	{
+		std::uint32_t clrText = rgb(0, 0, 0);
+		unsigned char flags = none;
+	};
+
+	ClistviewStyles();
+	~ClistviewStyles();
+
+	/*
+	** reset the index for the given number of columns
+	** all rows are removed
+	*/
+	void Reset(int iNumOfCols);
+
+	/*
+	** flag a column as a bar chart column
+	** applies to existing and future rows
+	*/
+	void SetBarChart(int iColNumber, bool bBarChart);
+
+	/*
+	** reserve space for the given number of rows
+	*/
+	void Reserve(int iNumOfRows);
+
+	/*
+	** append a row with default styles
+	** returns the new row's number
+	*/
+	int AddRow();
+
+	/*
+	** set the style of a cell
+	** iRowNumber and iColNumber counted from 0
+	*/
+	void SetCell(
+		int iRowNumber,		// row number
+		int iColNumber,		// column number
+		bool bCustom,		// whether the cell has a custom text color
+		std::uint32_t clrText	// custom text color
+	);
+
+	/*
+	** remove row from index
+	*/
+	void RemoveRow(int iRowNumber);
+
+	/*
+	** reorder rows
+	** vOrder[i] is the old row number of the row that is to become row i
+	*/
+	void Reorder(const std::vector<int> &vOrder);
+
+	/*
+	** get the style of a cell
+	** returns nullptr if the cell is out of range
+	*/
+	const cellStyle* Get(int iRowNumber, int iColNumber) const
+	{
+		if (iRowNumber < 0 || iColNumber < 0 ||
+			iColNumber >= m_iNumOfCols || iRowNumber >= m_iNumOfRows)
+			return nullptr;
+
+		return &m_vCells[(size_t)iRowNumber * m_iNumOfCols + iColNumber];
+	}
+
+	// get number of columns
+	int Get_NumOfCols() const { return m_iNumOfCols; }
+
+	// get number of rows
+	int Get_NumOfRows() const { return m_iNumOfRows; }
+
+private:
+	int m_iNumOfCols;		// number of columns
+	int m_iNumOfRows;		// number of rows
+	std::vector<unsigned char> m_vColFlags;	// default flags for each column
+	std::vector<cellStyle> m_vCells;		// cell styles, row-major
+}; // ClistviewStyles
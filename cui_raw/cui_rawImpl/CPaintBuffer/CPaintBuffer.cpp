@@ -0,0 +1,118 @@
+//
+// CPaintBuffer.cpp - shared paint buffer implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "CPaintBuffer.h"
+#include <WindowsX.h>
+
+CPaintBuffer::CPaintBuffer()
+{
+}
+
+CPaintBuffer::~CPaintBuffer()
+{
+	for (auto &it : m_vBuffers)
+		destroy(it);
+
+	m_vBuffers.clear();
+}
+
+void CPaintBuffer::destroy(buffer &b)
+{
+	if (b.hdc)
+	{
+		if (b.hbm)
+		{
+			SelectBitmap(b.hdc, b.hbmOld);
+			DeleteBitmap(b.hbm);
+			b.hbm = NULL;
+		}
+
+		DeleteDC(b.hdc);
+		b.hdc = NULL;
+	}
+
+	b.cx = 0;
+	b.cy = 0;
+} // destroy
+
+HDC CPaintBuffer::Acquire(HDC dc, int cx, int cy, const RECT &rcPaint)
+{
+	// take the first buffer that is not in use
+	size_t i = 0;
+
+	while (i < m_vBuffers.size() && m_vBuffers[i].bInUse)
+		i++;
+
+	if (i == m_vBuffers.size())
+		m_vBuffers.push_back(buffer());
+
+	buffer &b = m_vBuffers[i];
+
+	if (!b.hdc)
+	{
+		b.hdc = CreateCompatibleDC(dc);
+
+		if (!b.hdc)
+			return NULL;
+	}
+
+	if (b.cx < cx || b.cy < cy)
+	{
+		// grow the bitmap, in both directions at once, to cover this control and all before it
+		const int iWidth = max(cx, b.cx);
+		const int iHeight = max(cy, b.cy);
+
+		if (b.hbm)
+		{
+			SelectBitmap(b.hdc, b.hbmOld);
+			DeleteBitmap(b.hbm);
+			b.hbm = NULL;
+			b.cx = 0;
+			b.cy = 0;
+		}
+
+		b.hbm = CreateCompatibleBitmap(dc, iWidth, iHeight);
+
+		if (b.hbm)
+		{
+			b.hbmOld = SelectBitmap(b.hdc, b.hbm);
+			b.cx = iWidth;
+			b.cy = iHeight;
+		}
+	}
+
+	b.iSaved = SaveDC(b.hdc);
+	IntersectClipRect(b.hdc, rcPaint.left, rcPaint.top, rcPaint.right, rcPaint.bottom);
+
+	b.bInUse = true;
+	return b.hdc;
+} // Acquire
+
+void CPaintBuffer::Release(HDC hdc)
+{
+	for (auto &it : m_vBuffers)
+	{
+		if (it.hdc == hdc && it.bInUse)
+		{
+			RestoreDC(it.hdc, it.iSaved);
+			it.bInUse = false;
+			return;
+		}
+	}
+} // Release
+
+void CPaintBuffer::Clear()
+{
+	for (auto &it : m_vBuffers)
+	{
+		if (!it.bInUse)
+			destroy(it);
+	}
+} // Clear
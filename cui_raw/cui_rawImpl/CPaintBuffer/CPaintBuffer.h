@@ -0,0 +1,71 @@
+//
+// CPaintBuffer.h - shared paint buffer interface
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+
+/*
+** CPaintBuffer - back buffers shared by the owner-drawn controls of a window
+** a control paints into a memory DC from the pool and copies the result to the screen, so
+** that controls don't flicker without each of them keeping a bitmap of its own; the bitmap
+** grows to the largest control painted so far and is reused by every control after it
+** the memory DC is clipped to the part of the control being painted, so a paint handler can
+** draw its whole control and still only pay for the part that changed
+** a second buffer is made only if a paint starts while another is in progress
+** the pool is not thread safe; use it from the UI thread only
+*/
+class CPaintBuffer
+{
+public:
+	CPaintBuffer();
+	~CPaintBuffer();
+
+	/*
+	** get a memory DC compatible with dc, with a bitmap of at least cx by cy selected into
+	** it and clipped to rcPaint
+	** the contents of the bitmap are undefined; paint all of rcPaint before copying it out
+	** hand the DC back with Release when done; never delete it
+	*/
+	HDC Acquire(HDC dc, int cx, int cy, const RECT &rcPaint);
+
+	/*
+	** hand a DC back to the pool
+	** anything the paint handler selected into the DC or changed about it is undone
+	*/
+	void Release(HDC hdc);
+
+	/*
+	** destroy the buffers that are not in use
+	** they are made again as they are needed; call this when the display changes, since
+	** each buffer is compatible with the DC it was first made for
+	*/
+	void Clear();
+
+private:
+	struct buffer
+	{
+		HDC hdc = NULL;
+		HBITMAP hbm = NULL;
+		HBITMAP hbmOld = NULL;	// the bitmap the DC was made with
+		int cx = 0;
+		int cy = 0;
+		int iSaved = 0;			// DC state to restore on release
+		bool bInUse = false;
+	};
+
+	static void destroy(buffer &b);
+
+	std::vector<buffer> m_vBuffers;
+
+	CPaintBuffer(const CPaintBuffer&) = delete;
+	CPaintBuffer& operator=(const CPaintBuffer&) = delete;
+}; // CPaintBuffer
@@ -418,10 +418,29 @@ void CShadow::UpdateShadow(
 	if (hbitmap == NULL)
 		return;	// CreateDIBSection was NOT successful
 
-	ZeroMemory(pvBits, bmi.bmiHeader.biSizeImage);
+	// the shadow depends on the parent window's region as well as its size
+	HRGN hParentRgn = CreateRectRgn(0, 0, WndRect.right - WndRect.left, WndRect.bottom - WndRect.top);
+	GetWindowRgn(hParent, hParentRgn);
+
+	CShadowCache::key key;
+	key.iWidth = nShadWndWid;
+	key.iHeight = nShadWndHei;
+	key.nSize = m_nSize;
+	key.nSharpness = m_nSharpness;
+	key.nDarkness = m_nDarkness;
+	key.nxOffset = m_nxOffset;
+	key.nyOffset = m_nyOffset;
+	key.clr = m_Color;
+	key.iRegion = CShadowCache::HashRegion(hParentRgn);
+	DeleteObject(hParentRgn);
 
-	// make shadow
-	MakeShadow((UINT32 *)pvBits, hParent, &WndRect);
+	// reuse a cached shadow if there is one, else make shadow
+	if (!CShadowCache::Get(key, (UINT32 *)pvBits))
+	{
+		ZeroMemory(pvBits, bmi.bmiHeader.biSizeImage);
+		MakeShadow((UINT32 *)pvBits, hParent, &WndRect);
+		CShadowCache::Put(key, (UINT32 *)pvBits);
+	}
 
 	HDC hMemDC = CreateCompatibleDC(NULL);
 	HBITMAP hOriBmp = (HBITMAP)SelectObject(hMemDC, hbitmap);
@@ -462,235 +481,39 @@ void CShadow::MakeShadow(
 )
 {
 	/*
-	** The shadow algorithm:
-	**
-	** 1. Get the region of parent window,
-	** 2. Apply morphologic erosion to shrink it into the size (ShadowWndSize - Sharpness)
-	** 3. Apply modified (with blur effect) morphologic dilation to make the blurred border
-	**
-	** The algorithm is optimized by assuming parent window is just "one piece" and without "wholes" on it
-	*/
-
-	/*
-	** STEP 1:
 	** Get the region of parent window,
 	** Create a full rectangle region in case of the window region is not defined
 	*/
 	HRGN hParentRgn = CreateRectRgn(0, 0, rcParent->right - rcParent->left, rcParent->bottom - rcParent->top);
 	GetWindowRgn(hParent, hParentRgn);
 
-	// Determine the Start and end point of each horizontal scan line
-	SIZE szParent = { rcParent->right - rcParent->left, rcParent->bottom - rcParent->top };
-	SIZE szShadow = { szParent.cx + 2 * m_nSize, szParent.cy + 2 * m_nSize };
-
-	// Extra 2 lines (set to be empty) in ptAnchors are used in dilation
-	int nAnchors = max(szParent.cy, szShadow.cy);	// # of anchor points pares
-	int(*ptAnchors)[2] = new int[nAnchors + 2][2];
-	int(*ptAnchorsOri)[2] = new int[szParent.cy][2];	// anchor points, will not modify during erosion
-	ptAnchors[0][0] = szParent.cx;
-	ptAnchors[0][1] = 0;
-	ptAnchors[nAnchors + 1][0] = szParent.cx;
-	ptAnchors[nAnchors + 1][1] = 0;
-
-	if (m_nSize > 0)
-	{
-		// Put the parent window anchors at the center
-		for (int i = 0; i < m_nSize; i++)
-		{
-			ptAnchors[i + 1][0] = szParent.cx;
-			ptAnchors[i + 1][1] = 0;
-			ptAnchors[szShadow.cy - i][0] = szParent.cx;
-			ptAnchors[szShadow.cy - i][1] = 0;
-		}
-
-		ptAnchors += m_nSize;
-	}
-
-	for (int i = 0; i < szParent.cy; i++)
-	{
-		// find start point
-		int j = 0;
-
-		for (j = 0; j < szParent.cx; j++)
-		{
-			if (PtInRegion(hParentRgn, j, i))
-			{
-				ptAnchors[i + 1][0] = j + m_nSize;
-				ptAnchorsOri[i][0] = j;
-				break;
-			}
-		}
-
-		if (j >= szParent.cx)
-		{
-			// Start point not found
-			ptAnchors[i + 1][0] = szParent.cx;
-			ptAnchorsOri[i][1] = 0;
-			ptAnchors[i + 1][0] = szParent.cx;
-			ptAnchorsOri[i][1] = 0;
-		}
-		else
-		{
-			// find end point
-			for (j = szParent.cx - 1; j >= ptAnchors[i + 1][0]; j--)
-			{
-				if (PtInRegion(hParentRgn, j, i))
-				{
-					ptAnchors[i + 1][1] = j + 1 + m_nSize;
-					ptAnchorsOri[i][1] = j + 1;
-					break;
-				}
-			}
-		}
-	}
-
-	if (m_nSize > 0)
-		ptAnchors -= m_nSize;	// Restore pos of ptAnchors for erosion
-
-	int(*ptAnchorsTmp)[2] = new int[nAnchors + 2][2];	// Store the result of erosion
+	std::vector<CShadowImage::rect> vRegion;
 
-														// First and last line should be empty
-	ptAnchorsTmp[0][0] = szParent.cx;
-	ptAnchorsTmp[0][1] = 0;
-	ptAnchorsTmp[nAnchors + 1][0] = szParent.cx;
-	ptAnchorsTmp[nAnchors + 1][1] = 0;
+	DWORD dwRgnData = GetRegionData(hParentRgn, 0, NULL);
+	std::vector<BYTE> vRgnData(dwRgnData);
+	RGNDATA *pRgnData = reinterpret_cast<RGNDATA *>(vRgnData.data());
 
-	/*
-	** STEP 2:
-	** perform morphologic erosion
-	*/
-
-	for (int i = 0; i < m_nSharpness - m_nSize; i++)
+	if (dwRgnData && GetRegionData(hParentRgn, dwRgnData, pRgnData))
 	{
-		for (int j = 1; j < nAnchors + 1; j++)
-		{
-			ptAnchorsTmp[j][0] = max(ptAnchors[j - 1][0], max(ptAnchors[j][0], ptAnchors[j + 1][0])) + 1;
-			ptAnchorsTmp[j][1] = min(ptAnchors[j - 1][1], min(ptAnchors[j][1], ptAnchors[j + 1][1])) - 1;
-		}
+		const RECT *pRects = reinterpret_cast<const RECT *>(pRgnData->Buffer);
+		vRegion.reserve(pRgnData->rdh.nCount);
 
-		// Exchange ptAnchors and ptAnchorsTmp;
-		int(*ptAnchorsXange)[2] = ptAnchorsTmp;
-		ptAnchorsTmp = ptAnchors;
-		ptAnchors = ptAnchorsXange;
+		for (DWORD k = 0; k < pRgnData->rdh.nCount; k++)
+			vRegion.push_back({ pRects[k].left, pRects[k].top, pRects[k].right, pRects[k].bottom });
 	}
 
-	/*
-	** STEP 3:
-	** perform morphologic dilation
-	*/
-
-	ptAnchors += (m_nSize < 0 ? -m_nSize : 0) + 1;	// now coordinates in ptAnchors are same as in shadow window
-
-													// Generate the kernel
-	int nKernelSize = m_nSize > m_nSharpness ? m_nSize : m_nSharpness;
-	int nCenterSize = m_nSize > m_nSharpness ? (m_nSize - m_nSharpness) : 0;
-	UINT32 *pKernel = new UINT32[(2 * nKernelSize + 1) * (2 * nKernelSize + 1)];
-	UINT32 *pKernelIter = pKernel;
-
-	for (int i = 0; i <= 2 * nKernelSize; i++)
-	{
-		for (int j = 0; j <= 2 * nKernelSize; j++)
-		{
-			double dLength = sqrt((i - nKernelSize) * (i - nKernelSize) + (j - nKernelSize) * (double)(j - nKernelSize));
-
-			if (dLength < nCenterSize)
-				*pKernelIter = m_nDarkness << 24 | PreMultiply(m_Color, m_nDarkness);
-			else
-				if (dLength <= nKernelSize)
-				{
-					UINT32 nFactor = ((UINT32)((1 - (dLength - nCenterSize) / (m_nSharpness + 1)) * m_nDarkness));
-					*pKernelIter = nFactor << 24 | PreMultiply(m_Color, nFactor);
-				}
-				else
-					*pKernelIter = 0;
-
-			pKernelIter++;
-		}
-	}
-
-	// Generate blurred border
-	for (int i = nKernelSize; i < szShadow.cy - nKernelSize; i++)
-	{
-		int j = 0;
-
-		if (ptAnchors[i][0] < ptAnchors[i][1])
-		{
-			// Start of line
-			for (j = ptAnchors[i][0]; j < min(max(ptAnchors[i - 1][0], ptAnchors[i + 1][0]) + 1, ptAnchors[i][1]); j++)
-			{
-				for (int k = 0; k <= 2 * nKernelSize; k++)
-				{
-					UINT32 *pPixel = pShadBits + (szShadow.cy - i - 1 + nKernelSize - k) * szShadow.cx + j - nKernelSize;
-					UINT32 *pKernelPixel = pKernel + k * (2 * nKernelSize + 1);
-
-					for (int l = 0; l <= 2 * nKernelSize; l++)
-					{
-						if (*pPixel < *pKernelPixel)
-							*pPixel = *pKernelPixel;
-
-						pPixel++;
-						pKernelPixel++;
-					}
-				}
-			} // for() start of line
-
-			  // End of line
-			for (j = max(j, min(ptAnchors[i - 1][1], ptAnchors[i + 1][1]) - 1); j < ptAnchors[i][1]; j++)
-			{
-				for (int k = 0; k <= 2 * nKernelSize; k++)
-				{
-					UINT32 *pPixel = pShadBits +
-						(szShadow.cy - i - 1 + nKernelSize - k) * szShadow.cx + j - nKernelSize;
-					UINT32 *pKernelPixel = pKernel + k * (2 * nKernelSize + 1);
-					for (int l = 0; l <= 2 * nKernelSize; l++)
-					{
-						if (*pPixel < *pKernelPixel)
-							*pPixel = *pKernelPixel;
-						pPixel++;
-						pKernelPixel++;
-					}
-				}
-			} // for() end of line
-
-		}
-	} // for() Generate blurred border
-
-	  // Erase unwanted parts and complement missing
-	UINT32 clCenter = m_nDarkness << 24 | PreMultiply(m_Color, m_nDarkness);
-
-	for (int i = min(nKernelSize, max(m_nSize - m_nyOffset, 0)); i < max(szShadow.cy - nKernelSize, min(szParent.cy + m_nSize - m_nyOffset, szParent.cy + 2 * m_nSize)); i++)
-	{
-		UINT32 *pLine = pShadBits + (szShadow.cy - i - 1) * szShadow.cx;
-
-		if (i - m_nSize + m_nyOffset < 0 || i - m_nSize + m_nyOffset >= szParent.cy)
-		{
-			// Line is not covered by parent window
-			for (int j = ptAnchors[i][0]; j < ptAnchors[i][1]; j++)
-			{
-				*(pLine + j) = clCenter;
-			}
-		}
-		else
-		{
-			for (int j = ptAnchors[i][0]; j < min(ptAnchorsOri[i - m_nSize + m_nyOffset][0] + m_nSize - m_nxOffset, ptAnchors[i][1]); j++)
-				*(pLine + j) = clCenter;
-
-			for (int j = max(ptAnchorsOri[i - m_nSize + m_nyOffset][0] + m_nSize - m_nxOffset, 0); j < min(ptAnchorsOri[i - m_nSize + m_nyOffset][1] + m_nSize - m_nxOffset, szShadow.cx); j++)
-				*(pLine + j) = 0;
-
-			for (int j = max(ptAnchorsOri[i - m_nSize + m_nyOffset][1] + m_nSize - m_nxOffset, ptAnchors[i][0]); j < ptAnchors[i][1]; j++)
-				*(pLine + j) = clCenter;
-		}
-	}
-
-	// Delete used resources
-	delete[](ptAnchors - (m_nSize < 0 ? -m_nSize : 0) - 1);
-	delete[] ptAnchorsTmp;
-	delete[] ptAnchorsOri;
-	delete[] pKernel;
 	DeleteObject(hParentRgn);
 
-	return;
+	CShadowImage::properties shadow;
+	shadow.nSize = m_nSize;
+	shadow.nSharpness = m_nSharpness;
+	shadow.nDarkness = m_nDarkness;
+	shadow.nxOffset = m_nxOffset;
+	shadow.nyOffset = m_nyOffset;
+	shadow.clr = m_Color;
+
+	CShadowImage::Make(pShadBits, rcParent->right - rcParent->left, rcParent->bottom - rcParent->top,
+		vRegion, shadow);
 } // MakeShadow
 
   /*
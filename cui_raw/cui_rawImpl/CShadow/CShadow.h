@@ -51,6 +51,8 @@
 #include <math.h>
 #include <crtdbg.h>
 #include "../../CCriticalSection/CCriticalSection.h"
+#include "CShadowImage.h"
+#include "CShadowCache.h"
 
 /*
 ** CShadow - window shadow class
@@ -123,20 +125,6 @@ protected:
 
 private:
 
-	/*
-	** Helper to calculate the alpha-premultiled value for a pixel
-	*/
-	inline DWORD PreMultiply(
-		COLORREF cl,
-		unsigned char nAlpha
-	)
-	{
-		// It's strange that the byte order of RGB in 32b BMP is reverse to in COLORREF
-		return (GetRValue(cl) * (DWORD)nAlpha / 255) << 16 |
-			(GetGValue(cl) * (DWORD)nAlpha / 255) << 8 |
-			(GetBValue(cl) * (DWORD)nAlpha / 255);
-	} // PreMultiply
-
 	// Parent HWND and CShadow object pares, in order to find CShadow in ParentProc()
 	static std::map<HWND, CShadow *> s_Shadowmap;
 
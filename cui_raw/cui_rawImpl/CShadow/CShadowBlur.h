@@ -0,0 +1,222 @@
+//
+// CShadowBlur.h - shadow blur kernel - interface and implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define CSHADOWBLUR_SSE2
+#endif
+
+/*
+** CShadowBlur - paints the blurred border of a shadow
+** every pixel within the kernel radius of a source pixel gets the kernel value for its
+** distance to the nearest source pixel. Because kernel values only fall with distance, this
+** gives the same result as stamping a (2r+1)x(2r+1) max kernel on every source pixel, at a
+** fraction of the cost
+** the squared distance transform is separable: a horizontal pass works out the distance to
+** the nearest source pixel in the same row, and a vertical pass takes the minimum over the
+** rows within the radius; the vertical pass runs on 16-bit lanes (SSE2 where available) and
+** only over the blocks of columns near source pixels, so the inside of a large shadow costs nothing
+** the class has no platform dependencies
+*/
+class CShadowBlur
+{
+public:
+	// a run of source pixels in one row of the bitmap
+	struct span
+	{
+		int iRow;
+		int iLeft;	// first pixel
+		int iRight;	// one past the last pixel
+	};
+
+	/*
+	** paint the blurred border
+	** vLUT[d] is the pixel value at squared distance d, for d from 0 to iRadius * iRadius
+	** pixels further than iRadius from every source pixel are left untouched
+	** spans must lie within the bitmap
+	*/
+	static void Blur(
+		uint32_t *pBits,					// bitmap, iWidth * iHeight pixels, row by row
+		int iWidth,
+		int iHeight,
+		int iRadius,						// kernel radius
+		const std::vector<span> &vSpans,	// source pixels
+		const std::vector<uint32_t> &vLUT	// kernel values by squared distance
+	)
+	{
+		if (iWidth <= 0 || iHeight <= 0 || iRadius < 0 || vSpans.empty())
+			return;
+
+		// anything beyond the radius is as good as unreachable
+		const int iFar = (iRadius + 1) * (iRadius + 1);
+		const int16_t iCap = (int16_t)(iFar < 32767 ? iFar : 32767);
+
+		// the columns are worked on in blocks, and only blocks within the radius of a span
+		const int iBlock = 32;
+		const int iBlocks = (iWidth + iBlock - 1) / iBlock;
+
+		// 1. squared distance to the nearest source pixel in the same row
+		// only blocks that are worked on are allocated, from vPool; vRowBlocks holds the
+		// position of each row's blocks in the pool, or -1
+		std::vector<int16_t> vPool;
+		std::vector<int> vRowBlocks((size_t)iHeight * iBlocks, -1);
+		std::vector<unsigned char> vRowUsed(iHeight, 0);
+
+		int iTop = iHeight, iBottom = -1;
+
+		for (const auto &it : vSpans)
+		{
+			if (it.iLeft >= it.iRight)
+				continue;
+
+			vRowUsed[it.iRow] = 1;
+
+			if (it.iRow < iTop)
+				iTop = it.iRow;
+
+			if (it.iRow > iBottom)
+				iBottom = it.iRow;
+
+			const int iFrom = it.iLeft - iRadius > 0 ? it.iLeft - iRadius : 0;
+			const int iTo = it.iRight + iRadius < iWidth ? it.iRight + iRadius : iWidth;
+
+			for (int k = iFrom / iBlock; k <= (iTo - 1) / iBlock; k++)
+			{
+				int &iPos = vRowBlocks[(size_t)it.iRow * iBlocks + k];
+
+				if (iPos < 0)
+				{
+					iPos = (int)vPool.size();
+					vPool.resize(vPool.size() + iBlock, iCap);
+				}
+
+				int16_t *pBlock = &vPool[iPos];
+
+				const int iBlockFrom = k * iBlock > iFrom ? k * iBlock : iFrom;
+				const int iBlockTo = (k + 1) * iBlock < iTo ? (k + 1) * iBlock : iTo;
+
+				for (int c = iBlockFrom; c < iBlockTo; c++)
+				{
+					const int dx = c < it.iLeft ? it.iLeft - c : (c >= it.iRight ? c - it.iRight + 1 : 0);
+					const int16_t d = (int16_t)(dx * dx);
+
+					if (d < pBlock[c - k * iBlock])
+						pBlock[c - k * iBlock] = d;
+				}
+			}
+		}
+
+		if (iBottom < 0)
+			return;
+
+		// 2. minimum over the rows within the radius
+		std::vector<int16_t> vDist((size_t)iWidth, iCap);
+		std::vector<int> vBlockRows(iBlocks, 0);	// rows within the radius that work on each block
+		const int iRadiusSq = iRadius * iRadius;
+
+		const int iFirst = iTop - iRadius > 0 ? iTop - iRadius : 0;
+		const int iLast = iBottom + iRadius < iHeight - 1 ? iBottom + iRadius : iHeight - 1;
+
+		// keep count of the rows within the radius that work on each block as the window slides
+		auto count = [&](int rSrc, int iDelta)
+		{
+			if (rSrc < 0 || rSrc >= iHeight || !vRowUsed[rSrc])
+				return;
+
+			const int *pRowBlocks = &vRowBlocks[(size_t)rSrc * iBlocks];
+
+			for (int k = 0; k < iBlocks; k++)
+				vBlockRows[k] += (pRowBlocks[k] >= 0) ? iDelta : 0;
+		};
+
+		for (int rSrc = iFirst - iRadius; rSrc < iFirst + iRadius; rSrc++)
+			count(rSrc, 1);
+
+		for (int r = iFirst; r <= iLast; r++)
+		{
+			const int rFrom = r - iRadius > 0 ? r - iRadius : 0;
+			const int rTo = r + iRadius < iHeight - 1 ? r + iRadius : iHeight - 1;
+
+			count(r + iRadius, 1);
+			count(r - iRadius - 1, -1);
+
+			int16_t *pDist = vDist.data();
+			uint32_t *pOut = pBits + (size_t)r * iWidth;
+
+			for (int k = 0; k < iBlocks; k++)
+			{
+				if (!vBlockRows[k])
+					continue;
+
+				const int iFrom = k * iBlock;
+				const int iTo = iFrom + iBlock < iWidth ? iFrom + iBlock : iWidth;
+
+				std::fill(pDist + iFrom, pDist + iTo, iCap);
+
+				for (int rSrc = rFrom; rSrc <= rTo; rSrc++)
+				{
+					const int iPos = vRowBlocks[(size_t)rSrc * iBlocks + k];
+
+					if (iPos < 0)
+						continue;
+
+					const int dy = rSrc - r;
+					minRow(pDist + iFrom, &vPool[iPos], (int16_t)(dy * dy), iTo - iFrom);
+				}
+
+				// 3. look up the kernel value
+				for (int c = iFrom; c < iTo; c++)
+				{
+					if (pDist[c] <= iRadiusSq)
+						pOut[c] = vLUT[pDist[c]];
+				}
+			}
+		}
+	} // Blur
+
+private:
+	/*
+	** pDist[c] = min(pDist[c], pRow[c] + iAdd)
+	*/
+	static void minRow(int16_t *pDist, const int16_t *pRow, int16_t iAdd, int iWidth)
+	{
+		int c = 0;
+
+#if defined(CSHADOWBLUR_SSE2)
+		const __m128i vAdd = _mm_set1_epi16(iAdd);
+
+		for (; c + 8 <= iWidth; c += 8)
+		{
+			__m128i vRow = _mm_loadu_si128((const __m128i*)(pRow + c));
+			__m128i vDist = _mm_loadu_si128((const __m128i*)(pDist + c));
+			vDist = _mm_min_epi16(vDist, _mm_adds_epi16(vRow, vAdd));
+			_mm_storeu_si128((__m128i*)(pDist + c), vDist);
+		}
+#endif
+
+		// scalar fallback, and the tail
+		for (; c < iWidth; c++)
+		{
+			int d = pRow[c] + iAdd;
+
+			if (d > 32767)
+				d = 32767;
+
+			if (d < pDist[c])
+				pDist[c] = (int16_t)d;
+		}
+	} // minRow
+}; // CShadowBlur
@@ -0,0 +1,168 @@
+//
+// CShadowCache.cpp - shadow bitmap cache implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "CShadowCache.h"
+#include <cstring>
+
+/*
+** initialize variables
+*/
+std::list<CShadowCache::entry> CShadowCache::s_lru;
+std::unordered_map<CShadowCache::key, std::list<CShadowCache::entry>::iterator, CShadowCache::keyHash> CShadowCache::s_index;
+CShadowCache::stats CShadowCache::s_stats;
+size_t CShadowCache::s_iCapacity = 32 * 1024 * 1024;
+CCriticalSection CShadowCache::s_locker;
+
+/*
+** FNV-1a hash
+*/
+static unsigned long long hashBytes(const void *pData, size_t iSize,
+	unsigned long long iHash = 14695981039346656037ULL)
+{
+	const unsigned char *p = static_cast<const unsigned char *>(pData);
+
+	for (size_t i = 0; i < iSize; i++)
+	{
+		iHash ^= p[i];
+		iHash *= 1099511628211ULL;
+	}
+
+	return iHash;
+} // hashBytes
+
+bool CShadowCache::key::operator==(const key &other) const
+{
+	return iWidth == other.iWidth &&
+		iHeight == other.iHeight &&
+		nSize == other.nSize &&
+		nSharpness == other.nSharpness &&
+		nDarkness == other.nDarkness &&
+		nxOffset == other.nxOffset &&
+		nyOffset == other.nyOffset &&
+		clr == other.clr &&
+		iRegion == other.iRegion;
+}
+
+size_t CShadowCache::keyHash::operator()(const key &k) const
+{
+	unsigned long long iHash = hashBytes(&k.iWidth, sizeof(k.iWidth));
+	iHash = hashBytes(&k.iHeight, sizeof(k.iHeight), iHash);
+	iHash = hashBytes(&k.nSize, sizeof(k.nSize), iHash);
+	iHash = hashBytes(&k.nSharpness, sizeof(k.nSharpness), iHash);
+	iHash = hashBytes(&k.nDarkness, sizeof(k.nDarkness), iHash);
+	iHash = hashBytes(&k.nxOffset, sizeof(k.nxOffset), iHash);
+	iHash = hashBytes(&k.nyOffset, sizeof(k.nyOffset), iHash);
+	iHash = hashBytes(&k.clr, sizeof(k.clr), iHash);
+	iHash = hashBytes(&k.iRegion, sizeof(k.iRegion), iHash);
+	return static_cast<size_t>(iHash);
+}
+
+bool CShadowCache::Get(const key &k, UINT32 *pBits)
+{
+	CCriticalSectionLocker lock(s_locker);
+
+	auto it = s_index.find(k);
+
+	if (it == s_index.end())
+	{
+		s_stats.iMisses++;
+		return false;
+	}
+
+	s_stats.iHits++;
+
+	// move to the front of the list
+	s_lru.splice(s_lru.begin(), s_lru, it->second);
+
+	const std::vector<UINT32> &vBits = it->second->vBits;
+	memcpy(pBits, vBits.data(), vBits.size() * sizeof(UINT32));
+	return true;
+} // Get
+
+void CShadowCache::Put(const key &k, const UINT32 *pBits)
+{
+	const size_t iPixels = (size_t)k.iWidth * (size_t)k.iHeight;
+	const size_t iBytes = iPixels * sizeof(UINT32);
+
+	CCriticalSectionLocker lock(s_locker);
+
+	if (iBytes == 0 || iBytes > s_iCapacity || s_index.find(k) != s_index.end())
+		return;
+
+	// make room
+	trim(s_iCapacity - iBytes);
+
+	entry e;
+	e.k = k;
+	e.vBits.assign(pBits, pBits + iPixels);
+
+	s_lru.push_front(std::move(e));
+	s_index[k] = s_lru.begin();
+	s_stats.iEntries++;
+	s_stats.iBytes += iBytes;
+} // Put
+
+void CShadowCache::SetCapacity(size_t iBytes)
+{
+	CCriticalSectionLocker lock(s_locker);
+
+	s_iCapacity = iBytes;
+	trim(iBytes);
+} // SetCapacity
+
+void CShadowCache::Clear()
+{
+	CCriticalSectionLocker lock(s_locker);
+
+	s_index.clear();
+	s_lru.clear();
+	s_stats.iEntries = 0;
+	s_stats.iBytes = 0;
+} // Clear
+
+CShadowCache::stats CShadowCache::GetStats()
+{
+	CCriticalSectionLocker lock(s_locker);
+
+	stats s = s_stats;
+	s.iCapacity = s_iCapacity;
+	return s;
+} // GetStats
+
+unsigned long long CShadowCache::HashRegion(HRGN hRgn)
+{
+	DWORD dwRgnData = GetRegionData(hRgn, 0, NULL);
+
+	if (!dwRgnData)
+		return 0;
+
+	std::vector<BYTE> vRgnData(dwRgnData);
+	RGNDATA *pRgnData = reinterpret_cast<RGNDATA *>(vRgnData.data());
+
+	if (!GetRegionData(hRgn, dwRgnData, pRgnData))
+		return 0;
+
+	// the rectangles are all that matter; the header holds the bounds and counts
+	return hashBytes(pRgnData->Buffer, pRgnData->rdh.nCount * sizeof(RECT));
+} // HashRegion
+
+void CShadowCache::trim(size_t iBytes)
+{
+	while (s_stats.iBytes > iBytes && !s_lru.empty())
+	{
+		const entry &e = s_lru.back();
+		s_stats.iBytes -= e.vBits.size() * sizeof(UINT32);
+		s_stats.iEntries--;
+		s_stats.iEvictions++;
+
+		s_index.erase(e.k);
+		s_lru.pop_back();
+	}
+} // trim
@@ -0,0 +1,105 @@
+//
+// CShadowCache.h - shadow bitmap cache interface
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include "../../CCriticalSection/CCriticalSection.h"
+
+/*
+** CShadowCache - process-wide cache of shadow bitmaps
+** tooltips, notifications and dialogs keep producing shadows of the same size and
+** properties, so generated bitmaps are kept and reused, the least recently used being
+** dropped once the cache goes over its memory limit
+** safe to use from multiple threads
+*/
+class CShadowCache
+{
+public:
+	// everything a shadow bitmap depends on
+	struct key
+	{
+		int iWidth = 0;					// shadow bitmap width
+		int iHeight = 0;				// shadow bitmap height
+		signed char nSize = 0;
+		unsigned char nSharpness = 0;
+		unsigned char nDarkness = 0;
+		signed char nxOffset = 0;
+		signed char nyOffset = 0;
+		COLORREF clr = 0;
+		unsigned long long iRegion = 0;	// hash of the parent window's region
+
+		bool operator==(const key &other) const;
+	};
+
+	struct stats
+	{
+		unsigned long long iHits = 0;
+		unsigned long long iMisses = 0;
+		unsigned long long iEvictions = 0;
+		size_t iEntries = 0;	// number of bitmaps in the cache
+		size_t iBytes = 0;		// memory used by the bitmaps
+		size_t iCapacity = 0;	// memory limit, in bytes
+	};
+
+	/*
+	** copy a cached bitmap into pBits
+	** returns false if there is no bitmap for the key
+	*/
+	static bool Get(const key &k, UINT32 *pBits);
+
+	/*
+	** add a bitmap to the cache
+	** bitmaps larger than the memory limit are not cached
+	*/
+	static void Put(const key &k, const UINT32 *pBits);
+
+	/*
+	** set the memory limit, in bytes; 0 disables the cache
+	** drops bitmaps as necessary
+	*/
+	static void SetCapacity(size_t iBytes);
+
+	// drop all bitmaps, statistics are kept
+	static void Clear();
+
+	// get cache statistics
+	static stats GetStats();
+
+	/*
+	** get a hash of a region's rectangles
+	** returns 0 if the region data cannot be retrieved
+	*/
+	static unsigned long long HashRegion(HRGN hRgn);
+
+private:
+	struct keyHash
+	{
+		size_t operator()(const key &k) const;
+	};
+
+	struct entry
+	{
+		key k;
+		std::vector<UINT32> vBits;
+	};
+
+	// drop least recently used bitmaps until the cache is within iBytes
+	static void trim(size_t iBytes);
+
+	static std::list<entry> s_lru;	// most recently used first
+	static std::unordered_map<key, std::list<entry>::iterator, keyHash> s_index;
+	static stats s_stats;
+	static size_t s_iCapacity;	// memory limit, in bytes
+	static CCriticalSection s_locker;
+}; // CShadowCache
@@ -0,0 +1,283 @@
+//
+// CShadowImage.h - shadow image - interface and implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include "CShadowBlur.h"
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+
+/*
+** CShadowImage - the pixels of a shadow window, from the rectangles of its parent's region
+** this is the part of CShadow::MakeShadow that does not talk to Windows; the class has no
+** platform dependencies
+*/
+class CShadowImage
+{
+public:
+	// a rectangle of the parent window's region, as GetRegionData gives it
+	struct rect
+	{
+		int left;
+		int top;
+		int right;
+		int bottom;
+	};
+
+	// the shadow's properties, as CShadow keeps them
+	struct properties
+	{
+		int nSize;				// shadow window size, relative to parent window size
+		int nSharpness;			// width of the blurred border
+		int nDarkness;			// transparency of the blurred area, 0 to 255
+		int nxOffset;
+		int nyOffset;
+		uint32_t clr;			// COLORREF, 0x00bbggrr
+	};
+
+	/*
+	** fill in the shadow bitmap, which is bottom up as CreateDIBSection makes it and has
+	** been cleared to zero
+	** pShadBits is (iParentWidth + 2 * nSize) * (iParentHeight + 2 * nSize) pixels
+	*/
+	static void Make(
+		uint32_t *pShadBits,
+		int iParentWidth,
+		int iParentHeight,
+		const std::vector<rect> &vRegion,	// the parent window's region
+		const properties &shadow
+	)
+	{
+		/*
+		** The shadow algorithm:
+		**
+		** 1. Get the region of parent window,
+		** 2. Apply morphologic erosion to shrink it into the size (ShadowWndSize - Sharpness)
+		** 3. Apply modified (with blur effect) morphologic dilation to make the blurred border
+		**
+		** The algorithm is optimized by assuming parent window is just "one piece" and without "wholes" on it
+		*/
+
+		const int nSize = shadow.nSize;
+		const int nSharpness = shadow.nSharpness;
+		const int nxOffset = shadow.nxOffset;
+		const int nyOffset = shadow.nyOffset;
+		const unsigned char nDarkness = (unsigned char)shadow.nDarkness;
+
+		// Determine the Start and end point of each horizontal scan line
+		const int cxParent = iParentWidth;
+		const int cyParent = iParentHeight;
+		const int cxShadow = cxParent + 2 * nSize;
+		const int cyShadow = cyParent + 2 * nSize;
+
+		// Extra 2 lines (set to be empty) in ptAnchors are used in dilation
+		const int nAnchors = cyParent > cyShadow ? cyParent : cyShadow;	// # of anchor points pares
+		std::vector<int> vAnchors(2 * (nAnchors + 2)), vAnchorsTmp(2 * (nAnchors + 2));
+		std::vector<int> vAnchorsOri(2 * (cyParent + 1));
+		int(*ptAnchors)[2] = reinterpret_cast<int(*)[2]>(vAnchors.data());
+		int(*ptAnchorsOri)[2] = reinterpret_cast<int(*)[2]>(vAnchorsOri.data());	// anchor points, will not modify during erosion
+		ptAnchors[0][0] = cxParent;
+		ptAnchors[0][1] = 0;
+		ptAnchors[nAnchors + 1][0] = cxParent;
+		ptAnchors[nAnchors + 1][1] = 0;
+
+		if (nSize > 0)
+		{
+			// Put the parent window anchors at the center
+			for (int i = 0; i < nSize; i++)
+			{
+				ptAnchors[i + 1][0] = cxParent;
+				ptAnchors[i + 1][1] = 0;
+				ptAnchors[cyShadow - i][0] = cxParent;
+				ptAnchors[cyShadow - i][1] = 0;
+			}
+
+			ptAnchors += nSize;
+		}
+
+		// the leftmost and rightmost points of each line come from the region's rectangles
+		for (int i = 0; i < cyParent; i++)
+		{
+			ptAnchorsOri[i][0] = cxParent;
+			ptAnchorsOri[i][1] = 0;
+		}
+
+		for (const auto &it : vRegion)
+		{
+			const int iLeft = it.left > 0 ? it.left : 0;
+			const int iRight = it.right < cxParent ? it.right : cxParent;
+
+			if (iLeft >= iRight)
+				continue;
+
+			const int iTop = it.top > 0 ? it.top : 0;
+			const int iBottom = it.bottom < cyParent ? it.bottom : cyParent;
+
+			for (int i = iTop; i < iBottom; i++)
+			{
+				if (iLeft < ptAnchorsOri[i][0])
+					ptAnchorsOri[i][0] = iLeft;
+
+				if (iRight > ptAnchorsOri[i][1])
+					ptAnchorsOri[i][1] = iRight;
+			}
+		}
+
+		for (int i = 0; i < cyParent; i++)
+		{
+			if (ptAnchorsOri[i][0] < ptAnchorsOri[i][1])
+			{
+				ptAnchors[i + 1][0] = ptAnchorsOri[i][0] + nSize;
+				ptAnchors[i + 1][1] = ptAnchorsOri[i][1] + nSize;
+			}
+			else
+			{
+				// line not covered by the region
+				ptAnchors[i + 1][0] = cxParent;
+				ptAnchors[i + 1][1] = 0;
+			}
+		}
+
+		if (nSize > 0)
+			ptAnchors -= nSize;	// Restore pos of ptAnchors for erosion
+
+		int(*ptAnchorsTmp)[2] = reinterpret_cast<int(*)[2]>(vAnchorsTmp.data());	// Store the result of erosion
+
+		// First and last line should be empty
+		ptAnchorsTmp[0][0] = cxParent;
+		ptAnchorsTmp[0][1] = 0;
+		ptAnchorsTmp[nAnchors + 1][0] = cxParent;
+		ptAnchorsTmp[nAnchors + 1][1] = 0;
+
+		/*
+		** STEP 2:
+		** perform morphologic erosion
+		*/
+
+		for (int i = 0; i < nSharpness - nSize; i++)
+		{
+			for (int j = 1; j < nAnchors + 1; j++)
+			{
+				ptAnchorsTmp[j][0] = max3(ptAnchors[j - 1][0], ptAnchors[j][0], ptAnchors[j + 1][0]) + 1;
+				ptAnchorsTmp[j][1] = min3(ptAnchors[j - 1][1], ptAnchors[j][1], ptAnchors[j + 1][1]) - 1;
+			}
+
+			// Exchange ptAnchors and ptAnchorsTmp;
+			int(*ptAnchorsXange)[2] = ptAnchorsTmp;
+			ptAnchorsTmp = ptAnchors;
+			ptAnchors = ptAnchorsXange;
+		}
+
+		/*
+		** STEP 3:
+		** perform morphologic dilation
+		*/
+
+		ptAnchors += (nSize < 0 ? -nSize : 0) + 1;	// now coordinates in ptAnchors are same as in shadow window
+
+		// Generate the kernel values by squared distance from the border
+		const int nKernelSize = nSize > nSharpness ? nSize : nSharpness;
+		const int nCenterSize = nSize > nSharpness ? (nSize - nSharpness) : 0;
+		std::vector<uint32_t> vKernel(nKernelSize * nKernelSize + 1);
+
+		for (size_t d = 0; d < vKernel.size(); d++)
+		{
+			double dLength = sqrt((double)d);
+
+			if (dLength < nCenterSize)
+				vKernel[d] = (uint32_t)nDarkness << 24 | PreMultiply(shadow.clr, nDarkness);
+			else
+			{
+				uint32_t nFactor = ((uint32_t)((1 - (dLength - nCenterSize) / (nSharpness + 1)) * nDarkness));
+				vKernel[d] = nFactor << 24 | PreMultiply(shadow.clr, nFactor);
+			}
+		}
+
+		// Collect the border pixels that the kernel is applied to
+		std::vector<CShadowBlur::span> vSpans;
+		vSpans.reserve(2 * (cyShadow > 0 ? cyShadow : 0));
+
+		for (int i = nKernelSize; i < cyShadow - nKernelSize; i++)
+		{
+			if (ptAnchors[i][0] < ptAnchors[i][1])
+			{
+				const int iRow = cyShadow - i - 1;
+
+				// Start of line
+				int j = min2(max2(ptAnchors[i - 1][0], ptAnchors[i + 1][0]) + 1, ptAnchors[i][1]);
+
+				if (ptAnchors[i][0] < j)
+					vSpans.push_back({ iRow, ptAnchors[i][0], j });
+
+				j = max2(j, ptAnchors[i][0]);
+
+				// End of line
+				j = max2(j, min2(ptAnchors[i - 1][1], ptAnchors[i + 1][1]) - 1);
+
+				if (j < ptAnchors[i][1])
+					vSpans.push_back({ iRow, j, ptAnchors[i][1] });
+			}
+		}
+
+		// Generate blurred border
+		CShadowBlur::Blur(pShadBits, cxShadow, cyShadow, nKernelSize, vSpans, vKernel);
+
+		// Erase unwanted parts and complement missing
+		const uint32_t clCenter = (uint32_t)nDarkness << 24 | PreMultiply(shadow.clr, nDarkness);
+
+		for (int i = min2(nKernelSize, max2(nSize - nyOffset, 0)); i < max2(cyShadow - nKernelSize, min2(cyParent + nSize - nyOffset, cyParent + 2 * nSize)); i++)
+		{
+			uint32_t *pLine = pShadBits + (cyShadow - i - 1) * cxShadow;
+
+			if (i - nSize + nyOffset < 0 || i - nSize + nyOffset >= cyParent)
+			{
+				// Line is not covered by parent window
+				for (int j = ptAnchors[i][0]; j < ptAnchors[i][1]; j++)
+				{
+					*(pLine + j) = clCenter;
+				}
+			}
+			else
+			{
+				for (int j = ptAnchors[i][0]; j < min2(ptAnchorsOri[i - nSize + nyOffset][0] + nSize - nxOffset, ptAnchors[i][1]); j++)
+					*(pLine + j) = clCenter;
+
+				for (int j = max2(ptAnchorsOri[i - nSize + nyOffset][0] + nSize - nxOffset, 0); j < min2(ptAnchorsOri[i - nSize + nyOffset][1] + nSize - nxOffset, cxShadow); j++)
+					*(pLine + j) = 0;
+
+				for (int j = max2(ptAnchorsOri[i - nSize + nyOffset][1] + nSize - nxOffset, ptAnchors[i][0]); j < ptAnchors[i][1]; j++)
+					*(pLine + j) = clCenter;
+			}
+		}
+	} // Make
+
+	/*
+	** Helper to calculate the alpha-premultiled value for a pixel
+	*/
+	static uint32_t PreMultiply(
+		uint32_t cl,
+		unsigned char nAlpha
+	)
+	{
+		// It's strange that the byte order of RGB in 32b BMP is reverse to in COLORREF
+		return ((cl & 0xff) * (uint32_t)nAlpha / 255) << 16 |
+			(((cl >> 8) & 0xff) * (uint32_t)nAlpha / 255) << 8 |
+			(((cl >> 16) & 0xff) * (uint32_t)nAlpha / 255);
+	} // PreMultiply
+
+private:
+	// the min and max macros of Windows.h get in the way of std::min and std::max
+	static int min2(int a, int b) { return a < b ? a : b; }
+	static int max2(int a, int b) { return a > b ? a : b; }
+	static int min3(int a, int b, int c) { return min2(a, min2(b, c)); }
+	static int max3(int a, int b, int c) { return max2(a, max2(b, c)); }
+}; // CShadowImage
@@ -30,17 +30,19 @@ LRESULT CALLBACK cui_rawImpl::ComboBoxControlProc(HWND hWnd, UINT msg, WPARAM wP
 
 		HDC dc;
 
+		// a DC passed in is painted in full
+		RECT rcPaint = rect;
+
 		if (wParam == 0)
+		{
 			dc = BeginPaint(hWnd, &ps);
+			rcPaint = ps.rcPaint;
+		}
 		else
 			dc = (HDC)wParam;
 
-		HDC hdc = CreateCompatibleDC(dc);
-
-		if (!pThis->hbm_buffer)
-			pThis->hbm_buffer = CreateCompatibleBitmap(dc, cx, cy);
-
-		HBITMAP hbmOld = SelectBitmap(hdc, pThis->hbm_buffer);
+		// use double buffering to avoid flicker; only the part being painted is drawn
+		HDC hdc = pThis->d->m_paint_buffer.Acquire(dc, cx, cy, rcPaint);
 
 		/////////////////////////////////////////////////////////////////////////
 		//	Mask off the borders and draw ComboBox normally
@@ -142,13 +144,14 @@ LRESULT CALLBACK cui_rawImpl::ComboBoxControlProc(HWND hWnd, UINT msg, WPARAM wP
 			}
 		}
 
-		BitBlt(dc, 0, 0, cx, cy, hdc, 0, 0, SRCCOPY);
+		BitBlt(dc, rcPaint.left, rcPaint.top,
+			rcPaint.right - rcPaint.left, rcPaint.bottom - rcPaint.top,
+			hdc, rcPaint.left, rcPaint.top, SRCCOPY);
 
 		if (wParam == 0)
 			EndPaint(hWnd, &ps);
 
-		SelectBitmap(hdc, hbmOld);
-		DeleteDC(hdc);
+		pThis->d->m_paint_buffer.Release(hdc);
 	}
 	return 0;
 
@@ -213,26 +216,8 @@ LRESULT CALLBACK cui_rawImpl::ComboBoxControlProc(HWND hWnd, UINT msg, WPARAM wP
 	}
 	break;
 
-	case WM_DESTROY:
-	{
-		// delete buffer, we're done
-		if (pThis->hbm_buffer)
-		{
-			DeleteBitmap(pThis->hbm_buffer);
-			pThis->hbm_buffer = NULL;
-		}
-	}
-	break;
-
 	case WM_SIZE:
 	{
-		// delete buffer, we need it recreated
-		if (pThis->hbm_buffer)
-		{
-			DeleteBitmap(pThis->hbm_buffer);
-			pThis->hbm_buffer = NULL;
-		}
-
 		InvalidateRect(hWnd, NULL, FALSE);
 	}
 	break;
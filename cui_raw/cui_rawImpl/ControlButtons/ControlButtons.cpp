@@ -43,13 +43,8 @@ LRESULT CALLBACK cui_rawImpl::ControlBtnProc(HWND hWnd, UINT msg, WPARAM wParam,
 		int cx = rc.right - rc.left;
 		int cy = rc.bottom - rc.top;
 
-		// use double buffering to avoid flicker
-		HDC hdc = CreateCompatibleDC(dc);
-
-		if (!pThis->hbm_buffer)
-			pThis->hbm_buffer = CreateCompatibleBitmap(dc, cx, cy);
-
-		HBITMAP hbmOld = SelectBitmap(hdc, pThis->hbm_buffer);
+		// use double buffering to avoid flicker; only the part being painted is drawn
+		HDC hdc = pThis->d->m_paint_buffer.Acquire(dc, cx, cy, ps.rcPaint);
 
 		int iSize = rc.right - rc.left;
 
@@ -168,12 +163,13 @@ LRESULT CALLBACK cui_rawImpl::ControlBtnProc(HWND hWnd, UINT msg, WPARAM wParam,
 			graphics.DrawRectangle(&pen, rect);
 		}
 
-		BitBlt(dc, 0, 0, cx, cy, hdc, 0, 0, SRCCOPY);
+		BitBlt(dc, ps.rcPaint.left, ps.rcPaint.top,
+			ps.rcPaint.right - ps.rcPaint.left, ps.rcPaint.bottom - ps.rcPaint.top,
+			hdc, ps.rcPaint.left, ps.rcPaint.top, SRCCOPY);
 
 		EndPaint(hWnd, &ps);
 
-		SelectBitmap(hdc, hbmOld);
-		DeleteDC(hdc);
+		pThis->d->m_paint_buffer.Release(hdc);
 	}
 	break;
 
@@ -187,26 +183,8 @@ LRESULT CALLBACK cui_rawImpl::ControlBtnProc(HWND hWnd, UINT msg, WPARAM wParam,
 	}
 	break;
 
-	case WM_DESTROY:
-	{
-		// delete buffer, we're done
-		if (pThis->hbm_buffer)
-		{
-			DeleteBitmap(pThis->hbm_buffer);
-			pThis->hbm_buffer = NULL;
-		}
-	}
-	break;
-
 	case WM_SIZE:
 	{
-		// delete buffer, we need it recreated
-		if (pThis->hbm_buffer)
-		{
-			DeleteBitmap(pThis->hbm_buffer);
-			pThis->hbm_buffer = NULL;
-		}
-
 		InvalidateRect(hWnd, NULL, TRUE);
 	}
 	break;
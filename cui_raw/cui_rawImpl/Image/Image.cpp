@@ -146,6 +146,87 @@ void fitRect(
 	return;
 } // fitRect
 
+/// <summary>
+/// Center a rectangle of a given size in another, without resizing it.
+/// </summary>
+/// 
+/// <param name="size">
+/// The size of the rectangle to center.
+/// </param>
+/// 
+/// <param name="rectTarget">
+/// The rectangle to center in.
+/// </param>
+/// 
+/// <param name="rectOut">
+/// The centered rectangle.
+/// </param>
+void centerRect(
+	const SIZE &size,
+	const RECT &rectTarget,
+	RECT &rectOut
+)
+{
+	rectOut.left = rectTarget.left + ((rectTarget.right - rectTarget.left) - size.cx) / 2;
+	rectOut.top = rectTarget.top + ((rectTarget.bottom - rectTarget.top) - size.cy) / 2;
+	rectOut.right = rectOut.left + size.cx;
+	rectOut.bottom = rectOut.top + size.cy;
+} // centerRect
+
+/// <summary>
+/// Check whether an image control is waiting for its first image from a file.
+/// </summary>
+/// 
+/// <param name="pControl">
+/// The image control.
+/// </param>
+/// 
+/// <returns>
+/// Returns true if a placeholder is to be drawn in place of the image.
+/// </returns>
+bool awaitingImage(
+	const cui_rawImpl::ImageControl* pControl
+)
+{
+	return !pControl->iPNGResource && !pControl->sFileName.empty() &&
+		!pControl->bLoadFailed && !pControl->m_pDisplaybitmap;
+} // awaitingImage
+
+/// <summary>
+/// Have the image of a control loaded from its file in the background, unless the image on
+/// show was made for the same rectangle. The control is sent the image loaded message when the
+/// image is ready.
+/// </summary>
+/// 
+/// <param name="pControl">
+/// The image control.
+/// </param>
+/// 
+/// <param name="rectTarget">
+/// The rectangle to fit the image into.
+/// </param>
+void requestImage(
+	cui_rawImpl::ImageControl* pControl,
+	const RECT &rectTarget
+)
+{
+	if (pControl->iPNGResource || pControl->sFileName.empty() || pControl->bLoadFailed)
+		return;
+
+	SIZE size;
+	size.cx = rectTarget.right - rectTarget.left;
+	size.cy = rectTarget.bottom - rectTarget.top;
+
+	if (pControl->m_pDisplaybitmap &&
+		size.cx == pControl->sizeLoaded.cx && size.cy == pControl->sizeLoaded.cy)
+		return;
+
+	// asking again for an image that is on its way costs nothing
+	pControl->sizeRequested = size;
+	pControl->d->m_image_loader.Request(reinterpret_cast<std::uintptr_t>(pControl->hWnd),
+		pControl->sFileName, size.cx, size.cy);
+} // requestImage
+
 static bool design = false;
 
 LRESULT CALLBACK cui_rawImpl::ImageProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
@@ -153,6 +234,30 @@ LRESULT CALLBACK cui_rawImpl::ImageProc(HWND hWnd, UINT msg, WPARAM wParam, LPAR
 	LONG_PTR ptr = GetWindowLongPtr(hWnd, GWLP_USERDATA);
 	cui_rawImpl::ImageControl* pControl = reinterpret_cast<cui_rawImpl::ImageControl*>(ptr);
 
+	if (msg == (UINT)pControl->d->m_iImageLoadedMsg)
+	{
+		// the image from file has been loaded in the background, swap it in
+		CImageLoader::pixels image;
+
+		if (pControl->d->m_image_loader.Collect(reinterpret_cast<std::uintptr_t>(hWnd), image))
+		{
+			if (pControl->m_pDisplaybitmap)
+			{
+				delete pControl->m_pDisplaybitmap;
+				pControl->m_pDisplaybitmap = NULL;
+			}
+
+			// an empty image means the file could not be read
+			pControl->m_pDisplaybitmap = CImageLoaderGdiplus::ToBitmap(image);
+			pControl->bLoadFailed = pControl->m_pDisplaybitmap == NULL;
+			pControl->sizeLoaded = pControl->sizeRequested;
+
+			InvalidateRect(hWnd, NULL, FALSE);
+		}
+
+		return 0;
+	}
+
 	switch (msg)
 	{
 	case WM_PAINT:
@@ -173,13 +278,8 @@ LRESULT CALLBACK cui_rawImpl::ImageProc(HWND hWnd, UINT msg, WPARAM wParam, LPAR
 			int cx = rcClient.right - rcClient.left;
 			int cy = rcClient.bottom - rcClient.top;
 
-			// use double buffering to avoid flicker
-			HDC hdc = CreateCompatibleDC(dc);
-
-			if (!pControl->hbm_buffer)
-				pControl->hbm_buffer = CreateCompatibleBitmap(dc, cx, cy);
-
-			HBITMAP hbmOld = SelectBitmap(hdc, pControl->hbm_buffer);
+			// use double buffering to avoid flicker; only the part being painted is drawn
+			HDC hdc = pControl->d->m_paint_buffer.Acquire(dc, cx, cy, ps.rcPaint);
 
 			Gdiplus::Graphics graphics(hdc);
 			Gdiplus::Color color;
@@ -252,19 +352,9 @@ LRESULT CALLBACK cui_rawImpl::ImageProc(HWND hWnd, UINT msg, WPARAM wParam, LPAR
 			if (!IsWindowEnabled(hWnd))
 				clrText = clrDarken(pControl->d->m_clrDisabled, 30);	// TO-DO: remove magic number
 
-			Gdiplus::FontFamily ffm(pControl->sFontName.c_str());
-			Gdiplus::Font* p_font = new Gdiplus::Font(&ffm,
+			Gdiplus::Font* p_font = pControl->d->m_gdiplus_cache.GetFont(pControl->sFontName,
 				static_cast<Gdiplus::REAL>(11.0 * pControl->iFontSize / 9));
 
-			if (p_font->GetLastStatus() != Gdiplus::Status::Ok)
-			{
-				delete p_font;
-				p_font = nullptr;
-				p_font = new Gdiplus::Font(pControl->sFontName.c_str(),
-					static_cast<Gdiplus::REAL>(11.0 * pControl->iFontSize / 9), Gdiplus::FontStyle::FontStyleRegular,
-					Gdiplus::UnitPoint, &pControl->d->m_font_collection);
-			}
-
 			// measure text rectangle
 			Gdiplus::RectF text_rect;
 			graphics.MeasureString((pControl->sText + L" ").c_str(), -1, p_font, text_rect, &text_rect);
@@ -325,9 +415,18 @@ LRESULT CALLBACK cui_rawImpl::ImageProc(HWND hWnd, UINT msg, WPARAM wParam, LPAR
 			}
 			else
 			{
-				// load image created from file
-				if (!pControl->m_pDisplaybitmap && pControl->GdiplusBitmap)	// load only once
-					pControl->m_pDisplaybitmap = ResizeGdiplusBitmap(pControl->GdiplusBitmap, rc, false, Quality::high, false, true, pControl->rcImage);
+				// image from file, loaded in the background; a placeholder takes its place meanwhile
+				requestImage(pControl, rc);
+
+				if (pControl->m_pDisplaybitmap)
+				{
+					SIZE size;
+					size.cx = (LONG)pControl->m_pDisplaybitmap->GetWidth();
+					size.cy = (LONG)pControl->m_pDisplaybitmap->GetHeight();
+					centerRect(size, rc, pControl->rcImage);
+				}
+				else
+					pControl->rcImage = rc;
 			}
 
 			// capture active rect
@@ -368,13 +467,9 @@ LRESULT CALLBACK cui_rawImpl::ImageProc(HWND hWnd, UINT msg, WPARAM wParam, LPAR
 					}
 
 					// draw text
-					color.SetFromCOLORREF(clrText);
-					Gdiplus::SolidBrush text_brush(color);
+					Gdiplus::SolidBrush* p_text_brush = pControl->d->m_gdiplus_cache.GetBrush(clrText);
 					graphics.DrawString(pControl->sText.c_str(),
-						-1, p_font, text_rect, &format, &text_brush);
-
-					delete p_font;
-					p_font = nullptr;
+						-1, p_font, text_rect, &format, p_text_brush);
 				}
 
 				{
@@ -382,19 +477,9 @@ LRESULT CALLBACK cui_rawImpl::ImageProc(HWND hWnd, UINT msg, WPARAM wParam, LPAR
 					format.SetAlignment(Gdiplus::StringAlignment::StringAlignmentNear);
 					format.SetTrimming(Gdiplus::StringTrimming::StringTrimmingEllipsisCharacter);
 
-					Gdiplus::FontFamily ffm(pControl->sFontNameDescription.c_str());
-					Gdiplus::Font* p_font_description = new Gdiplus::Font(&ffm,
+					Gdiplus::Font* p_font_description = pControl->d->m_gdiplus_cache.GetFont(pControl->sFontNameDescription,
 						static_cast<Gdiplus::REAL>(pControl->iFontSize));
 
-					if (p_font_description->GetLastStatus() != Gdiplus::Status::Ok)
-					{
-						delete p_font_description;
-						p_font_description = nullptr;
-						p_font_description = new Gdiplus::Font(pControl->sFontNameDescription.c_str(),
-							static_cast<Gdiplus::REAL>(pControl->iFontSize), Gdiplus::FontStyle::FontStyleRegular,
-							Gdiplus::UnitPoint, &pControl->d->m_font_collection);
-					}
-
 					RECT rcDescription = pControl->rcText;
 					rcDescription.top = rcDescription.bottom;
 					rcDescription.bottom = rcClient.bottom - iMargin;
@@ -419,13 +504,9 @@ LRESULT CALLBACK cui_rawImpl::ImageProc(HWND hWnd, UINT msg, WPARAM wParam, LPAR
 						graphics.FillRectangle(&brush, rect_description);
 					}
 
-					color.SetFromCOLORREF(clrLighten(clrText, 40));
-					Gdiplus::SolidBrush text_brush(color);
+					Gdiplus::SolidBrush* p_text_brush = pControl->d->m_gdiplus_cache.GetBrush(clrLighten(clrText, 40));
 					graphics.DrawString(pControl->sDescription.c_str(),
-						-1, p_font_description, rect_description, &format, &text_brush);
-
-					delete p_font_description;
-					p_font_description = nullptr;
+						-1, p_font_description, rect_description, &format, p_text_brush);
 				}
 			}
 
@@ -514,13 +595,21 @@ LRESULT CALLBACK cui_rawImpl::ImageProc(HWND hWnd, UINT msg, WPARAM wParam, LPAR
 					original = NULL;
 				}
 			}
+			else
+				if (awaitingImage(pControl))
+				{
+					// placeholder while the image is being loaded
+					graphics.FillRectangle(pControl->d->m_gdiplus_cache.GetBrush(clrDarken(clr_bk, 5)),
+						liblec::cui::gui_raw::cui_rawImpl::convert_rect(pControl->rcImage));
+				}
 
-			BitBlt(dc, 0, 0, cx, cy, hdc, 0, 0, SRCCOPY);
+			BitBlt(dc, ps.rcPaint.left, ps.rcPaint.top,
+				ps.rcPaint.right - ps.rcPaint.left, ps.rcPaint.bottom - ps.rcPaint.top,
+				hdc, ps.rcPaint.left, ps.rcPaint.top, SRCCOPY);
 
 			EndPaint(hWnd, &ps);
 
-			SelectBitmap(hdc, hbmOld);
-			DeleteDC(hdc);
+			pControl->d->m_paint_buffer.Release(hdc);
 		}
 		else
 		{
@@ -532,13 +621,8 @@ LRESULT CALLBACK cui_rawImpl::ImageProc(HWND hWnd, UINT msg, WPARAM wParam, LPAR
 			int cx = rcClient.right - rcClient.left;
 			int cy = rcClient.bottom - rcClient.top;
 
-			// use double buffering to avoid flicker
-			HDC hdc = CreateCompatibleDC(dc);
-
-			if (!pControl->hbm_buffer)
-				pControl->hbm_buffer = CreateCompatibleBitmap(dc, cx, cy);
-
-			HBITMAP hbmOld = SelectBitmap(hdc, pControl->hbm_buffer);
+			// use double buffering to avoid flicker; only the part being painted is drawn
+			HDC hdc = pControl->d->m_paint_buffer.Acquire(dc, cx, cy, ps.rcPaint);
 
 			Gdiplus::Graphics graphics(hdc);
 			Gdiplus::Color color;
@@ -640,19 +724,9 @@ LRESULT CALLBACK cui_rawImpl::ImageProc(HWND hWnd, UINT msg, WPARAM wParam, LPAR
 			if (!IsWindowEnabled(hWnd))
 				clrText = clrDarken(pControl->d->m_clrDisabled, 30);	// TO-DO: remove magic number
 
-			Gdiplus::FontFamily ffm(pControl->sFontName.c_str());
-			Gdiplus::Font* p_font = new Gdiplus::Font(&ffm,
+			Gdiplus::Font* p_font = pControl->d->m_gdiplus_cache.GetFont(pControl->sFontName,
 				static_cast<Gdiplus::REAL>(pControl->iFontSize));
 
-			if (p_font->GetLastStatus() != Gdiplus::Status::Ok)
-			{
-				delete p_font;
-				p_font = nullptr;
-				p_font = new Gdiplus::Font(pControl->sFontName.c_str(),
-					static_cast<Gdiplus::REAL>(pControl->iFontSize), Gdiplus::FontStyle::FontStyleRegular,
-					Gdiplus::UnitPoint, &pControl->d->m_font_collection);
-			}
-
 			// measure text rectangle
 			Gdiplus::RectF text_rect;
 			graphics.MeasureString((pControl->sText + L" ").c_str(), -1, p_font, text_rect, &text_rect);
@@ -669,7 +743,7 @@ LRESULT CALLBACK cui_rawImpl::ImageProc(HWND hWnd, UINT msg, WPARAM wParam, LPAR
 				if (pControl->iPNGResource)
 					bmp = pControl->GdiplusBitmap_res;
 				else
-					bmp = pControl->GdiplusBitmap;
+					bmp = pControl->m_pDisplaybitmap;	// images from files are loaded display sized
 
 				if (bmp)
 				{
@@ -713,13 +787,23 @@ LRESULT CALLBACK cui_rawImpl::ImageProc(HWND hWnd, UINT msg, WPARAM wParam, LPAR
 					break;
 				}
 
+				if (awaitingImage(pControl))
+				{
+					// square placeholder until the image has been loaded
+					imageSize.cx = min(rcDraw.right - rcDraw.left, rcDraw.bottom - rcDraw.top);
+					imageSize.cy = imageSize.cx;
+				}
+
 				// compute image placement
 				RECT rcImage = rcDraw;
 				rcImage.right = rcImage.left + imageSize.cx;
 				rcImage.bottom = rcImage.top + imageSize.cy;
 
 				// fit image
-				fitRect(rcImage, rcDraw, rcImage);
+				if (!pControl->iPNGResource && bmp)
+					centerRect(imageSize, rcDraw, rcImage);	// already made to fit
+				else
+					fitRect(rcImage, rcDraw, rcImage);
 
 				imageSize.cx = rcImage.right - rcImage.left;
 				imageSize.cy = rcImage.bottom - rcImage.top;
@@ -769,9 +853,18 @@ LRESULT CALLBACK cui_rawImpl::ImageProc(HWND hWnd, UINT msg, WPARAM wParam, LPAR
 				}
 				else
 				{
-					// load image created from file
-					if (!pControl->m_pDisplaybitmap && pControl->GdiplusBitmap)	// load only once
-						pControl->m_pDisplaybitmap = ResizeGdiplusBitmap(pControl->GdiplusBitmap, rcImage, false, Quality::high, false, true, pControl->rcImage);
+					// image from file, loaded in the background; a placeholder takes its place meanwhile
+					requestImage(pControl, pControl->bImageOnlyTightFit ? rcClient : rcDraw);
+
+					if (pControl->m_pDisplaybitmap && pControl->bImageOnlyTightFit)
+					{
+						SIZE size;
+						size.cx = (LONG)pControl->m_pDisplaybitmap->GetWidth();
+						size.cy = (LONG)pControl->m_pDisplaybitmap->GetHeight();
+						centerRect(size, rcClient, pControl->rcImage);
+					}
+					else
+						pControl->rcImage = rcImage;
 				}
 			}
 
@@ -953,13 +1046,9 @@ LRESULT CALLBACK cui_rawImpl::ImageProc(HWND hWnd, UINT msg, WPARAM wParam, LPAR
 					}
 
 					// draw text
-					color.SetFromCOLORREF(clrText);
-					Gdiplus::SolidBrush text_brush(color);
+					Gdiplus::SolidBrush* p_text_brush = pControl->d->m_gdiplus_cache.GetBrush(clrText);
 					graphics.DrawString(pControl->sText.c_str(),
-						-1, p_font, text_rect, &format, &text_brush);
-
-					delete p_font;
-					p_font = nullptr;
+						-1, p_font, text_rect, &format, p_text_brush);
 				}
 			}
 
@@ -1048,13 +1137,21 @@ LRESULT CALLBACK cui_rawImpl::ImageProc(HWND hWnd, UINT msg, WPARAM wParam, LPAR
 					original = NULL;
 				}
 			}
+			else
+				if (awaitingImage(pControl))
+				{
+					// placeholder while the image is being loaded
+					graphics.FillRectangle(pControl->d->m_gdiplus_cache.GetBrush(clrDarken(clr_bk, 5)),
+						liblec::cui::gui_raw::cui_rawImpl::convert_rect(pControl->rcImage));
+				}
 
-			BitBlt(dc, 0, 0, cx, cy, hdc, 0, 0, SRCCOPY);
+			BitBlt(dc, ps.rcPaint.left, ps.rcPaint.top,
+				ps.rcPaint.right - ps.rcPaint.left, ps.rcPaint.bottom - ps.rcPaint.top,
+				hdc, ps.rcPaint.left, ps.rcPaint.top, SRCCOPY);
 
 			EndPaint(hWnd, &ps);
 
-			SelectBitmap(hdc, hbmOld);
-			DeleteDC(hdc);
+			pControl->d->m_paint_buffer.Release(hdc);
 		}
 		break;
 
@@ -1088,12 +1185,8 @@ LRESULT CALLBACK cui_rawImpl::ImageProc(HWND hWnd, UINT msg, WPARAM wParam, LPAR
 
 	case WM_DESTROY:
 	{
-		// delete buffer, we're done
-		if (pControl->hbm_buffer)
-		{
-			DeleteBitmap(pControl->hbm_buffer);
-			pControl->hbm_buffer = NULL;
-		}
+		// an image still being loaded is of no use anymore
+		pControl->d->m_image_loader.Cancel(reinterpret_cast<std::uintptr_t>(hWnd));
 
 		// delete display bitmap, we're done
 		if (pControl->m_pDisplaybitmap)
@@ -1106,20 +1199,14 @@ LRESULT CALLBACK cui_rawImpl::ImageProc(HWND hWnd, UINT msg, WPARAM wParam, LPAR
 
 	case WM_SIZE:
 	{
-		// delete buffer, we need it recreated
-		if (pControl->m_pDisplaybitmap)
+		// delete the display bitmap of a PNG resource so that it's made again for the new size;
+		// an image from file stays on show until the one for the new size has been loaded
+		if (pControl->m_pDisplaybitmap && pControl->iPNGResource)
 		{
 			delete pControl->m_pDisplaybitmap;
 			pControl->m_pDisplaybitmap = NULL;
 		}
 
-		// delete buffer, we need it recreated
-		if (pControl->hbm_buffer)
-		{
-			DeleteBitmap(pControl->hbm_buffer);
-			pControl->hbm_buffer = NULL;
-		}
-
 		InvalidateRect(hWnd, NULL, FALSE);
 	}
 	break;
@@ -0,0 +1,110 @@
+//
+// CLineChartDecimate.h - line chart level of detail - interface and implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+/*
+** ClinechartDecimate - reduces a series to what a chart of a given width can show
+** the points between the first and the last are split into buckets and only the lowest and
+** highest point of each bucket are kept, in their original order, so peaks and troughs
+** survive the reduction no matter how many points share a pixel column
+** the class has no platform dependencies
+*/
+class ClinechartDecimate
+{
+public:
+	/*
+	** decimate a series using min/max bucketing
+	** pValues points to iCount contiguous values
+	** vIndices receives the indices of the points to keep, in ascending order; the first and
+	** the last point are always kept
+	** if iCount is no more than 2 * iBuckets every index is written, otherwise points 1 to
+	** iCount - 2 are split into iBuckets - 1 buckets, so that no more than 2 * iBuckets
+	** indices are written in all
+	*/
+	static void MinMax(
+		const double *pValues,		// the values
+		size_t iCount,				// number of values
+		size_t iBuckets,			// number of buckets, typically the plot width in pixels
+		std::vector<size_t> &vIndices	// indices of the points to keep
+	)
+	{
+		vIndices.clear();
+
+		if (iCount == 0)
+			return;
+
+		if (iBuckets == 0 || iCount <= 2 * iBuckets)
+		{
+			vIndices.resize(iCount);
+
+			for (size_t i = 0; i < iCount; i++)
+				vIndices[i] = i;
+
+			return;
+		}
+
+		vIndices.reserve(2 * iBuckets);
+		vIndices.push_back(0);
+
+		// the first and the last point take up the place of a bucket between them
+		const size_t iInner = iCount - 2;
+		const size_t iInnerBuckets = iBuckets - 1;
+
+		for (size_t b = 0; b < iInnerBuckets; b++)
+		{
+			const size_t iStart = 1 + (b * iInner) / iInnerBuckets;
+			const size_t iEnd = 1 + ((b + 1) * iInner) / iInnerBuckets;
+
+			size_t iLow = iStart, iHigh = iStart;
+			extremes(pValues, iStart, iEnd, iLow, iHigh);
+
+			// keep the pair in the order in which the points occur
+			const size_t iFirst = iLow < iHigh ? iLow : iHigh;
+			const size_t iSecond = iLow < iHigh ? iHigh : iLow;
+
+			vIndices.push_back(iFirst);
+
+			if (iSecond != iFirst)
+				vIndices.push_back(iSecond);
+		}
+
+		vIndices.push_back(iCount - 1);
+	} // MinMax
+
+private:
+	/*
+	** find the indices of the lowest and highest values in [iStart, iEnd)
+	** the loop body has no branches so that the compiler can vectorize it
+	*/
+	static void extremes(const double *pValues, size_t iStart, size_t iEnd,
+		size_t &iLow, size_t &iHigh)
+	{
+		double dLow = pValues[iStart];
+		double dHigh = pValues[iStart];
+		iLow = iStart;
+		iHigh = iStart;
+
+		for (size_t i = iStart + 1; i < iEnd; i++)
+		{
+			const double v = pValues[i];
+			const bool bLower = v < dLow;
+			const bool bHigher = v > dHigh;
+
+			dLow = bLower ? v : dLow;
+			iLow = bLower ? i : iLow;
+			dHigh = bHigher ? v : dHigh;
+			iHigh = bHigher ? i : iHigh;
+		}
+	} // extremes
+}; // ClinechartDecimate
@@ -0,0 +1,168 @@
+//
+// CLineChartSeries.h - line chart series ring buffer - interface and implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <cstddef>
+#include <utility>
+
+/*
+** ClinechartSeriesT - the points of a line chart series
+** points are kept in a ring buffer so that appending to a full series drops the oldest
+** point in O(1), and the lowest and highest values are tracked as points come and go
+** so that autoscaling does not need to scan the series
+** T must have a dValue member; the class has no platform dependencies
+*/
+template <typename T>
+class ClinechartSeriesT
+{
+public:
+	ClinechartSeriesT(size_t iCapacity = 0) :
+		m_iHead(0),
+		m_iSize(0),
+		m_iCapacity(iCapacity),
+		m_iAppended(0)
+	{
+		if (m_iCapacity)
+			m_vPoints.reserve(m_iCapacity);
+	}
+
+	/*
+	** set the maximum number of points, 0 for no limit
+	** the oldest points are dropped if there are more points than the new capacity
+	*/
+	void SetCapacity(size_t iCapacity)
+	{
+		std::vector<T> vPoints;
+		vPoints.reserve(iCapacity ? iCapacity : m_iSize);
+
+		const size_t iDrop = (iCapacity && m_iSize > iCapacity) ? m_iSize - iCapacity : 0;
+
+		for (size_t i = iDrop; i < m_iSize; i++)
+			vPoints.push_back(std::move(at(i)));
+
+		const unsigned long long iAppended = m_iAppended;
+
+		m_iCapacity = iCapacity;
+		Clear();
+
+		// keep the sequence numbers of the points that remain
+		m_iAppended = iAppended - vPoints.size();
+
+		for (auto &it : vPoints)
+			Append(std::move(it));
+	}
+
+	// get the maximum number of points, 0 if there is no limit
+	size_t Capacity() const { return m_iCapacity; }
+
+	// get the number of points
+	size_t Size() const { return m_iSize; }
+
+	// check whether the series has no points
+	bool Empty() const { return m_iSize == 0; }
+
+	// get the number of points ever appended, including those that have been dropped
+	unsigned long long Appended() const { return m_iAppended; }
+
+	/*
+	** remove all points
+	*/
+	void Clear()
+	{
+		m_vPoints.clear();
+		m_iHead = 0;
+		m_iSize = 0;
+		m_iAppended = 0;
+		m_dqMin.clear();
+		m_dqMax.clear();
+	}
+
+	/*
+	** append a point, dropping the oldest point if the series is full
+	*/
+	void Append(T pt)
+	{
+		const double dValue = pt.dValue;
+		const unsigned long long iSeq = m_iAppended++;
+
+		if (m_iCapacity == 0 || m_iSize < m_iCapacity)
+		{
+			m_vPoints.push_back(std::move(pt));
+			m_iSize++;
+		}
+		else
+		{
+			// overwrite the oldest point
+			m_vPoints[m_iHead] = std::move(pt);
+			m_iHead = (m_iHead + 1) % m_iCapacity;
+
+			// forget the dropped point's value
+			const unsigned long long iDropped = iSeq - m_iCapacity;
+
+			if (!m_dqMin.empty() && m_dqMin.front().first == iDropped)
+				m_dqMin.pop_front();
+
+			if (!m_dqMax.empty() && m_dqMax.front().first == iDropped)
+				m_dqMax.pop_front();
+		}
+
+		// keep the candidates for lowest and highest value in order
+		while (!m_dqMin.empty() && m_dqMin.back().second >= dValue)
+			m_dqMin.pop_back();
+
+		m_dqMin.push_back(std::make_pair(iSeq, dValue));
+
+		while (!m_dqMax.empty() && m_dqMax.back().second <= dValue)
+			m_dqMax.pop_back();
+
+		m_dqMax.push_back(std::make_pair(iSeq, dValue));
+	}
+
+	/*
+	** get a point, 0 being the oldest
+	*/
+	const T& operator[](size_t i) const
+	{
+		return m_vPoints[m_iCapacity ? (m_iHead + i) % m_iCapacity : i];
+	}
+
+	/*
+	** get the lowest and highest values
+	** returns false if the series is empty
+	*/
+	bool GetRange(double &dMin, double &dMax) const
+	{
+		if (m_dqMin.empty() || m_dqMax.empty())
+			return false;
+
+		dMin = m_dqMin.front().second;
+		dMax = m_dqMax.front().second;
+		return true;
+	}
+
+private:
+	T& at(size_t i)
+	{
+		return m_vPoints[m_iCapacity ? (m_iHead + i) % m_iCapacity : i];
+	}
+
+	std::vector<T> m_vPoints;		// points, the oldest at m_iHead once the buffer wraps
+	size_t m_iHead;					// index of the oldest point
+	size_t m_iSize;					// number of points
+	size_t m_iCapacity;				// maximum number of points, 0 for no limit
+	unsigned long long m_iAppended;	// number of points ever appended
+
+	// (sequence number, value) of the points that can still become the lowest or highest value
+	std::deque<std::pair<unsigned long long, double>> m_dqMin;
+	std::deque<std::pair<unsigned long long, double>> m_dqMax;
+}; // ClinechartSeriesT
@@ -9,8 +9,8 @@
 //
 
 #include "../cui_rawImpl.h"
+#include "../CChartScene/CChartSceneRender.h"
 #include "../../clrAdjust/clrAdjust.h"
-#include "../../reverse.h"
 
 /*
 ** double to int (rounds off instead of truncating)
@@ -37,447 +37,116 @@ static std::basic_string<TCHAR> round_off(double number, int decimal_places)
 	return std::basic_string<TCHAR>(sPerc_rounded.begin(), sPerc_rounded.end());
 }
 
-/////////////////////////////////////////////////////////////////////
-
-// chart parameters
-struct chartParams
-{
-	int iLowerLimit = 0;
-	int iUpperLimit = 0;
-	int iNumberOfLines = 0;
-};
-
 /*
-** ensures that the lower limit
-** - is less than supplied value
-** - is divisible by 5
+** get the indices of the points of a line that are worth drawing on a plot iWidth pixels wide
+** the result is cached in the line until the series or the width changes
 */
-static int adjustLowerLimit(int iLowest)
+static const std::vector<size_t>& getLineLod(cui_rawImpl::chartLine &line, int iWidth)
 {
-	int iNewLowerLimit = 0;
-
-	if ((iLowest % 5) == 0)
+	if (line.iLodWidth != iWidth ||
+		line.iLodAppended != line.values.Appended() ||
+		line.iLodSize != line.values.Size())
 	{
-		// calculate new lower limit
-		iNewLowerLimit = iLowest - 5;
+		// the kernel works on contiguous values
+		std::vector<double> vValues(line.values.Size());
 
-		if (iNewLowerLimit < 0)
-			iNewLowerLimit = 0;
-	}
-	else
-	{
-		// calculate new lower limit
-		iNewLowerLimit = iLowest;
+		for (size_t i = 0; i < vValues.size(); i++)
+			vValues[i] = line.values[i].dValue;
 
-		do
-		{
-			iNewLowerLimit--;
-		} while ((iNewLowerLimit % 5) != 0);
-	}
+		ClinechartDecimate::MinMax(vValues.data(), vValues.size(),
+			iWidth > 0 ? (size_t)iWidth : 0, line.vLod);
 
-	return iNewLowerLimit;
-} // adjustLowerLimit
-
-  /*
-  ** ensures that the upper limit
-  ** - is greater than supplied value
-  ** - is divisible by 5
-  */
-static int adjustUpperLimit(int iHighest)
-{
-	int iNewUpperLimit = 0;
-
-	if ((iHighest % 5) == 0)
-	{
-		// calculate new upper limit
-		iNewUpperLimit = iHighest;
+		line.iLodWidth = iWidth;
+		line.iLodAppended = line.values.Appended();
+		line.iLodSize = line.values.Size();
 	}
-	else
-	{
-		// calculate new upper limit
-		iNewUpperLimit = iHighest;
 
-		do
-		{
-			iNewUpperLimit++;
-		} while ((iNewUpperLimit % 5) != 0);
-	}
+	return line.vLod;
+} // getLineLod
 
-	return iNewUpperLimit;
-} // adjustUpperLimit
+static bool design = false;
+static bool border = true;
 
-static bool isRangeOk(int iLowerValue, int iUpperValue)
+/*
+** lay out the frame and the series labels again if the series, size or fonts have changed since
+** they were last laid out
+** returns true if they were laid out again, in which case all of the chart needs painting
+*/
+static bool buildScene(Gdiplus::Graphics &graphics, const RECT &rcClient, cui_rawImpl::LineChartControl* pState)
 {
-	if (iLowerValue < iUpperValue)
-		return true;
-	else
+	CChartScene::chart info;
+	info.fWidth = static_cast<float>(rcClient.right - rcClient.left);
+	info.fHeight = static_cast<float>(rcClient.bottom - rcClient.top);
+	info.sFontName = pState->sFontName;
+	info.fFontSize = static_cast<float>(pState->iFontSize);
+	info.dFontScale = pState->d->m_DPIScale;
+
+	if (pState->bLayoutCaptured && pState->scene.IsValid(info))
 		return false;
-} // isRangeOk
-
-  /*
-  ** iLowerLimit and iUpperLimit must be multiples of 5 first!!!!!
-  ** works best for a range < 1000
-  ** TO-DO: remove magic numbers
-  */
-static void calcParams(
-	const int iLowerLimit,
-	const int iUpperLimit,
-	int &iNumberOfLines
-)
-{
-	int iRange = iUpperLimit - iLowerLimit;
-
-	double dSeperator = 200;
-
-	// less than 1000
-	if (iRange <= 1000)
-		dSeperator = 100;
-
-	if (iRange <= 500)
-		dSeperator = 50;
 
-	if (iRange <= 200)
-		dSeperator = 20;
+	info.sTitle = pState->sChartName;
+	info.sXaxisLabel = pState->sXaxisLabel;
+	info.sYaxisLabel = pState->sYaxisLabel;
 
-	// less than 100
-	if (iRange <= 100)
-		dSeperator = 10;
+	std::vector<std::wstring> vSeries;
+	vSeries.reserve(pState->vLines.size());
 
-	if (iRange <= 50)
-		dSeperator = 5;
+	for (const auto &it : pState->vLines)
+		vSeries.push_back(it.sSeriesName);
 
-	if (iRange <= 20)
-		dSeperator = 2;
+	CChartScene &scene = pState->scene;
+	scene.BuildLineChart(info, vSeries,
+		CChartSceneRender::Measurer(graphics, pState->d->m_gdiplus_cache, pState->sFontName));
 
-	// less than 10
-	if (iRange <= 10)
-		dSeperator = 1;
+	// capture the layout for plot-only paints: the space between the title, the axis labels
+	// and the series labels
+	const CChartScene::frame &frame = scene.Frame();
+	pState->rcPlot.left = static_cast<LONG>(frame.yAxisLabel.rcLayout.right());
+	pState->rcPlot.top = static_cast<LONG>(frame.title.rcLayout.bottom());
+	pState->rcPlot.right = static_cast<LONG>(frame.rcLegend.x);
+	pState->rcPlot.bottom = static_cast<LONG>(frame.xAxisLabel.rcLayout.y);
+	pState->bLayoutCaptured = true;
 
-	if (iRange <= 5)
-		dSeperator = 0.5;
+	// the plot may have changed width, and with it the points that are drawn
+	pState->bPointInfoStale = true;
+	return true;
+} // buildScene
 
-	if (iRange <= 2)
-		dSeperator = 0.3;
-
-	// less than 1
-	if (iRange <= 1)
-		dSeperator = 0.1;
-
-	iNumberOfLines = int((iRange / dSeperator) + 0.5);
-} // calcParams
-
-  /*
-  ** calculate chart parameters
-  ** returns true if successful, else returns false
-  */
-static bool calcChartParams(
-	const double dLowest,
-	const double dHighest,
-	chartParams &params
-)
-{
-	int iLowest = (int)dLowest;				// truncate
-	int iHighest = (int)(dHighest + 0.5);	// round off
-
-											// clear params
-	params = {};
-
-	if (isRangeOk(iLowest, iHighest))
-	{
-		int iLowerLimit = adjustLowerLimit(iLowest);
-		int iUpperLimit = adjustUpperLimit(iHighest);
-
-		int iNumberOfLines = 0;
-
-		calcParams(iLowerLimit, iUpperLimit, iNumberOfLines);
-
-		// write back parameters
-		params.iLowerLimit = iLowerLimit;
-		params.iNumberOfLines = iNumberOfLines;
-		params.iUpperLimit = iUpperLimit;
-
-		return true;
-	}
-	else
-		return false;
-} // calcChartParams
-
-static bool design = false;
-static bool border = true;
-
-static void DrawChart(HWND hGraph, HDC hdc, cui_rawImpl::LineChartControl* pState)
+/*
+** draw the chart into the part of the buffer given by rcPaint
+** the rest of the buffer is left as the last paint left it
+*/
+static void DrawChart(HWND hGraph, HDC hdc, cui_rawImpl::LineChartControl* pState, RECT rcPaint)
 {
 	Gdiplus::Graphics graphics(hdc);
 	Gdiplus::Color color;
-	color.SetFromCOLORREF(pState->d->m_clrBackground);
-	graphics.Clear(color);
 
 	// get control coordinates
 	RECT rectChartControl;
 	GetClientRect(hGraph, &rectChartControl);
 
-	const int absolute_right = rectChartControl.right;
-
-	// 1. draw bounding rectangle for chart control
-	if (border)
-	{
-		RECT rcBorder = rectChartControl;
-		InflateRect(&rcBorder, -1, -1);
+	if (buildScene(graphics, rectChartControl, pState))
+		rcPaint = rectChartControl;
 
-		Gdiplus::RectF rect = liblec::cui::gui_raw::cui_rawImpl::convert_rect(rcBorder);
-
-		color.SetFromCOLORREF(RGB(200, 200, 200));
-		Gdiplus::Pen pen(color, 1);
-		pen.SetAlignment(Gdiplus::PenAlignment::PenAlignmentCenter);
-		graphics.DrawRectangle(&pen, rect);
-	}
+	const int absolute_right = rectChartControl.right;
 
 	int iWidth = rectChartControl.right - rectChartControl.left;
 	int iHeight = rectChartControl.bottom - rectChartControl.top;
 
-	Gdiplus::REAL top = 0.0f;
-
-	// draw chart title
-	{
-		RECT rectTitle;
-		rectTitle.top = rectChartControl.top + 2;
-		rectTitle.bottom = rectTitle.top;	// make height 0 so MeasureString can figure it out
-		rectTitle.left = rectChartControl.left + 2;
-		rectTitle.right = rectChartControl.right - 2;
-
-		Gdiplus::RectF layoutRect = liblec::cui::gui_raw::cui_rawImpl::convert_rect(rectTitle);
-
-		Gdiplus::FontFamily ffm(pState->sFontName.c_str());
-		Gdiplus::Font* p_font = new Gdiplus::Font(&ffm, 11);
-
-		if (p_font->GetLastStatus() != Gdiplus::Status::Ok)
-		{
-			delete p_font;
-			p_font = nullptr;
-			p_font = new Gdiplus::Font(pState->sFontName.c_str(),
-				11, Gdiplus::FontStyle::FontStyleRegular, Gdiplus::UnitPoint, &pState->d->m_font_collection);
-		}
-
-		color.SetFromCOLORREF(RGB(0, 120, 200));
-		Gdiplus::SolidBrush text_brush(color);
-
-		Gdiplus::StringFormat format;
-		format.SetAlignment(Gdiplus::StringAlignment::StringAlignmentNear);
-		format.SetTrimming(Gdiplus::StringTrimming::StringTrimmingEllipsisCharacter);
-		format.SetFormatFlags(Gdiplus::StringFormatFlags::StringFormatFlagsNoWrap);
-
-		// measure text rectangle
-		Gdiplus::RectF text_rect;
-		graphics.MeasureString(pState->sChartName.c_str(), -1, p_font, layoutRect, &text_rect);
-
-		if (true)
-		{
-			if (text_rect.Width < layoutRect.Width)
-				text_rect.Width = min(text_rect.Width * 1.01f, layoutRect.Width);
-		}
-
-		layoutRect.Height = text_rect.Height;
-
-		// align the text rectangle to the layout rectangle
-		liblec::cui::gui_raw::cui_rawImpl::align_text(text_rect, layoutRect,
-			liblec::cui::gui_raw::cui_raw::textAlignment::middle);
-
-		if (design)
-		{
-			color.SetFromCOLORREF(RGB(240, 240, 240));
-			Gdiplus::SolidBrush brush(color);
-			graphics.FillRectangle(&brush, layoutRect);
-
-			color.SetFromCOLORREF(RGB(230, 230, 230));
-			brush.SetColor(color);
-			graphics.FillRectangle(&brush, text_rect);
-		}
-
-		// draw text
-		graphics.DrawString(pState->sChartName.c_str(),
-			-1, p_font, text_rect, &format, &text_brush);
-
-		delete p_font;
-		p_font = nullptr;
-
-		top = layoutRect.GetBottom();
-	}
-
-	Gdiplus::REAL bottom = 0.0f;
-
-	// label x-axis
-	{
-		Gdiplus::RectF layoutRect;
-		layoutRect.X = 0;
-		layoutRect.Y = 0;
-		layoutRect.Width =
-			static_cast<Gdiplus::REAL>(rectChartControl.right - rectChartControl.left - 2 * 4);
-		layoutRect.Height = 0;	// make 0 so measureString can figure it out
-
-		Gdiplus::FontFamily ffm(pState->sFontName.c_str());
-		Gdiplus::Font* p_font = new Gdiplus::Font(&ffm, 9);
-
-		if (p_font->GetLastStatus() != Gdiplus::Status::Ok)
-		{
-			delete p_font;
-			p_font = nullptr;
-			p_font = new Gdiplus::Font(pState->sFontName.c_str(),
-				9, Gdiplus::FontStyle::FontStyleRegular, Gdiplus::UnitPoint, &pState->d->m_font_collection);
-		}
-
-		color.SetFromCOLORREF(RGB(0, 0, 0));
-		Gdiplus::SolidBrush text_brush(color);
-
-		Gdiplus::StringFormat format;
-		format.SetAlignment(Gdiplus::StringAlignment::StringAlignmentNear);
-		format.SetTrimming(Gdiplus::StringTrimming::StringTrimmingEllipsisCharacter);
-		format.SetFormatFlags(Gdiplus::StringFormatFlags::StringFormatFlagsNoWrap);
-
-		// measure text rectangle
-		Gdiplus::RectF text_rect;
-		graphics.MeasureString(pState->sXaxisLabel.c_str(), -1, p_font, layoutRect, &text_rect);
-
-		if (true)
-		{
-			if (text_rect.Width < layoutRect.Width)
-				text_rect.Width = min(text_rect.Width * 1.01f, layoutRect.Width);
-		}
-
-		layoutRect.X = static_cast<Gdiplus::REAL>(rectChartControl.left + 4);
-		layoutRect.Y = static_cast<Gdiplus::REAL>(rectChartControl.bottom - 4) - text_rect.Height;
-		layoutRect.Height = text_rect.Height;
-
-		// align the text rectangle to the layout rectangle
-		liblec::cui::gui_raw::cui_rawImpl::align_text(text_rect, layoutRect,
-			liblec::cui::gui_raw::cui_raw::textAlignment::middle);
-
-		if (design)
-		{
-			color.SetFromCOLORREF(RGB(240, 240, 240));
-			Gdiplus::SolidBrush brush(color);
-			graphics.FillRectangle(&brush, layoutRect);
-
-			color.SetFromCOLORREF(RGB(230, 230, 230));
-			brush.SetColor(color);
-			graphics.FillRectangle(&brush, text_rect);
-		}
-
-		graphics.DrawString(pState->sXaxisLabel.c_str(),
-			-1, p_font, text_rect, &format, &text_brush);
-
-		delete p_font;
-		p_font = nullptr;
-
-		bottom = layoutRect.GetTop();
-	}
-
-	Gdiplus::REAL left = 0.0f;
-
-	// label y-axis
-	{
-		Gdiplus::RectF layoutRect;
-		layoutRect.X = static_cast<Gdiplus::REAL>(rectChartControl.left + 4);
-		layoutRect.Y = top + 4.0f;
-		layoutRect.Width = 0;
-		layoutRect.Height = 0;	// make 0 so measureString can figure it out
-
-		Gdiplus::FontFamily ffm(pState->sFontName.c_str());
-		Gdiplus::Font* p_font = new Gdiplus::Font(&ffm, 9);
-
-		if (p_font->GetLastStatus() != Gdiplus::Status::Ok)
-		{
-			delete p_font;
-			p_font = nullptr;
-			p_font = new Gdiplus::Font(pState->sFontName.c_str(),
-				9, Gdiplus::FontStyle::FontStyleRegular, Gdiplus::UnitPoint, &pState->d->m_font_collection);
-		}
-
-		color.SetFromCOLORREF(RGB(0, 0, 0));
-		Gdiplus::SolidBrush text_brush(color);
-
-		Gdiplus::StringFormat format;
-		format.SetAlignment(Gdiplus::StringAlignment::StringAlignmentNear);
-		format.SetTrimming(Gdiplus::StringTrimming::StringTrimmingEllipsisCharacter);
-		format.SetFormatFlags(Gdiplus::StringFormatFlags::StringFormatFlagsNoWrap);
-
-		// measure text rectangle
-		Gdiplus::RectF text_rect;
-		graphics.MeasureString(pState->sYaxisLabel.c_str(), -1, p_font, layoutRect, &text_rect);
-
-		if (true)
-		{
-			if (text_rect.Width < layoutRect.Width)
-				text_rect.Width = min(text_rect.Width * 1.01f, layoutRect.Width);
-		}
-
-		// change dimensions
-		Gdiplus::REAL width = text_rect.Width;
-		Gdiplus::REAL height = text_rect.Height;
-
-		layoutRect.Height = bottom - top - 4.0f * 2.0f;
-		layoutRect.Width = height;
-
-		text_rect.Height = width;
-		text_rect.Width = height;
-
-		// align the text rectangle to the layout rectangle
-		liblec::cui::gui_raw::cui_rawImpl::align_text(text_rect, layoutRect,
-			liblec::cui::gui_raw::cui_raw::textAlignment::middle);
-
-		if (design)
-		{
-			color.SetFromCOLORREF(RGB(240, 240, 240));
-			Gdiplus::SolidBrush brush(color);
-			graphics.FillRectangle(&brush, layoutRect);
-
-			color.SetFromCOLORREF(RGB(230, 230, 230));
-			brush.SetColor(color);
-			graphics.FillRectangle(&brush, text_rect);
-		}
-
-		// figure out center
-		Gdiplus::REAL x = layoutRect.X + (layoutRect.Width / 2);
-		Gdiplus::REAL y = layoutRect.Y + (layoutRect.Height / 2);
-
-		graphics.TranslateTransform(x, y);		// set rotation point
-		graphics.RotateTransform(-90);			// rotate text
-		graphics.TranslateTransform(-x, -y);	// reset translate transform
+	const CChartScene &scene = pState->scene;
+	const CChartScene::rect rcArea = CChartSceneRender::Convert(rcPaint);
+	CGdiPlusCache &cache = pState->d->m_gdiplus_cache;
 
-		// Draw string centered in x, y
-		Gdiplus::PointF pt(x - width / 2, y - height / 2);
-		graphics.DrawString(pState->sYaxisLabel.c_str(),
-			(INT)pState->sYaxisLabel.length(), p_font, pt, &text_brush);
-		graphics.ResetTransform();
+	// a paint within the plot, such as after points are appended, leaves out the frame
+	graphics.SetClip(CChartSceneRender::Convert(rcArea));
+	graphics.FillRectangle(cache.GetBrush(pState->d->m_clrBackground), CChartSceneRender::Convert(rcArea));
 
-		delete p_font;
-		p_font = nullptr;
+	CChartSceneRender::DrawFrame(graphics, cache, pState->sFontName, scene, border, rcArea);
 
-		left = layoutRect.GetRight();
-	}
-
-	Gdiplus::REAL right = 0.0f;
-
-	// draw labels
-	Gdiplus::RectF rectLabels;
-	{
-		Gdiplus::REAL width = static_cast<Gdiplus::REAL>(iWidth / 8);
-
-		width = width > 100.0f ? width : 100.0f;
-
-		rectLabels.X = static_cast<Gdiplus::REAL>(rectChartControl.right) - width - 4.0f;
-		rectLabels.Y = top + 4.0f;
-		rectLabels.Width = width;
-		rectLabels.Height = bottom - top - 4.0f * 2.0f;
-
-		if (design)
-		{
-			color.SetFromCOLORREF(RGB(240, 240, 240));
-			Gdiplus::SolidBrush brush(color);
-			graphics.FillRectangle(&brush, rectLabels);
-		}
-
-		right = rectLabels.GetLeft();
-	}
+	const Gdiplus::REAL top = static_cast<Gdiplus::REAL>(pState->rcPlot.top);
+	const Gdiplus::REAL bottom = static_cast<Gdiplus::REAL>(pState->rcPlot.bottom);
+	const Gdiplus::REAL left = static_cast<Gdiplus::REAL>(pState->rcPlot.left);
+	const Gdiplus::REAL right = static_cast<Gdiplus::REAL>(pState->rcPlot.right);
 
 	// calculate chart rectangle
 	RECT rectChart;
@@ -509,75 +178,69 @@ static void DrawChart(HWND hGraph, HDC hdc, cui_rawImpl::LineChartControl* pStat
 	}
 
 	// draw chart
-	Gdiplus::FontFamily ffm(pState->sFontName.c_str());
-	Gdiplus::Font* p_font = new Gdiplus::Font(&ffm,
+	Gdiplus::Font* p_font = pState->d->m_gdiplus_cache.GetFont(pState->sFontName,
 		static_cast<Gdiplus::REAL>(pState->iFontSize));
 
-	if (p_font->GetLastStatus() != Gdiplus::Status::Ok)
-	{
-		delete p_font;
-		p_font = nullptr;
-		p_font = new Gdiplus::Font(pState->sFontName.c_str(),
-			static_cast<Gdiplus::REAL>(pState->iFontSize), Gdiplus::FontStyle::FontStyleRegular,
-			Gdiplus::UnitPoint, &pState->d->m_font_collection);
-	}
-
-	color.SetFromCOLORREF(RGB(0, 0, 0));
-	Gdiplus::SolidBrush text_brush(color);
+	Gdiplus::SolidBrush* p_text_brush = pState->d->m_gdiplus_cache.GetBrush(RGB(0, 0, 0));
 
 	Gdiplus::StringFormat format;
 	format.SetAlignment(Gdiplus::StringAlignment::StringAlignmentNear);
 	format.SetTrimming(Gdiplus::StringTrimming::StringTrimmingEllipsisCharacter);
 	format.SetFormatFlags(Gdiplus::StringFormatFlags::StringFormatFlagsNoWrap);
 
-	// calculate lowest and highest value
-	std::vector<cui_raw::lineInfo> vLines = pState->vLines;
+	std::vector<cui_rawImpl::chartLine> &vLines = pState->vLines;
 
 	// 2. Draw Axes
 	if (vLines.size() > 0)
 	{
+		// calculate lowest and highest value; each series keeps track of its own
 		double dMin = 0;
 		double dMax = 0;
 
 		bool bFirst = true;
-		for (auto x_it : vLines)
+		for (const auto &x_it : vLines)
 		{
-			for (auto it : x_it.vValues)
+			double dLineMin = 0, dLineMax = 0;
+
+			if (!x_it.values.GetRange(dLineMin, dLineMax))
+				continue;
+
+			if (bFirst)
 			{
-				if (bFirst)
-				{
-					bFirst = false;
+				bFirst = false;
 
-					dMin = it.dValue;
-					dMax = it.dValue;
-				}
-				else
-				{
-					dMin = std::fmin(it.dValue, dMin);
-					dMax = std::fmax(it.dValue, dMax);
-				}
+				dMin = dLineMin;
+				dMax = dLineMax;
+			}
+			else
+			{
+				dMin = std::fmin(dLineMin, dMin);
+				dMax = std::fmax(dLineMax, dMax);
 			}
 		}
 
-		double dxSep = double(rectChart.right - rectChart.left) / (double)vLines[0].vValues.size();
+		const size_t iPoints = vLines[0].values.Size();
+		double dxSep = double(rectChart.right - rectChart.left) / (double)(iPoints ? iPoints : 1);
 
 		// calculate the most suitable chart parameters
-		chartParams params;
+		// no more gridlines than there is room for, at a minimum spacing of iMinLineSpacing
+		const int iMinLineSpacing = 20;
+		const int iMaxLines = max(1, min(10, int(rectChart.bottom - rectChart.top) / iMinLineSpacing));
 
-		if (!calcChartParams(dMin, dMax, params) || !pState->bAutoScale)
+		CChartAxis &axis = pState->axis;
+
+		if (!pState->bAutoScale || !axis.Calculate(dMin, dMax, iMaxLines))
 		{
 			// Function failed. Fall back to defaults.
-			params.iLowerLimit = (int)pState->iLowerLimit;			// truncate
-			params.iUpperLimit = (int)(pState->iUpperLimit + 0.5);	// round off
-			params.iNumberOfLines = 10;
+			axis.SetLimits(pState->iLowerLimit, pState->iUpperLimit, 10);
 		}
 
-		double dySep = double(rectChart.bottom - rectChart.top) / params.iNumberOfLines;
-		int iLowerLimit = params.iLowerLimit;
-		int iUpperLimit = params.iUpperLimit;
+		double dySep = double(rectChart.bottom - rectChart.top) / axis.Lines();
+		const double dLowerLimit = axis.Lower();
+		const double dUpperLimit = axis.Upper();
 
 		// draw y-axis markers
-		for (int i = 0; i <= params.iNumberOfLines; i++)
+		for (int i = 0; i <= axis.Lines(); i++)
 		{
 			double dY = (double)rectChart.bottom - (i * dySep);
 
@@ -598,11 +261,11 @@ static void DrawChart(HWND hGraph, HDC hdc, cui_rawImpl::LineChartControl* pStat
 			layoutRect.Width = static_cast<Gdiplus::REAL>(marker_Y_width);
 			layoutRect.Height = static_cast<Gdiplus::REAL>(dySep);
 
-			double dMarker = (double)iLowerLimit + (double)i * (double)(iUpperLimit - iLowerLimit) / (double)params.iNumberOfLines;
+			const std::wstring &sMarker = axis.Label(i);
 
 			// measure text rectangle
 			Gdiplus::RectF text_rect;
-			graphics.MeasureString(round_off(dMarker, 1).c_str(), -1, p_font, layoutRect, &text_rect);
+			graphics.MeasureString(sMarker.c_str(), -1, p_font, layoutRect, &text_rect);
 
 			if (true)
 			{
@@ -630,8 +293,8 @@ static void DrawChart(HWND hGraph, HDC hdc, cui_rawImpl::LineChartControl* pStat
 			}
 
 			// draw text
-			graphics.DrawString(round_off(dMarker, 1).c_str(),
-				-1, p_font, text_rect, &format, &text_brush);
+			graphics.DrawString(sMarker.c_str(),
+				-1, p_font, text_rect, &format, p_text_brush);
 		}
 
 		if (!pState->bInfoCaptured)
@@ -639,42 +302,72 @@ static void DrawChart(HWND hGraph, HDC hdc, cui_rawImpl::LineChartControl* pStat
 			pState->linesInfo.clear();
 			pState->linesInfo.resize(vLines.size());
 		}
+		else
+			if (pState->bPointInfoStale)
+			{
+				// points have moved, but series labels have not
+				for (auto &it : pState->linesInfo)
+					it.chartLinesInfo.clear();
+			}
+
+		const bool bCapturePoints = !pState->bInfoCaptured || pState->bPointInfoStale;
+
+		const int iPlotWidth = rectChart.right - rectChart.left;
 
 		// figure out if every label fits (important for aesthetics)
+		// the labels are point numbers, so only the longest one in each line needs measuring
 		bool bFits = true;
-		for (auto x_it : vLines)
+		for (auto &x_it : vLines)
 		{
-			for (int i = 0; i < (int)x_it.vValues.size(); i++)
+			if (getLineLod(x_it, iPlotWidth).size() < x_it.values.Size())
 			{
-				int iX = rectChart.left + int(i * dxSep);
+				// decimated, so there are more points than pixels
+				bFits = false;
+				break;
+			}
 
-				RECT rect;
-				rect.bottom = rectChart.bottom + (rectChartControl.bottom - rectChart.bottom) / 2;
-				rect.top = rectChart.bottom + (rectChartControl.bottom - rectChart.bottom) / 8;
-				rect.left = iX;
-				rect.right = rect.left + int(dxSep);
+			std::basic_string<TCHAR> sLongest;
 
-				SIZE size;
-				GetTextExtentPoint32(hdc, std::to_wstring(x_it.vValues[i].iNumber).c_str(),
-					lstrlen(std::to_wstring(x_it.vValues[i].iNumber).c_str()), &size);
+			for (size_t i = 0; i < x_it.values.Size(); i++)
+			{
+				std::basic_string<TCHAR> sLabel = std::to_wstring(x_it.values[i].iNumber);
 
-				if (double(size.cx) >= (dxSep / 1.5))
-				{
-					bFits = false;
-					break;
-				}
+				if (sLabel.length() > sLongest.length())
+					sLongest.swap(sLabel);
 			}
+
+			if (sLongest.empty())
+				continue;
+
+			SIZE size;
+			GetTextExtentPoint32(hdc, sLongest.c_str(), (int)sLongest.length(), &size);
+
+			if (double(size.cx) >= (dxSep / 1.5))
+				bFits = false;
 		}
 
 		bool bFirstLine = true;
 		int iLineNumber = 0;
-		for (auto x_it : vLines)
+		for (auto &x_it : vLines)
 		{
+			// draw only the points that the plot's width can show
+			const std::vector<size_t> &vLod = getLineLod(x_it, iPlotWidth);
+			const bool bDecimated = vLod.size() < x_it.values.Size();
+
+			// the hit test rects are one per point drawn
+			const bool bCaptureLine = bCapturePoints ||
+				pState->linesInfo[iLineNumber].chartLinesInfo.size() != vLod.size();
+
+			if (bCaptureLine)
+				pState->linesInfo[iLineNumber].chartLinesInfo.clear();
+
 			std::vector<Gdiplus::PointF> points;
+			points.reserve(vLod.size());
 
 			// draw x-axis markers and Lines
-			for (int i = 0; i < (int)x_it.vValues.size(); i++)
+			for (size_t k = 0; k < vLod.size(); k++)
 			{
+				const int i = (int)vLod[k];
 				int iX = rectChart.left + int(i * dxSep);
 
 				RECT rect;
@@ -692,7 +385,7 @@ static void DrawChart(HWND hGraph, HDC hdc, cui_rawImpl::LineChartControl* pStat
 
 						// measure text rectangle
 						Gdiplus::RectF text_rect;
-						graphics.MeasureString(std::to_wstring(x_it.vValues[i].iNumber).c_str(), -1, p_font, layoutRect, &text_rect);
+						graphics.MeasureString(std::to_wstring(x_it.values[i].iNumber).c_str(), -1, p_font, layoutRect, &text_rect);
 
 						if (true)
 						{
@@ -718,8 +411,8 @@ static void DrawChart(HWND hGraph, HDC hdc, cui_rawImpl::LineChartControl* pStat
 						}
 
 						// draw text
-						graphics.DrawString(std::to_wstring(x_it.vValues[i].iNumber).c_str(),
-							-1, p_font, text_rect, &format, &text_brush);
+						graphics.DrawString(std::to_wstring(x_it.values[i].iNumber).c_str(),
+							-1, p_font, text_rect, &format, p_text_brush);
 					}
 				}
 
@@ -727,11 +420,11 @@ static void DrawChart(HWND hGraph, HDC hdc, cui_rawImpl::LineChartControl* pStat
 				RECT rectLine;
 				rectLine.bottom = rectChart.bottom;
 
-				double dValue = x_it.vValues[i].dValue;
+				double dValue = x_it.values[i].dValue;
 
-				double dAboveLower = dValue - iLowerLimit;
+				double dAboveLower = dValue - dLowerLimit;
 
-				double dRatioOfRange = dAboveLower / (iUpperLimit - iLowerLimit);
+				double dRatioOfRange = dAboveLower / (dUpperLimit - dLowerLimit);
 
 				// don't permit negative
 				if (dRatioOfRange < 0)
@@ -757,22 +450,21 @@ static void DrawChart(HWND hGraph, HDC hdc, cui_rawImpl::LineChartControl* pStat
 				points.push_back(pt);
 			}
 
-			Gdiplus::PointF *pts = new Gdiplus::PointF[points.size()];
-
-			for (size_t i = 0; i < points.size(); i++)
-			{
-				pts[i] = points[i];
-			}
-
 			// make a graphics object from the control's HWND
 			Gdiplus::Graphics graphics(hdc);
 			graphics.SetSmoothingMode(Gdiplus::SmoothingMode::SmoothingModeAntiAlias);
+			graphics.SetClip(CChartSceneRender::Convert(rcArea));
 
 			// draw curve
 			using namespace Gdiplus;
 
 			GraphicsPath path;
-			path.AddCurve(pts, (unsigned int)points.size());
+
+			// a curve through min/max pairs would overshoot the peaks
+			if (bDecimated)
+				path.AddLines(points.data(), (INT)points.size());
+			else
+				path.AddCurve(points.data(), (unsigned int)points.size());
 
 			COLORREF clr = x_it.clrLine;
 			Gdiplus::REAL m_lineWidth = 1;
@@ -795,7 +487,7 @@ static void DrawChart(HWND hGraph, HDC hdc, cui_rawImpl::LineChartControl* pStat
 				{
 					Rect rect(INT(pt.X - 5), INT(pt.Y - 5), 10, 10);
 
-					if (!pState->bInfoCaptured)
+					if (bCaptureLine)
 					{
 						// capture chart Line info
 						cui_rawImpl::chartLineInfo m_chartLineinfo;
@@ -805,7 +497,8 @@ static void DrawChart(HWND hGraph, HDC hdc, cui_rawImpl::LineChartControl* pStat
 						m_chartLineinfo.rect.right = m_chartLineinfo.rect.left + rect.Width;
 						m_chartLineinfo.rect.bottom = m_chartLineinfo.rect.top + rect.Height;
 
-						m_chartLineinfo.sChartInfo = x_it.sSeriesName + _T(": ") + (x_it.vValues[i].sLabel + _T(" - ") + round_off(x_it.vValues[i].dValue, 1)).c_str();
+						const auto &value = x_it.values[vLod[i]];
+						m_chartLineinfo.sChartInfo = x_it.sSeriesName + _T(": ") + (value.sLabel + _T(" - ") + round_off(value.dValue, 1)).c_str();
 
 						pState->linesInfo[iLineNumber].chartLinesInfo.push_back(m_chartLineinfo);
 					}
@@ -839,12 +532,6 @@ static void DrawChart(HWND hGraph, HDC hdc, cui_rawImpl::LineChartControl* pStat
 				}
 			}
 
-			if (pts)
-			{
-				delete pts;
-				pts = NULL;
-			}
-
 			pState->linesInfo[iLineNumber].sSeriesName = x_it.sSeriesName;
 
 			bFirstLine = false;
@@ -852,134 +539,52 @@ static void DrawChart(HWND hGraph, HDC hdc, cui_rawImpl::LineChartControl* pStat
 		}
 
 		pState->bInfoCaptured = true;
+		pState->bPointInfoStale = false;
 	}
 
-	delete p_font;
-	p_font = nullptr;
+	// draw series labels, capturing their rectangles for hit testing
+	const auto &vLegend = scene.Legend();
 
-	const int iItemHeight = 18;
-	const int iMargin = 2;
-
-	// check if items fit in the given space
-	if (((iItemHeight + iMargin) * static_cast<int>(vLines.size())) > (rectChart.bottom - rectChart.top))
+	for (size_t i = 0; i < pState->linesInfo.size(); i++)
 	{
-		for (auto &it : pState->linesInfo)
-			it.rcLabel = { 0 };
-
-		return;
-	}
-
-	int iLeftBorder = static_cast<int>(rectLabels.GetLeft());
-	int iBottom = static_cast<int>(rectLabels.GetBottom());
-
-	int m_x = (int)vLines.size();
-	for (auto it : reverse(vLines))
-	{
-		RECT rcBlock;
-		rcBlock.bottom = iBottom;
-		rcBlock.top = rcBlock.bottom - iItemHeight;
-		rcBlock.left = iLeftBorder;
-		rcBlock.right = rcBlock.left + iItemHeight;
-
-		RECT rcLabel = rcBlock;
-
-		m_x--;
-		bool bHot = pState->linesInfo[m_x].bHot;
-		bool bPressed = pState->linesInfo[m_x].bPressed;
-
-		COLORREF clr = it.clrLine;
-
-		if (bHot)
+		if (i < vLegend.size())
 		{
-			if (bPressed)
-				clr = clrDarken(it.clrLine, 40);
-			else
-				clr = clrDarken(it.clrLine, 25);
-		}
-
-		// paint item block
-		color.SetFromCOLORREF(clr);
-		Gdiplus::SolidBrush block_brush(color);
+			CChartSceneRender::DrawLegendItem(graphics, cache, pState->sFontName, vLegend[i],
+				vLines[i].clrLine, pState->linesInfo[i].bHot, pState->linesInfo[i].bPressed, rcArea);
 
-		RECT rcBlockSmall = rcBlock;
-
-		if (bHot)
-			InflateRect(&rcBlockSmall, -4, -4);
+			pState->linesInfo[i].rcLabel = CChartSceneRender::Bounds(vLegend[i].rcHot);
+		}
 		else
-			InflateRect(&rcBlockSmall, -5, -5);
-
-		Gdiplus::RectF rect_block = liblec::cui::gui_raw::cui_rawImpl::convert_rect(rcBlockSmall);
-		graphics.FillRectangle(&block_brush, rect_block);
-
-		std::basic_string<TCHAR> sText = it.sSeriesName;
-
-		// write text
-		RECT rcText = rcBlock;
-		rcText.left = rcText.right + 5;
-		rcText.right = static_cast<LONG>(rectLabels.GetRight()) - 5;
-
-		{
-			Gdiplus::RectF layoutRect = liblec::cui::gui_raw::cui_rawImpl::convert_rect(rcText);
-
-			Gdiplus::FontFamily ffm(pState->sFontName.c_str());
-			Gdiplus::Font* p_font = new Gdiplus::Font(&ffm, 7);
-
-			if (p_font->GetLastStatus() != Gdiplus::Status::Ok)
-			{
-				delete p_font;
-				p_font = nullptr;
-				p_font = new Gdiplus::Font(pState->sFontName.c_str(),
-					7, Gdiplus::FontStyle::FontStyleRegular,
-					Gdiplus::UnitPoint, &pState->d->m_font_collection);
-			}
-
-			color.SetFromCOLORREF(RGB(0, 0, 0));
-			Gdiplus::SolidBrush text_brush(color);
-
-			// measure text rectangle
-			Gdiplus::RectF text_rect;
-			graphics.MeasureString(sText.c_str(), -1, p_font, layoutRect, &text_rect);
-
-			if (true)
-			{
-				if (text_rect.Width < layoutRect.Width)
-					text_rect.Width = min(text_rect.Width * 1.01f, layoutRect.Width);
-			}
-
-			// align the text rectangle to the layout rectangle
-			liblec::cui::gui_raw::cui_rawImpl::align_text(text_rect, layoutRect,
-				liblec::cui::gui_raw::cui_raw::textAlignment::middleleft);
-
-			if (design)
-			{
-				color.SetFromCOLORREF(RGB(240, 240, 240));
-				Gdiplus::SolidBrush brush(color);
-				graphics.FillRectangle(&brush, layoutRect);
-
-				color.SetFromCOLORREF(RGB(230, 230, 230));
-				brush.SetColor(color);
-				graphics.FillRectangle(&brush, text_rect);
-			}
-
-			format.SetTrimming(Gdiplus::StringTrimming::StringTrimmingWord);
-
-			// draw text
-			graphics.DrawString(sText.c_str(),
-				-1, p_font, text_rect, &format, &text_brush);
+			pState->linesInfo[i].rcLabel = { 0 };	// the series labels don't fit
+	}
+} // DrawChart
 
-			delete p_font;
-			p_font = nullptr;
-		}
+/*
+** replace the lines of a line chart
+** the points are moved into ring buffered series that honor the control's point limit
+*/
+void cui_rawImpl::setLineChartLines(LineChartControl &Control, std::vector<cui_raw::lineInfo> &&vLines)
+{
+	Control.vLines.clear();
+	Control.vLines.reserve(vLines.size());
 
-		// get overall label RECT
-		rcLabel.right = rcText.right;
+	for (auto &it : vLines)
+	{
+		chartLine line;
+		line.sSeriesName = std::move(it.sSeriesName);
+		line.clrLine = it.clrLine;
+		line.values.SetCapacity(Control.iMaxPoints);
 
-		// capture RECT
-		pState->linesInfo[m_x].rcLabel = rcLabel;
+		for (auto &pt : it.vValues)
+			line.values.Append(std::move(pt));
 
-		iBottom -= (iItemHeight + iMargin);
+		Control.vLines.push_back(std::move(line));
 	}
-} // DrawChart
+
+	// everything needs to be recaptured
+	Control.bInfoCaptured = false;
+	Control.bLayoutCaptured = false;
+} // setLineChartLines
 
 LRESULT CALLBACK cui_rawImpl::LineChartControlProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
@@ -1001,16 +606,26 @@ LRESULT CALLBACK cui_rawImpl::LineChartControlProc(HWND hWnd, UINT msg, WPARAM w
 		// use double buffering to avoid flicker
 		HDC hdc = CreateCompatibleDC(dc);
 
+		// the buffer keeps the last paint, so only the invalid part needs drawing
+		RECT rcPaint = ps.rcPaint;
+
 		if (!pControl->hbm_buffer)
+		{
 			pControl->hbm_buffer = CreateCompatibleBitmap(dc, cx, cy);
 
+			// nothing has been drawn in a new buffer
+			rcPaint = rcClient;
+		}
+
 		HBITMAP hbmOld = SelectBitmap(hdc, pControl->hbm_buffer);
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////////
-		DrawChart(hWnd, hdc, pControl);
+		DrawChart(hWnd, hdc, pControl, rcPaint);
 		////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-		BitBlt(dc, 0, 0, cx, cy, hdc, 0, 0, SRCCOPY);
+		BitBlt(dc, ps.rcPaint.left, ps.rcPaint.top,
+			ps.rcPaint.right - ps.rcPaint.left, ps.rcPaint.bottom - ps.rcPaint.top,
+			hdc, ps.rcPaint.left, ps.rcPaint.top, SRCCOPY);
 
 		EndPaint(hWnd, &ps);
 
@@ -1066,6 +681,10 @@ LRESULT CALLBACK cui_rawImpl::LineChartControlProc(HWND hWnd, UINT msg, WPARAM w
 			pControl->hbm_buffer = NULL;
 		}
 
+		// the layout changes with the size, and so do the points that fit in the plot
+		pControl->bLayoutCaptured = false;
+		pControl->bPointInfoStale = true;
+
 		InvalidateRect(hWnd, NULL, FALSE);
 	}
 	break;
@@ -9,201 +9,130 @@
 //
 
 #include "../cui_rawImpl.h"
+#include "../CChartScene/CChartSceneRender.h"
 #include "../../clrAdjust/clrAdjust.h"
 
-/// <summary>
-/// Rounding off class.
-/// </summary>
-class CRoundOff
-{
-public:
-	/// <summary>
-	/// Round-off a double to a string.
-	/// </summary>
-	/// 
-	/// <param name="d">
-	/// The double to round-off.
-	/// </param>
-	/// 
-	/// <param name="iDecimalPlaces">
-	/// The number of decimal places to round it off to.
-	/// </param>
-	/// 
-	/// <returns>
-	/// The rounded-off value, as a string.
-	/// </returns>
-	template <typename T>
-	static std::basic_string<T> tostr(const double &d, int iDecimalPlaces)
-	{
-		std::basic_stringstream<T> ss;
-		ss << std::fixed;
-		ss.precision(iDecimalPlaces);
-		ss << d;
-		return ss.str();
-	} // tostr
-
-	/// <summary>
-	/// Round-off a double to another double.
-	/// </summary>
-	/// 
-	/// <param name="d">
-	/// The double to round-off.
-	/// </param>
-	/// 
-	/// <param name="iDecimalPlaces">
-	/// The number of decimal places to round it off to.
-	/// </param>
-	/// 
-	/// <returns>
-	/// The rounded-off value.
-	/// </returns>
-	static double tod(const double &d, int iDecimalPlaces)
-	{
-		int y = (int)d;
-		double z = d - (double)y;
-		double m = pow(10, iDecimalPlaces);
-		double q = z * m;
-		double r = round(q);
-
-		return static_cast<double>(y) + (1.0 / m) * r;
-	} // tod
-}; // CRoundOff
-
-template<typename It>
-class Range
-{
-	It b, e;
-public:
-	Range(It b, It e) : b(b), e(e) {}
-	It begin() const { return b; }
-	It end() const { return e; }
-};
-
-template<typename ORange, typename OIt = decltype(std::begin(std::declval<ORange>())), typename It = std::reverse_iterator<OIt>>
-Range<It> reverse(ORange && originalRange) {
-	return Range<It>(It(std::end(originalRange)), It(std::begin(originalRange)));
-}
-
-static bool design = false;
 static bool border = false;
 
-// TO-DO: use proportional drawing instead of fixed items like iBorderWidth = 1
-void DrawPieChart(HWND hGraph, HDC hdc, cui_rawImpl::PieChartControl* pState)
+/*
+** lay the chart out again if its data, size or fonts have changed since it was last laid out
+** returns true if it was laid out again, in which case all of it needs painting
+*/
+static bool buildScene(Gdiplus::Graphics &graphics, const RECT &rcClient, cui_rawImpl::PieChartControl* pState)
 {
-	Gdiplus::Graphics graphics(hdc);
-	graphics.SetSmoothingMode(Gdiplus::SmoothingMode::SmoothingModeAntiAlias);
-
-	Gdiplus::Color color;
-	color.SetFromCOLORREF(pState->d->m_clrBackground);
-	graphics.Clear(color);
-
-	int iBorderWidth = 1;
-
-	// get control coordinates
-	RECT rectChart;
-	GetClientRect(hGraph, &rectChart);
+	CChartScene::chart info;
+	info.fWidth = static_cast<float>(rcClient.right - rcClient.left);
+	info.fHeight = static_cast<float>(rcClient.bottom - rcClient.top);
+	info.sFontName = pState->sFontName;
+	info.fFontSize = static_cast<float>(pState->iFontSize);
+	info.dFontScale = pState->d->m_DPIScale;
 
-	InflateRect(&rectChart, -iBorderWidth, -iBorderWidth);
+	if (pState->bInfoCaptured && pState->scene.IsValid(info))
+		return false;
 
-	RECT rectChartControl = rectChart;
+	std::vector<CChartScene::item> vItems(pState->vData.size());
 
-	// 1. draw bounding rectangle for chart control
-	if (border)
+	for (size_t i = 0; i < vItems.size(); i++)
 	{
-		RECT rcBorder = rectChartControl;
-		InflateRect(&rcBorder, -1, -1);
-
-		Gdiplus::RectF rect = liblec::cui::gui_raw::cui_rawImpl::convert_rect(rcBorder);
-
-		color.SetFromCOLORREF(RGB(200, 200, 200));
-		Gdiplus::Pen pen(color, 1);
-		pen.SetAlignment(Gdiplus::PenAlignment::PenAlignmentCenter);
-		graphics.DrawRectangle(&pen, rect);
+		vItems[i].dValue = pState->vData[i].dValue;
+		vItems[i].iNumber = pState->vData[i].iNumber;
+		vItems[i].sLabel = pState->vData[i].sItemLabel;
 	}
 
-	Gdiplus::REAL top = static_cast<Gdiplus::REAL>(rectChartControl.top);
-	Gdiplus::REAL bottom = static_cast<Gdiplus::REAL>(rectChartControl.bottom);
-	Gdiplus::REAL right = 0.0f;
+	CChartScene &scene = pState->scene;
+	scene.BuildPieChart(info, vItems,
+		CChartSceneRender::Measurer(graphics, pState->d->m_gdiplus_cache, pState->sFontName));
 
-	// draw labels
-	Gdiplus::RectF rectLabels;
+	// cleanup previous pie chart regions
+	for (auto &it : pState->chartBarsInfo)
 	{
-		Gdiplus::REAL width =
-			static_cast<Gdiplus::REAL>(rectChartControl.right - rectChartControl.left) / 8;
+		if (it.pRegion)
+		{
+			delete it.pRegion;
+			it.pRegion = NULL;
+		}
+	}
 
-		width = width > 100.0f ? width : 100.0f;
-		
-		rectLabels.X = static_cast<Gdiplus::REAL>(rectChartControl.right) - width - 4.0f;
-		rectLabels.Y = top + 4.0f;
-		rectLabels.Width = width;
-		rectLabels.Height = bottom - top - 4.0f * 2.0f;
+	// capture pie chart item info for hit testing; hover states survive a change of size
+	if (!pState->bInfoCaptured)
+	{
+		pState->chartBarsInfo.assign(vItems.size(), cui_rawImpl::pieChartItemInfo());
 
-		if (design)
+		for (size_t i = 0; i < vItems.size(); i++)
 		{
-			color.SetFromCOLORREF(RGB(240, 240, 240));
-			Gdiplus::SolidBrush brush(color);
-			graphics.FillRectangle(&brush, rectLabels);
+			pState->chartBarsInfo[i].iNumber = pState->vData[i].iNumber;
+			pState->chartBarsInfo[i].sItemLabel = pState->vData[i].sItemLabel;
 		}
-
-		right = rectLabels.GetLeft();
 	}
 
-	rectChartControl.right = static_cast<LONG>(right);
+	const CChartScene::pie &pie = scene.Pie();
+	const auto &vLegend = scene.Legend();
+	const Gdiplus::RectF rect = CChartSceneRender::Convert(pie.rc);
 
-	pState->rcPieChart = rectChart;
+	for (size_t i = 0; i < pState->chartBarsInfo.size(); i++)
+	{
+		cui_rawImpl::pieChartItemInfo &it = pState->chartBarsInfo[i];
+		it.sTooltip = pie.vSlices[i].sTooltip;
 
-	int iWidth = rectChartControl.right - rectChartControl.left;
-	int iHeight = rectChartControl.bottom - rectChartControl.top;
+		// make region from the slice
+		Gdiplus::GraphicsPath path;
+		path.AddPie(rect, pie.vSlices[i].fAngle, pie.vSlices[i].fSweep);
 
-	Gdiplus::REAL angle = 270;
-	Gdiplus::REAL sweep = 0;
+		Gdiplus::Region region(&path);
+		it.pRegion = region.Clone();
 
-	// total
-	double dTotal = 0;
+		if (i < vLegend.size())
+			it.rcLabel = CChartSceneRender::Bounds(vLegend[i].rcHot);
+		else
+			it.rcLabel = { 0 };	// the legend doesn't fit
+	}
 
-	for (auto it : pState->vData)
-		dTotal += it.dValue;
+	pState->rcPieChart = CChartSceneRender::Bounds(scene.Frame().rcPlot);
+	pState->bInfoCaptured = true;
+	return true;
+} // buildScene
 
-	bool bFill = true;
+/*
+** draw the chart into the part of the buffer given by rcPaint
+** the rest of the buffer is left as the last paint left it
+*/
+// TO-DO: use proportional drawing instead of fixed items like iBorderWidth = 1
+static void DrawPieChart(HWND hGraph, HDC hdc, cui_rawImpl::PieChartControl* pState, RECT rcPaint)
+{
+	Gdiplus::Graphics graphics(hdc);
+	graphics.SetSmoothingMode(Gdiplus::SmoothingMode::SmoothingModeAntiAlias);
 
-	int side = min(iWidth, iHeight);
+	RECT rcClient;
+	GetClientRect(hGraph, &rcClient);
 
-	Gdiplus::RectF rect;
-	rect.Width = static_cast<Gdiplus::REAL>(side);
-	rect.Height = static_cast<Gdiplus::REAL>(side);
-	rect.X = static_cast<Gdiplus::REAL>(rectChartControl.left + ((rectChartControl.right - rectChartControl.left) - side) / 2);
-	rect.Y = static_cast<Gdiplus::REAL>(rectChartControl.top + ((rectChartControl.bottom - rectChartControl.top) - side) / 2);
+	if (buildScene(graphics, rcClient, pState))
+		rcPaint = rcClient;
 
-	bool bHover = false;
+	const CChartScene &scene = pState->scene;
+	const CChartScene::rect rcArea = CChartSceneRender::Convert(rcPaint);
+	CGdiPlusCache &cache = pState->d->m_gdiplus_cache;
 
-	if (!pState->bInfoCaptured)
-	{
-		// cleanup previous pie chart info
-		for (auto &it : pState->chartBarsInfo)
-		{
-			if (it.pRegion)
-			{
-				delete it.pRegion;
-				it.pRegion = NULL;
-			}
-		}
+	graphics.SetClip(CChartSceneRender::Convert(rcArea));
+	graphics.FillRectangle(cache.GetBrush(pState->d->m_clrBackground), CChartSceneRender::Convert(rcArea));
 
-		pState->chartBarsInfo.clear();
-	}
-	else
+	int iBorderWidth = 1;
+
+	// 1. draw bounding rectangle for chart control
+	if (border)
 	{
-		// check if there is a hover
-		for (auto it : pState->chartBarsInfo)
-		{
-			if (it.bHot)
-			{
-				bHover = true;
-				break;
-			}
-		}
+		RECT rcBorder = pState->rcPieChart;
+		InflateRect(&rcBorder, -1, -1);
+
+		Gdiplus::RectF rect = liblec::cui::gui_raw::cui_rawImpl::convert_rect(rcBorder);
+
+		Gdiplus::Color color;
+		color.SetFromCOLORREF(RGB(200, 200, 200));
+		Gdiplus::Pen pen(color, 1);
+		pen.SetAlignment(Gdiplus::PenAlignment::PenAlignmentCenter);
+		graphics.DrawRectangle(&pen, rect);
 	}
 
-	auto drawPie = [](Gdiplus::Graphics &g, Gdiplus::Color &color, Gdiplus::RectF &rect, Gdiplus::REAL &angle, Gdiplus::REAL &sweep, int iBorderWidth)
+	auto drawPie = [](Gdiplus::Graphics &g, Gdiplus::Color &color, Gdiplus::RectF &rect, Gdiplus::REAL angle, Gdiplus::REAL sweep, int iBorderWidth)
 	{
 		// draw pie
 		Gdiplus::SolidBrush brush(color);
@@ -218,84 +147,49 @@ void DrawPieChart(HWND hGraph, HDC hdc, cui_rawImpl::PieChartControl* pState)
 		}
 	};
 
-	int ix = 0;
-	for (auto it : pState->vData)
-	{
-		// calculate sweep
-		sweep = 0;
-
-		if (dTotal > 0)
-			sweep = Gdiplus::REAL(360) * Gdiplus::REAL(it.dValue) / Gdiplus::REAL(dTotal);
-
-		{
-			cui_rawImpl::pieChartItemInfo item;
-			item.bHot = false;
+	const CChartScene::pie &pie = scene.Pie();
 
-			// create path
-			Gdiplus::GraphicsPath path;
+	// the pie is drawn whole, since a hover can change how every slice is drawn
+	CChartScene::rect rcPie = pie.rc;
+	rcPie.x -= 1;
+	rcPie.y -= 1;
+	rcPie.width += 2;
+	rcPie.height += 2;
 
-			// add pie to path
-			path.AddPie(rect, angle, sweep);
+	if (rcPie.intersects(rcArea))
+	{
+		Gdiplus::RectF rect = CChartSceneRender::Convert(pie.rc);
 
-			// make region from path
-			Gdiplus::Region region(&path);
+		bool bHover = false;
 
-			if (!pState->bInfoCaptured)
+		// check if there is a hover
+		for (const auto &it : pState->chartBarsInfo)
+		{
+			if (it.bHot)
 			{
-				// assign region to pie chart item
-				item.pRegion = region.Clone();	// TO-DO: read about the Clone member and check whether we need to clear this memory later ... very crucial this check
-
-				// assign item number
-				item.iNumber = it.iNumber;
-
-				// assign item label
-				item.sItemLabel = it.sItemLabel;
-
-				std::basic_string<TCHAR> sTooltip = it.sItemLabel;
-				double dPercentage = 0;
-				
-				if (dTotal > 0)
-					dPercentage = 100 * it.dValue / dTotal;
+				bHover = true;
+				break;
+			}
+		}
 
-				sTooltip += _T(" (") + CRoundOff::tostr<TCHAR>(dPercentage, 1) + _T("%)");
+		for (size_t ix = 0; ix < pie.vSlices.size(); ix++)
+		{
+			const Gdiplus::REAL angle = pie.vSlices[ix].fAngle;
+			const Gdiplus::REAL sweep = pie.vSlices[ix].fSweep;
 
-				// capture tooltip text in the form "itemLabel (percentage %)
-				item.sTooltip = sTooltip;
+			COLORREF clr = pState->vData[ix].clrItem;
 
-				// grab the item
-				pState->chartBarsInfo.push_back(item);
-			}
-			else
+			if (pState->chartBarsInfo[ix].bHot)
 			{
-				// cleanup previous region
-				if (pState->chartBarsInfo[ix].pRegion)
-				{
-					delete pState->chartBarsInfo[ix].pRegion;
-					pState->chartBarsInfo[ix].pRegion = NULL;
-				}
-
-				// update pie chart region
-				pState->chartBarsInfo[ix].pRegion = region.Clone();
+				if (pState->chartBarsInfo[ix].bPressed)
+					clr = clrDarken(pState->vData[ix].clrItem, 40);
+				else
+					clr = clrDarken(pState->vData[ix].clrItem, 25);
 			}
 
-		}
-
-		COLORREF clr = it.clrItem;
-
-		if (pState->chartBarsInfo[ix].bHot)
-		{
-			if (pState->chartBarsInfo[ix].bPressed)
-				clr = clrDarken(it.clrItem, 40);
-			else
-				clr = clrDarken(it.clrItem, 25);
-		}
+			Gdiplus::Color color;
+			color.SetFromCOLORREF(clr);
 
-		Gdiplus::Color color;
-		color.SetFromCOLORREF(clr);
-		
-		// if fill mode, fill pie
-		if (bFill)
-		{
 			switch (pState->hoverEffect)
 			{
 			case cui_raw::pieChartHoverEffect::glowAndArc:
@@ -306,21 +200,13 @@ void DrawPieChart(HWND hGraph, HDC hdc, cui_rawImpl::PieChartControl* pState)
 					Gdiplus::RectF rect_arc = rect;
 					Gdiplus::Pen pen(color, (Gdiplus::REAL)iBorderWidth);
 					graphics.DrawArc(&pen, rect_arc, angle, sweep);
-
-					// draw pie
-					Gdiplus::RectF rect_pie = rect;
-					rect_pie.Inflate(static_cast<Gdiplus::REAL>(-2 * iBorderWidth), static_cast<Gdiplus::REAL>(-2 * iBorderWidth));
-
-					drawPie(graphics, color, rect_pie, angle, sweep, iBorderWidth);
 				}
-				else
-				{
-					// draw pie
-					Gdiplus::RectF rect_pie = rect;
-					rect_pie.Inflate(static_cast<Gdiplus::REAL>(-2 * iBorderWidth), static_cast<Gdiplus::REAL>(-2 * iBorderWidth));
 
-					drawPie(graphics, color, rect_pie, angle, sweep, iBorderWidth);
-				}
+				// draw pie
+				Gdiplus::RectF rect_pie = rect;
+				rect_pie.Inflate(static_cast<Gdiplus::REAL>(-2 * iBorderWidth), static_cast<Gdiplus::REAL>(-2 * iBorderWidth));
+
+				drawPie(graphics, color, rect_pie, angle, sweep, iBorderWidth);
 			}
 			break;
 
@@ -359,173 +245,41 @@ void DrawPieChart(HWND hGraph, HDC hdc, cui_rawImpl::PieChartControl* pState)
 				break;
 			}
 		}
-		else
-		{
-			Gdiplus::Pen pen(color, (Gdiplus::REAL)iBorderWidth);
-			graphics.DrawPie(&pen, rect, angle, sweep);
-		}
-
-		angle += sweep;
-		ix++;
-	}
-
-	if (dTotal <= 0)
-	{
-		// everything is a zero ... draw a light grey empty pie
-
-		Gdiplus::Color color;
-		color.SetFromCOLORREF(RGB(245, 245, 245));
 
-		Gdiplus::RectF rect_pie = rect;
-
-		Gdiplus::REAL angle = 270;
-		Gdiplus::REAL sweep = 360;
-		drawPie(graphics, color, rect_pie, angle, sweep, 0);
-	}
-
-	if (pState->bDoughnut)
-	{
-		Gdiplus::Color color;
-		color.SetFromCOLORREF(RGB(255, 255, 255));
-
-		// get height
-		Gdiplus::REAL iFactor = static_cast<Gdiplus::REAL>(side) / 10.0f;
-
-		iFactor = max(iFactor, 20.0f);
-
-		Gdiplus::RectF rect_pie = rect;
-		rect_pie.Inflate(-iFactor, -iFactor);
-
-		Gdiplus::REAL angle = 270;
-		Gdiplus::REAL sweep = 360;
-		drawPie(graphics, color, rect_pie, angle, sweep, 0);
-	}
-
-	pState->bInfoCaptured = true;
-
-	const int iItemHeight = 18;
-	const int iMargin = 2;
-
-	// check if items fit in the given space
-	if (((iItemHeight + iMargin) * static_cast<int>(pState->vData.size())) > (rectChart.bottom - rectChart.top))
-	{
-		for (auto &it : pState->chartBarsInfo)
-			it.rcLabel = { 0 };
-
-		return;
-	}
-
-	int iLeftBorder = static_cast<int>(rectLabels.GetLeft());
-	int iBottom = static_cast<int>(rectLabels.GetBottom());
-
-	size_t m_x = pState->chartBarsInfo.size();
-	for (auto it : reverse(pState->vData))
-	{
-		RECT rcBlock;
-		rcBlock.bottom = iBottom;
-		rcBlock.top = rcBlock.bottom - iItemHeight;
-		rcBlock.left = iLeftBorder;
-		rcBlock.right = rcBlock.left + iItemHeight;
-
-		RECT rcLabel = rcBlock;
-
-		m_x--;
-		bool bHot = pState->chartBarsInfo[m_x].bHot;
-		bool bPressed = pState->chartBarsInfo[m_x].bPressed;
-
-		COLORREF clr = it.clrItem;
-
-		if (bHot)
+		if (pie.bEmpty)
 		{
-			if (bPressed)
-				clr = clrDarken(it.clrItem, 40);
-			else
-				clr = clrDarken(it.clrItem, 25);
-		}
-
-		// paint item block
-		color.SetFromCOLORREF(clr);
-		Gdiplus::SolidBrush block_brush(color);
+			// everything is a zero ... draw a light grey empty pie
+			Gdiplus::Color color;
+			color.SetFromCOLORREF(RGB(245, 245, 245));
 
-		RECT rcBlockSmall = rcBlock;
-
-		if (bHot)
-			InflateRect(&rcBlockSmall, -4, -4);
-		else
-			InflateRect(&rcBlockSmall, -5, -5);
-
-		Gdiplus::RectF rect_block = liblec::cui::gui_raw::cui_rawImpl::convert_rect(rcBlockSmall);
-		graphics.FillRectangle(&block_brush, rect_block);
-
-		// write text
-		RECT rcText = rcBlock;
-		rcText.left = rcText.right + 5;
-		rcText.right = static_cast<LONG>(rectLabels.GetRight()) - 5;
+			Gdiplus::RectF rect_pie = rect;
+			drawPie(graphics, color, rect_pie, 270, 360, 0);
+		}
 
+		if (pState->bDoughnut)
 		{
-			Gdiplus::RectF layoutRect = liblec::cui::gui_raw::cui_rawImpl::convert_rect(rcText);
-
-			Gdiplus::FontFamily ffm(pState->sFontName.c_str());
-			Gdiplus::Font* p_font = new Gdiplus::Font(&ffm, 7);
-
-			if (p_font->GetLastStatus() != Gdiplus::Status::Ok)
-			{
-				delete p_font;
-				p_font = nullptr;
-				p_font = new Gdiplus::Font(pState->sFontName.c_str(),
-					7, Gdiplus::FontStyle::FontStyleRegular,
-					Gdiplus::UnitPoint, &pState->d->m_font_collection);
-			}
-
-			color.SetFromCOLORREF(RGB(0, 0, 0));
-			Gdiplus::SolidBrush text_brush(color);
-
-			// measure text rectangle
-			Gdiplus::RectF text_rect;
-			graphics.MeasureString(it.sItemLabel.c_str(), -1, p_font, layoutRect, &text_rect);
-
-			if (true)
-			{
-				if (text_rect.Width < layoutRect.Width)
-					text_rect.Width = min(text_rect.Width * 1.01f, layoutRect.Width);
-			}
-
-			// align the text rectangle to the layout rectangle
-			liblec::cui::gui_raw::cui_rawImpl::align_text(text_rect, layoutRect,
-				liblec::cui::gui_raw::cui_raw::textAlignment::middleleft);
-
-			if (design)
-			{
-				color.SetFromCOLORREF(RGB(240, 240, 240));
-				Gdiplus::SolidBrush brush(color);
-				graphics.FillRectangle(&brush, layoutRect);
+			Gdiplus::Color color;
+			color.SetFromCOLORREF(RGB(255, 255, 255));
 
-				color.SetFromCOLORREF(RGB(230, 230, 230));
-				brush.SetColor(color);
-				graphics.FillRectangle(&brush, text_rect);
-			}
+			// get height
+			Gdiplus::REAL iFactor = pie.rc.width / 10.0f;
 
-			Gdiplus::StringFormat format;
-			format.SetAlignment(Gdiplus::StringAlignment::StringAlignmentNear);
-			format.SetFormatFlags(Gdiplus::StringFormatFlags::StringFormatFlagsNoWrap);
-			format.SetTrimming(Gdiplus::StringTrimming::StringTrimmingWord);
+			iFactor = max(iFactor, 20.0f);
 
-			// draw text
-			graphics.DrawString(it.sItemLabel.c_str(),
-				-1, p_font, text_rect, &format, &text_brush);
+			Gdiplus::RectF rect_pie = rect;
+			rect_pie.Inflate(-iFactor, -iFactor);
 
-			delete p_font;
-			p_font = nullptr;
+			drawPie(graphics, color, rect_pie, 270, 360, 0);
 		}
+	}
 
-		// get overall label RECT
-		rcLabel.right = rcText.right;
-
-		// capture RECT
-		pState->chartBarsInfo[m_x].rcLabel = rcLabel;
+	// draw legend
+	const auto &vLegend = scene.Legend();
 
-		iBottom -= (iItemHeight + iMargin);
-	}
+	for (size_t i = 0; i < vLegend.size(); i++)
+		CChartSceneRender::DrawLegendItem(graphics, cache, pState->sFontName, vLegend[i],
+			pState->vData[i].clrItem, pState->chartBarsInfo[i].bHot, pState->chartBarsInfo[i].bPressed,
+			rcArea);
 } // DrawPieChart
 
 LRESULT CALLBACK cui_rawImpl::PieChartControlProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
@@ -548,16 +302,26 @@ LRESULT CALLBACK cui_rawImpl::PieChartControlProc(HWND hWnd, UINT msg, WPARAM wP
 		// use double buffering to avoid flicker
 		HDC hdc = CreateCompatibleDC(dc);
 
+		// the buffer keeps the last paint, so only the invalid part needs drawing
+		RECT rcPaint = ps.rcPaint;
+
 		if (!pControl->hbm_buffer)
+		{
 			pControl->hbm_buffer = CreateCompatibleBitmap(dc, cx, cy);
 
+			// nothing has been drawn in a new buffer
+			rcPaint = rcClient;
+		}
+
 		HBITMAP hbmOld = SelectBitmap(hdc, pControl->hbm_buffer);
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////////
-		DrawPieChart(hWnd, hdc, pControl);
+		DrawPieChart(hWnd, hdc, pControl, rcPaint);
 		////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-		BitBlt(dc, 0, 0, cx, cy, hdc, 0, 0, SRCCOPY);
+		BitBlt(dc, ps.rcPaint.left, ps.rcPaint.top,
+			ps.rcPaint.right - ps.rcPaint.left, ps.rcPaint.bottom - ps.rcPaint.top,
+			hdc, ps.rcPaint.left, ps.rcPaint.top, SRCCOPY);
 
 		EndPaint(hWnd, &ps);
 
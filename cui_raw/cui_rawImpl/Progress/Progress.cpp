@@ -11,6 +11,17 @@
 #include "../cui_rawImpl.h"
 #include "../../clrAdjust/clrAdjust.h"
 
+// the bar of a busy progress control, a tenth of the width of the inside of the control
+static Gdiplus::RectF busyBar(const Gdiplus::RectF &rect, int iBusyPerc)
+{
+	Gdiplus::RectF m_rc = rect;
+	m_rc.X = 0;
+	m_rc.Width = 0.1f * rect.Width;
+
+	cui_rawImpl::pos_rect(m_rc, rect, static_cast<Gdiplus::REAL>(iBusyPerc), 0);
+	return m_rc;
+} // busyBar
+
 LRESULT CALLBACK cui_rawImpl::ProgressProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
 	LONG_PTR ptr = GetWindowLongPtr(hWnd, GWLP_USERDATA);
@@ -30,13 +41,8 @@ LRESULT CALLBACK cui_rawImpl::ProgressProc(HWND hWnd, UINT msg, WPARAM wParam, L
 		int cx = rc.right - rc.left;
 		int cy = rc.bottom - rc.top;
 
-		// use double buffering to avoid flicker
-		HDC hdc = CreateCompatibleDC(dc);
-
-		if (!pThis->hbm_buffer)
-			pThis->hbm_buffer = CreateCompatibleBitmap(dc, cx, cy);
-
-		HBITMAP hbmOld = SelectBitmap(hdc, pThis->hbm_buffer);
+		// use double buffering to avoid flicker; only the part being painted is drawn
+		HDC hdc = pThis->d->m_paint_buffer.Acquire(dc, cx, cy, ps.rcPaint);
 
 		int iBorderChangeFactor = 10;
 
@@ -84,11 +90,7 @@ LRESULT CALLBACK cui_rawImpl::ProgressProc(HWND hWnd, UINT msg, WPARAM wParam, L
 		else
 		{
 			// draw "busy" progress bar
-			Gdiplus::RectF m_rc = rect;
-			m_rc.X = 0;
-			m_rc.Width = 0.1f * rect.Width;
-
-			cui_rawImpl::pos_rect(m_rc, rect, static_cast<Gdiplus::REAL>(pThis->iBusyPerc), 0);
+			Gdiplus::RectF m_rc = busyBar(rect, pThis->iBusyPerc);
 
 			color.SetFromCOLORREF(pThis->clrBar);
 			brush.SetColor(color);
@@ -102,35 +104,18 @@ LRESULT CALLBACK cui_rawImpl::ProgressProc(HWND hWnd, UINT msg, WPARAM wParam, L
 			}
 		}
 
-		BitBlt(dc, 0, 0, cx, cy, hdc, 0, 0, SRCCOPY);
+		BitBlt(dc, ps.rcPaint.left, ps.rcPaint.top,
+			ps.rcPaint.right - ps.rcPaint.left, ps.rcPaint.bottom - ps.rcPaint.top,
+			hdc, ps.rcPaint.left, ps.rcPaint.top, SRCCOPY);
 
 		EndPaint(hWnd, &ps);
 
-		SelectBitmap(hdc, hbmOld);
-		DeleteDC(hdc);
-	}
-	break;
-
-	case WM_DESTROY:
-	{
-		// delete buffer, we're done
-		if (pThis->hbm_buffer)
-		{
-			DeleteBitmap(pThis->hbm_buffer);
-			pThis->hbm_buffer = NULL;
-		}
+		pThis->d->m_paint_buffer.Release(hdc);
 	}
 	break;
 
 	case WM_SIZE:
 	{
-		// delete buffer, we need it recreated
-		if (pThis->hbm_buffer)
-		{
-			DeleteBitmap(pThis->hbm_buffer);
-			pThis->hbm_buffer = NULL;
-		}
-
 		InvalidateRect(hWnd, NULL, FALSE);
 	}
 	break;
@@ -145,12 +130,14 @@ LRESULT CALLBACK cui_rawImpl::ProgressProc(HWND hWnd, UINT msg, WPARAM wParam, L
 				if (pThis->iBusyPerc == 0)
 					pThis->bBackward = false;
 
+			const int iBusyPerc = pThis->iBusyPerc;
+
 			if (pThis->bBackward)
 				pThis->iBusyPerc--;
 			else
 				pThis->iBusyPerc++;
 
-			InvalidateRect(hWnd, NULL, FALSE);
+			invalidateProgressBusy(*pThis, iBusyPerc, pThis->iBusyPerc);
 			UpdateWindow(hWnd);
 		}
 	}
@@ -161,3 +148,58 @@ LRESULT CALLBACK cui_rawImpl::ProgressProc(HWND hWnd, UINT msg, WPARAM wParam, L
 	// Any messages we don't process must be passed onto the original window function
 	return CallWindowProc((WNDPROC)pThis->PrevProc, hWnd, msg, wParam, lParam);
 } // ProgressProc
+
+void cui_rawImpl::invalidateProgress(cui_rawImpl::ProgressControl &Control, double dFrom, double dTo)
+{
+	// the border and the unfilled part stay as they are, only the bar between the two
+	// percentages changes
+	RECT rc;
+	GetClientRect(Control.hWnd, &rc);
+	InflateRect(&rc, -1, -1);
+
+	auto clamp = [](double dPerc)
+	{
+		return dPerc < 0 ? 0 : (dPerc > 100 ? 100 : dPerc);
+	};
+
+	const double dWidth = double(rc.right - rc.left);
+	const double dLow = dWidth * min(clamp(dFrom), clamp(dTo)) / 100.0;
+	const double dHigh = dWidth * max(clamp(dFrom), clamp(dTo)) / 100.0;
+
+	RECT rcUpdate = rc;
+
+	if (Control.bReverse)
+	{
+		rcUpdate.left = rc.right - static_cast<LONG>(dHigh);
+		rcUpdate.right = rc.right - static_cast<LONG>(dLow);
+	}
+	else
+	{
+		rcUpdate.left = rc.left + static_cast<LONG>(dLow);
+		rcUpdate.right = rc.left + static_cast<LONG>(dHigh);
+	}
+
+	// allow for the bar's edge falling between pixels
+	InflateRect(&rcUpdate, 1, 0);
+	InvalidateRect(Control.hWnd, &rcUpdate, FALSE);
+} // invalidateProgress
+
+void cui_rawImpl::invalidateProgressBusy(cui_rawImpl::ProgressControl &Control, int iFrom, int iTo)
+{
+	// the busy bar slides along, so repaint where it was and where it is now
+	RECT rc;
+	GetClientRect(Control.hWnd, &rc);
+
+	Gdiplus::RectF rect = convert_rect(rc);
+	rect.Inflate(-1.0f, -1.0f);
+
+	const RECT rcFrom = convert_rect(busyBar(rect, iFrom));
+	const RECT rcTo = convert_rect(busyBar(rect, iTo));
+
+	RECT rcUpdate;
+	UnionRect(&rcUpdate, &rcFrom, &rcTo);
+
+	// allow for the bar's edges falling between pixels
+	InflateRect(&rcUpdate, 1, 0);
+	InvalidateRect(Control.hWnd, &rcUpdate, FALSE);
+} // invalidateProgressBusy
@@ -705,15 +705,8 @@ static void addCaptionIcon(HWND hWnd, stateinfo_sf* pThis, int &iCaptionIconWidt
 			std::basic_string<TCHAR> sErr;
 			bool bRes = pThis->captionIconControl.GdiplusBitmap_res.Load(pThis->captionIconControl.iPNGResource, _T("PNG"), sErr, pThis->d->m_hResModule);
 		}
-		else
-			if (!pThis->captionIconControl.sFileName.empty())
-			{
-				// attempt to load image from file
 
-				// TO-DO: implement error response
-				std::basic_string<TCHAR> sErr;
-				bool bRes = pThis->captionIconControl.GdiplusBitmap.Load(pThis->captionIconControl.sFileName.c_str(), sErr);
-			}
+		// an image from a file is loaded in the background once the control is painted
 
 		// subclass static control so we can do custom drawing
 		SetWindowLongPtr(pThis->captionIconControl.hWnd, GWLP_USERDATA, (LONG_PTR)&pThis->captionIconControl);
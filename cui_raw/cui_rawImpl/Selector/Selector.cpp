@@ -40,13 +40,8 @@ LRESULT CALLBACK cui_rawImpl::SelectorProc(HWND hWnd, UINT msg, WPARAM wParam, L
 		PAINTSTRUCT ps;
 		HDC dc = BeginPaint(hWnd, &ps);
 
-		// use double buffering to avoid flicker
-		HDC hdc = CreateCompatibleDC(dc);
-
-		if (!pControl->hbm_buffer)
-			pControl->hbm_buffer = CreateCompatibleBitmap(dc, cx, cy);
-
-		HBITMAP hbmOld = SelectBitmap(hdc, pControl->hbm_buffer);
+		// use double buffering to avoid flicker; only the part being painted is drawn
+		HDC hdc = pControl->d->m_paint_buffer.Acquire(dc, cx, cy, ps.rcPaint);
 
 		{
 			CBrush brBackground(pControl->d->m_clrBackground);
@@ -235,13 +230,14 @@ LRESULT CALLBACK cui_rawImpl::SelectorProc(HWND hWnd, UINT msg, WPARAM wParam, L
 		SelectPen(hdc, hpen_old);
 		DeletePen(hpen);
 
-		BitBlt(dc, 0, 0, cx, cy, hdc, 0, 0, SRCCOPY);
-		SelectBitmap(hdc, hbmOld);
+		BitBlt(dc, ps.rcPaint.left, ps.rcPaint.top,
+			ps.rcPaint.right - ps.rcPaint.left, ps.rcPaint.bottom - ps.rcPaint.top,
+			hdc, ps.rcPaint.left, ps.rcPaint.top, SRCCOPY);
 
 		EndPaint(hWnd, &ps);
 
 		// cleanup
-		DeleteDC(hdc);
+		pControl->d->m_paint_buffer.Release(hdc);
 	}
 	break;
 
@@ -285,26 +281,8 @@ LRESULT CALLBACK cui_rawImpl::SelectorProc(HWND hWnd, UINT msg, WPARAM wParam, L
 	}
 	break;
 
-	case WM_DESTROY:
-	{
-		// delete buffer, we're done
-		if (pControl->hbm_buffer)
-		{
-			DeleteBitmap(pControl->hbm_buffer);
-			pControl->hbm_buffer = NULL;
-		}
-	}
-	break;
-
 	case WM_SIZE:
 	{
-		// delete buffer, we need it recreated
-		if (pControl->hbm_buffer)
-		{
-			DeleteBitmap(pControl->hbm_buffer);
-			pControl->hbm_buffer = NULL;
-		}
-
 		InvalidateRect(hWnd, NULL, FALSE);
 	}
 	break;
@@ -313,3 +291,15 @@ LRESULT CALLBACK cui_rawImpl::SelectorProc(HWND hWnd, UINT msg, WPARAM wParam, L
 	// Any messages we don't process must be passed onto the original window function
 	return CallWindowProc((WNDPROC)pControl->PrevProc, hWnd, msg, wParam, lParam);
 } // SelectorProc
+
+void cui_rawImpl::invalidateSelector(cui_rawImpl::SelectorControl &Control)
+{
+	RECT rcUpdate;
+	GetClientRect(Control.hWnd, &rcUpdate);
+
+	// the selector only moves up and down its column, the descriptions stay where they are
+	if (!IsRectEmpty(&Control.rcSelector))
+		rcUpdate.right = Control.rcSelector.right + 1;
+
+	InvalidateRect(Control.hWnd, &rcUpdate, FALSE);
+} // invalidateSelector
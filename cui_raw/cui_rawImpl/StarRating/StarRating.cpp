@@ -106,13 +106,8 @@ LRESULT CALLBACK cui_rawImpl::StarRatingProc(HWND hWnd, UINT msg, WPARAM wParam,
 		PAINTSTRUCT ps;
 		HDC dc = BeginPaint(hWnd, &ps);
 
-		// use double buffering to avoid flicker
-		HDC hdc = CreateCompatibleDC(dc);
-
-		if (!pControl->hbm_buffer)
-			pControl->hbm_buffer = CreateCompatibleBitmap(dc, cx, cy);
-
-		HBITMAP hbmOld = SelectBitmap(hdc, pControl->hbm_buffer);
+		// use double buffering to avoid flicker; only the part being painted is drawn
+		HDC hdc = pControl->d->m_paint_buffer.Acquire(dc, cx, cy, ps.rcPaint);
 
 		{
 			CBrush brBackground(pControl->d->m_clrBackground);
@@ -195,13 +190,14 @@ LRESULT CALLBACK cui_rawImpl::StarRatingProc(HWND hWnd, UINT msg, WPARAM wParam,
 		}
 
 		// do the BitBlt
-		BitBlt(dc, 0, 0, cx, cy, hdc, 0, 0, SRCCOPY);
-		SelectBitmap(hdc, hbmOld);
+		BitBlt(dc, ps.rcPaint.left, ps.rcPaint.top,
+			ps.rcPaint.right - ps.rcPaint.left, ps.rcPaint.bottom - ps.rcPaint.top,
+			hdc, ps.rcPaint.left, ps.rcPaint.top, SRCCOPY);
 
 		EndPaint(hWnd, &ps);
 
 		// cleanup
-		DeleteDC(hdc);
+		pControl->d->m_paint_buffer.Release(hdc);
 	}
 	break;
 
@@ -231,26 +227,8 @@ LRESULT CALLBACK cui_rawImpl::StarRatingProc(HWND hWnd, UINT msg, WPARAM wParam,
 	}
 	break;
 
-	case WM_DESTROY:
-	{
-		// delete buffer, we're done
-		if (pControl->hbm_buffer)
-		{
-			DeleteBitmap(pControl->hbm_buffer);
-			pControl->hbm_buffer = NULL;
-		}
-	}
-	break;
-
 	case WM_SIZE:
 	{
-		// delete buffer, we need it recreated
-		if (pControl->hbm_buffer)
-		{
-			DeleteBitmap(pControl->hbm_buffer);
-			pControl->hbm_buffer = NULL;
-		}
-
 		InvalidateRect(hWnd, NULL, FALSE);
 	}
 	break;
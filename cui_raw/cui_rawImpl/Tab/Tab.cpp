@@ -29,12 +29,8 @@ LRESULT CALLBACK cui_rawImpl::tabControlProc(HWND hWnd, UINT msg, WPARAM wParam,
 		int cy = rc.bottom - rc.top;
 
 		// use double buffering to prevent flicker
-		HDC hdc = CreateCompatibleDC(dc);
-
-		if (!pControl->hbm_buffer)
-			pControl->hbm_buffer = CreateCompatibleBitmap(dc, cx, cy);
-
-		HBITMAP hbmOld = SelectBitmap(hdc, pControl->hbm_buffer);
+		// use double buffering to avoid flicker; only the part being painted is drawn
+		HDC hdc = pControl->d->m_paint_buffer.Acquire(dc, cx, cy, ps.rcPaint);
 
 		Gdiplus::Graphics graphics(hdc);
 		Gdiplus::Color color;
@@ -163,35 +159,18 @@ LRESULT CALLBACK cui_rawImpl::tabControlProc(HWND hWnd, UINT msg, WPARAM wParam,
 			}
 		}
 
-		BitBlt(dc, 0, 0, cx, cy, hdc, 0, 0, SRCCOPY);
+		BitBlt(dc, ps.rcPaint.left, ps.rcPaint.top,
+			ps.rcPaint.right - ps.rcPaint.left, ps.rcPaint.bottom - ps.rcPaint.top,
+			hdc, ps.rcPaint.left, ps.rcPaint.top, SRCCOPY);
 
 		EndPaint(hWnd, &ps);
 
-		SelectBitmap(hdc, hbmOld);
-		DeleteDC(hdc);
-	}
-	break;
-
-	case WM_DESTROY:
-	{
-		// delete buffer, we're done
-		if (pControl->hbm_buffer)
-		{
-			DeleteBitmap(pControl->hbm_buffer);
-			pControl->hbm_buffer = NULL;
-		}
+		pControl->d->m_paint_buffer.Release(hdc);
 	}
 	break;
 
 	case WM_SIZE:
 	{
-		// delete buffer, we need it recreated
-		if (pControl->hbm_buffer)
-		{
-			DeleteBitmap(pControl->hbm_buffer);
-			pControl->hbm_buffer = NULL;
-		}
-
 		InvalidateRect(hWnd, NULL, TRUE);
 	}
 	break;
@@ -12,6 +12,42 @@
 
 static bool design = false;
 
+// the font a text control is painted with; delete it when done
+static Gdiplus::Font* makeFont(const cui_rawImpl::TextControl &Control, INT style)
+{
+	Gdiplus::FontFamily ffm(Control.sFontName.c_str());
+	Gdiplus::Font* p_font = new Gdiplus::Font(&ffm,
+		static_cast<Gdiplus::REAL>(Control.iFontSize), style);
+
+	if (p_font->GetLastStatus() != Gdiplus::Status::Ok)
+	{
+		delete p_font;
+		p_font = nullptr;
+		p_font = new Gdiplus::Font(Control.sFontName.c_str(),
+			static_cast<Gdiplus::REAL>(Control.iFontSize), style, Gdiplus::UnitPoint, &Control.d->m_font_collection);
+	}
+
+	return p_font;
+} // makeFont
+
+// the rectangle a text control's text takes up, aligned within the layout rectangle
+static Gdiplus::RectF measureText(const cui_rawImpl::TextControl &Control, Gdiplus::Graphics &graphics,
+	Gdiplus::Font* p_font, const Gdiplus::RectF &layoutRect)
+{
+	Gdiplus::RectF text_rect;
+	graphics.MeasureString(Control.sText.c_str(), -1, p_font, layoutRect, &text_rect);
+
+	if (!Control.bMultiLine)
+	{
+		if (text_rect.Width < layoutRect.Width)
+			text_rect.Width = min(text_rect.Width * 1.01f, layoutRect.Width);
+	}
+
+	// align the text rectangle to the layout rectangle
+	cui_rawImpl::align_text(text_rect, layoutRect, Control.align);
+	return text_rect;
+} // measureText
+
 LRESULT CALLBACK cui_rawImpl::TextControlProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
 	LONG_PTR ptr = GetWindowLongPtr(hWnd, GWLP_USERDATA);
@@ -29,13 +65,8 @@ LRESULT CALLBACK cui_rawImpl::TextControlProc(HWND hWnd, UINT msg, WPARAM wParam
 		int cx = rc.right - rc.left;
 		int cy = rc.bottom - rc.top;
 
-		// use double buffering to avoid flicker
-		HDC hdc = CreateCompatibleDC(dc);
-
-		if (!pThis->hbm_buffer)
-			pThis->hbm_buffer = CreateCompatibleBitmap(dc, cx, cy);
-
-		HBITMAP hbmOld = SelectBitmap(hdc, pThis->hbm_buffer);
+		// use double buffering to avoid flicker; only the part being painted is drawn
+		HDC hdc = pThis->d->m_paint_buffer.Acquire(dc, cx, cy, ps.rcPaint);
 
 		COLORREF clr_text = pThis->clrText;
 		INT style = Gdiplus::FontStyle::FontStyleRegular;
@@ -56,17 +87,7 @@ LRESULT CALLBACK cui_rawImpl::TextControlProc(HWND hWnd, UINT msg, WPARAM wParam
 
 		Gdiplus::RectF layoutRect = convert_rect(rc);
 
-		Gdiplus::FontFamily ffm(pThis->sFontName.c_str());
-		Gdiplus::Font* p_font = new Gdiplus::Font(&ffm,
-			static_cast<Gdiplus::REAL>(pThis->iFontSize), style);
-
-		if (p_font->GetLastStatus() != Gdiplus::Status::Ok)
-		{
-			delete p_font;
-			p_font = nullptr;
-			p_font = new Gdiplus::Font(pThis->sFontName.c_str(),
-				static_cast<Gdiplus::REAL>(pThis->iFontSize), style, Gdiplus::UnitPoint, &pThis->d->m_font_collection);
-		}
+		Gdiplus::Font* p_font = makeFont(*pThis, style);
 
 		color.SetFromCOLORREF(clr_text);
 		Gdiplus::SolidBrush text_brush(color);
@@ -79,17 +100,7 @@ LRESULT CALLBACK cui_rawImpl::TextControlProc(HWND hWnd, UINT msg, WPARAM wParam
 			format.SetFormatFlags(Gdiplus::StringFormatFlags::StringFormatFlagsNoWrap);
 
 		// measure text rectangle
-		Gdiplus::RectF text_rect;
-		graphics.MeasureString(pThis->sText.c_str(), -1, p_font, layoutRect, &text_rect);
-
-		if (!pThis->bMultiLine)
-		{
-			if (text_rect.Width < layoutRect.Width)
-				text_rect.Width = min(text_rect.Width * 1.01f, layoutRect.Width);
-		}
-
-		// align the text rectangle to the layout rectangle
-		align_text(text_rect, layoutRect, pThis->align);
+		Gdiplus::RectF text_rect = measureText(*pThis, graphics, p_font, layoutRect);
 
 		if (design)
 		{
@@ -112,12 +123,13 @@ LRESULT CALLBACK cui_rawImpl::TextControlProc(HWND hWnd, UINT msg, WPARAM wParam
 		// capture the text rectangle
 		pThis->rcText = convert_rect(text_rect);
 
-		BitBlt(dc, 0, 0, cx, cy, hdc, 0, 0, SRCCOPY);
+		BitBlt(dc, ps.rcPaint.left, ps.rcPaint.top,
+			ps.rcPaint.right - ps.rcPaint.left, ps.rcPaint.bottom - ps.rcPaint.top,
+			hdc, ps.rcPaint.left, ps.rcPaint.top, SRCCOPY);
 
 		EndPaint(hWnd, &ps);
 
-		SelectBitmap(hdc, hbmOld);
-		DeleteDC(hdc);
+		pThis->d->m_paint_buffer.Release(hdc);
 	}
 	break;
 
@@ -138,26 +150,8 @@ LRESULT CALLBACK cui_rawImpl::TextControlProc(HWND hWnd, UINT msg, WPARAM wParam
 	}
 	break;
 
-	case WM_DESTROY:
-	{
-		// delete buffer, we're done
-		if (pThis->hbm_buffer)
-		{
-			DeleteBitmap(pThis->hbm_buffer);
-			pThis->hbm_buffer = NULL;
-		}
-	}
-	break;
-
 	case WM_SIZE:
 	{
-		// delete buffer, we need it recreated
-		if (pThis->hbm_buffer)
-		{
-			DeleteBitmap(pThis->hbm_buffer);
-			pThis->hbm_buffer = NULL;
-		}
-
 		InvalidateRect(hWnd, NULL, TRUE);
 	}
 	break;
@@ -166,3 +160,36 @@ LRESULT CALLBACK cui_rawImpl::TextControlProc(HWND hWnd, UINT msg, WPARAM wParam
 	// Any messages we don't process must be passed onto the original window function
 	return CallWindowProc((WNDPROC)pThis->PrevProc, hWnd, msg, wParam, lParam);
 } // TextControlProc
+
+void cui_rawImpl::invalidateText(cui_rawImpl::TextControl &Control)
+{
+	if (IsRectEmpty(&Control.rcText))
+	{
+		InvalidateRect(Control.hWnd, NULL, TRUE);
+		return;
+	}
+
+	RECT rc;
+	GetClientRect(Control.hWnd, &rc);
+
+	// where the text was painted last, and where it will be painted now
+	INT style = Gdiplus::FontStyle::FontStyleRegular;
+
+	if (Control.bHot && !Control.bStatic)
+		style = Gdiplus::FontStyle::FontStyleUnderline;
+
+	Gdiplus::Graphics graphics(Control.hWnd);
+	Gdiplus::Font* p_font = makeFont(Control, style);
+
+	const RECT rcNew = convert_rect(measureText(Control, graphics, p_font, convert_rect(rc)));
+
+	delete p_font;
+	p_font = nullptr;
+
+	RECT rcUpdate;
+	UnionRect(&rcUpdate, &Control.rcText, &rcNew);
+
+	// allow for the edges of the text falling between pixels
+	InflateRect(&rcUpdate, 1, 1);
+	InvalidateRect(Control.hWnd, &rcUpdate, TRUE);
+} // invalidateText
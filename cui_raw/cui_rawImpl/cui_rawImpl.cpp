@@ -11,9 +11,12 @@
 #include "cui_rawImpl.h"
 #include "Combobox/Combobox.h"
 #include "TooltipControl/TooltipControl.h"
+#include "CChartScene/CChartSceneRender.h"
 #include "../scaleAdjust/scaleAdjust.h"
 #include "../HlpFxs/HlpFxs.h"
 
+#include <algorithm>
+
 #ifdef _UNICODE
 #define to_tstring	std::to_wstring
 #else
@@ -118,6 +121,8 @@ cui_rawImpl::cui_rawImpl(const std::wstring& title)
 
 	m_bParentClosing = false;
 
+	m_bHitGridValid = false;
+
 	uID = 1;	// tray icon id
 	m_iRegID = 0;	// this instance's registration ID
 	m_iCopyDataID = 0;	// the id to be called when data is received from another instance
@@ -128,6 +133,7 @@ cui_rawImpl::cui_rawImpl(const std::wstring& title)
 	m_vPreventQuitList.clear();
 	hRichEdit = NULL;
 	iAddToWM_APP = 1;
+	m_iImageLoadedMsg = GetNewMessageID();
 	vFonts.clear();
 }
 
@@ -727,7 +733,7 @@ void cui_rawImpl::checkPressToggleButtonControl(cui_rawImpl::ToggleButtonControl
 				SendMessage(GetParent(Control.hWnd), WM_COMMAND, (WPARAM)Control.iUniqueID, NULL);
 		}
 
-		InvalidateRect(Control.hWnd, NULL, FALSE);
+		invalidateToggleButton(Control, Control.bOldState);
 		UpdateWindow(Control.hWnd);
 	}
 
@@ -990,7 +996,7 @@ void cui_rawImpl::checkPressSelectorControl(cui_rawImpl::SelectorControl &Contro
 				// toggle button dragged
 			}
 
-			InvalidateRect(Control.hWnd, NULL, FALSE);
+			invalidateSelector(Control);
 			UpdateWindow(Control.hWnd);
 
 			if (Control.iSelectedItem != Control.iOldSelectedItem)
@@ -1094,14 +1100,24 @@ void cui_rawImpl::checkPressPieChartControl(cui_rawImpl::PieChartControl &Contro
 		}
 	}
 
-	// reset ALL
+	// reset ALL, along with the legend items that were drawn pressed
+	RECT rcLabels = { 0 };
+
 	for (auto &it : Control.chartBarsInfo)
+	{
+		if (it.bPressed)
+			UnionRect(&rcLabels, &rcLabels, &it.rcLabel);
+
 		it.bPressed = false;
+	}
 
 	if (bInPieChart)
 	{
-		// TO-DO: improve ... find a way of doing this BEFORE
-		InvalidateRect(Control.hWnd, NULL, FALSE);
+		// a pressed slice is drawn darker, so repaint the pie and the legend items
+		RECT rcUpdate = CChartSceneRender::Bounds(Control.scene.Pie().rc, 2);
+		UnionRect(&rcUpdate, &rcUpdate, &rcLabels);
+
+		InvalidateRect(Control.hWnd, &rcUpdate, FALSE);
 		UpdateWindow(Control.hWnd);
 	}
 } // checkPressPieChartControl
@@ -1164,9 +1180,22 @@ void cui_rawImpl::OnWM_LBUTTONUP(HWND hWnd, cui_rawImpl* d)
 
 			if (bSelChange)
 			{
+				// the tabs that are drawn differently now, the one selected and the one that was
+				RECT rcUpdate = { 0 };
+
 				// set selection change
 				for (size_t i = 0; i < d->m_Pages.at(d->m_sCurrentPage).m_TabControl.vTabs.size(); i++)
 				{
+					if (i == iSelected || d->m_Pages.at(d->m_sCurrentPage).m_TabControl.vTabs[i].bSelected)
+					{
+						// rcTab is the tab's hot area, inset from where it is drawn
+						const int iInset = int(0.5 + 5 * d->m_DPIScale);
+
+						RECT rc = d->m_Pages.at(d->m_sCurrentPage).m_TabControl.vTabs[i].rcTab;
+						InflateRect(&rc, iInset, iInset);
+						UnionRect(&rcUpdate, &rcUpdate, &rc);
+					}
+
 					if (i == iSelected)
 						d->m_Pages.at(d->m_sCurrentPage).m_TabControl.vTabs[i].bSelected = true;
 					else
@@ -1197,8 +1226,8 @@ void cui_rawImpl::OnWM_LBUTTONUP(HWND hWnd, cui_rawImpl* d)
 					}
 				}
 
-				// selection changed ... repaint tab control
-				InvalidateRect(d->m_Pages.at(d->m_sCurrentPage).m_TabControl.hWnd, NULL, TRUE);
+				// selection changed ... repaint the tabs
+				InvalidateRect(d->m_Pages.at(d->m_sCurrentPage).m_TabControl.hWnd, &rcUpdate, TRUE);
 				UpdateWindow(d->m_Pages.at(d->m_sCurrentPage).m_TabControl.hWnd);
 
 				// reset cursor ... if neccessary
@@ -1697,6 +1726,7 @@ void cui_rawImpl::flagPressPieChartControl(cui_rawImpl::PieChartControl &Control
 	Gdiplus::Graphics g(Control.hWnd);
 
 	bool bUpdate = false;
+	RECT rcLabels = { 0 };	// legend items whose pressed state has changed
 
 	bool bInPieChart = false;
 
@@ -1746,6 +1776,9 @@ void cui_rawImpl::flagPressPieChartControl(cui_rawImpl::PieChartControl &Control
 		if (bControlAvailable && bInRegion)
 		{
 			// user has pressed a bar
+			if (!Control.chartBarsInfo[i].bPressed)
+				UnionRect(&rcLabels, &rcLabels, &Control.chartBarsInfo[i].rcLabel);
+
 			Control.chartBarsInfo[i].bPressed = true;
 			bUpdate = true;
 		}
@@ -1755,6 +1788,7 @@ void cui_rawImpl::flagPressPieChartControl(cui_rawImpl::PieChartControl &Control
 			if (Control.chartBarsInfo[i].bPressed)
 			{
 				Control.chartBarsInfo[i].bPressed = false;
+				UnionRect(&rcLabels, &rcLabels, &Control.chartBarsInfo[i].rcLabel);
 				bUpdate = true;
 			}
 		}
@@ -1762,7 +1796,11 @@ void cui_rawImpl::flagPressPieChartControl(cui_rawImpl::PieChartControl &Control
 
 	if (bUpdate)
 	{
-		InvalidateRect(Control.hWnd, NULL, FALSE);
+		// pressing changes the slice and its legend item, not the rest of the chart
+		RECT rcUpdate = CChartSceneRender::Bounds(Control.scene.Pie().rc, 2);
+		UnionRect(&rcUpdate, &rcUpdate, &rcLabels);
+
+		InvalidateRect(Control.hWnd, &rcUpdate, FALSE);
 		UpdateWindow(Control.hWnd);
 	}
 } // flagPressPieChartControl
@@ -1994,6 +2032,9 @@ void cui_rawImpl::OnWM_RBUTTONDOWN(HWND hWnd, cui_rawImpl* d)
 
 void cui_rawImpl::OnWM_SIZE(HWND hWnd, WPARAM wParam, cui_rawImpl* d)
 {
+	// controls are moved when the window is resized
+	d->invalidateHitGrid();
+
 	// must be before the place where m_bMaximized is revised
 	if (wParam == SIZE_RESTORED && d->m_bMaximized)
 	{
@@ -2231,6 +2272,95 @@ void cui_rawImpl::resetImageControl(cui_rawImpl::ImageControl &Control)
 	}
 } // resetImageControl
 
+void cui_rawImpl::resetBarChartControl(cui_rawImpl::BarChartControl &Control)
+{
+	HideToolTip(Control.toolTip);
+
+	// repaint just the bars and legend items that were hot
+	RECT rcUpdate = { 0 };
+
+	for (auto &it : Control.chartBarsInfo)
+	{
+		if (!it.bHot)
+			continue;
+
+		it.bHot = false;
+		UnionRect(&rcUpdate, &rcUpdate, &it.rect);
+		UnionRect(&rcUpdate, &rcUpdate, &it.rcLabel);
+	}
+
+	if (!IsRectEmpty(&rcUpdate))
+	{
+		InflateRect(&rcUpdate, 1, 1);
+		InvalidateRect(Control.hWnd, &rcUpdate, FALSE);
+		UpdateWindow(Control.hWnd);
+	}
+} // resetBarChartControl
+
+void cui_rawImpl::resetLineChartControl(cui_rawImpl::LineChartControl &Control)
+{
+	HideToolTip(Control.toolTip);
+
+	bool bUpdate = false;
+
+	for (auto &it : Control.linesInfo)
+	{
+		bUpdate = bUpdate || it.bHot;
+		it.bHot = false;
+
+		for (auto &m_it : it.chartLinesInfo)
+		{
+			bUpdate = bUpdate || m_it.bHot;
+			m_it.bHot = false;
+		}
+	}
+
+	if (!bUpdate)
+		return;
+
+	if (Control.bLayoutCaptured)
+	{
+		// hover changes the lines, their nodes and the series labels, not the rest of the frame
+		RECT rcLegend = CChartSceneRender::Bounds(Control.scene.Frame().rcLegend);
+
+		RECT rcUpdate;
+		UnionRect(&rcUpdate, &Control.rcPlot, &rcLegend);
+		InvalidateRect(Control.hWnd, &rcUpdate, FALSE);
+	}
+	else
+		InvalidateRect(Control.hWnd, NULL, FALSE);
+
+	UpdateWindow(Control.hWnd);
+} // resetLineChartControl
+
+void cui_rawImpl::resetPieChartControl(cui_rawImpl::PieChartControl &Control)
+{
+	HideToolTip(Control.toolTip);
+
+	bool bUpdate = false;
+	RECT rcLabels = { 0 };	// legend items that were hot
+
+	for (auto &it : Control.chartBarsInfo)
+	{
+		if (!it.bHot)
+			continue;
+
+		it.bHot = false;
+		UnionRect(&rcLabels, &rcLabels, &it.rcLabel);
+		bUpdate = true;
+	}
+
+	if (bUpdate)
+	{
+		// a hover can change how every slice is drawn, so repaint the whole pie
+		RECT rcUpdate = CChartSceneRender::Bounds(Control.scene.Pie().rc, 2);
+		UnionRect(&rcUpdate, &rcUpdate, &rcLabels);
+
+		InvalidateRect(Control.hWnd, &rcUpdate, FALSE);
+		UpdateWindow(Control.hWnd);
+	}
+} // resetPieChartControl
+
 void cui_rawImpl::OnWM_MOUSELEAVE(HWND hWnd, cui_rawImpl* d)
 {
 	// reset window cursor
@@ -2268,26 +2398,12 @@ void cui_rawImpl::OnWM_MOUSELEAVE(HWND hWnd, cui_rawImpl* d)
 	{
 		// reset bar chart controls
 		for (auto &it : d->m_Pages.at(d->m_sCurrentPage).m_BarChartControls)
-		{
-			for (auto &m_it : it.second.chartBarsInfo)
-				m_it.bHot = false;
-
-			HideToolTip(it.second.toolTip);
-			InvalidateRect(it.second.hWnd, NULL, FALSE);
-			UpdateWindow(it.second.hWnd);
-		}
+			d->resetBarChartControl(it.second);
 
 		// reset pageless bar chart controls
 		if (d->m_sCurrentPage != d->m_sTitle)
 			for (auto &it : d->m_Pages.at(d->m_sTitle).m_BarChartControls)
-			{
-				for (auto &m_it : it.second.chartBarsInfo)
-					m_it.bHot = false;
-
-				HideToolTip(it.second.toolTip);
-				InvalidateRect(it.second.hWnd, NULL, FALSE);
-				UpdateWindow(it.second.hWnd);
-			}
+				d->resetBarChartControl(it.second);
 	}
 	catch (std::exception &e)
 	{
@@ -2299,36 +2415,12 @@ void cui_rawImpl::OnWM_MOUSELEAVE(HWND hWnd, cui_rawImpl* d)
 	{
 		// reset line chart controls
 		for (auto &it : d->m_Pages.at(d->m_sCurrentPage).m_LineChartControls)
-		{
-			for (auto &it : it.second.linesInfo)
-			{
-				it.bHot = false;
-
-				for (auto &m_it : it.chartLinesInfo)
-					m_it.bHot = false;
-			}
-
-			HideToolTip(it.second.toolTip);
-			InvalidateRect(it.second.hWnd, NULL, FALSE);
-			UpdateWindow(it.second.hWnd);
-		}
+			d->resetLineChartControl(it.second);
 
 		// reset pageless line chart controls
 		if (d->m_sCurrentPage != d->m_sTitle)
 			for (auto &it : d->m_Pages.at(d->m_sTitle).m_LineChartControls)
-			{
-				for (auto &it : it.second.linesInfo)
-				{
-					it.bHot = false;
-
-					for (auto &m_it : it.chartLinesInfo)
-						m_it.bHot = false;
-				}
-
-				HideToolTip(it.second.toolTip);
-				InvalidateRect(it.second.hWnd, NULL, FALSE);
-				UpdateWindow(it.second.hWnd);
-			}
+				d->resetLineChartControl(it.second);
 	}
 	catch (std::exception &e)
 	{
@@ -2340,26 +2432,12 @@ void cui_rawImpl::OnWM_MOUSELEAVE(HWND hWnd, cui_rawImpl* d)
 	{
 		// reset pie chart controls
 		for (auto &it : d->m_Pages.at(d->m_sCurrentPage).m_PieChartControls)
-		{
-			for (auto &m_it : it.second.chartBarsInfo)
-				m_it.bHot = false;
-
-			HideToolTip(it.second.toolTip);
-			InvalidateRect(it.second.hWnd, NULL, FALSE);
-			UpdateWindow(it.second.hWnd);
-		}
+			d->resetPieChartControl(it.second);
 
 		// reset pageless pie chart controls
 		if (d->m_sCurrentPage != d->m_sTitle)
 			for (auto &it : d->m_Pages.at(d->m_sTitle).m_PieChartControls)
-			{
-				for (auto &m_it : it.second.chartBarsInfo)
-					m_it.bHot = false;
-
-				HideToolTip(it.second.toolTip);
-				InvalidateRect(it.second.hWnd, NULL, FALSE);
-				UpdateWindow(it.second.hWnd);
-			}
+				d->resetPieChartControl(it.second);
 	}
 	catch (std::exception &e)
 	{
@@ -2373,9 +2451,14 @@ void cui_rawImpl::OnWM_MOUSELEAVE(HWND hWnd, cui_rawImpl* d)
 		for (auto &it : d->m_ControlBtns)
 		{
 			HideToolTip(it.second.toolTip);
-			it.second.bHot = false;
-			InvalidateRect(it.second.hWnd, NULL, FALSE);
-			UpdateWindow(it.second.hWnd);
+
+			// a hot button is drawn differently all over; the others don't change
+			if (it.second.bHot)
+			{
+				it.second.bHot = false;
+				InvalidateRect(it.second.hWnd, NULL, FALSE);
+				UpdateWindow(it.second.hWnd);
+			}
 		}
 	}
 	catch (std::exception &e)
@@ -2518,7 +2601,7 @@ void cui_rawImpl::OnWM_MOUSELEAVE(HWND hWnd, cui_rawImpl* d)
 				if (IsWindowEnabled(it.second.hWnd) && IsWindowVisible(it.second.hWnd))
 				{
 					// reset buttons
-					InvalidateRect(it.second.hWnd, NULL, FALSE);
+					invalidateText(it.second);
 					UpdateWindow(it.second.hWnd);
 				}
 			}
@@ -2538,7 +2621,7 @@ void cui_rawImpl::OnWM_MOUSELEAVE(HWND hWnd, cui_rawImpl* d)
 					if (IsWindowEnabled(it.second.hWnd) && IsWindowVisible(it.second.hWnd))
 					{
 						// reset buttons
-						InvalidateRect(it.second.hWnd, NULL, FALSE);
+						invalidateText(it.second);
 						UpdateWindow(it.second.hWnd);
 					}
 				}
@@ -2774,6 +2857,8 @@ void cui_rawImpl::hitStarRatingControl(cui_rawImpl::StarRatingControl &Control,
 
 	if (bControlAvailable && PtInRect(&rcStarRating, pt))
 	{
+		const bool bWasHot = Control.bHot;
+
 		// mouse is over a button
 		if (!Control.bHot)
 		{
@@ -2802,27 +2887,31 @@ void cui_rawImpl::hitStarRatingControl(cui_rawImpl::StarRatingControl &Control,
 				iPerc = int(dPerc + 0.5);
 		}
 
-		for (auto &it : Control.rcStars)
-			it.bHot = false;
-
-		Control.rcStars[0].bHot = true;
+		// repaint just the stars whose hover state changes
+		RECT rcUpdate = { 0 };
 
-		int i = 0;
-		for (auto &it : Control.rcStars)
+		for (size_t i = 0; i < Control.rcStars.size(); i++)
 		{
-			if (i == 0)
+			// the first star is always hot, the rest once the cursor is past their share
+			const bool bHot = i == 0 ||
+				iPerc > ((100 * (int)i) / (int)Control.rcStars.size());
+
+			if (Control.rcStars[i].bHot != bHot)
 			{
-				i++;
-				continue;
+				Control.rcStars[i].bHot = bHot;
+				UnionRect(&rcUpdate, &rcUpdate, &Control.rcStars[i].rc);
 			}
+		}
 
-			if (iPerc > ((100 * i) / (int)Control.rcStars.size()))
-				it.bHot = true;
+		// entering the control changes the color of every star that is on
+		if (!bWasHot)
+			rcUpdate = Control.rcStarRating;
 
-			i++;
+		if (!IsRectEmpty(&rcUpdate))
+		{
+			InflateRect(&rcUpdate, 1, 1);
+			InvalidateRect(Control.hWnd, &rcUpdate, FALSE);
 		}
-
-		InvalidateRect(Control.hWnd, &Control.rcStarRating, FALSE);	// TO-DO: make this conditional to avoid overdrawing
 	}
 	else
 	{
@@ -3173,7 +3262,7 @@ void cui_rawImpl::hitSelectorControl(cui_rawImpl::SelectorControl &Control, POIN
 
 			Control.iPercV = iPerc;
 
-			InvalidateRect(Control.hWnd, NULL, FALSE);
+			invalidateSelector(Control);
 		}
 	}
 } // hitSelectorControl
@@ -3188,7 +3277,13 @@ void cui_rawImpl::hitBarChartControl(cui_rawImpl::BarChartControl &Control, POIN
 		bControlAvailable = true;
 
 	bool bInCaptions = false;
-	bool bUpdate = false;
+
+	// hover states on entry, to work out what needs repainting
+	std::vector<bool> vWasHot;
+	vWasHot.reserve(Control.chartBarsInfo.size());
+
+	for (const auto &it : Control.chartBarsInfo)
+		vWasHot.push_back(it.bHot);
 
 	for (auto &it : Control.chartBarsInfo)
 	{
@@ -3232,7 +3327,6 @@ void cui_rawImpl::hitBarChartControl(cui_rawImpl::BarChartControl &Control, POIN
 				}
 
 				it.bHot = true;
-				bUpdate = true;
 			}
 		}
 		else
@@ -3241,7 +3335,6 @@ void cui_rawImpl::hitBarChartControl(cui_rawImpl::BarChartControl &Control, POIN
 			if (it.bHot)
 			{
 				it.bHot = false;
-				bUpdate = true;
 			}
 		}
 	}
@@ -3293,7 +3386,6 @@ void cui_rawImpl::hitBarChartControl(cui_rawImpl::BarChartControl &Control, POIN
 
 					it.bHot = true;
 					RECT rc = it.rect;
-					bUpdate = true;
 				}
 			}
 			else
@@ -3309,7 +3401,6 @@ void cui_rawImpl::hitBarChartControl(cui_rawImpl::BarChartControl &Control, POIN
 
 					it.bHot = false;
 					RECT rc = it.rect;
-					bUpdate = true;
 				}
 			}
 		}
@@ -3325,9 +3416,24 @@ void cui_rawImpl::hitBarChartControl(cui_rawImpl::BarChartControl &Control, POIN
 		}
 	}
 
-	if (bUpdate)
+	// repaint just the bars and legend items whose hover state has changed
+	RECT rcUpdate = { 0 };
+
+	for (size_t i = 0; i < Control.chartBarsInfo.size(); i++)
 	{
-		InvalidateRect(Control.hWnd, NULL, FALSE);
+		const auto &it = Control.chartBarsInfo[i];
+
+		if (it.bHot == vWasHot[i])
+			continue;
+
+		UnionRect(&rcUpdate, &rcUpdate, &it.rect);
+		UnionRect(&rcUpdate, &rcUpdate, &it.rcLabel);
+	}
+
+	if (!IsRectEmpty(&rcUpdate))
+	{
+		InflateRect(&rcUpdate, 1, 1);
+		InvalidateRect(Control.hWnd, &rcUpdate, FALSE);
 		UpdateWindow(Control.hWnd);
 	}
 } // hitBarChartControl
@@ -3498,7 +3604,18 @@ void cui_rawImpl::hitLineChartControl(cui_rawImpl::LineChartControl &Control, PO
 
 	if (bUpdate)
 	{
-		InvalidateRect(Control.hWnd, NULL, FALSE);
+		if (Control.bLayoutCaptured)
+		{
+			// hover changes the lines, their nodes and the series labels, not the rest of the frame
+			RECT rcLegend = CChartSceneRender::Bounds(Control.scene.Frame().rcLegend);
+
+			RECT rcUpdate;
+			UnionRect(&rcUpdate, &Control.rcPlot, &rcLegend);
+			InvalidateRect(Control.hWnd, &rcUpdate, FALSE);
+		}
+		else
+			InvalidateRect(Control.hWnd, NULL, FALSE);
+
 		UpdateWindow(Control.hWnd);
 	}
 } // hitLineChartControl
@@ -3527,6 +3644,7 @@ void cui_rawImpl::hitPieChartControl(cui_rawImpl::PieChartControl &Control, POIN
 	Gdiplus::Graphics g(Control.hWnd);
 
 	bool bUpdate = false;
+	RECT rcLabels = { 0 };	// labels whose hover state has changed
 
 	bool bInPieChart = false;
 
@@ -3591,6 +3709,7 @@ void cui_rawImpl::hitPieChartControl(cui_rawImpl::PieChartControl &Control, POIN
 				}
 
 				Control.chartBarsInfo[i].bHot = true;
+				UnionRect(&rcLabels, &rcLabels, &Control.chartBarsInfo[i].rcLabel);
 				bUpdate = true;
 			}
 		}
@@ -3606,6 +3725,7 @@ void cui_rawImpl::hitPieChartControl(cui_rawImpl::PieChartControl &Control, POIN
 				}
 
 				Control.chartBarsInfo[i].bHot = false;
+				UnionRect(&rcLabels, &rcLabels, &Control.chartBarsInfo[i].rcLabel);
 				bUpdate = true;
 			}
 		}
@@ -3613,7 +3733,11 @@ void cui_rawImpl::hitPieChartControl(cui_rawImpl::PieChartControl &Control, POIN
 
 	if (bUpdate)
 	{
-		InvalidateRect(Control.hWnd, NULL, FALSE);
+		// a hover can change how every slice is drawn, so repaint the whole pie
+		RECT rcUpdate = CChartSceneRender::Bounds(Control.scene.Pie().rc, 2);
+		UnionRect(&rcUpdate, &rcUpdate, &rcLabels);
+
+		InvalidateRect(Control.hWnd, &rcUpdate, FALSE);
 		UpdateWindow(Control.hWnd);
 	}
 
@@ -3713,7 +3837,7 @@ void cui_rawImpl::hitTextControl(cui_rawImpl::TextControl &Control, POINT &pt, s
 
 				if (!Control.bStatic)
 				{
-					InvalidateRect(Control.hWnd, NULL, FALSE);
+					invalidateText(Control);
 					UpdateWindow(Control.hWnd);
 				}
 			}
@@ -3732,7 +3856,7 @@ void cui_rawImpl::hitTextControl(cui_rawImpl::TextControl &Control, POINT &pt, s
 
 				if (!Control.bStatic)
 				{
-					InvalidateRect(Control.hWnd, NULL, FALSE);
+					invalidateText(Control);
 					UpdateWindow(Control.hWnd);
 				}
 			}
@@ -3740,6 +3864,138 @@ void cui_rawImpl::hitTextControl(cui_rawImpl::TextControl &Control, POINT &pt, s
 	}
 } // hitTextControl
 
+void cui_rawImpl::invalidateHitGrid()
+{
+	m_bHitGridValid = false;
+} // invalidateHitGrid
+
+void cui_rawImpl::buildHitGrid(HWND hWnd)
+{
+	// remember the controls that were under the cursor, so that they are still reset when
+	// the cursor leaves them
+	std::vector<void *> vLast;
+
+	for (auto &it : m_vHitLast)
+		vLast.push_back(m_vHitEntries[it].pControl);
+
+	m_vHitEntries.clear();
+	m_vHitLast.clear();
+	m_HitGrid.Clear();
+
+	// controls of the current page, then pageless controls, as OnWM_MOUSEMOVE has always
+	// hit tested them
+	auto addControls = [&](auto getControls, hitType type)
+	{
+		try
+		{
+			for (auto &it : getControls(m_Pages.at(m_sCurrentPage)))
+				m_vHitEntries.push_back({ type, &it.second, it.second.hWnd });
+
+			if (m_sCurrentPage != m_sTitle)
+				for (auto &it : getControls(m_Pages.at(m_sTitle)))
+					if (it.second.bPageLess)
+						m_vHitEntries.push_back({ type, &it.second, it.second.hWnd });
+		}
+		catch (std::exception &e)
+		{
+			// do nothing ... map probably out of range
+			std::string m_sErr = e.what();
+		}
+	};
+
+	addControls([](page &p) -> auto & { return p.m_BarChartControls; }, hitBarChart);
+	addControls([](page &p) -> auto & { return p.m_LineChartControls; }, hitLineChart);
+	addControls([](page &p) -> auto & { return p.m_PieChartControls; }, hitPieChart);
+	addControls([](page &p) -> auto & { return p.m_ButtonControls; }, hitButton);
+	addControls([](page &p) -> auto & { return p.m_ToggleButtonControls; }, hitToggleButton);
+	addControls([](page &p) -> auto & { return p.m_StarRatingControls; }, hitStarRating);
+	addControls([](page &p) -> auto & { return p.m_SelectorControls; }, hitSelector);
+	addControls([](page &p) -> auto & { return p.m_ImageControls; }, hitImage);
+	addControls([](page &p) -> auto & { return p.m_TextControls; }, hitText);
+
+	for (auto &it : m_ControlBtns)
+		m_vHitEntries.push_back({ hitControlBtn, &it.second, it.second.hWnd });
+
+	// the grid is over the window rectangles, which hold every rectangle the hit functions
+	// test; the margin covers image controls, which move by a few pixels when hot
+	const int iMargin = 4;
+
+	for (size_t i = 0; i < m_vHitEntries.size(); i++)
+	{
+		RECT rc;
+
+		if (!GetWindowRect(m_vHitEntries[i].hWnd, &rc))
+			continue;
+
+		MapWindowPoints(NULL, hWnd, reinterpret_cast<LPPOINT>(&rc), 2);
+		InflateRect(&rc, iMargin, iMargin);
+
+		CHitGrid::rect rcGrid;
+		rcGrid.left = rc.left;
+		rcGrid.top = rc.top;
+		rcGrid.right = rc.right;
+		rcGrid.bottom = rc.bottom;
+		m_HitGrid.Add(rcGrid, i);
+
+		if (std::find(vLast.begin(), vLast.end(), m_vHitEntries[i].pControl) != vLast.end())
+			m_vHitLast.push_back(i);
+	}
+
+	m_HitGrid.Build();
+
+	m_sHitGridPage = m_sCurrentPage;
+	m_bHitGridValid = true;
+} // buildHitGrid
+
+void cui_rawImpl::hitTest(hitEntry &entry, POINT &pt, std::vector<RECT> &m_vHotRects)
+{
+	switch (entry.type)
+	{
+	case hitBarChart:
+		hitBarChartControl(*static_cast<BarChartControl *>(entry.pControl), pt, m_vHotRects);
+		break;
+
+	case hitLineChart:
+		hitLineChartControl(*static_cast<LineChartControl *>(entry.pControl), pt, m_vHotRects);
+		break;
+
+	case hitPieChart:
+		hitPieChartControl(*static_cast<PieChartControl *>(entry.pControl), pt, m_vHotRects);
+		break;
+
+	case hitButton:
+		hitButtonControl(*static_cast<ButtonControl *>(entry.pControl), pt, m_vHotRects);
+		break;
+
+	case hitToggleButton:
+		hitToggleButtonControl(*static_cast<ToggleButtonControl *>(entry.pControl), pt, m_vHotRects);
+		break;
+
+	case hitStarRating:
+		hitStarRatingControl(*static_cast<StarRatingControl *>(entry.pControl), pt, m_vHotRects);
+		break;
+
+	case hitSelector:
+		hitSelectorControl(*static_cast<SelectorControl *>(entry.pControl), pt, m_vHotRects);
+		break;
+
+	case hitImage:
+		hitImageControl(*static_cast<ImageControl *>(entry.pControl), pt, m_vHotRects);
+		break;
+
+	case hitText:
+		hitTextControl(*static_cast<TextControl *>(entry.pControl), pt, m_vHotRects);
+		break;
+
+	case hitControlBtn:
+		hitControlButton(*static_cast<ControlBtn *>(entry.pControl), pt, m_vHotRects);
+		break;
+
+	default:
+		break;
+	}
+} // hitTest
+
 void cui_rawImpl::OnWM_MOUSEMOVE(HWND hWnd, LPARAM lParam, cui_rawImpl* d)
 {
 	if (d->m_iTimer > 0 && d->m_bTimerRunning && d->m_bStopOnMouseOverWindow)
@@ -3849,203 +4105,49 @@ void cui_rawImpl::OnWM_MOUSEMOVE(HWND hWnd, LPARAM lParam, cui_rawImpl* d)
 		std::string m_sErr = e.what();
 	}
 
-	try
-	{
-		// handle current page's bar charts
-		for (auto &it : d->m_Pages.at(d->m_sCurrentPage).m_BarChartControls)
-			d->hitBarChartControl(it.second, pt, m_vHotRects);
+	// hit test the controls under the cursor, and those that were under it on the last
+	// mouse move so that they are reset
+	if (!d->m_bHitGridValid || d->m_sHitGridPage != d->m_sCurrentPage)
+		d->buildHitGrid(hWnd);
 
-		// handle pageless bar chart controls
-		if (d->m_sCurrentPage != d->m_sTitle)
-			for (auto &it : d->m_Pages.at(d->m_sTitle).m_BarChartControls)
-				if (it.second.bPageLess)
-					d->hitBarChartControl(it.second, pt, m_vHotRects);
-	}
-	catch (std::exception &e)
-	{
-		// do nothing ... map probably out of range
-		std::string m_sErr = e.what();
-	}
+	std::vector<size_t> &vCandidates = d->m_vHitCandidates;
+	d->m_HitGrid.Query(pt.x, pt.y, vCandidates);
 
-	try
-	{
-		// handle current page's line charts
-		for (auto &it : d->m_Pages.at(d->m_sCurrentPage).m_LineChartControls)
-			d->hitLineChartControl(it.second, pt, m_vHotRects);
+	const size_t iUnderCursor = vCandidates.size();
+	vCandidates.insert(vCandidates.end(), d->m_vHitLast.begin(), d->m_vHitLast.end());
+	d->m_vHitLast.assign(vCandidates.begin(), vCandidates.begin() + iUnderCursor);
 
-		// handle pageless line chart controls
-		if (d->m_sCurrentPage != d->m_sTitle)
-			for (auto &it : d->m_Pages.at(d->m_sTitle).m_LineChartControls)
-				if (it.second.bPageLess)
-					d->hitLineChartControl(it.second, pt, m_vHotRects);
-	}
-	catch (std::exception &e)
+	// hit test in the order of the entries, which is the order the controls have always
+	// been hit tested in
+	std::sort(vCandidates.begin(), vCandidates.end());
+	vCandidates.erase(std::unique(vCandidates.begin(), vCandidates.end()), vCandidates.end());
+
+	for (auto &it : vCandidates)
+		d->hitTest(d->m_vHitEntries[it], pt, m_vHotRects);
+
+	bool bSetCursorToHand = false;
+
+	for (size_t i = 0; i < m_vHotRects.size(); i++)
 	{
-		// do nothing ... map probably out of range
-		std::string m_sErr = e.what();
+		if (PtInRect(&m_vHotRects[i], pt))
+		{
+			bSetCursorToHand = true;
+			break;
+		}
 	}
 
-	try
+	// change cursor, if necessary ...
+	if (bSetCursorToHand)
 	{
-		// handle current page's pie charts charts
-		for (auto &it : d->m_Pages.at(d->m_sCurrentPage).m_PieChartControls)
-			d->hitPieChartControl(it.second, pt, m_vHotRects);
-
-		// handle pageless pie chart controls
-		if (d->m_sCurrentPage != d->m_sTitle)
-			for (auto &it : d->m_Pages.at(d->m_sTitle).m_PieChartControls)
-				if (it.second.bPageLess)
-					d->hitPieChartControl(it.second, pt, m_vHotRects);
+		if (GetCursor() != d->m_hHotCursor)
+			SetClassLongPtr(hWnd, GCLP_HCURSOR, (LONG_PTR)d->m_hHotCursor);
 	}
-	catch (std::exception &e)
+	else
 	{
-		// do nothing ... map probably out of range
-		std::string m_sErr = e.what();
+		if (GetCursor() != d->m_hNormalCursor)
+			SetClassLongPtr(hWnd, GCLP_HCURSOR, (LONG_PTR)d->m_hNormalCursor);
 	}
-
-	try
-	{
-		// handle current page's buttons
-		for (auto &it : d->m_Pages.at(d->m_sCurrentPage).m_ButtonControls)
-			d->hitButtonControl(it.second, pt, m_vHotRects);
-
-		// handle pageless button controls
-		if (d->m_sCurrentPage != d->m_sTitle)
-			for (auto &it : d->m_Pages.at(d->m_sTitle).m_ButtonControls)
-				if (it.second.bPageLess)
-					d->hitButtonControl(it.second, pt, m_vHotRects);
-	}
-	catch (std::exception &e)
-	{
-		// do nothing ... map probably out of range
-		std::string m_sErr = e.what();
-	}
-
-	try
-	{
-		// handle current page's toggle buttons
-		for (auto &it : d->m_Pages.at(d->m_sCurrentPage).m_ToggleButtonControls)
-			d->hitToggleButtonControl(it.second, pt, m_vHotRects);
-
-		// handle pageless toggle buttons
-		if (d->m_sCurrentPage != d->m_sTitle)
-			for (auto &it : d->m_Pages.at(d->m_sTitle).m_ToggleButtonControls)
-				if (it.second.bPageLess)
-					d->hitToggleButtonControl(it.second, pt, m_vHotRects);
-	}
-	catch (std::exception &e)
-	{
-		// do nothing ... map probably out of range
-		std::string m_sErr = e.what();
-	}
-
-	try
-	{
-		// handle current star rating controls
-		for (auto &it : d->m_Pages.at(d->m_sCurrentPage).m_StarRatingControls)
-			d->hitStarRatingControl(it.second, pt, m_vHotRects);
-
-		// handle pageless star rating controls
-		if (d->m_sCurrentPage != d->m_sTitle)
-			for (auto &it : d->m_Pages.at(d->m_sTitle).m_StarRatingControls)
-				if (it.second.bPageLess)
-					d->hitStarRatingControl(it.second, pt, m_vHotRects);
-	}
-	catch (std::exception &e)
-	{
-		// do nothing ... map probably out of range
-		std::string m_sErr = e.what();
-	}
-
-	try
-	{
-		// handle current page's selector controls
-		for (auto &it : d->m_Pages.at(d->m_sCurrentPage).m_SelectorControls)
-			d->hitSelectorControl(it.second, pt, m_vHotRects);
-
-		// handle pageless selector controls
-		if (d->m_sCurrentPage != d->m_sTitle)
-			for (auto &it : d->m_Pages.at(d->m_sTitle).m_SelectorControls)
-				if (it.second.bPageLess)
-					d->hitSelectorControl(it.second, pt, m_vHotRects);
-	}
-	catch (std::exception &e)
-	{
-		// do nothing ... map probably out of range
-		std::string m_sErr = e.what();
-	}
-
-	try
-	{
-		// handle current page's image controls
-		for (auto &it : d->m_Pages.at(d->m_sCurrentPage).m_ImageControls)
-			d->hitImageControl(it.second, pt, m_vHotRects);
-
-		// handle pageless image controls
-		if (d->m_sCurrentPage != d->m_sTitle)
-			for (auto &it : d->m_Pages.at(d->m_sTitle).m_ImageControls)
-				if (it.second.bPageLess)
-					d->hitImageControl(it.second, pt, m_vHotRects);
-	}
-	catch (std::exception &e)
-	{
-		// do nothing ... map probably out of range
-		std::string m_sErr = e.what();
-	}
-
-	try
-	{
-		// handle current page's text controls
-		for (auto &it : d->m_Pages.at(d->m_sCurrentPage).m_TextControls)
-			d->hitTextControl(it.second, pt, m_vHotRects);
-
-		// handle pageless text controls
-		if (d->m_sCurrentPage != d->m_sTitle)
-			for (auto &it : d->m_Pages.at(d->m_sTitle).m_TextControls)
-				if (it.second.bPageLess)
-					d->hitTextControl(it.second, pt, m_vHotRects);
-	}
-	catch (std::exception &e)
-	{
-		// do nothing ... map probably out of range
-		std::string m_sErr = e.what();
-	}
-
-	try
-	{
-		// handle control button controls
-		for (auto &it : d->m_ControlBtns)
-			d->hitControlButton(it.second, pt, m_vHotRects);
-	}
-	catch (std::exception &e)
-	{
-		// do nothing ... map probably out of range
-		std::string m_sErr = e.what();
-	}
-
-	bool bSetCursorToHand = false;
-
-	for (size_t i = 0; i < m_vHotRects.size(); i++)
-	{
-		if (PtInRect(&m_vHotRects[i], pt))
-		{
-			bSetCursorToHand = true;
-			break;
-		}
-	}
-
-	// change cursor, if necessary ...
-	if (bSetCursorToHand)
-	{
-		if (GetCursor() != d->m_hHotCursor)
-			SetClassLongPtr(hWnd, GCLP_HCURSOR, (LONG_PTR)d->m_hHotCursor);
-	}
-	else
-	{
-		if (GetCursor() != d->m_hNormalCursor)
-			SetClassLongPtr(hWnd, GCLP_HCURSOR, (LONG_PTR)d->m_hNormalCursor);
-	}
-} // OnWM_MOUSEMOVE
+} // OnWM_MOUSEMOVE
 
 LRESULT cui_rawImpl::OnWM_NOTIFY(HWND hWnd, LPARAM lParam, cui_rawImpl* d)
 {
@@ -4163,8 +4265,10 @@ LRESULT cui_rawImpl::OnWM_NOTIFY(HWND hWnd, LPARAM lParam, cui_rawImpl* d)
 		{
 			try
 			{
-				if (d->m_Pages.at(d->m_sCurrentPage).m_listviewControls.find(Val_notify->hdr.idFrom) != d->m_Pages.at(d->m_sCurrentPage).m_listviewControls.end())
-					return HandleCustomDraw((NMLVCUSTOMDRAW*)pHdr, pHdr->hwndFrom, d->m_Pages.at(d->m_sCurrentPage).m_listviewControls.at(Val_notify->hdr.idFrom).vData, d->m_Pages.at(d->m_sCurrentPage).m_listviewControls.at(Val_notify->hdr.idFrom).vColumns);
+				cui_rawImpl::listviewControl *pControl = d->findVisibleListview(Val_notify->hdr.idFrom);
+
+				if (pControl)
+					return HandleCustomDraw((NMLVCUSTOMDRAW*)pHdr, pHdr->hwndFrom, *pControl);
 			}
 			catch (std::exception &e)
 			{
@@ -4174,6 +4278,62 @@ LRESULT cui_rawImpl::OnWM_NOTIFY(HWND hWnd, LPARAM lParam, cui_rawImpl* d)
 		}
 		break; // NM_CUSTOMDRAW
 
+		case LVN_GETDISPINFO:
+		{
+			// virtual listview is asking for the text of an item
+			try
+			{
+				cui_rawImpl::listviewControl *pControl = d->findVisibleListview(Val_notify->hdr.idFrom);
+
+				if (pControl && pControl->bVirtual)
+				{
+					NMLVDISPINFO *pDispInfo = (NMLVDISPINFO*)lParam;
+
+					if ((pDispInfo->item.mask & LVIF_TEXT) && pDispInfo->item.pszText && pDispInfo->item.cchTextMax > 0)
+					{
+						const ClistviewCache::cell *pCell =
+							pControl->cache.GetCell(pDispInfo->item.iItem, pDispInfo->item.iSubItem);
+
+						if (pCell)
+							lstrcpyn(pDispInfo->item.pszText, pCell->sText.c_str(), pDispInfo->item.cchTextMax);
+						else
+							pDispInfo->item.pszText[0] = 0;
+					}
+				}
+			}
+			catch (std::exception &e)
+			{
+				// do nothing ... map probably out of range
+				std::string m_sErr = e.what();
+			}
+		}
+		break; // LVN_GETDISPINFO
+
+		case LVN_ODCACHEHINT:
+		{
+			// virtual listview is about to display a range of rows
+			try
+			{
+				cui_rawImpl::listviewControl *pControl = d->findVisibleListview(Val_notify->hdr.idFrom);
+
+				if (pControl && pControl->bVirtual)
+				{
+					NMLVCACHEHINT *pCacheHint = (NMLVCACHEHINT*)lParam;
+					pControl->cache.Hint(pCacheHint->iFrom, pCacheHint->iTo);
+				}
+			}
+			catch (std::exception &e)
+			{
+				// do nothing ... map probably out of range
+				std::string m_sErr = e.what();
+			}
+		}
+		break; // LVN_ODCACHEHINT
+
+		case LVN_ODFINDITEM:
+			// incremental search is not supported in virtual listviews
+			return -1;
+
 		case LVN_COLUMNCLICK:
 		{
 			// check for listview column click notification
@@ -4183,7 +4343,8 @@ LRESULT cui_rawImpl::OnWM_NOTIFY(HWND hWnd, LPARAM lParam, cui_rawImpl* d)
 				{
 					int i = Val_notify->hdr.idFrom;
 
-					if (d->m_Pages.at(d->m_sCurrentPage).m_listviewControls.at(i).bSortByClickingColumn)
+					if (d->m_Pages.at(d->m_sCurrentPage).m_listviewControls.at(i).bSortByClickingColumn &&
+						!d->m_Pages.at(d->m_sCurrentPage).m_listviewControls.at(i).bVirtual)
 					{
 						// sort column
 						LPNMLISTVIEW pLVInfo = Val_notify;
@@ -4208,102 +4369,174 @@ LRESULT cui_rawImpl::OnWM_NOTIFY(HWND hWnd, LPARAM lParam, cui_rawImpl* d)
 						if (!d->m_Pages.at(d->m_sCurrentPage).m_listviewControls.at(i).bSortAscending)
 							lParamSort = -lParamSort;
 
-						sortstruct Sort;
-						Sort.lParamSort = lParamSort;
-						Sort.hlistview = pLVInfo->hdr.hwndFrom;
+						cui_rawImpl::listviewControl *pControl = &d->m_Pages.at(d->m_sCurrentPage).m_listviewControls.at(i);
 
-						/*
-						** sort list
-						*/
-						ListView_SortItemsEx(pLVInfo->hdr.hwndFrom, CompareListItems, (LPARAM)&Sort);
-
-						// change listview index numbers
-						if (d->m_Pages.at(d->m_sCurrentPage).m_listviewControls.find(Val_notify->hdr.idFrom) != d->m_Pages.at(d->m_sCurrentPage).m_listviewControls.end())
+						if (pControl->pClistview &&
+							(int)pControl->vData.size() == pControl->pClistview->Get_NumOfRows())
 						{
-							// set double click flag to true
-							cui_rawImpl::listviewControl *pControl = &d->m_Pages.at(d->m_sCurrentPage).m_listviewControls.at(Val_notify->hdr.idFrom);
+							/*
+							** sort on pre-computed keys from our own copy of the data, then
+							** move the rows in the control and in vData in one pass each
+							*/
+							const int iSortColumn = pControl->nSortColumn;
 
-							int iUniqueColumnNumber = -1;
+							std::basic_string<TCHAR> sSortColumnName;
 
-							// determine unique column number
-							for (size_t iColumnNames = 0; iColumnNames < pControl->vColumns.size(); iColumnNames++)
+							for (const auto &col : pControl->vColumns)
 							{
-								if (
-									pControl->vColumns[iColumnNames].sColumnName ==
-									pControl->sUniqueColumnName)
+								if (col.iColumnID == iSortColumn)
 								{
-									iUniqueColumnNumber = pControl->vColumns[iColumnNames].iColumnID;
+									sSortColumnName = col.sColumnName;
 									break;
 								}
 							}
 
-							// updated listview data container that will have items in the new order
-							std::vector<cui_raw::listviewRow> vData(pControl->vData.size());
+							std::vector<const std::basic_string<TCHAR>*> vText(pControl->vData.size(), nullptr);
 
-							for (auto &row : pControl->vData)
+							for (size_t iRow = 0; iRow < pControl->vData.size(); iRow++)
 							{
-								int iRowNumber = -1;
+								for (const auto &it : pControl->vData[iRow].vItems)
+								{
+									if (it.sColumnName == sSortColumnName)
+									{
+										vText[iRow] = &it.sItemData;
+										break;
+									}
+								}
+							}
 
-								// get number of columns
-								const int iCols = pControl->pClistview->Get_NumOfCols();
+							ClistviewSort::enType type = ClistviewSort::String;
 
-								// get number of rows
-								const int iRows = pControl->pClistview->Get_NumOfRows();
+							switch (pControl->pClistview->GetColType(iSortColumn))
+							{
+							case Clistview::Char: type = ClistviewSort::Char; break;
+							case Clistview::Int: type = ClistviewSort::Int; break;
+							case Clistview::Float: type = ClistviewSort::Float; break;
+							case Clistview::String:
+							default: type = ClistviewSort::String; break;
+							}
 
-								LVITEM lv = { 0 };
+							const std::vector<int> vOrder = ClistviewSort::Sort(vText, type, pControl->bSortAscending == TRUE);
 
-								HWND m_hlistview = pControl->hWnd;
+							if (pControl->pClistview->Reorder(vOrder))
+							{
+								std::vector<cui_raw::listviewRow> vData(vOrder.size());
 
-								for (int iRow = 0; iRow < iRows; iRow++)
+								for (size_t iRow = 0; iRow < vOrder.size(); iRow++)
 								{
-									lv.mask = LVIF_TEXT;
-									lv.iItem = iRow;
+									vData[iRow] = std::move(pControl->vData[vOrder[iRow]]);
+
+									// update internal row number in listview items
+									for (auto &it : vData[iRow].vItems)
+										it.iRowNumber = (int)iRow;
+								}
 
-									bool bMatch = false;
+								pControl->vData.swap(vData);
 
-									for (int iCol = 0; iCol < iCols; iCol++)
+								// the style index follows the new row order
+								pControl->styles.Reorder(vOrder);
+							}
+						}
+						else
+						{
+							// the data is out of step with the control, sort through the control
+							sortstruct Sort;
+							Sort.lParamSort = lParamSort;
+							Sort.hlistview = pLVInfo->hdr.hwndFrom;
+
+							/*
+							** sort list
+							*/
+							ListView_SortItemsEx(pLVInfo->hdr.hwndFrom, CompareListItems, (LPARAM)&Sort);
+
+							// change listview index numbers
+							if (d->m_Pages.at(d->m_sCurrentPage).m_listviewControls.find(Val_notify->hdr.idFrom) != d->m_Pages.at(d->m_sCurrentPage).m_listviewControls.end())
+							{
+								int iUniqueColumnNumber = -1;
+
+								// determine unique column number
+								for (size_t iColumnNames = 0; iColumnNames < pControl->vColumns.size(); iColumnNames++)
+								{
+									if (
+										pControl->vColumns[iColumnNames].sColumnName ==
+										pControl->sUniqueColumnName)
 									{
-										if (iCol == iUniqueColumnNumber)
-										{
-											lv.iSubItem = iCol;
+										iUniqueColumnNumber = pControl->vColumns[iColumnNames].iColumnID;
+										break;
+									}
+								}
 
-											TCHAR buf[1024];
-											ListView_GetItemText(m_hlistview, iRow, iCol, buf, _countof(buf));
+								// updated listview data container that will have items in the new order
+								std::vector<cui_raw::listviewRow> vData(pControl->vData.size());
 
-											// insert information into matrix
-											std::basic_string<TCHAR> sText(buf);
+								for (auto &row : pControl->vData)
+								{
+									int iRowNumber = -1;
 
-											// check if this text is in our target row
-											for (auto &it : row.vItems)
+									// get number of columns
+									const int iCols = pControl->pClistview->Get_NumOfCols();
+
+									// get number of rows
+									const int iRows = pControl->pClistview->Get_NumOfRows();
+
+									LVITEM lv = { 0 };
+
+									HWND m_hlistview = pControl->hWnd;
+
+									for (int iRow = 0; iRow < iRows; iRow++)
+									{
+										lv.mask = LVIF_TEXT;
+										lv.iItem = iRow;
+
+										bool bMatch = false;
+
+										for (int iCol = 0; iCol < iCols; iCol++)
+										{
+											if (iCol == iUniqueColumnNumber)
 											{
-												if (it.sColumnName != pControl->sUniqueColumnName)
-													continue;
+												lv.iSubItem = iCol;
+
+												TCHAR buf[1024];
+												ListView_GetItemText(m_hlistview, iRow, iCol, buf, _countof(buf));
+
+												// insert information into matrix
+												std::basic_string<TCHAR> sText(buf);
+
+												// check if this text is in our target row
+												for (auto &it : row.vItems)
+												{
+													if (it.sColumnName != pControl->sUniqueColumnName)
+														continue;
 
-												if (it.sItemData == sText)
-													bMatch = true;
+													if (it.sItemData == sText)
+														bMatch = true;
+												}
 											}
 										}
-									}
 
-									if (bMatch)
-									{
-										// determine the row number
-										iRowNumber = iRow;
+										if (bMatch)
+										{
+											// determine the row number
+											iRowNumber = iRow;
 
-										// update internal row number in listview items
-										for (auto &it : row.vItems)
-											it.iRowNumber = iRowNumber;
+											// update internal row number in listview items
+											for (auto &it : row.vItems)
+												it.iRowNumber = iRowNumber;
 
-										// insert row in appropriate slot in our updated listview data container
-										vData[iRowNumber] = row;
+											// insert row in appropriate slot in our updated listview data container
+											vData[iRowNumber] = row;
 
-										break;
+											break;
+										}
 									}
-								}
-							} // for (auto &row : pControl->vData)
+								} // for (auto &row : pControl->vData)
 
-							  // replace listview data with update lot
-							pControl->vData = vData;
+								  // replace listview data with update lot
+								pControl->vData = vData;
+
+								// the style index follows the new row order
+								buildListviewStyles(*pControl);
+							}
 						}
 					} // if
 				} // for
@@ -5339,12 +5572,8 @@ int CALLBACK cui_rawImpl::CompareListItems(LPARAM lParam1, LPARAM lParam2, LPARA
 	}
 } // CompareListItems
 
-LRESULT cui_rawImpl::HandleCustomDraw(NMLVCUSTOMDRAW* pcd, HWND hWndlistview, std::vector<cui_raw::listviewRow> lvRows, std::vector<cui_raw::listviewColumn> lvColumns)
+LRESULT cui_rawImpl::HandleCustomDraw(NMLVCUSTOMDRAW* pcd, HWND hWndlistview, listviewControl &Control)
 {
-	// TO-DO: get rid of this magic number!!!!!!!!
-	TCHAR buffer[256];
-	LVITEM item;
-
 	switch (pcd->nmcd.dwDrawStage)
 	{
 	case CDDS_PREPAINT:
@@ -5358,182 +5587,227 @@ LRESULT cui_rawImpl::HandleCustomDraw(NMLVCUSTOMDRAW* pcd, HWND hWndlistview, st
 		return CDRF_DODEFAULT | CDRF_NOTIFYSUBITEMDRAW;
 
 	case (CDDS_ITEM | CDDS_SUBITEM | CDDS_PREPAINT):
-		item.iSubItem = pcd->iSubItem;
-		item.pszText = buffer;
-		item.cchTextMax = sizeof(buffer) / sizeof(buffer[0]);
-		SendMessage(hWndlistview, LVM_GETITEMTEXT, pcd->nmcd.dwItemSpec, (LPARAM)&item);
-		int iColumn = pcd->iSubItem;
-		int iRow = item.iItem;
+	{
+		const int iRow = (int)pcd->nmcd.dwItemSpec;
+		const int iColumn = pcd->iSubItem;
 
-		// check if this item requires custom drawing
-		for (size_t m_iRow = 0; m_iRow < lvRows.size(); m_iRow++)
+		bool bCustom = false;
+		bool bBarChart = false;
+		COLORREF clrText = RGB(0, 0, 0);
+
+		if (Control.bVirtual)
 		{
-			if (m_iRow == iRow)
-			{
-				for (size_t m_iColumn = 0; m_iColumn < lvRows[m_iRow].vItems.size(); m_iColumn++)
-				{
-					if (m_iColumn == iColumn)
-					{
-						if (lvRows[m_iRow].vItems[m_iColumn].bCustom)
-						{
-							pcd->clrText = lvRows[m_iRow].vItems[m_iColumn].clrText;
+			// virtual listview ... the cell is in the row cache (it has just been displayed)
+			const ClistviewCache::cell *pCell = Control.cache.GetCell(iRow, iColumn);
 
-							/* Let the control do the painting itself with the new color. */
-							return CDRF_DODEFAULT;
-						}
-						else
-							pcd->clrText = RGB(0, 0, 0);
-					}
-				}
-			}
+			if (!pCell)
+				break;
+
+			bCustom = pCell->bCustom;
+			clrText = pCell->clrText;
+			bBarChart = Control.vColumns[iColumn].bBarChart;
+		}
+		else
+		{
+			// look up the cell's style in the style index
+			const ClistviewStyles::cellStyle *pStyle = Control.styles.Get(iRow, iColumn);
+
+			if (!pStyle)
+				break;
+
+			bCustom = (pStyle->flags & ClistviewStyles::custom) != 0;
+			clrText = pStyle->clrText;
+			bBarChart = (pStyle->flags & ClistviewStyles::barchart) != 0;
 		}
 
-		for (size_t i = 0; i < lvColumns.size(); i++)
+		if (bCustom)
 		{
-			if (lvColumns[i].bBarChart)
-			{
-				if (lvColumns[i].iColumnID == iColumn)
-				{
-					/* Customize "progress" column. We paint simple progress
-					* indicator. */
-					item.iSubItem = iColumn;
-					item.pszText = buffer;
-					item.cchTextMax = sizeof(buffer) / sizeof(buffer[0]);
-					SendMessage(hWndlistview, LVM_GETITEMTEXT, pcd->nmcd.dwItemSpec, (LPARAM)&item);
+			pcd->clrText = clrText;
 
-					int iProgress = _ttoi(buffer);
-					int iMax = lvColumns[i].iBarChartMax;
+			/* Let the control do the painting itself with the new color. */
+			return CDRF_DODEFAULT;
+		}
+		else
+			pcd->clrText = RGB(0, 0, 0);
 
-					if (iMax > 0)
-					{
-						int cx;
-						HDC hdc = pcd->nmcd.hdc;
-						COLORREF clrBack;
-						HBRUSH hBackBrush;
-						HBRUSH hProgressBrush;
-						HBRUSH hOldBrush;
-						HPEN hPen;
-						HPEN hOldPen;
-						RECT rc;
-
-						clrBack = pcd->clrTextBk;
-						if (clrBack == CLR_NONE || clrBack == CLR_DEFAULT)
-							clrBack = RGB(255, 255, 255);
-
-						hBackBrush = CreateSolidBrush(clrBack);
-						hProgressBrush = CreateSolidBrush(lvColumns[i].clrBarChart);
-						hPen = CreatePen(PS_SOLID, 0, lvColumns[i].clrBarChart);
-
-						hOldBrush = (HBRUSH)SelectObject(hdc, hBackBrush);
-						FillRect(hdc, &pcd->nmcd.rc, hBackBrush);
-
-						cx = pcd->nmcd.rc.right - pcd->nmcd.rc.left - 6;
-						if (cx < 0)
-							cx = 0;
-						rc.left = pcd->nmcd.rc.left + 3;
-						rc.top = pcd->nmcd.rc.top + 2;
-						rc.right = rc.left + cx * iProgress / iMax;
-						rc.bottom = pcd->nmcd.rc.bottom - 2;
-						SelectObject(hdc, hProgressBrush);
-						FillRect(hdc, &rc, hProgressBrush);
-
-						rc.right = pcd->nmcd.rc.right - 3;
-						SelectObject(hdc, GetStockObject(HOLLOW_BRUSH));
-						hOldPen = (HPEN)SelectObject(hdc, hPen);
-						Rectangle(hdc, rc.left, rc.top, rc.right, rc.bottom);
-
-						COLORREF clrOld = SetTextColor(hdc, lvColumns[i].clrText);
-
-						DrawText(hdc, buffer, -1, &rc,
-							DT_CENTER | DT_VCENTER | DT_NOPREFIX | DT_SINGLELINE | DT_END_ELLIPSIS);
-
-						SetTextColor(hdc, clrOld);
-						SelectObject(hdc, hOldBrush);
-						DeleteObject(hProgressBrush);
-						DeleteObject(hBackBrush);
-						SelectObject(hdc, hOldPen);
-						DeleteObject(hPen);
-					}
+		if (bBarChart && iColumn < (int)Control.vColumns.size())
+		{
+			const cui_raw::listviewColumn &column = Control.vColumns[iColumn];
 
-					/* Tell the control to not paint as we did so. */
-					return CDRF_SKIPDEFAULT;
-				} // if
-			}
-			else
+			// TO-DO: get rid of this magic number!!!!!!!!
+			TCHAR buffer[256];
+			LVITEM item;
+
+			/* Customize "progress" column. We paint simple progress
+			* indicator. */
+			item.iSubItem = iColumn;
+			item.pszText = buffer;
+			item.cchTextMax = sizeof(buffer) / sizeof(buffer[0]);
+			SendMessage(hWndlistview, LVM_GETITEMTEXT, pcd->nmcd.dwItemSpec, (LPARAM)&item);
+
+			int iProgress = _ttoi(buffer);
+			int iMax = column.iBarChartMax;
+
+			if (iMax > 0)
 			{
-				if (lvColumns[i].iColumnID == pcd->iSubItem && !(pcd->nmcd.dwDrawStage & CDDS_PREPAINT))
-				{
-					item.iSubItem = pcd->iSubItem;
-					item.pszText = buffer;
-					item.cchTextMax = sizeof(buffer) / sizeof(buffer[0]);
-					SendMessage(hWndlistview, LVM_GETITEMTEXT, pcd->nmcd.dwItemSpec, (LPARAM)&item);
+				int cx;
+				HDC hdc = pcd->nmcd.hdc;
+				COLORREF clrBack;
+				HBRUSH hBackBrush;
+				HBRUSH hProgressBrush;
+				HBRUSH hOldBrush;
+				HPEN hPen;
+				HPEN hOldPen;
+				RECT rc;
 
-					int iProgress = _ttoi(buffer);
-					int iMax = lvColumns[i].iBarChartMax;
+				clrBack = pcd->clrTextBk;
+				if (clrBack == CLR_NONE || clrBack == CLR_DEFAULT)
+					clrBack = RGB(255, 255, 255);
 
-					if (iMax > 0)
-					{
-						int cx;
-						HDC hdc = pcd->nmcd.hdc;
-						COLORREF clrBack;
-						HBRUSH hBackBrush;
-						HBRUSH hProgressBrush;
-						HBRUSH hOldBrush;
-						HPEN hPen;
-						HPEN hOldPen;
-						RECT rc;
-
-						clrBack = pcd->clrTextBk;
-						if (clrBack == CLR_NONE || clrBack == CLR_DEFAULT)
-							clrBack = RGB(255, 255, 255);
-
-						hBackBrush = CreateSolidBrush(clrBack);
-						hProgressBrush = CreateSolidBrush(lvColumns[i].clrBarChart);
-						hPen = CreatePen(PS_SOLID, 0, lvColumns[i].clrBarChart);
-
-						hOldBrush = (HBRUSH)SelectObject(hdc, hBackBrush);
-						FillRect(hdc, &pcd->nmcd.rc, hBackBrush);
-
-						cx = pcd->nmcd.rc.right - pcd->nmcd.rc.left - 6;
-						if (cx < 0)
-							cx = 0;
-						rc.left = pcd->nmcd.rc.left + 3;
-						rc.top = pcd->nmcd.rc.top + 2;
-						rc.right = rc.left + cx * iProgress / iMax;
-						rc.bottom = pcd->nmcd.rc.bottom - 2;
-						SelectObject(hdc, hProgressBrush);
-						//FillRect(hdc, &rc, hProgressBrush);
-
-						rc.right = pcd->nmcd.rc.right - 3;
-						SelectObject(hdc, GetStockObject(HOLLOW_BRUSH));
-						hOldPen = (HPEN)SelectObject(hdc, hPen);
-						//Rectangle(hdc, rc.left, rc.top, rc.right, rc.bottom);
-
-						COLORREF clrOld = SetTextColor(hdc, lvColumns[i].clrText);
-
-						DrawText(hdc, buffer, -1, &rc,
-							DT_LEFT | DT_VCENTER | DT_NOPREFIX | DT_SINGLELINE | DT_END_ELLIPSIS);
-
-						SetTextColor(hdc, clrOld);
-						SelectObject(hdc, hOldBrush);
-						DeleteObject(hProgressBrush);
-						DeleteObject(hBackBrush);
-						SelectObject(hdc, hOldPen);
-						DeleteObject(hPen);
-					}
+				hBackBrush = CreateSolidBrush(clrBack);
+				hProgressBrush = CreateSolidBrush(column.clrBarChart);
+				hPen = CreatePen(PS_SOLID, 0, column.clrBarChart);
 
-					/* Tell the control to not paint as we did so. */
-					return CDRF_SKIPDEFAULT;
-				}
+				hOldBrush = (HBRUSH)SelectObject(hdc, hBackBrush);
+				FillRect(hdc, &pcd->nmcd.rc, hBackBrush);
+
+				cx = pcd->nmcd.rc.right - pcd->nmcd.rc.left - 6;
+				if (cx < 0)
+					cx = 0;
+				rc.left = pcd->nmcd.rc.left + 3;
+				rc.top = pcd->nmcd.rc.top + 2;
+				rc.right = rc.left + cx * iProgress / iMax;
+				rc.bottom = pcd->nmcd.rc.bottom - 2;
+				SelectObject(hdc, hProgressBrush);
+				FillRect(hdc, &rc, hProgressBrush);
+
+				rc.right = pcd->nmcd.rc.right - 3;
+				SelectObject(hdc, GetStockObject(HOLLOW_BRUSH));
+				hOldPen = (HPEN)SelectObject(hdc, hPen);
+				Rectangle(hdc, rc.left, rc.top, rc.right, rc.bottom);
+
+				COLORREF clrOld = SetTextColor(hdc, column.clrText);
+
+				DrawText(hdc, buffer, -1, &rc,
+					DT_CENTER | DT_VCENTER | DT_NOPREFIX | DT_SINGLELINE | DT_END_ELLIPSIS);
+
+				SetTextColor(hdc, clrOld);
+				SelectObject(hdc, hOldBrush);
+				DeleteObject(hProgressBrush);
+				DeleteObject(hBackBrush);
+				SelectObject(hdc, hOldPen);
+				DeleteObject(hPen);
 			}
-		} // for
-		break;
+
+			/* Tell the control to not paint as we did so. */
+			return CDRF_SKIPDEFAULT;
+		}
+	}
+	break;
 	}
 
 	/* For all unhandled cases, we let the control do the default. */
 	return CDRF_DODEFAULT;
 } // HandleCustomDraw
 
+// get the column number of the column with the given name, or -1 if there is no such column
+int cui_rawImpl::getListviewColumnNumber(const listviewControl &Control, const std::basic_string<TCHAR> &sColumnName)
+{
+	auto it = Control.columnIndex.find(sColumnName);
+
+	if (it == Control.columnIndex.end() || it->second >= Control.vColumns.size())
+		return -1;
+
+	return Control.vColumns[it->second].iColumnID;
+} // getListviewColumnNumber
+
+// index a listview's columns by name; call whenever vColumns is assigned
+void cui_rawImpl::buildListviewColumnIndex(listviewControl &Control)
+{
+	Control.columnIndex.clear();
+	Control.columnIndex.reserve(Control.vColumns.size());
+
+	// the first column with a given name wins, as with a linear search
+	for (size_t i = 0; i < Control.vColumns.size(); i++)
+		Control.columnIndex.insert(std::make_pair(Control.vColumns[i].sColumnName, i));
+} // buildListviewColumnIndex
+
+// find a listview control, returns nullptr if there is no such control
+cui_rawImpl::listviewControl* cui_rawImpl::findListview(const std::basic_string<TCHAR> &sPageName, int iUniqueID)
+{
+	// page-less controls are kept under the window title
+	auto page = m_Pages.find(sPageName.empty() ? m_sTitle : sPageName);
+
+	if (page == m_Pages.end())
+		return nullptr;
+
+	auto it = page->second.m_listviewControls.find(iUniqueID);
+
+	if (it == page->second.m_listviewControls.end())
+		return nullptr;
+
+	return &it->second;
+} // findListview
+
+// find a listview on the current page or among the page-less controls
+cui_rawImpl::listviewControl* cui_rawImpl::findVisibleListview(int iUniqueID)
+{
+	listviewControl* pControl = findListview(m_sCurrentPage, iUniqueID);
+
+	if (!pControl && m_sCurrentPage != m_sTitle)
+		pControl = findListview(m_sTitle, iUniqueID);
+
+	return pControl;
+} // findVisibleListview
+
+// fetch a row of a virtual listview from the application's row provider
+void cui_rawImpl::fetchVirtualListviewRow(listviewControl &Control, int iRowNumber, ClistviewCache::row &cells)
+{
+	if (!Control.pRowProvider)
+		return;
+
+	cui_raw::listviewRow row;
+	Control.pRowProvider(iRowNumber, row, Control.pRowProviderData);
+
+	for (auto &item : row.vItems)
+	{
+		const int iColumnNumber = getListviewColumnNumber(Control, item.sColumnName);
+
+		if (iColumnNumber < 0 || iColumnNumber >= (int)cells.size())
+			continue;	// failsafe in-case there's a typo in the column name
+
+		cells[iColumnNumber].sText.swap(item.sItemData);
+		cells[iColumnNumber].bCustom = item.bCustom;
+		cells[iColumnNumber].clrText = item.clrText;
+	}
+} // fetchVirtualListviewRow
+
+// rebuild a listview's style index from its columns and data
+void cui_rawImpl::buildListviewStyles(listviewControl &Control)
+{
+	Control.styles.Reset((int)Control.vColumns.size());
+
+	for (const auto &column : Control.vColumns)
+		Control.styles.SetBarChart(column.iColumnID, column.bBarChart);
+
+	Control.styles.Reserve((int)Control.vData.size());
+
+	for (const auto &row : Control.vData)
+		addListviewStylesRow(Control, row);
+} // buildListviewStyles
+
+// append a row to a listview's style index
+void cui_rawImpl::addListviewStylesRow(listviewControl &Control, const cui_raw::listviewRow &row)
+{
+	const int iRow = Control.styles.AddRow();
+
+	for (const auto &item : row.vItems)
+	{
+		if (item.bCustom)
+			Control.styles.SetCell(iRow, getListviewColumnNumber(Control, item.sColumnName), true, item.clrText);
+	}
+} // addListviewStylesRow
+
   // returns true if (x, y) is within rc
 bool cui_rawImpl::insideRect(int x, int y, LPRECT lpRect)
 {
@@ -5809,6 +6083,12 @@ LRESULT CALLBACK cui_rawImpl::WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM
 			OnWM_GETMINMAXINFO(hWnd, wParam, lParam, pThis->d);
 			break;
 
+		case WM_DISPLAYCHANGE:
+		case WM_DPICHANGED:
+			// the pooled back buffers match the display they were made on, make them again
+			pThis->d->m_paint_buffer.Clear();
+			break;
+
 		case WM_ERASEBKGND:
 			OnWM_ERASEBKGND(hWnd, wParam, pThis->d);
 			return TRUE;
@@ -6125,6 +6405,10 @@ void cui_rawImpl::hidePage(std::basic_string<TCHAR> sPageName)
 		for (auto &it : m_Pages.at(sPageName).m_ImageControls)
 			HideToolTip(it.second.toolTip);
 
+		// stop loading images nobody is going to see; they are asked for again when painted
+		for (auto &it : m_Pages.at(sPageName).m_ImageControls)
+			m_image_loader.Cancel(reinterpret_cast<std::uintptr_t>(it.second.hWnd));
+
 		// disable and hide all tooltips in toggle buttons
 		for (auto &it : m_Pages.at(sPageName).m_ToggleButtonControls)
 			HideToolTip(it.second.toolTip);
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <map>
+#include <unordered_map>
 #include <Windows.h>
 #include <WindowsX.h>
 #include <CommCtrl.h>
@@ -20,7 +21,18 @@
 #include "../cui_raw.h"
 #include "CMouseTrack/CMouseTrack.h"
 #include "Clistview/CListView.h"
+#include "Clistview/CListViewStyles.h"
+#include "Clistview/CListViewCache.h"
+#include "Clistview/CListViewSort.h"
+#include "LineChart/CLineChartSeries.h"
+#include "LineChart/CLineChartDecimate.h"
 #include "CShadow/CShadow.h"
+#include "CHitGrid/CHitGrid.h"
+#include "CChartScene/CChartScene.h"
+#include "CGdiPlusCache/CGdiPlusCache.h"
+#include "CPaintBuffer/CPaintBuffer.h"
+#include "CImageLoader/CImageLoader.h"
+#include "CImageLoader/CImageLoaderGdiplus.h"
 #include "../CImage/CImage.h"
 #include "../CBrush/CBrush.h"
 #include "../CPopupMenu/CPopupMenu.h"
@@ -164,7 +176,17 @@ public:
 
 	static LRESULT CALLBACK listviewControlProc(HWND, UINT, WPARAM, LPARAM);
 	static int CALLBACK CompareListItems(LPARAM lParam1, LPARAM lParam2, LPARAM lParam);
-	static LRESULT HandleCustomDraw(NMLVCUSTOMDRAW* pcd, HWND hlistview, std::vector<cui_raw::listviewRow> lvRows, std::vector<cui_raw::listviewColumn> lvColumns);
+	struct listviewControl;
+	typedef ClistviewCacheT<TCHAR> ClistviewCache;
+	typedef ClistviewSortT<TCHAR> ClistviewSort;
+	static LRESULT HandleCustomDraw(NMLVCUSTOMDRAW* pcd, HWND hlistview, listviewControl &Control);
+	static void fetchVirtualListviewRow(listviewControl &Control, int iRowNumber, ClistviewCache::row &cells);
+	static int getListviewColumnNumber(const listviewControl &Control, const std::basic_string<TCHAR> &sColumnName);
+	static void buildListviewColumnIndex(listviewControl &Control);
+	static void buildListviewStyles(listviewControl &Control);
+	static void addListviewStylesRow(listviewControl &Control, const cui_raw::listviewRow &row);
+	struct LineChartControl;
+	static void setLineChartLines(LineChartControl &Control, std::vector<cui_raw::lineInfo> &&vLines);
 	static LRESULT CALLBACK EditControlProc(HWND, UINT, WPARAM, LPARAM);
 	static LRESULT CALLBACK ToggleBtnProc(HWND, UINT, WPARAM, LPARAM);
 	static LRESULT CALLBACK BtnProc(HWND, UINT, WPARAM, LPARAM);
@@ -185,6 +207,8 @@ public:
 	static LRESULT CALLBACK RichEditControlProc(HWND, UINT, WPARAM, LPARAM);
 
 	void handleTabControls(const std::basic_string<TCHAR> &sPageName, int iUniqueID);
+	listviewControl* findListview(const std::basic_string<TCHAR> &sPageName, int iUniqueID);
+	listviewControl* findVisibleListview(int iUniqueID);
 	void captureControls(const std::basic_string<TCHAR> &sPageName, int iUniqueID, HWND hWnd);
 	void capturePagelessControls(int iUniqueID, HWND hWnd);
 	void hideControl(const std::basic_string<TCHAR> &sPageName, HWND hWnd);
@@ -256,8 +280,6 @@ public:
 		bool bPressed = false;	// reserved
 
 		ToolTipControl toolTip;
-
-		HBITMAP hbm_buffer = nullptr;
 	};
 
 	struct TextControl
@@ -280,11 +302,10 @@ public:
 		bool bPressed = false;			// reserved
 		COLORREF clrBackground;	// reserved
 
-		HBITMAP hbm_buffer = NULL;
 		bool bHot = false;
 
 		ToolTipControl toolTip;
-		RECT rcText;
+		RECT rcText = { 0 };	// captured when painted
 
 		bool bStatic = true;
 		cui_rawImpl* d = NULL;
@@ -312,7 +333,6 @@ public:
 		BOOL fMouseDown = FALSE;
 		BOOL fButtonDown = FALSE;
 
-		HBITMAP hbm_buffer = NULL;
 		cui_rawImpl* d = NULL;
 		bool bFontList = false;
 
@@ -355,6 +375,19 @@ public:
 		bool bBusy = false;
 
 		std::basic_string<TCHAR> sUniqueColumnName;
+
+		// column name to position in vColumns
+		std::unordered_map<std::basic_string<TCHAR>, size_t> columnIndex;
+
+		// cell styles for custom drawing, kept in sync with vData
+		ClistviewStyles styles;
+
+		// virtual (owner-data) listview
+		bool bVirtual = false;
+		int iRowCount = 0;
+		cui_raw::listviewRowProvider pRowProvider = nullptr;
+		void *pRowProviderData = nullptr;
+		ClistviewCache cache;	// rows fetched from pRowProvider
 	};
 
 	struct EditControl
@@ -387,8 +420,6 @@ public:
 		bool bUpDown = false;
 		LONG_PTR UpDownPrevProc = NULL;	// super reserved
 
-		HBITMAP hbm_buffer = NULL;
-
 		BOOL fMouseDown = FALSE;
 		BOOL fButtonDown = FALSE;
 
@@ -418,7 +449,6 @@ public:
 		LONG_PTR PrevProc = NULL;
 		enumBtn state;			// reserved
 		bool bPressed = false;	// reserved
-		HBITMAP hbm_buffer = nullptr;
 
 		ToolTipControl toolTip;
 	};
@@ -442,7 +472,7 @@ public:
 
 		LONG_PTR PrevProc = NULL;			// reserved
 		cui_rawImpl* d = NULL;		// reserved
-		RECT rcToggler;			// reserved
+		RECT rcToggler = { 0 };	// reserved; captured when painted
 		enumBtn state;			// reserved
 		bool bPressed = false;			// reserved
 		bool bHot = false;				// reserved
@@ -453,8 +483,6 @@ public:
 		bool bOldState;
 
 		POINT ptStart;
-
-		HBITMAP hbm_buffer = NULL;
 	};
 
 	struct ProgressControl
@@ -482,9 +510,6 @@ public:
 		bool bBackward = false;
 
 		int iBusyPerc = 0;
-
-		// for double buffering
-		HBITMAP hbm_buffer = NULL;
 	};
 
 	struct PasswordStrengthControl
@@ -538,8 +563,10 @@ public:
 		HWND hWndText;			// reserved
 		WNDCLASSEX wcex;		// reserved
 		CGdiPlusBitmapResource GdiplusBitmap_res;	// reserved
-		CGdiPlusBitmap GdiplusBitmap;				// reserved
 		Gdiplus::Bitmap* m_pDisplaybitmap = NULL;	// reserved
+		bool bLoadFailed = false;	// reserved; the image file could not be read
+		SIZE sizeRequested = { 0 };	// reserved; the size last asked of the background loader
+		SIZE sizeLoaded = { 0 };	// reserved; the size the display bitmap was loaded for
 
 		bool bImageOnlyTightFit = false;
 
@@ -561,8 +588,6 @@ public:
 
 		ToolTipControl toolTip;
 
-		HBITMAP hbm_buffer = NULL;
-
 		bool bDescriptive = false;
 		std::basic_string<TCHAR> sDescription;
 		SIZE imageSize;
@@ -597,8 +622,6 @@ public:
 		LONG_PTR PrevProc = NULL;	// reserved
 		cui_rawImpl* d = NULL;			// reserved
 
-		HBITMAP hbm_buffer = NULL;
-
 		std::vector<tab> vTabs;		// reserved
 
 		ToolTipControl toolTip;
@@ -647,7 +670,7 @@ public:
 		std::vector<cui_raw::selectorItem> vItems;
 
 		int iSelectedItem = 0;
-		RECT rcSelector;		// reserved
+		RECT rcSelector = { 0 };	// reserved; captured when painted
 
 		bool bHot = false;
 		int iPercV = 0;
@@ -659,8 +682,6 @@ public:
 
 		int yUpper = 0;
 		int yLower = 0;
-
-		HBITMAP hbm_buffer = NULL;
 	};
 
 	struct DateControl
@@ -759,6 +780,7 @@ public:
 		int iLowerLimit;					// lower limit
 		int iUpperLimit;					// upper limit
 		bool bAutoScale;					// autoscale flag
+		CChartScene scene;				// layout, kept between paints
 		std::vector<cui_raw::barChartData> vValues;	// values to plot (v[x-value][y-value])
 
 		std::vector<chartBarInfo> chartBarsInfo;		// information about chart bars
@@ -784,6 +806,23 @@ public:
 		std::vector<chartLineInfo> chartLinesInfo;
 	};
 
+	typedef ClinechartSeriesT<cui_raw::barChartData> ClinechartSeries;
+
+	// line chart series
+	struct chartLine
+	{
+		std::basic_string<TCHAR> sSeriesName;
+		COLORREF clrLine;
+		ClinechartSeries values;
+
+		// indices of the points to draw, see ClinechartDecimate
+		// valid while the series and the plot width are unchanged
+		std::vector<size_t> vLod;
+		unsigned long long iLodAppended = 0;
+		size_t iLodSize = 0;
+		int iLodWidth = -1;
+	};
+
 	struct LineChartControl
 	{
 		bool bPageLess = false;
@@ -812,11 +851,19 @@ public:
 		int iLowerLimit;					// lower limit
 		int iUpperLimit;					// upper limit
 		bool bAutoScale;					// autoscale flag
-		std::vector<cui_raw::lineInfo> vLines;	// lines to plot
+		CChartAxis axis;					// y-axis limits, gridlines and labels
+		CChartScene scene;				// layout of the frame and the legend, kept between paints
+		std::vector<chartLine> vLines;	// lines to plot
+		size_t iMaxPoints = 0;			// maximum number of points per line, 0 for no limit
 
 		std::vector<lines> linesInfo;		// information about chart lines
 
 		bool bInfoCaptured = false;
+		bool bPointInfoStale = false;	// points have been appended since the point info was captured
+
+		// layout of the last full paint, so that appending can repaint just the plot
+		bool bLayoutCaptured = false;
+		RECT rcPlot = { 0 };			// plot and axis markers
 	};
 
 	// pie chart item info struct
@@ -859,6 +906,8 @@ public:
 
 		std::vector<pieChartItemInfo> chartBarsInfo;		// information about chart items
 
+		CChartScene scene;	// layout, kept between paints
+
 		bool bAutoColor = false;
 
 		bool bInfoCaptured = false;
@@ -934,7 +983,6 @@ public:
 
 		ToolTipControl toolTip;
 
-		HBITMAP hbm_buffer = NULL;
 		bool bStatic = false;
 	};
 
@@ -1119,6 +1167,45 @@ public:
 	void hitTextControl(cui_rawImpl::TextControl &Control, POINT &pt, std::vector<RECT> &m_vHotRects);
 	void hitStarRatingControl(cui_rawImpl::StarRatingControl &Control, POINT &pt, std::vector<RECT> &m_vHotRects);
 
+	/*
+	** hover hit testing
+	** the controls WM_MOUSEMOVE hit tests are kept in a grid over their window rectangles, so
+	** that only the controls under the cursor, and those that were under it on the last mouse
+	** move (so that they can be reset), are hit tested
+	** the grid is rebuilt when the page changes or the window is resized
+	*/
+	enum hitType
+	{
+		hitBarChart,
+		hitLineChart,
+		hitPieChart,
+		hitButton,
+		hitToggleButton,
+		hitStarRating,
+		hitSelector,
+		hitImage,
+		hitText,
+		hitControlBtn,
+	};
+
+	struct hitEntry
+	{
+		hitType type;
+		void *pControl;
+		HWND hWnd;
+	};
+
+	std::vector<hitEntry> m_vHitEntries;	// in the order they are hit tested
+	CHitGrid m_HitGrid;
+	bool m_bHitGridValid;
+	std::basic_string<TCHAR> m_sHitGridPage;	// the page the grid was built for
+	std::vector<size_t> m_vHitCandidates;		// entries to hit test on this mouse move
+	std::vector<size_t> m_vHitLast;				// entries hit tested on the last mouse move
+
+	void buildHitGrid(HWND hWnd);
+	void invalidateHitGrid();
+	void hitTest(hitEntry &entry, POINT &pt, std::vector<RECT> &m_vHotRects);
+
 	void flagPressControlButton(cui_rawImpl::ControlBtn &Control, POINT &pt);
 	void flagPressButtonControl(cui_rawImpl::ButtonControl &Control, POINT &pt);
 	void flagPressToggleButtonControl(cui_rawImpl::ToggleButtonControl &Control, POINT &pt);
@@ -1142,6 +1229,20 @@ public:
 	void checkRightPressStarRatingControl(cui_rawImpl::StarRatingControl &Control, POINT &pt);
 
 	void resetImageControl(cui_rawImpl::ImageControl &Control);
+	void resetBarChartControl(cui_rawImpl::BarChartControl &Control);
+	void resetLineChartControl(cui_rawImpl::LineChartControl &Control);
+	void resetPieChartControl(cui_rawImpl::PieChartControl &Control);
+
+	/*
+	** repaint only the part of a control that a change in its state affects
+	** the rectangles these work from are captured when the control is painted, so a control
+	** that has not been painted yet is repainted in full
+	*/
+	static void invalidateToggleButton(cui_rawImpl::ToggleButtonControl &Control, bool bOldState);
+	static void invalidateSelector(cui_rawImpl::SelectorControl &Control);
+	static void invalidateProgress(cui_rawImpl::ProgressControl &Control, double dFrom, double dTo);
+	static void invalidateProgressBusy(cui_rawImpl::ProgressControl &Control, int iFrom, int iTo);
+	static void invalidateText(cui_rawImpl::TextControl &Control);
 
 	void showTrayPopupMenu();
 
@@ -1165,4 +1266,18 @@ public:
 	std::map<std::basic_string<TCHAR>, Gdiplus::Font*> vFonts;
 	Gdiplus::PrivateFontCollection m_font_collection;
 	std::vector<std::basic_string<TCHAR>> m_font_collection_files;
+
+	// fonts and brushes for paint handlers; cleared whenever m_font_collection changes
+	CGdiPlusCache m_gdiplus_cache{ m_font_collection };
+
+	// back buffers shared by the paint handlers of the owner-drawn controls
+	CPaintBuffer m_paint_buffer;
+
+	// posted to an image control when m_image_loader has its image ready
+	int m_iImageLoadedMsg = 0;
+
+	// decodes and resizes images from files off the UI thread; see ImageProc
+	// declared last so that its threads are stopped before anything else is destroyed
+	CImageLoader m_image_loader{ CImageLoaderGdiplus::Decode,
+		[this](std::uintptr_t key) { PostMessage(reinterpret_cast<HWND>(key), m_iImageLoadedMsg, 0, 0); } };
 }; // cui_rawImpl
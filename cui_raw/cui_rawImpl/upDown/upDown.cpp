@@ -29,17 +29,19 @@ LRESULT CALLBACK cui_rawImpl::UpDownControlProc(HWND hWnd, UINT msg, WPARAM wPar
 
 		HDC dc;
 
+		// a DC passed in is painted in full
+		RECT rcPaint = rect;
+
 		if (wParam == 0)
+		{
 			dc = BeginPaint(hWnd, &ps);
+			rcPaint = ps.rcPaint;
+		}
 		else
 			dc = (HDC)wParam;
 
-		HDC hdc = CreateCompatibleDC(dc);
-
-		if (!pThis->hbm_buffer)
-			pThis->hbm_buffer = CreateCompatibleBitmap(dc, cx, cy);
-
-		HBITMAP hbmOld = SelectBitmap(hdc, pThis->hbm_buffer);
+		// use double buffering to avoid flicker; only the part being painted is drawn
+		HDC hdc = pThis->d->m_paint_buffer.Acquire(dc, cx, cy, rcPaint);
 
 		// draw borders
 		RECT rectBoarder;
@@ -155,13 +157,14 @@ LRESULT CALLBACK cui_rawImpl::UpDownControlProc(HWND hWnd, UINT msg, WPARAM wPar
 			}
 		}
 
-		BitBlt(dc, 0, 0, cx, cy, hdc, 0, 0, SRCCOPY);
+		BitBlt(dc, rcPaint.left, rcPaint.top,
+			rcPaint.right - rcPaint.left, rcPaint.bottom - rcPaint.top,
+			hdc, rcPaint.left, rcPaint.top, SRCCOPY);
 
 		if (wParam == 0)
 			EndPaint(hWnd, &ps);
 
-		SelectBitmap(hdc, hbmOld);
-		DeleteDC(hdc);
+		pThis->d->m_paint_buffer.Release(hdc);
 	}
 	return 0;
 
@@ -232,26 +235,8 @@ LRESULT CALLBACK cui_rawImpl::UpDownControlProc(HWND hWnd, UINT msg, WPARAM wPar
 	}
 	break;
 
-	case WM_DESTROY:
-	{
-		// delete buffer, we're done
-		if (pThis->hbm_buffer)
-		{
-			DeleteBitmap(pThis->hbm_buffer);
-			pThis->hbm_buffer = NULL;
-		}
-	}
-	break;
-
 	case WM_SIZE:
 	{
-		// delete buffer, we need it recreated
-		if (pThis->hbm_buffer)
-		{
-			DeleteBitmap(pThis->hbm_buffer);
-			pThis->hbm_buffer = NULL;
-		}
-
 		InvalidateRect(hWnd, NULL, FALSE);
 	}
 	break;
@@ -361,6 +361,7 @@ std::vector<liblec::cui::gui_raw::cui_raw::listviewRow>
 convert_listview_rows(const std::vector<liblec::cui::widgets::listview_row> &data)
 {
 	std::vector<liblec::cui::gui_raw::cui_raw::listviewRow> rows_;
+	rows_.reserve(data.size());
 
 	for (size_t i = 0; i < data.size(); i++)
 	{
@@ -377,10 +378,10 @@ convert_listview_rows(const std::vector<liblec::cui::widgets::listview_row> &dat
 			item_.sColumnName = convert_string(data[i].items[j].column_name);
 			item_.sItemData = convert_string(data[i].items[j].item_data);
 
-			row_.vItems.push_back(item_);
+			row_.vItems.push_back(std::move(item_));
 		}
 
-		rows_.push_back(row_);
+		rows_.push_back(std::move(row_));
 	}
 
 	return rows_;
@@ -1597,6 +1598,13 @@ public:
 				vLines,
 				l.data.autocolor);
 
+			if (l.data.max_points)
+			{
+				std::basic_string<TCHAR> error_;
+				p_raw_ui_->lineChartMaxPointsSet(convert_string(page_name), unique_id,
+					(int)l.data.max_points, error_);
+			}
+
 			if (!l.alias.empty())
 			{
 				// add this line chart to the id map
@@ -1681,19 +1689,39 @@ public:
 				return context_menu_;
 			};
 
-			p_raw_ui_->addListview(convert_string(page_name),
-				unique_id,
-				convert_listview_columns(l.columns),
-				convert_string(l.unique_column_name),
-				convert_listview_rows(l.data),
-				convert_context_menu(l.context_menu),
-				convert_string(set_font(l.font)),
-				l.font_size,
-				convert_rect(l.rect, top_margin_),
-				convert_resize(l.on_resize),
-				l.border,
-				l.gridlines,
-				l.sort_by_clicking_column);
+			if (l.row_provider)
+			{
+				// virtual listview ... rows are supplied by the row provider when displayed
+				row_providers_[unique_id] = l.row_provider;
+
+				p_raw_ui_->addVirtualListview(convert_string(page_name),
+					unique_id,
+					convert_listview_columns(l.columns),
+					static_cast<int>(l.row_count),
+					listview_row_provider,
+					&row_providers_.at(unique_id),
+					convert_context_menu(l.context_menu),
+					convert_string(set_font(l.font)),
+					l.font_size,
+					convert_rect(l.rect, top_margin_),
+					convert_resize(l.on_resize),
+					l.border,
+					l.gridlines);
+			}
+			else
+				p_raw_ui_->addListview(convert_string(page_name),
+					unique_id,
+					convert_listview_columns(l.columns),
+					convert_string(l.unique_column_name),
+					convert_listview_rows(l.data),
+					convert_context_menu(l.context_menu),
+					convert_string(set_font(l.font)),
+					l.font_size,
+					convert_rect(l.rect, top_margin_),
+					convert_resize(l.on_resize),
+					l.border,
+					l.gridlines,
+					l.sort_by_clicking_column);
 
 			if (!l.alias.empty())
 			{
@@ -1706,6 +1734,36 @@ public:
 		}
 	} // add_listview
 
+	// row provider for virtual listviews
+	static void listview_row_provider(int row_number,
+		liblec::cui::gui_raw::cui_raw::listviewRow &row,
+		void *p_data)
+	{
+		auto p_row_provider = reinterpret_cast<std::function<void(const size_t &,
+			liblec::cui::widgets::listview_row &)>*>(p_data);
+
+		if (!p_row_provider || !(*p_row_provider))
+			return;
+
+		liblec::cui::widgets::listview_row row_;
+		(*p_row_provider)(static_cast<size_t>(row_number), row_);
+
+		row.vItems.reserve(row_.items.size());
+
+		for (const auto &it : row_.items)
+		{
+			liblec::cui::gui_raw::cui_raw::listviewItem item_;
+			item_.bCustom = it.custom_text_color;
+			item_.clrText = RGB(it.color_text.red,
+				it.color_text.green, it.color_text.blue);
+			item_.iRowNumber = row_number;
+			item_.sColumnName = convert_string(it.column_name);
+			item_.sItemData = convert_string(it.item_data);
+
+			row.vItems.push_back(item_);
+		}
+	} // listview_row_provider
+
 	// the command procedure
 	static void command_procedure(liblec::cui::gui_raw::cui_raw &raw_ui,
 		int unique_id,
@@ -1823,6 +1881,9 @@ private:
 
 	std::map<int, std::function<void()>> handler_;	// map to store handlers <unique_id, handler>
 
+	// map to store virtual listview row providers <unique_id, row provider>
+	std::map<int, std::function<void(const size_t &, liblec::cui::widgets::listview_row &)>> row_providers_;
+
 	liblec::cui::gui_raw::cui_raw* p_raw_ui_;			// pointer to the raw gui object
 	liblec::cui::gui_raw::cui_raw* p_parent_;
 
@@ -3326,6 +3387,16 @@ bool liblec::cui::gui::load_fonts(const std::vector<font_file> &font_files,
 		}
 	}
 
+	if (d_->p_raw_ui_)
+	{
+		// already running, add the fonts for Gdiplus (this also resets the font cache)
+		for (auto &it : font_files)
+		{
+			std::basic_string<TCHAR> sErr;
+			d_->p_raw_ui_->addFont(convert_string(it.fullpath), sErr);
+		}
+	}
+
 	return true;
 } // load_fonts
 
@@ -3353,6 +3424,10 @@ bool liblec::cui::gui::load_fonts(const std::vector<font_resource> &font_resourc
 		}
 	}
 
+	// fonts resolved before these were loaded may be cached
+	if (d_->p_raw_ui_)
+		d_->p_raw_ui_->resetGdiPlusCache();
+
 	return true;
 } // load_fonts
 
@@ -5186,7 +5261,7 @@ bool liblec::cui::gui::barchart_reload(const std::string &alias,
 				data.bars[i].color.green, data.bars[i].color.blue);
 			data_.dValue = data.bars[i].value;
 
-			vValues.push_back(data_);
+			vValues.push_back(std::move(data_));
 		}
 
 		int unique_id = d_->id_map_.at(alias);
@@ -5205,7 +5280,7 @@ bool liblec::cui::gui::barchart_reload(const std::string &alias,
 			data.lower_limit,
 			data.upper_limit,
 			data.autoscale,
-			vValues,
+			std::move(vValues),
 			error_);
 
 		error = convert_string(error_);
@@ -5396,10 +5471,10 @@ bool liblec::cui::gui::linechart_reload(const std::string &alias,
 					data.lines[i].points[j].color.green, data.lines[i].points[j].color.blue);
 				data_.dValue = data.lines[i].points[j].value;
 
-				line.vValues.push_back(data_);
+				line.vValues.push_back(std::move(data_));
 			}
 
-			vLines.push_back(line);
+			vLines.push_back(std::move(line));
 		}
 
 		int unique_id = d_->id_map_.at(alias);
@@ -5410,6 +5485,15 @@ bool liblec::cui::gui::linechart_reload(const std::string &alias,
 		page_name.erase(idx, page_name.length());
 
 		std::basic_string<TCHAR> error_;
+
+		// set the point limit first so that the reloaded lines are trimmed to it
+		if (!d_->p_raw_ui_->lineChartMaxPointsSet(convert_string(page_name),
+			unique_id, (int)data.max_points, error_))
+		{
+			error = convert_string(error_);
+			return false;
+		}
+
 		bool result = d_->p_raw_ui_->lineChartReload(convert_string(page_name),
 			unique_id,
 			convert_string(data.caption),
@@ -5418,7 +5502,7 @@ bool liblec::cui::gui::linechart_reload(const std::string &alias,
 			data.lower_limit,
 			data.upper_limit,
 			data.autoscale,
-			vLines,
+			std::move(vLines),
 			error_);
 
 		error = convert_string(error_);
@@ -5431,6 +5515,56 @@ bool liblec::cui::gui::linechart_reload(const std::string &alias,
 	}
 } // linechart_reload
 
+bool liblec::cui::gui::linechart_append(const std::string &alias,
+	const std::string &series_name,
+	const std::vector<liblec::cui::widgets::chart_entry> &points,
+	std::string &error)
+{
+	if (!d_->p_raw_ui_)
+	{
+		error = "Library usage error: liblec::cui::gui::linechart_append";
+		return false;
+	}
+
+	try
+	{
+		std::vector<liblec::cui::gui_raw::cui_raw::barChartData> vValues;
+		vValues.reserve(points.size());
+
+		for (const auto &it : points)
+		{
+			liblec::cui::gui_raw::cui_raw::barChartData data_;
+			data_.sLabel = convert_string(it.label);
+			data_.clrBar = RGB(it.color.red, it.color.green, it.color.blue);
+			data_.dValue = it.value;
+
+			vValues.push_back(std::move(data_));
+		}
+
+		int unique_id = d_->id_map_.at(alias);
+
+		std::string page_name = alias;
+
+		auto idx = page_name.rfind("/");
+		page_name.erase(idx, page_name.length());
+
+		std::basic_string<TCHAR> error_;
+		bool result = d_->p_raw_ui_->lineChartAppend(convert_string(page_name),
+			unique_id,
+			convert_string(series_name),
+			std::move(vValues),
+			error_);
+
+		error = convert_string(error_);
+		return result;
+	}
+	catch (std::exception &e)
+	{
+		error = e.what();
+		return false;
+	}
+} // linechart_append
+
 bool liblec::cui::gui::linechart_save(const std::string &alias,
 	liblec::cui::image_format format,
 	const std::string &full_path,
@@ -5494,7 +5628,7 @@ bool liblec::cui::gui::piechart_reload(const std::string &alias,
 				data.slices[i].color.green, data.slices[i].color.blue);
 			data_.dValue = data.slices[i].value;
 
-			vValues.push_back(data_);
+			vValues.push_back(std::move(data_));
 		}
 
 		int unique_id = d_->id_map_.at(alias);
@@ -5509,7 +5643,7 @@ bool liblec::cui::gui::piechart_reload(const std::string &alias,
 			unique_id,
 			data.autocolor,
 			convert_string(data.caption),
-			vValues,
+			std::move(vValues),
 			convert_piechart_hover_effect(data.on_hover),
 			data.doughnut,
 			error_);
@@ -5589,7 +5723,7 @@ bool liblec::cui::gui::add_listview_row(const std::string &alias,
 			item_.sColumnName = convert_string(row.items[j].column_name);
 			item_.sItemData = convert_string(row.items[j].item_data);
 
-			row_.vItems.push_back(item_);
+			row_.vItems.push_back(std::move(item_));
 		}
 
 		int unique_id = d_->id_map_.at(alias);
@@ -5621,6 +5755,62 @@ bool liblec::cui::gui::add_listview_row(const std::string &alias,
 	}
 } // add_listview_row
 
+bool liblec::cui::gui::add_listview_row(const std::string &alias,
+	liblec::cui::widgets::listview_row &&row,
+	const bool &scroll_to_bottom,
+	std::string &error)
+{
+	if (!d_->p_raw_ui_)
+	{
+		error = "Library usage error: liblec::cui::gui::add_listview_row";
+		return false;
+	}
+
+	try
+	{
+		liblec::cui::gui_raw::cui_raw::listviewRow row_;
+		row_.vItems.reserve(row.items.size());
+
+		for (auto &item : row.items)
+		{
+			liblec::cui::gui_raw::cui_raw::listviewItem item_;
+			item_.bCustom = item.custom_text_color;
+			item_.clrText = RGB(item.color_text.red,
+				item.color_text.green, item.color_text.blue);
+			item_.iRowNumber = item.row_number;
+			item_.sColumnName = convert_string(item.column_name);
+			item_.sItemData = convert_string(item.item_data);
+
+			row_.vItems.push_back(std::move(item_));
+		}
+
+		// the caller has given up the row, release it now
+		row.items.clear();
+
+		int unique_id = d_->id_map_.at(alias);
+
+		std::string page_name = alias;
+
+		auto idx = page_name.rfind("/");
+		page_name.erase(idx, page_name.length());
+
+		std::basic_string<TCHAR> error_;
+		bool result = d_->p_raw_ui_->addListviewRow(convert_string(page_name),
+			unique_id,
+			std::move(row_),
+			scroll_to_bottom,
+			error_);
+
+		error = convert_string(error_);
+		return result;
+	}
+	catch (std::exception &e)
+	{
+		error = e.what();
+		return false;
+	}
+} // add_listview_row
+
 bool liblec::cui::gui::repopulate_listview(const std::string &alias,
 	std::vector<liblec::cui::widgets::listview_row> &data,
 	std::string &error)
@@ -5660,6 +5850,129 @@ bool liblec::cui::gui::repopulate_listview(const std::string &alias,
 	}
 } // repopulate_listview
 
+bool liblec::cui::gui::repopulate_listview(const std::string &alias,
+	std::vector<liblec::cui::widgets::listview_row> &&data,
+	std::string &error)
+{
+	if (!d_->p_raw_ui_)
+	{
+		error = "Library usage error: liblec::cui::gui::repopulate_listview";
+		return false;
+	}
+
+	try
+	{
+		std::vector<liblec::cui::gui_raw::cui_raw::listviewRow> data_ =
+			convert_listview_rows(data);
+
+		// the caller has given up the data, release it now
+		data.clear();
+		data.shrink_to_fit();
+
+		int unique_id = d_->id_map_.at(alias);
+
+		std::string page_name = alias;
+
+		auto idx = page_name.rfind("/");
+		page_name.erase(idx, page_name.length());
+
+		std::basic_string<TCHAR> error_;
+		bool result = d_->p_raw_ui_->repopulateListview(convert_string(page_name),
+			unique_id,
+			std::move(data_),
+			error_);
+
+		error = convert_string(error_);
+		return result;
+	}
+	catch (std::exception &e)
+	{
+		error = e.what();
+		return false;
+	}
+} // repopulate_listview
+
+bool liblec::cui::gui::repopulate_listview(const std::string &alias,
+	const size_t &row_count,
+	std::string &error)
+{
+	if (!d_->p_raw_ui_)
+	{
+		error = "Library usage error: liblec::cui::gui::repopulate_listview";
+		return false;
+	}
+
+	try
+	{
+		int unique_id = d_->id_map_.at(alias);
+
+		std::string page_name = alias;
+
+		auto idx = page_name.rfind("/");
+		page_name.erase(idx, page_name.length());
+
+		std::basic_string<TCHAR> error_;
+		bool result = d_->p_raw_ui_->setListviewRowCount(convert_string(page_name),
+			unique_id,
+			static_cast<int>(row_count),
+			error_);
+
+		error = convert_string(error_);
+		return result;
+	}
+	catch (std::exception &e)
+	{
+		error = e.what();
+		return false;
+	}
+} // repopulate_listview
+
+bool liblec::cui::gui::repopulate_listview(const std::string &alias,
+	const std::vector<liblec::cui::widgets::listview_column_data> &columns,
+	std::string &error)
+{
+	if (!d_->p_raw_ui_)
+	{
+		error = "Library usage error: liblec::cui::gui::repopulate_listview";
+		return false;
+	}
+
+	try
+	{
+		std::vector<liblec::cui::gui_raw::cui_raw::listviewColumnData> columns_(columns.size());
+
+		for (size_t i = 0; i < columns.size(); i++)
+		{
+			columns_[i].sColumnName = convert_string(columns[i].column_name);
+			columns_[i].vItems.reserve(columns[i].items.size());
+
+			for (const auto &item : columns[i].items)
+				columns_[i].vItems.push_back(convert_string(item));
+		}
+
+		int unique_id = d_->id_map_.at(alias);
+
+		std::string page_name = alias;
+
+		auto idx = page_name.rfind("/");
+		page_name.erase(idx, page_name.length());
+
+		std::basic_string<TCHAR> error_;
+		bool result = d_->p_raw_ui_->repopulateListview(convert_string(page_name),
+			unique_id,
+			columns_,
+			error_);
+
+		error = convert_string(error_);
+		return result;
+	}
+	catch (std::exception &e)
+	{
+		error = e.what();
+		return false;
+	}
+} // repopulate_listview
+
 bool liblec::cui::gui::get_listview(const std::string &alias,
 	std::vector<liblec::cui::widgets::listview_column> &columns,
 	std::vector<liblec::cui::widgets::listview_row> &data,
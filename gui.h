@@ -562,6 +562,12 @@ namespace liblec
 				bool autoscale = true;
 				bool autocolor = false;
 				std::vector<liblec::cui::widgets::line_info> lines;
+
+				/// <summary>
+				/// Maximum number of points kept per line, 0 for no limit. When a line is full
+				/// the oldest point is dropped for every point appended.
+				/// </summary>
+				size_t max_points = 0;
 			}; // linechart_data
 
 			struct linechart
@@ -635,6 +641,16 @@ namespace liblec
 				std::vector<liblec::cui::widgets::listview_item> items;
 			};
 
+			/// <summary>
+			/// The cells of a listview column, one per row, for populating a listview
+			/// one column at a time.
+			/// </summary>
+			struct listview_column_data
+			{
+				std::string column_name;
+				std::vector<std::string> items;
+			};
+
 			struct context_menu_item
 			{
 				std::string label;
@@ -658,6 +674,19 @@ namespace liblec
 				liblec::cui::rect rect;
 				liblec::cui::widgets::on_resize on_resize;
 				std::function<void()> on_selection = nullptr;
+
+				/// <summary>
+				/// Row provider for a virtual listview. When set, data is ignored and the listview
+				/// asks for each row (row_number counted from 0) only when it is displayed. Sorting
+				/// by clicking columns is not available in a virtual listview.
+				/// </summary>
+				std::function<void(const size_t &row_number,
+					liblec::cui::widgets::listview_row &row)> row_provider = nullptr;
+
+				/// <summary>
+				/// Number of rows in a virtual listview.
+				/// </summary>
+				size_t row_count = 0;
 			}; // listview
 
 			struct tab_control
@@ -1254,6 +1283,21 @@ namespace liblec
 				const liblec::cui::widgets::linechart_data &data,
 				std::string &error);
 
+			/// <summary>
+			/// Append points to a line chart series.
+			/// </summary>
+			/// 
+			/// <remarks>
+			/// The series is added if it does not exist. Points are numbered on from those
+			/// already appended to the series, and the oldest points are dropped once the
+			/// series holds the line chart's max_points. Only the plot is repainted unless
+			/// the series is new.
+			/// </remarks>
+			bool linechart_append(const std::string &alias,
+				const std::string &series_name,
+				const std::vector<liblec::cui::widgets::chart_entry> &points,
+				std::string &error);
+
 			bool linechart_save(const std::string &alias,
 				liblec::cui::image_format format,
 				const std::string &full_path,
@@ -1279,10 +1323,63 @@ namespace liblec
 				const bool &scroll_to_bottom,
 				std::string &error);
 
+			/// <summary>
+			/// Add a row to a listview, giving up the row.
+			/// </summary>
+			/// 
+			/// <remarks>
+			/// Each cell's text is still converted to the library's character type, which
+			/// allocates in Unicode builds. What is saved is the copy the listview would otherwise
+			/// keep and the conversion back, so the row number is not written back and row is
+			/// left empty.
+			/// </remarks>
+			bool add_listview_row(const std::string &alias,
+				liblec::cui::widgets::listview_row &&row,
+				const bool &scroll_to_bottom,
+				std::string &error);
+
 			bool repopulate_listview(const std::string &alias,
 				std::vector<liblec::cui::widgets::listview_row> &data,
 				std::string &error);
 
+			/// <summary>
+			/// Repopulate a listview, giving up the data.
+			/// </summary>
+			/// 
+			/// <remarks>
+			/// Each cell's text is still converted to the library's character type, which
+			/// allocates in Unicode builds. What is saved is the copy the listview would otherwise
+			/// keep and the conversion back, so row numbers are not written back and data is left
+			/// empty.
+			/// </remarks>
+			bool repopulate_listview(const std::string &alias,
+				std::vector<liblec::cui::widgets::listview_row> &&data,
+				std::string &error);
+
+			/// <summary>
+			/// Repopulate a virtual listview.
+			/// </summary>
+			/// 
+			/// <remarks>
+			/// Only the row count is updated; rows are requested again from the listview's
+			/// row_provider when they are displayed.
+			/// </remarks>
+			bool repopulate_listview(const std::string &alias,
+				const size_t &row_count,
+				std::string &error);
+
+			/// <summary>
+			/// Repopulate a listview from column data.
+			/// </summary>
+			/// 
+			/// <remarks>
+			/// The number of rows is that of the longest column; cells missing from shorter
+			/// columns are left empty. Items are added without custom text colors.
+			/// </remarks>
+			bool repopulate_listview(const std::string &alias,
+				const std::vector<liblec::cui::widgets::listview_column_data> &columns,
+				std::string &error);
+
 			bool get_listview(const std::string &alias,
 				std::vector<liblec::cui::widgets::listview_column> &columns,
 				std::vector<liblec::cui::widgets::listview_row> &data,
@@ -8,32 +8,51 @@
 // file LICENSE.txt
 //
 
-#define _GNU_SOURCE
-
 #include "../../resources/dictionary_resource.h"
 #include "dictionary.h"
 
-#include <Shlwapi.h>				// for StrStrA
-#pragma comment(lib, "Shlwapi.lib")
-
 #include <cctype>					// for tolower
+#include <mutex>
+#include <atomic>
+
+dictionary_index dictionary::index;
+mapped_file dictionary::file;
+dictionary_automaton dictionary::automaton;
+
+// guards loading of the dictionary
+static std::mutex dict_mutex;
 
-const char* dictionary::dict_buffer = NULL;
+// set once the dictionary and the automaton are ready, so that callers that rate many
+// passwords at once do not have to take the lock every time
+static std::atomic<bool> dict_loaded(false);
+static std::atomic<bool> automaton_built(false);
 
-/// load dictionary file into buffer
-/// this function will only load the dictionary if the buffer is found to be empty
+/// load dictionary resource
+/// the resource is a dictionary compiled by the dictc tool, and is used in place: nothing is
+/// parsed and the pages are shared by every process that loads the module
+/// this function will only load the dictionary if it is found to be empty
 void dictionary::LoadDict()
 {
-	if (dict_buffer == NULL)
+	if (dict_loaded.load(std::memory_order_acquire))
+		return;
+
+	std::lock_guard<std::mutex> lock(dict_mutex);
+
+	if (index.empty())
 	{
+#if defined(_WIN32)
 		DWORD size = 0;
+		const char* dict_buffer = NULL;
 
-		// load dictionary text file in resource
-		LoadFileInResource(IDTXT_DICT, TEXTFILE, size, dict_buffer);
+		// load compiled dictionary in resource
+		LoadFileInResource(IDBIN_DICT, BINFILE, size, dict_buffer);
 
-		if (size == 0 || dict_buffer == NULL) {
-			dict_buffer = NULL;
-		}
+		// the resource is part of the module so there is no need to verify its checksum
+		if (size != 0 && dict_buffer != NULL)
+			index.attach(dict_buffer, size, false);
+#endif
+
+		dict_loaded.store(!index.empty(), std::memory_order_release);
 	}
 	else {
 		// dictionary already in memory
@@ -42,67 +61,145 @@ void dictionary::LoadDict()
 	return;
 }
 
-int searchforword(const char* ccSource, const char* ccToFind, bool bCasesensitive) {
+/// load dictionary from a file and index it
+/// the file is either a dictionary compiled by the dictc tool, which is used in place after
+/// its checksum is verified, or a plain list of newline separated words
+/// replaces any dictionary already in memory
+/// returns false if the file cannot be read or is not a usable dictionary
+bool dictionary::LoadDict(const std::string& sFullPath)
+{
+	mapped_file new_file;
+
+	if (!new_file.open(sFullPath))
+		return false;
+
+	dictionary_index new_index;
+
+	if (dictionary_index::is_image(new_file.data(), new_file.size())) {
+		if (!new_index.attach(new_file.data(), new_file.size(), true))
+			return false;
+	}
+	else {
+		if (!new_index.build(static_cast<const char*>(new_file.data()), new_file.size()))
+			return false;
+	}
+
+	std::lock_guard<std::mutex> lock(dict_mutex);
+
+	// the index refers to the mapping, which stays in place when swapped
+	file.swap(new_file);
+	index = std::move(new_index);
+	automaton.clear();
+	automaton_built.store(false, std::memory_order_release);
+	dict_loaded.store(true, std::memory_order_release);
+	return true;
+}
+
+static bool searchforword(const dictionary_index& index, const std::string& sToFind, bool bCasesensitive) {
 	if (bCasesensitive == true) {
-		// search for word in dictionary (case sensitive)
-		if (strstr(ccSource, ccToFind) != NULL) return 1;
+		// look up word in dictionary (case sensitive)
+		return index.contains(sToFind);
 	}
 	else {
-		// search for word in dictionary (case insensitive)
-		std::string m_sToFind(ccToFind);
+		// look up word in dictionary (case insensitive)
+		std::string m_sToFind(sToFind);
 
 		// check all lowercase
 		for (int i = 0; i < (int)m_sToFind.length(); i++)
-			m_sToFind[i] = tolower(m_sToFind[i]);
+			m_sToFind[i] = tolower((unsigned char)m_sToFind[i]);
 
-		if (strstr(ccSource, m_sToFind.c_str()) != NULL)
-			return 1;
+		if (index.contains(m_sToFind))
+			return true;
 
 		// check first letter uppercase
-		for (int i = 0; i < (int)m_sToFind.length(); i++)
-		{
-			m_sToFind[0] = toupper(m_sToFind[0]);
-			break;
-		}
+		if (!m_sToFind.empty())
+			m_sToFind[0] = toupper((unsigned char)m_sToFind[0]);
 
-		if (strstr(ccSource, m_sToFind.c_str()) != NULL)
-			return 1;
+		return index.contains(m_sToFind);
 	}
-
-	return 0;
 }
 
-/// search word in dictionary file
-/// returns 0 if word is NOT found in the file
-/// returns 1 if word is found
+/// search word in dictionary
+/// returns 0 if word is NOT in the dictionary
+/// returns 1 if word is in the dictionary
 /// returns -1 if dictionary has not been loaded into memory
 int dictionary::SearchInDict(const std::wstring& sWord, bool bCasesensitive) {
-	if (dict_buffer == NULL) return -1;
+	std::string m_sWord;
+	m_sWord.reserve(sWord.length());
 
-	std::string m_sWord = std::string(sWord.begin(), sWord.end());
+	for (const auto& c : sWord)
+		m_sWord.push_back((char)c);
 
-	int iRes = 0;
+	return SearchInDict(m_sWord, bCasesensitive);
+}
 
-	// check if last character is an 's' and cut it off to check for plurals
-	if (m_sWord.length() > 1 && tolower(m_sWord[m_sWord.length() - 1]) == 's') {
-		std::string m_sWordToSearch = std::string(m_sWord.begin(), m_sWord.end() - 1);
+int dictionary::SearchInDict(const std::string& sWord, bool bCasesensitive) {
+	if (index.empty()) return -1;
 
-		iRes = searchforword(dict_buffer, m_sWordToSearch.c_str(), bCasesensitive);
+	std::string m_sWord(sWord);
+
+	// check word as-is
+	if (searchforword(index, m_sWord, bCasesensitive))
+		return 1;
 
-		if (iRes == 1)
+	// check if last character is an 's' and cut it off to check for plurals
+	if (m_sWord.length() > 1 && tolower((unsigned char)m_sWord[m_sWord.length() - 1]) == 's') {
+		m_sWord.pop_back();
+
+		if (searchforword(index, m_sWord, bCasesensitive))
 			return 1;
-		else
-			return 0;
 	}
 
-	// check word as-is
-	iRes = searchforword(dict_buffer, m_sWord.c_str(), bCasesensitive);
+	return 0;
+}
 
-	if (iRes == 1) return 1;
+/// build the automaton the first time it is needed
+/// returns false if dictionary has not been loaded into memory
+bool dictionary::BuildAutomaton() {
+	if (index.empty()) return false;
 
-	return 0;
+	if (!automaton_built.load(std::memory_order_acquire)) {
+		std::lock_guard<std::mutex> lock(dict_mutex);
+
+		if (!automaton_built.load(std::memory_order_relaxed)) {
+			automaton.build(index);
+			automaton_built.store(true, std::memory_order_release);
+		}
+	}
+
+	return true;
+}
+
+/// find the dictionary words embedded in a password, including words spelt with common
+/// substitutions such as '0' for 'o' (see dictionary_automaton)
+/// returns the number of words found
+/// returns -1 if dictionary has not been loaded into memory
+int dictionary::FindInDict(const std::string& sPassword, std::vector<dictionary_match>& matches) {
+	matches.clear();
+
+	if (!BuildAutomaton()) return -1;
+
+	automaton.find(sPassword, matches);
+	return (int)matches.size();
+}
+
+/// number of dictionary words of a given length that FindInDict can match
+/// returns 0 if dictionary has not been loaded into memory
+size_t dictionary::CountInDict(size_t iLength) {
+	if (!BuildAutomaton()) return 0;
+
+	return automaton.words_of_length(iLength);
+}
+
+/// the automaton FindInDict uses, for callers that match a password one character at a time
+/// returns nullptr if dictionary has not been loaded into memory
+const dictionary_automaton* dictionary::GetAutomaton() {
+	if (!BuildAutomaton()) return nullptr;
+
+	return &automaton;
 }
 
+#if defined(_WIN32)
 void dictionary::LoadFileInResource(int name, int type, DWORD& size, const char*& data) {
 	HMODULE handle = NULL;
 
@@ -118,3 +215,4 @@ void dictionary::LoadFileInResource(int name, int type, DWORD& size, const char*
 
 	data = static_cast<const char*>(LockResource(rcData));
 }
+#endif
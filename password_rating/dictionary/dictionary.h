@@ -10,19 +10,40 @@
 
 #pragma once
 
+#if defined(_WIN32)
 #include <Windows.h>
 #include <tchar.h>
+#endif
+
 #include <string>
+#include <vector>
+#include "dictionary_index.h"
+#include "dictionary_automaton.h"
+#include "mapped_file.h"
 
 // dictionary class - definition
 class dictionary {
-	static const char* dict_buffer;
+	static dictionary_index index;
+	static mapped_file file;	// the file the dictionary was loaded from, if any
+	static dictionary_automaton automaton;	// built from the index the first time it is needed
+
+	static bool BuildAutomaton();
+
+#if defined(_WIN32)
 	static void LoadFileInResource(int name, int type, DWORD& size, const char*& data);
+#endif
 
 public:
 	dictionary();
 	~dictionary();
 
 	static void LoadDict();
+
+	// not to be called while another thread is searching the dictionary
+	static bool LoadDict(const std::string& sFullPath);
 	static int SearchInDict(const std::wstring& sWord, bool bCasesensitive);
+	static int SearchInDict(const std::string& sWord, bool bCasesensitive);
+	static int FindInDict(const std::string& sPassword, std::vector<dictionary_match>& matches);
+	static size_t CountInDict(size_t iLength);
+	static const dictionary_automaton* GetAutomaton();
 };
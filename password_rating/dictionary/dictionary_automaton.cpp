@@ -0,0 +1,293 @@
+//
+// dictionary_automaton.cpp - dictionary automaton implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "dictionary_automaton.h"
+#include "dictionary_index.h"
+
+#include <algorithm>
+
+static int popcount(uint32_t v) {
+	v = v - ((v >> 1) & 0x55555555u);
+	v = (v & 0x33333333u) + ((v >> 2) & 0x33333333u);
+	return int((((v + (v >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+}
+
+dictionary_automaton::dictionary_automaton() {}
+dictionary_automaton::~dictionary_automaton() {}
+
+bool dictionary_automaton::build(const dictionary_index& index) {
+	clear();
+
+	// collect the words, in lowercase
+	std::vector<std::string> words;
+	words.reserve(index.size());
+
+	index.for_each_word([&](const char* word, size_t length) {
+		if (length < min_length || length > max_length)
+			return;
+
+		std::string s(word, length);
+
+		for (auto& c : s) {
+			if (c >= 'A' && c <= 'Z')
+				c = char(c - 'A' + 'a');
+			else
+				if (c < 'a' || c > 'z')
+					return;
+		}
+
+		words.push_back(std::move(s));
+	});
+
+	if (words.empty())
+		return false;
+
+	std::sort(words.begin(), words.end());
+	words.erase(std::unique(words.begin(), words.end()), words.end());
+
+	words_of_length_.assign(max_length + 1, 0);
+
+	for (const auto& word : words)
+		words_of_length_[word.length()]++;
+
+	// 1. build a temporary trie; siblings are linked in letter order because the words are sorted
+	struct temp_node {
+		uint32_t first_child = 0;
+		uint32_t last_child = 0;
+		uint32_t next_sibling = 0;
+		uint8_t letter = 0;
+		uint8_t word_length = 0;
+	};
+
+	std::vector<temp_node> trie(1);
+
+	for (const auto& word : words) {
+		uint32_t node = 0;
+
+		for (size_t i = 0; i < word.length(); i++) {
+			const uint8_t letter = uint8_t(word[i] - 'a');
+			const uint32_t last = trie[node].last_child;
+
+			if (last != 0 && trie[last].letter == letter)
+				node = last;
+			else {
+				const uint32_t child = uint32_t(trie.size());
+				temp_node n;
+				n.letter = letter;
+				trie.push_back(n);
+
+				if (last == 0)
+					trie[node].first_child = child;
+				else
+					trie[last].next_sibling = child;
+
+				trie[node].last_child = child;
+				node = child;
+			}
+		}
+
+		trie[node].word_length = uint8_t(word.length());
+	}
+
+	words.clear();
+	words.shrink_to_fit();
+
+	// 2. lay the trie out breadth first so that the children of every node are contiguous
+	const size_t nodes = trie.size();
+	mask_.assign(nodes, 0);
+	first_child_.assign(nodes, 0);
+	fail_.assign(nodes, 0);
+	word_length_.assign(nodes, 0);
+	output_.assign(nodes, 0);
+
+	std::vector<uint32_t> order;	// temporary node of each final node
+	order.reserve(nodes);
+	order.push_back(0);
+
+	for (size_t i = 0; i < order.size(); i++) {
+		const temp_node& n = trie[order[i]];
+		word_length_[i] = n.word_length;
+		first_child_[i] = uint32_t(order.size());
+
+		for (uint32_t c = n.first_child; c != 0; c = trie[c].next_sibling) {
+			mask_[i] |= 1u << trie[c].letter;
+			order.push_back(c);
+		}
+	}
+
+	trie.clear();
+	trie.shrink_to_fit();
+
+	// 3. failure and output links, breadth first so that shallower links are ready first
+	for (uint32_t u = 0; u < uint32_t(nodes); u++) {
+		uint32_t child = first_child_[u];
+
+		for (int letter = 0; letter < 26; letter++) {
+			if ((mask_[u] & (1u << letter)) == 0)
+				continue;
+
+			const uint32_t f = (u == 0) ? 0 : next(fail_[u], letter);
+			fail_[child] = f;
+			output_[child] = word_length_[f] ? f : output_[f];
+			child++;
+		}
+	}
+
+	return true;
+}
+
+uint32_t dictionary_automaton::next(uint32_t state, int letter) const {
+	const uint32_t bit = 1u << letter;
+
+	for (;;) {
+		if (mask_[state] & bit)
+			return first_child_[state] + popcount(mask_[state] & (bit - 1));
+
+		if (state == 0)
+			return 0;
+
+		state = fail_[state];
+	}
+}
+
+void dictionary_automaton::clear() {
+	mask_.clear();
+	mask_.shrink_to_fit();
+	first_child_.clear();
+	first_child_.shrink_to_fit();
+	fail_.clear();
+	fail_.shrink_to_fit();
+	word_length_.clear();
+	word_length_.shrink_to_fit();
+	output_.clear();
+	output_.shrink_to_fit();
+	words_of_length_.clear();
+}
+
+size_t dictionary_automaton::words_of_length(size_t length) const {
+	return length < words_of_length_.size() ? words_of_length_[length] : 0;
+}
+
+bool dictionary_automaton::empty() const {
+	return mask_.empty();
+}
+
+/// the letters a password character can stand for; returns the number of letters
+static int read_as(char c, int letters[2]) {
+	if (c >= 'a' && c <= 'z') { letters[0] = c - 'a'; return 1; }
+	if (c >= 'A' && c <= 'Z') { letters[0] = c - 'A'; return 1; }
+
+	switch (c) {
+	case '4': case '@': letters[0] = 'a' - 'a'; return 1;
+	case '8': letters[0] = 'b' - 'a'; return 1;
+	case '(': letters[0] = 'c' - 'a'; return 1;
+	case '3': letters[0] = 'e' - 'a'; return 1;
+	case '6': case '9': letters[0] = 'g' - 'a'; return 1;
+	case '1': letters[0] = 'i' - 'a'; letters[1] = 'l' - 'a'; return 2;
+	case '!': case '|': letters[0] = 'i' - 'a'; letters[1] = 'l' - 'a'; return 2;
+	case '0': letters[0] = 'o' - 'a'; return 1;
+	case '5': case '$': letters[0] = 's' - 'a'; return 1;
+	case '7': case '+': letters[0] = 't' - 'a'; return 1;
+	case '%': letters[0] = 'x' - 'a'; return 1;
+	case '2': letters[0] = 'z' - 'a'; return 1;
+	default: return 0;
+	}
+}
+
+void dictionary_automaton::find(const std::string& password, std::vector<dictionary_match>& matches) const {
+	matches.clear();
+
+	if (empty())
+		return;
+
+	cursor c;
+
+	for (size_t pos = 0; pos < password.length(); pos++)
+		step(c, password[pos], pos, matches);
+}
+
+void dictionary_automaton::step(cursor& c, char ch, size_t pos, std::vector<dictionary_match>& matches) const {
+	if (empty())
+		return;
+
+	// substitutions split states when a character can be read as more than one letter
+	int letters[2];
+	const int n = read_as(ch, letters);
+	const bool substituted = !((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z'));
+
+	cursor::state following[max_states];
+	size_t following_count = 0;
+
+	for (size_t s = 0; s < c.count; s++) {
+		for (int l = 0; l < n; l++) {
+			const uint32_t node = next(c.states[s].node, letters[l]);
+
+			if (node == 0)
+				continue;
+
+			cursor::state st = { node, substituted ? int32_t(pos) : c.states[s].leet_pos };
+
+			bool duplicate = false;
+
+			for (size_t k = 0; k < following_count; k++) {
+				if (following[k].node == st.node) {
+					// keep the reading with the fewest substitutions
+					if (following[k].leet_pos >= 0 && st.leet_pos < 0)
+						following[k] = st;
+
+					duplicate = true;
+					break;
+				}
+			}
+
+			if (!duplicate && following_count < max_states)
+				following[following_count++] = st;
+		}
+	}
+
+	if (following_count == 0) {
+		c.states[0] = { 0, -1 };
+		c.count = 1;
+		return;
+	}
+
+	for (size_t s = 0; s < following_count; s++) {
+		const cursor::state& st = following[s];
+		uint32_t out = word_length_[st.node] ? st.node : output_[st.node];
+
+		while (out != 0) {
+			dictionary_match m;
+			m.length = word_length_[out];
+			m.begin = pos + 1 - m.length;
+			m.leet = st.leet_pos >= 0 && size_t(st.leet_pos) >= m.begin;
+
+			// the same word may be reached through several readings; report it once,
+			// preferring the reading without substitutions
+			bool reported = false;
+
+			for (auto it = matches.rbegin(); it != matches.rend() && it->begin + it->length == pos + 1; it++) {
+				if (it->begin == m.begin) {
+					it->leet = it->leet && m.leet;
+					reported = true;
+					break;
+				}
+			}
+
+			if (!reported)
+				matches.push_back(m);
+
+			out = output_[out];
+		}
+
+		c.states[s] = st;
+	}
+
+	c.count = following_count;
+}
@@ -0,0 +1,98 @@
+//
+// dictionary_automaton.h - dictionary automaton interface
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class dictionary_index;
+
+/// a dictionary word found inside a password
+struct dictionary_match {
+	size_t begin = 0;		// position of the first character in the password
+	size_t length = 0;		// number of characters
+	bool leet = false;		// true if the word was only found by reading digits or symbols as letters
+};
+
+/// Aho-Corasick automaton over the words of a dictionary
+/// finds every dictionary word embedded in a password in one pass over the password,
+/// ignoring case and reading common substitutions ('0' for 'o', '4' and '@' for 'a', etc.)
+/// as the letters they stand for
+/// only words of min_length letters or more are matched, since shorter words are found in
+/// almost any string
+/// the class has no platform dependencies
+class dictionary_automaton {
+public:
+	dictionary_automaton();
+	~dictionary_automaton();
+
+	/// build the automaton from the words in an index
+	/// words with characters other than letters are left out
+	/// returns false if the index has no usable words
+	bool build(const dictionary_index& index);
+
+	/// clear the automaton
+	void clear();
+
+	bool empty() const;
+
+	/// find the dictionary words in a password
+	/// every occurrence is reported, including words inside longer words, in order of
+	/// the position of their last character
+	void find(const std::string& password, std::vector<dictionary_match>& matches) const;
+
+	/// most states the matcher tracks at once; ambiguous substitutions split the state
+	static const size_t max_states = 16;
+
+	/// matcher state after some of the characters of a password
+	/// a state is a node, and the position of the last substitution made to reach it, so that
+	/// a word ending at the node can tell whether it was spelt with substitutions
+	struct cursor {
+		struct state {
+			uint32_t node;
+			int32_t leet_pos;	// position of the last substitution, or -1 if none
+		};
+
+		state states[max_states];
+		size_t count;
+
+		cursor() : count(1) { states[0] = { 0, -1 }; }
+	};
+
+	/// feed the character at position pos of a password to the matcher, for passwords that
+	/// are matched one character at a time
+	/// the words ending at pos are appended to matches, as find would report them
+	void step(cursor& c, char ch, size_t pos, std::vector<dictionary_match>& matches) const;
+
+	/// number of distinct words of a given length in the automaton
+	size_t words_of_length(size_t length) const;
+
+	/// shortest word the automaton matches
+	static const size_t min_length = 4;
+
+	/// longest word the automaton matches
+	static const size_t max_length = 32;
+
+private:
+	/// go from a state on a letter (0 to 25), following failure links as needed
+	uint32_t next(uint32_t state, int letter) const;
+
+	// the trie is stored breadth first; the children of a node are contiguous, in letter
+	// order, starting at first_child_, and mask_ has a bit set for each letter with a child
+	std::vector<uint32_t> mask_;
+	std::vector<uint32_t> first_child_;
+	std::vector<uint32_t> fail_;
+	std::vector<uint8_t> word_length_;	// length of the word ending at the node, or 0
+	std::vector<uint32_t> output_;		// nearest node on the failure chain that ends a word, or 0
+	std::vector<size_t> words_of_length_;	// number of words of each length
+};
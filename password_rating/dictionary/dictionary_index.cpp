@@ -0,0 +1,296 @@
+//
+// dictionary_index.cpp - dictionary index implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "dictionary_index.h"
+#include <cstring>
+#include <utility>
+
+static const char image_magic[8] = { 'C', 'U', 'I', 'D', 'I', 'C', 'T', '\0' };
+static const uint32_t image_byte_order = 0x01020304;
+
+dictionary_index::dictionary_index() :
+	text_(nullptr),
+	text_size_(0),
+	slots_(nullptr),
+	capacity_(0),
+	words_(0) {}
+
+dictionary_index::~dictionary_index() {}
+
+dictionary_index::dictionary_index(dictionary_index&& other) noexcept :
+	dictionary_index() {
+	*this = std::move(other);
+}
+
+dictionary_index& dictionary_index::operator=(dictionary_index&& other) noexcept {
+	if (this != &other) {
+		const bool own = other.slots_ != nullptr && other.slots_ == other.own_slots_.data();
+
+		text_ = other.text_;
+		text_size_ = other.text_size_;
+		capacity_ = other.capacity_;
+		words_ = other.words_;
+		own_slots_ = std::move(other.own_slots_);
+		slots_ = own ? own_slots_.data() : other.slots_;
+
+		other.clear();
+	}
+
+	return *this;
+}
+
+uint32_t dictionary_index::hash(const char* word, size_t length) {
+	uint32_t h = 2166136261u;
+
+	for (size_t i = 0; i < length; i++) {
+		h ^= (unsigned char)word[i];
+		h *= 16777619u;
+	}
+
+	return h;
+}
+
+/// map a hash onto [0, capacity_) without a division
+size_t dictionary_index::first_slot(uint32_t h) const {
+	return size_t((uint64_t(h) * capacity_) >> 32);
+}
+
+bool dictionary_index::build(const char* text, size_t size) {
+	clear();
+
+	if (text == nullptr)
+		return false;
+
+	// a resource or a file may be terminated by a null character
+	const char* nul = static_cast<const char*>(memchr(text, '\0', size));
+
+	if (nul)
+		size = size_t(nul - text);
+
+	if (size == 0 || size > UINT32_MAX)
+		return false;
+
+	// count the lines to size the table
+	size_t lines = 1;
+
+	for (size_t i = 0; i < size; i++)
+		if (text[i] == '\n')
+			lines++;
+
+	// keep the load factor at or below two thirds so that probe sequences stay short
+	const size_t capacity = lines + lines / 2 + 1;
+
+	if (capacity > UINT32_MAX)
+		return false;
+
+	own_slots_.assign(capacity, slot{ 0, 0, 0 });
+	slots_ = own_slots_.data();
+	capacity_ = capacity;
+	text_ = text;
+	text_size_ = size;
+
+	slot* slots = own_slots_.data();
+	size_t start = 0;
+
+	while (start < size) {
+		const char* line = text + start;
+		const char* end = static_cast<const char*>(memchr(line, '\n', size - start));
+		size_t length = end ? size_t(end - line) : size - start;
+		const size_t next = start + length + 1;
+
+		if (length > 0 && line[length - 1] == '\r')
+			length--;
+
+		if (length > 0 && length <= UINT16_MAX) {
+			const uint32_t h = hash(line, length);
+			const uint16_t tag = uint16_t(h);
+			size_t i = first_slot(h);
+
+			for (;;) {
+				slot& s = slots[i];
+
+				if (s.length == 0) {
+					s.offset = uint32_t(start);
+					s.length = uint16_t(length);
+					s.tag = tag;
+					words_++;
+					break;
+				}
+
+				// duplicate word
+				if (s.tag == tag && s.length == length && memcmp(text_ + s.offset, line, length) == 0)
+					break;
+
+				if (++i == capacity_)
+					i = 0;
+			}
+		}
+
+		start = next;
+	}
+
+	if (words_ == 0) {
+		clear();
+		return false;
+	}
+
+	return true;
+}
+
+/// 64-bit FNV style checksum, eight bytes at a time
+uint64_t dictionary_index::checksum(const void* data, size_t size, uint64_t seed) {
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	uint64_t h = seed;
+	size_t i = 0;
+
+	for (; i + 8 <= size; i += 8) {
+		uint64_t v;
+		memcpy(&v, p + i, 8);
+		h = (h ^ v) * 1099511628211ull;
+	}
+
+	for (; i < size; i++)
+		h = (h ^ p[i]) * 1099511628211ull;
+
+	return h;
+}
+
+bool dictionary_index::save(std::vector<char>& out) const {
+	out.clear();
+
+	if (words_ == 0)
+		return false;
+
+	image_header header;
+	memcpy(header.magic, image_magic, sizeof(header.magic));
+	header.version = image_version;
+	header.byte_order = image_byte_order;
+	header.words = uint32_t(words_);
+	header.capacity = uint32_t(capacity_);
+	header.text_size = uint32_t(text_size_);
+	header.reserved = 0;
+
+	const size_t slots_size = capacity_ * sizeof(slot);
+	header.checksum = checksum(slots_, slots_size, 14695981039346656037ull);
+	header.checksum = checksum(text_, text_size_, header.checksum);
+
+	out.resize(sizeof(header) + slots_size + text_size_);
+	memcpy(out.data(), &header, sizeof(header));
+	memcpy(out.data() + sizeof(header), slots_, slots_size);
+	memcpy(out.data() + sizeof(header) + slots_size, text_, text_size_);
+	return true;
+}
+
+bool dictionary_index::is_image(const void* data, size_t size) {
+	return data != nullptr && size >= sizeof(image_header) &&
+		memcmp(data, image_magic, sizeof(image_magic)) == 0;
+}
+
+bool dictionary_index::attach(const void* image, size_t size, bool verify) {
+	clear();
+
+	if (!is_image(image, size))
+		return false;
+
+	// read the header by value so that the image needs no particular alignment
+	image_header header;
+	memcpy(&header, image, sizeof(header));
+
+	// images are written on little-endian machines, as all Windows targets are
+	if (header.version != image_version || header.byte_order != image_byte_order)
+		return false;
+
+	if (header.words == 0 || header.capacity <= header.words)
+		return false;
+
+	const size_t slots_size = size_t(header.capacity) * sizeof(slot);
+
+	if (size - sizeof(header) < slots_size ||
+		size - sizeof(header) - slots_size < header.text_size)
+		return false;
+
+	const char* base = static_cast<const char*>(image);
+	const char* slots_image = base + sizeof(header);
+	const char* text = base + sizeof(header) + slots_size;
+
+	if (verify) {
+		uint64_t h = checksum(slots_image, slots_size, 14695981039346656037ull);
+		h = checksum(text, header.text_size, h);
+
+		if (h != header.checksum)
+			return false;
+	}
+
+	const slot* slots = reinterpret_cast<const slot*>(slots_image);
+
+	if ((reinterpret_cast<uintptr_t>(slots_image) % alignof(slot)) != 0) {
+		// the header is a multiple of 8 bytes, so this only happens if the image itself is
+		// misaligned, e.g. a resource packed at an odd offset
+		own_slots_.resize(header.capacity);
+		memcpy(own_slots_.data(), slots_image, slots_size);
+		slots = own_slots_.data();
+	}
+
+	slots_ = slots;
+	text_ = text;
+	text_size_ = header.text_size;
+	capacity_ = header.capacity;
+	words_ = header.words;
+	return true;
+}
+
+void dictionary_index::clear() {
+	text_ = nullptr;
+	text_size_ = 0;
+	slots_ = nullptr;
+	capacity_ = 0;
+	words_ = 0;
+	own_slots_.clear();
+	own_slots_.shrink_to_fit();
+}
+
+bool dictionary_index::contains(const char* word, size_t length) const {
+	if (words_ == 0 || word == nullptr || length == 0 || length > UINT16_MAX)
+		return false;
+
+	const uint32_t h = hash(word, length);
+	const uint16_t tag = uint16_t(h);
+	size_t i = first_slot(h);
+
+	// the table is never full, so the probe always ends at an empty slot
+	for (size_t probes = 0; probes < capacity_; probes++) {
+		const slot& s = slots_[i];
+
+		if (s.length == 0)
+			return false;
+
+		if (s.tag == tag && s.length == length &&
+			size_t(s.offset) + length <= text_size_ &&
+			memcmp(text_ + s.offset, word, length) == 0)
+			return true;
+
+		if (++i == capacity_)
+			i = 0;
+	}
+
+	return false;
+}
+
+bool dictionary_index::contains(const std::string& word) const {
+	return contains(word.data(), word.length());
+}
+
+size_t dictionary_index::size() const {
+	return words_;
+}
+
+bool dictionary_index::empty() const {
+	return words_ == 0;
+}
@@ -0,0 +1,108 @@
+//
+// dictionary_index.h - dictionary index interface
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/// hashed index over a newline separated word list
+/// the index answers exact word lookups in O(length of word)
+/// it is either built from the word list, or attached to a compiled image of itself (see save)
+/// so that a dictionary compiled offline can be used straight from a mapped file or resource
+/// the words are not copied; the text or image the index uses must outlive it
+/// the class has no platform dependencies
+class dictionary_index {
+public:
+	dictionary_index();
+	~dictionary_index();
+
+	dictionary_index(dictionary_index&&) noexcept;
+	dictionary_index& operator=(dictionary_index&&) noexcept;
+
+	/// build the index from a buffer of newline separated words
+	/// carriage returns and empty lines are ignored, and so are words longer than 65535 characters
+	/// returns false if the buffer holds no words
+	bool build(const char* text, size_t size);
+
+	/// write a compiled image of the index, words included, to out
+	/// the image is little-endian; see image_header for the layout
+	/// returns false if the index is empty
+	bool save(std::vector<char>& out) const;
+
+	/// attach the index to a compiled image, using it in place
+	/// the image may be at any address; if it is not aligned for the slots (4 bytes) the slots
+	/// are copied, and only the text is used in place
+	/// the checksum is only verified if verify is true; images embedded in the module
+	/// can skip it
+	/// returns false if the image is not a valid image of this version
+	bool attach(const void* image, size_t size, bool verify);
+
+	/// check whether a buffer starts like a compiled image
+	static bool is_image(const void* data, size_t size);
+
+	/// clear the index
+	void clear();
+
+	/// check whether a word is in the index (case sensitive)
+	bool contains(const char* word, size_t length) const;
+	bool contains(const std::string& word) const;
+
+	/// number of distinct words in the index
+	size_t size() const;
+	bool empty() const;
+
+	/// call fn(const char* word, size_t length) for every word in the index, in no particular order
+	template <class Fn>
+	void for_each_word(Fn fn) const {
+		for (size_t i = 0; i < capacity_; i++)
+			if (slots_[i].length != 0 && size_t(slots_[i].offset) + slots_[i].length <= text_size_)
+				fn(text_ + slots_[i].offset, size_t(slots_[i].length));
+	}
+
+	/// FNV-1a hash of a word
+	static uint32_t hash(const char* word, size_t length);
+
+	/// current version of the compiled image
+	static const uint32_t image_version = 1;
+
+private:
+	/// an open addressing slot; length is zero for an empty slot
+	struct slot {
+		uint32_t offset;	// position of the word in the text
+		uint16_t length;	// length of the word
+		uint16_t tag;		// lower bits of the hash, to skip most string comparisons
+	};
+
+	/// compiled image layout: the header, then capacity slots, then text_size bytes of text
+	struct image_header {
+		char magic[8];			// "CUIDICT"
+		uint32_t version;		// image_version
+		uint32_t byte_order;	// 0x01020304, as written by the compiler
+		uint32_t words;			// number of distinct words
+		uint32_t capacity;		// number of slots
+		uint32_t text_size;		// size of the text
+		uint32_t reserved;
+		uint64_t checksum;		// of the slots and the text
+	};
+
+	static uint64_t checksum(const void* data, size_t size, uint64_t seed);
+
+	size_t first_slot(uint32_t h) const;
+
+	const char* text_;
+	size_t text_size_;
+	const slot* slots_;
+	size_t capacity_;
+	size_t words_;
+	std::vector<slot> own_slots_;	// used when the index is built rather than attached
+};
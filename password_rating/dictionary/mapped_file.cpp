@@ -0,0 +1,126 @@
+//
+// mapped_file.cpp - read-only memory mapped file implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "mapped_file.h"
+#include <utility>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+mapped_file::mapped_file() :
+	data_(nullptr),
+	size_(0)
+#if defined(_WIN32)
+	, mapping_(nullptr)
+#endif
+{}
+
+mapped_file::~mapped_file() {
+	close();
+}
+
+bool mapped_file::open(const std::string& full_path) {
+	close();
+
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(full_path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER file_size;
+
+	if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0 ||
+		(unsigned long long)file_size.QuadPart > (size_t)-1) {
+		CloseHandle(file);
+		return false;
+	}
+
+	// the mapping object keeps the file open
+	HANDLE mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(file);
+
+	if (mapping == NULL)
+		return false;
+
+	const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	if (data == NULL) {
+		CloseHandle(mapping);
+		return false;
+	}
+
+	mapping_ = mapping;
+	data_ = data;
+	size_ = (size_t)file_size.QuadPart;
+#else
+	const int file = ::open(full_path.c_str(), O_RDONLY);
+
+	if (file == -1)
+		return false;
+
+	struct stat file_stat;
+
+	if (fstat(file, &file_stat) != 0 || file_stat.st_size <= 0) {
+		::close(file);
+		return false;
+	}
+
+	void* data = mmap(nullptr, (size_t)file_stat.st_size, PROT_READ, MAP_SHARED, file, 0);
+	::close(file);
+
+	if (data == MAP_FAILED)
+		return false;
+
+	data_ = data;
+	size_ = (size_t)file_stat.st_size;
+#endif
+
+	return true;
+}
+
+void mapped_file::close() {
+	if (data_ == nullptr)
+		return;
+
+#if defined(_WIN32)
+	UnmapViewOfFile(data_);
+	CloseHandle(mapping_);
+	mapping_ = nullptr;
+#else
+	munmap(const_cast<void*>(data_), size_);
+#endif
+
+	data_ = nullptr;
+	size_ = 0;
+}
+
+void mapped_file::swap(mapped_file& other) {
+	std::swap(data_, other.data_);
+	std::swap(size_, other.size_);
+#if defined(_WIN32)
+	std::swap(mapping_, other.mapping_);
+#endif
+}
+
+const void* mapped_file::data() const {
+	return data_;
+}
+
+size_t mapped_file::size() const {
+	return size_;
+}
@@ -0,0 +1,45 @@
+//
+// mapped_file.h - read-only memory mapped file interface
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+/// maps a whole file into memory, read-only
+/// the pages are shared with every other process that maps the same file
+class mapped_file {
+public:
+	mapped_file();
+	~mapped_file();
+
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+
+	/// map the file, unmapping any file already mapped
+	/// returns false if the file cannot be opened or is empty
+	bool open(const std::string& full_path);
+
+	/// unmap the file
+	void close();
+
+	/// swap two mappings
+	void swap(mapped_file& other);
+
+	const void* data() const;
+	size_t size() const;
+
+private:
+	const void* data_;
+	size_t size_;
+#if defined(_WIN32)
+	void* mapping_;	// file mapping object handle
+#endif
+};
@@ -0,0 +1,781 @@
+//
+// password_entropy.cpp - password guess estimation implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "../cui.h"
+#include "password_entropy.h"
+#include "dictionary/dictionary.h"
+
+#include <cmath>
+#include <cstdlib>
+
+enum {
+	pattern_bruteforce,
+	pattern_dictionary,
+	pattern_username,
+	pattern_spatial,
+	pattern_repeat,
+	pattern_sequence,
+	pattern_date,
+	pattern_year,
+};
+
+// guesses at which an extra match stops being cheaper than brute force
+static const double min_guesses_before_growing_sequence = 10000;
+
+// least guesses for a match that is only part of the password
+static const double min_submatch_guesses_single_char = 10;
+static const double min_submatch_guesses_multi_char = 50;
+
+// guesses per brute force character
+static const double bruteforce_cardinality = 10;
+
+// years are guessed outwards from this one
+static const int reference_year = 2020;
+static const int min_year_space = 20;
+
+static bool is_lower(char c) { return c >= 'a' && c <= 'z'; }
+static bool is_upper(char c) { return c >= 'A' && c <= 'Z'; }
+static bool is_digit(char c) { return c >= '0' && c <= '9'; }
+static char to_lower(char c) { return is_upper(c) ? char(c - 'A' + 'a') : c; }
+
+static int lowest_bit(uint64_t v) {
+	int bit = 0;
+
+	while ((v & 1) == 0) {
+		v >>= 1;
+		bit++;
+	}
+
+	return bit;
+}
+
+static double n_choose_k(int n, int k) {
+	if (k > n) return 0;
+	if (k == 0) return 1;
+
+	double r = 1;
+
+	for (int d = 1; d <= k; d++) {
+		r *= n;
+		r /= d;
+		n--;
+	}
+
+	return r;
+}
+
+/// ways an attacker would try to capitalise a word
+static double uppercase_variations(const char* token, int length) {
+	int upper = 0, lower = 0;
+
+	for (int i = 0; i < length; i++) {
+		if (is_upper(token[i])) upper++;
+		if (is_lower(token[i])) lower++;
+	}
+
+	if (upper == 0)
+		return 1;
+
+	// first letter, last letter or all letters in uppercase are tried first
+	if (lower == 0 ||
+		(upper == 1 && (is_upper(token[0]) || is_upper(token[length - 1]))))
+		return 2;
+
+	double variations = 0;
+
+	for (int i = 1; i <= (upper < lower ? upper : lower); i++)
+		variations += n_choose_k(upper + lower, i);
+
+	return variations;
+}
+
+/// keyboard adjacency graph, built once
+/// keys are numbered, and a 64-bit mask holds the neighbours of each key
+struct keyboard_graph {
+	int key_of[128];
+	bool shifted[128];
+	uint64_t adjacent[64];
+	int row[64];
+	double x[64];
+	int keys = 0;
+	double starting_positions = 0;
+	double average_degree = 0;
+
+	keyboard_graph(const char* const* rows, const char* const* shifted_rows, const double* offsets,
+		int row_count, bool diagonals) {
+		for (int c = 0; c < 128; c++) {
+			key_of[c] = -1;
+			shifted[c] = false;
+		}
+
+		for (int r = 0; r < row_count; r++) {
+			for (int k = 0; rows[r][k] != '\0'; k++) {
+				row[keys] = r;
+				x[keys] = offsets[r] + k;
+				key_of[(unsigned char)rows[r][k]] = keys;
+
+				if (shifted_rows) {
+					key_of[(unsigned char)shifted_rows[r][k]] = keys;
+					shifted[(unsigned char)shifted_rows[r][k]] = true;
+				}
+
+				keys++;
+			}
+		}
+
+		int degree = 0;
+
+		for (int a = 0; a < keys; a++) {
+			adjacent[a] = 0;
+
+			for (int b = 0; b < keys; b++) {
+				if (a == b)
+					continue;
+
+				const double dx = std::fabs(x[a] - x[b]);
+				const int dr = std::abs(row[a] - row[b]);
+
+				// keys in the same row are neighbours one key apart; in adjacent rows, keys
+				// that overlap, or on a grid keypad, diagonal keys too
+				const bool neighbour = (dr == 0 && dx == 1) ||
+					(dr == 1 && (diagonals ? dx <= 1 : dx < 1));
+
+				if (neighbour) {
+					adjacent[a] |= uint64_t(1) << b;
+					degree++;
+				}
+			}
+		}
+
+		starting_positions = keys;
+		average_degree = double(degree) / keys;
+	}
+
+	/// direction of a step between neighbouring keys, to count turns
+	int direction(int a, int b) const {
+		const int dr = row[b] - row[a];
+		const int dx = x[b] < x[a] ? 0 : (x[b] == x[a] ? 1 : 2);
+		return (dr + 1) * 3 + dx;
+	}
+};
+
+static const keyboard_graph& qwerty() {
+	static const char* const rows[] = { "`1234567890-=", "qwertyuiop[]\\", "asdfghjkl;'", "zxcvbnm,./" };
+	static const char* const shifted_rows[] = { "~!@#$%^&*()_+", "QWERTYUIOP{}|", "ASDFGHJKL:\"", "ZXCVBNM<>?" };
+	static const double offsets[] = { 0, 1.5, 1.75, 2.25 };
+	static const keyboard_graph graph(rows, shifted_rows, offsets, 4, false);
+	return graph;
+}
+
+static const keyboard_graph& keypad() {
+	static const char* const rows[] = { "789", "456", "123", "0." };
+	static const double offsets[] = { 0, 0, 0, 0 };
+	static const keyboard_graph graph(rows, nullptr, offsets, 4, true);
+	return graph;
+}
+
+static void spatial_matches(const keyboard_graph& graph, const char* p, int n,
+	std::vector<password_entropy::match>& matches) {
+	int i = 0;
+
+	while (i < n - 2) {
+		const int first = (p[i] & 0x80) ? -1 : graph.key_of[(int)p[i]];
+
+		if (first < 0) {
+			i++;
+			continue;
+		}
+
+		int j = i;
+		int turns = 0;
+		int shifted = graph.shifted[(int)p[i]] ? 1 : 0;
+		int last_direction = -1;
+
+		while (j + 1 < n) {
+			const int a = graph.key_of[(int)p[j]];
+			const int b = (p[j + 1] & 0x80) ? -1 : graph.key_of[(int)p[j + 1]];
+
+			if (b < 0 || (graph.adjacent[a] & (uint64_t(1) << b)) == 0)
+				break;
+
+			const int d = graph.direction(a, b);
+
+			if (d != last_direction) {
+				turns++;
+				last_direction = d;
+			}
+
+			if (graph.shifted[(int)p[j + 1]])
+				shifted++;
+
+			j++;
+		}
+
+		const int length = j - i + 1;
+
+		if (length >= 3) {
+			double guesses = 0;
+
+			for (int l = 2; l <= length; l++) {
+				const int possible_turns = turns < l - 1 ? turns : l - 1;
+
+				for (int t = 1; t <= possible_turns; t++)
+					guesses += n_choose_k(l - 1, t - 1) * graph.starting_positions *
+					std::pow(graph.average_degree, t);
+			}
+
+			if (shifted > 0) {
+				const int unshifted = length - shifted;
+
+				if (unshifted == 0)
+					guesses *= 2;
+				else {
+					double variations = 0;
+
+					for (int s = 1; s <= (shifted < unshifted ? shifted : unshifted); s++)
+						variations += n_choose_k(shifted + unshifted, s);
+
+					guesses *= variations;
+				}
+			}
+
+			password_entropy::match m;
+			m.i = i;
+			m.j = j;
+			m.pattern = pattern_spatial;
+			m.guesses = guesses;
+			matches.push_back(m);
+		}
+
+		i = j > i ? j : i + 1;
+	}
+}
+
+static void repeat_matches(const char* p, int n, std::vector<password_entropy::match>& matches) {
+	int i = 0;
+
+	while (i < n) {
+		int best_unit = 0, best_repeats = 0;
+
+		for (int unit = 1; unit <= (n - i) / 2; unit++) {
+			int repeats = 1;
+
+			while (i + (repeats + 1) * unit <= n) {
+				bool same = true;
+
+				for (int k = 0; k < unit; k++) {
+					if (p[i + repeats * unit + k] != p[i + k]) {
+						same = false;
+						break;
+					}
+				}
+
+				if (!same)
+					break;
+
+				repeats++;
+			}
+
+			if (repeats >= 2 && unit * repeats > best_unit * best_repeats) {
+				best_unit = unit;
+				best_repeats = repeats;
+			}
+		}
+
+		if (best_unit * best_repeats >= 3) {
+			// guesses for the repeated unit: a dictionary word, or brute force
+			double base = std::pow(bruteforce_cardinality, best_unit) + 1;
+
+			if (best_unit >= 4 &&
+				dictionary::SearchInDict(std::string(p + i, best_unit), false) == 1) {
+				const double words = (double)dictionary::CountInDict(best_unit);
+
+				if (words > 0 && words < base)
+					base = words;
+			}
+
+			password_entropy::match m;
+			m.i = i;
+			m.j = i + best_unit * best_repeats - 1;
+			m.pattern = pattern_repeat;
+			m.guesses = base * best_repeats;
+			matches.push_back(m);
+
+			i = m.j + 1;
+		}
+		else
+			i++;
+	}
+}
+
+static void sequence_matches(const char* p, int n, std::vector<password_entropy::match>& matches) {
+	auto same_class = [](char a, char b) {
+		return (is_lower(a) && is_lower(b)) || (is_upper(a) && is_upper(b)) ||
+			(is_digit(a) && is_digit(b));
+	};
+
+	int i = 0;
+
+	while (i < n - 2) {
+		const int delta = p[i + 1] - p[i];
+
+		if (delta == 0 || std::abs(delta) > 5 || !same_class(p[i], p[i + 1])) {
+			i++;
+			continue;
+		}
+
+		int j = i + 1;
+
+		while (j + 1 < n && p[j + 1] - p[j] == delta && same_class(p[j], p[j + 1]))
+			j++;
+
+		const int length = j - i + 1;
+
+		if (length >= 3) {
+			const char first = p[i];
+			double base;
+
+			if (first == 'a' || first == 'A' || first == 'z' || first == 'Z' ||
+				first == '0' || first == '1' || first == '9')
+				base = 4;
+			else
+				base = is_digit(first) ? 10 : 26;
+
+			if (delta < 0)
+				base *= 2;
+
+			password_entropy::match m;
+			m.i = i;
+			m.j = j;
+			m.pattern = pattern_sequence;
+			m.guesses = base * length;
+			matches.push_back(m);
+		}
+
+		i = j;
+	}
+}
+
+static bool valid_date(int day, int month, int year) {
+	return month >= 1 && month <= 12 && day >= 1 && day <= 31 && year >= 1000 && year <= 2050;
+}
+
+static int expand_year(int year, int digits) {
+	if (digits > 2)
+		return year;
+
+	return year > 50 ? 1900 + year : 2000 + year;
+}
+
+/// read three numbers as a date, with the year first or last
+/// returns the year closest to the reference year, or 0 if the numbers are not a date
+static int read_date(const int* parts, const int* digits) {
+	int best = 0;
+
+	auto consider = [&](int day, int month, int year, int year_digits) {
+		if (year_digits != 2 && year_digits != 4)
+			return;
+
+		year = expand_year(year, year_digits);
+
+		if (!valid_date(day, month, year))
+			return;
+
+		if (best == 0 || std::abs(year - reference_year) < std::abs(best - reference_year))
+			best = year;
+	};
+
+	// year last: d m y, m d y; year first: y m d, y d m
+	if (digits[0] <= 2 && digits[1] <= 2) {
+		consider(parts[0], parts[1], parts[2], digits[2]);
+		consider(parts[1], parts[0], parts[2], digits[2]);
+	}
+
+	if (digits[1] <= 2 && digits[2] <= 2) {
+		consider(parts[2], parts[1], parts[0], digits[0]);
+		consider(parts[1], parts[2], parts[0], digits[0]);
+	}
+
+	return best;
+}
+
+static double date_guesses(int year, bool separator) {
+	const int space = std::abs(year - reference_year);
+	return double(space > min_year_space ? space : min_year_space) * 365 * (separator ? 4 : 1);
+}
+
+static void date_matches(const char* p, int n, std::vector<password_entropy::match>& matches) {
+	for (int i = 0; i < n; i++) {
+		// dates without separators, 4 to 8 digits
+		for (int length = 4; length <= 8 && i + length <= n; length++) {
+			bool digits_only = true;
+
+			for (int k = i; k < i + length; k++)
+				if (!is_digit(p[k])) { digits_only = false; break; }
+
+			if (!digits_only)
+				break;
+
+			int best = 0;
+
+			for (int a = 1; a < length - 1; a++) {
+				for (int b = a + 1; b < length; b++) {
+					const int digits[3] = { a, b - a, length - b };
+
+					if (digits[0] > 4 || digits[1] > 4 || digits[2] > 4)
+						continue;
+
+					int parts[3] = { 0, 0, 0 };
+
+					for (int k = 0; k < length; k++)
+						parts[k < a ? 0 : (k < b ? 1 : 2)] = parts[k < a ? 0 : (k < b ? 1 : 2)] * 10 + (p[i + k] - '0');
+
+					const int year = read_date(parts, digits);
+
+					if (year != 0 && (best == 0 ||
+						std::abs(year - reference_year) < std::abs(best - reference_year)))
+						best = year;
+				}
+			}
+
+			if (best != 0) {
+				password_entropy::match m;
+				m.i = i;
+				m.j = i + length - 1;
+				m.pattern = pattern_date;
+				m.guesses = date_guesses(best, false);
+				matches.push_back(m);
+			}
+		}
+
+		// dates with separators: d{1,4} sep d{1,2} sep d{1,4}, with the same separator twice
+		{
+			int parts[3] = { 0, 0, 0 };
+			int digits[3] = { 0, 0, 0 };
+			int k = i;
+			char separator = 0;
+			bool ok = true;
+
+			for (int part = 0; part < 3 && ok; part++) {
+				while (k < n && is_digit(p[k]) && digits[part] < 4) {
+					parts[part] = parts[part] * 10 + (p[k] - '0');
+					digits[part]++;
+					k++;
+				}
+
+				if (digits[part] == 0 || (part == 1 && digits[part] > 2)) {
+					ok = false;
+					break;
+				}
+
+				if (part < 2) {
+					const char c = k < n ? p[k] : '\0';
+					const bool is_separator = c == ' ' || c == '/' || c == '\\' || c == '_' ||
+						c == '.' || c == '-';
+
+					if (!is_separator || (part == 1 && c != separator)) {
+						ok = false;
+						break;
+					}
+
+					separator = c;
+					k++;
+				}
+			}
+
+			if (ok) {
+				const int year = read_date(parts, digits);
+
+				if (year != 0) {
+					password_entropy::match m;
+					m.i = i;
+					m.j = k - 1;
+					m.pattern = pattern_date;
+					m.guesses = date_guesses(year, true);
+					matches.push_back(m);
+				}
+			}
+		}
+
+		// recent years on their own
+		if (i + 4 <= n && is_digit(p[i]) && is_digit(p[i + 1]) && is_digit(p[i + 2]) && is_digit(p[i + 3]) &&
+			((p[i] == '1' && p[i + 1] == '9') || (p[i] == '2' && p[i + 1] == '0'))) {
+			const int year = (p[i] - '0') * 1000 + (p[i + 1] - '0') * 100 + (p[i + 2] - '0') * 10 + (p[i + 3] - '0');
+			const int space = std::abs(year - reference_year);
+
+			password_entropy::match m;
+			m.i = i;
+			m.j = i + 3;
+			m.pattern = pattern_year;
+			m.guesses = space > min_year_space ? space : min_year_space;
+			matches.push_back(m);
+		}
+	}
+}
+
+static void dictionary_matches(const std::string& username, const std::string& password, int n,
+	password_entropy::scratch& s, uint32_t& issues) {
+	const char* p = password.c_str();
+	const std::string analysed = password.substr(0, (size_t)n);
+
+	if (dictionary::FindInDict(analysed, s.dictionary_matches) >= 0) {
+		for (const auto& d : s.dictionary_matches) {
+			const int length = (int)d.length;
+			const double words = (double)dictionary::CountInDict(d.length);
+
+			password_entropy::match m;
+			m.i = (int)d.begin;
+			m.j = (int)(d.begin + d.length) - 1;
+			m.pattern = pattern_dictionary;
+			m.guesses = (words > 1 ? words : 1) * uppercase_variations(p + m.i, length);
+			m.leet = d.leet;
+
+			if (d.leet) {
+				// each distinct substituted character doubles the guesses
+				bool seen[128] = { false };
+
+				for (int k = m.i; k <= m.j; k++) {
+					const unsigned char c = (unsigned char)p[k];
+
+					if (c < 128 && !is_lower(p[k]) && !is_upper(p[k]) && !seen[c]) {
+						seen[c] = true;
+						m.guesses *= 2;
+					}
+				}
+			}
+
+			s.matches.push_back(m);
+		}
+
+		// the whole password, as the classic engine checks it, including short words and plurals
+		if (dictionary::SearchInDict(password, false) == 1) {
+			issues |= liblec::cui::password_issue::dictionary_attack;
+
+			const double words = (double)dictionary::CountInDict((size_t)n);
+
+			password_entropy::match m;
+			m.i = 0;
+			m.j = n - 1;
+			m.pattern = pattern_dictionary;
+			m.guesses = (words > 10 ? words : 10) * uppercase_variations(p, n);
+			s.matches.push_back(m);
+		}
+	}
+	else
+		issues |= liblec::cui::password_issue::no_dictionary;
+
+	// the username, or any part of it of 3 or more characters, ignoring case
+	const int u = (int)username.length();
+
+	if (u >= 3) {
+		for (int i = 0; i + 3 <= n; i++) {
+			int length = 0;
+
+			// longest part of the username that starts at i
+			for (int start = 0; start < u; start++) {
+				int k = 0;
+
+				while (i + k < n && start + k < u && to_lower(p[i + k]) == to_lower(username[start + k]))
+					k++;
+
+				if (k > length)
+					length = k;
+			}
+
+			if (length >= 3) {
+				password_entropy::match m;
+				m.i = i;
+				m.j = i + length - 1;
+				m.pattern = pattern_username;
+				m.guesses = uppercase_variations(p + i, length);
+				s.matches.push_back(m);
+			}
+		}
+	}
+}
+
+double password_entropy::guesses_log10(const std::string& username, const std::string& password,
+	uint32_t& issues, scratch& s) {
+	using namespace liblec::cui;
+
+	issues = 0;
+
+	const int length = (int)password.length();
+
+	if (length == 0)
+		return 0;
+
+	const int n = length < max_length ? length : max_length;
+	const char* p = password.c_str();
+
+	// 1. matches
+	s.matches.clear();
+	dictionary_matches(username, password, n, s, issues);
+	spatial_matches(qwerty(), p, n, s.matches);
+	spatial_matches(keypad(), p, n, s.matches);
+	repeat_matches(p, n, s.matches);
+	sequence_matches(p, n, s.matches);
+	date_matches(p, n, s.matches);
+
+	for (auto& m : s.matches) {
+		const double min_guesses = (m.j - m.i + 1 == n) ? 1 :
+			(m.j == m.i ? min_submatch_guesses_single_char : min_submatch_guesses_multi_char);
+
+		if (m.guesses < min_guesses)
+			m.guesses = min_guesses;
+	}
+
+	// 2. dynamic programming over the match spans
+	// table[k * (n + 1) + l] is the best sequence of l matches covering characters 0 to k
+	// entries are only read once their bit in s.lengths is set, so the table needs no clearing
+	if (s.table.size() < (size_t)n * (n + 1))
+		s.table.resize((size_t)n * (n + 1));
+
+	double factorial[max_length + 1];
+	double additive[max_length + 1];	// min_guesses_before_growing_sequence ^ (l - 1)
+	factorial[0] = 1;
+	additive[0] = 0;
+
+	for (int l = 1; l <= n; l++) {
+		factorial[l] = factorial[l - 1] * l;
+		additive[l] = (l == 1) ? 1 : additive[l - 1] * min_guesses_before_growing_sequence;
+	}
+
+	auto at = [&](int k, int l) -> step& { return s.table[(size_t)k * (n + 1) + l]; };
+
+	// bit l - 1 of s.lengths[k] is set if table entry (k, l) is
+	s.lengths.assign((size_t)n, 0);
+
+	auto update = [&](int i, int k, double guesses, int match, int l) {
+		double pi = guesses;
+
+		if (l > 1)
+			pi *= at(i - 1, l - 1).pi;
+
+		const double g = factorial[l] * pi + additive[l];
+
+		// keep the new sequence only if no sequence of as many or fewer matches is as cheap
+		uint64_t others = s.lengths[k] & (l >= 64 ? ~uint64_t(0) : (uint64_t(1) << l) - 1);
+
+		while (others) {
+			const int other = lowest_bit(others) + 1;
+			others &= others - 1;
+
+			if (at(k, other).g <= g)
+				return;
+		}
+
+		step& st = at(k, l);
+		st.pi = pi;
+		st.g = g;
+		st.match = match;
+		st.start = i;
+		s.lengths[k] |= uint64_t(1) << (l - 1);
+	};
+
+	double bruteforce[max_length + 1];	// bruteforce_cardinality ^ chars
+	bruteforce[0] = 1;
+
+	for (int chars = 1; chars <= n; chars++)
+		bruteforce[chars] = bruteforce[chars - 1] * bruteforce_cardinality;
+
+	auto bruteforce_guesses = [&](int i, int k) {
+		const int chars = k - i + 1;
+		double guesses = bruteforce[chars];
+		const double min_guesses = (chars == n) ? 1 :
+			(chars == 1 ? min_submatch_guesses_single_char : min_submatch_guesses_multi_char) + 1;
+		return guesses > min_guesses ? guesses : min_guesses;
+	};
+
+	for (int k = 0; k < n; k++) {
+		for (int mi = 0; mi < (int)s.matches.size(); mi++) {
+			const match& m = s.matches[mi];
+
+			if (m.j != k)
+				continue;
+
+			if (m.i == 0)
+				update(0, k, m.guesses, mi, 1);
+			else
+				for (uint64_t ls = s.lengths[m.i - 1]; ls; ls &= ls - 1) {
+					const int l = lowest_bit(ls) + 1;
+
+					if (l < n)
+						update(m.i, k, m.guesses, mi, l + 1);
+				}
+		}
+
+		// brute force from the start, or after a match
+		update(0, k, bruteforce_guesses(0, k), -1, 1);
+
+		for (int i = 1; i <= k; i++) {
+			const double guesses = bruteforce_guesses(i, k);
+
+			for (uint64_t ls = s.lengths[i - 1]; ls; ls &= ls - 1) {
+				const int l = lowest_bit(ls) + 1;
+
+				if (l < n && at(i - 1, l).match >= 0)
+					update(i, k, guesses, -1, l + 1);
+			}
+		}
+	}
+
+	// 3. the cheapest sequence over the whole password
+	int best_l = 0;
+
+	for (uint64_t ls = s.lengths[n - 1]; ls; ls &= ls - 1) {
+		const int l = lowest_bit(ls) + 1;
+
+		if (best_l == 0 || at(n - 1, l).g < at(n - 1, best_l).g)
+			best_l = l;
+	}
+
+	const double guesses = at(n - 1, best_l).g;
+
+	// issues for the patterns in the sequence
+	for (int k = n - 1, l = best_l; k >= 0 && l > 0; l--) {
+		const step& st = at(k, l);
+
+		if (st.match >= 0) {
+			const match& m = s.matches[st.match];
+
+			switch (m.pattern) {
+			case pattern_dictionary:
+				issues |= m.leet ? password_issue::dictionary_words_leet : password_issue::dictionary_words;
+				break;
+			case pattern_username: issues |= password_issue::too_similar; break;
+			case pattern_spatial: issues |= password_issue::keyboard_patterns; break;
+			case pattern_repeat: issues |= password_issue::repeats; break;
+			case pattern_sequence: issues |= password_issue::sequences; break;
+			case pattern_date:
+			case pattern_year: issues |= password_issue::dates; break;
+			default: break;
+			}
+		}
+
+		k = st.start - 1;
+	}
+
+	// a whole password in the dictionary is reported as such
+	if (issues & password_issue::dictionary_attack)
+		issues &= ~(password_issue::dictionary_words | password_issue::dictionary_words_leet);
+
+	// characters beyond those matched count as brute force
+	return std::log10(guesses) + (length - n) * std::log10(bruteforce_cardinality);
+}
+
+int password_entropy::strength(double guesses_log10) {
+	const double strength = guesses_log10 * 7.5;
+
+	if (strength < 0) return 0;
+	if (strength > 100) return 100;
+
+	return (int)(strength + 0.5);
+}
@@ -0,0 +1,65 @@
+//
+// password_entropy.h - password guess estimation interface
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "dictionary/dictionary_automaton.h"
+
+/// estimates how many guesses an attacker needs to find a password, in the manner of zxcvbn
+/// the password is matched against dictionary words, the username, keyboard walks, repeats,
+/// sequences and dates; each match gets a guess estimate, and dynamic programming over the
+/// match spans finds the sequence of matches and brute force stretches that is cheapest for
+/// an attacker to guess
+/// only the first max_length characters are matched; each character after that counts as
+/// brute force
+class password_entropy {
+public:
+	/// a pattern found in the password
+	struct match {
+		int i = 0;				// first character
+		int j = 0;				// last character
+		int pattern = 0;		// one of the pattern values in the implementation
+		double guesses = 0;		// guesses for this match on its own
+		bool leet = false;		// dictionary word spelt with substitutions
+	};
+
+	/// one entry of the dynamic programming table
+	struct step {
+		double pi = 0;			// product of the guesses of the matches in the sequence
+		double g = 0;			// guesses for the whole sequence
+		int match = -1;			// last match, or -1 for brute force
+		int start = 0;			// first character of the last match
+	};
+
+	/// scratch space kept from one estimate to the next
+	struct scratch {
+		std::vector<match> matches;
+		std::vector<dictionary_match> dictionary_matches;
+		std::vector<step> table;	// max_length rows of max_length + 1 sequence lengths
+		std::vector<uint64_t> lengths;	// the sequence lengths set in each row
+	};
+
+	/// estimate the guesses for a password
+	/// returns the base 10 logarithm of the number of guesses
+	/// issues receives liblec::cui::password_issue flags for the patterns that make up the
+	/// cheapest sequence
+	static double guesses_log10(const std::string& username, const std::string& password,
+		uint32_t& issues, scratch& s);
+
+	/// strength on the 0 - 100 scale of password_rating: 7.5 points per factor of ten in the
+	/// number of guesses, so that 10^12 guesses rate 90
+	static int strength(double guesses_log10);
+
+	/// number of characters that are matched
+	static const int max_length = 64;
+};
@@ -10,169 +10,251 @@
 
 #include "../cui.h"
 #include "dictionary/dictionary.h"
+#include "password_entropy.h"
+
+#include <thread>
+#include <atomic>
+#include <string_view>
+#include <memory>
 
 #define MAX_STR	256
-#define MAX_LCS 256	// Maximum size of the longest common sequence
 #define NO_OF_CHARS 256
 
-/// <summary>
-/// Function removes duplicate characters from the string
-/// This function work in-place and fills null characters
-/// in the extra space left
-/// </summary>
-std::string remove_duplicates(const std::string& str_in) {
-	char str[NO_OF_CHARS];
-	strncpy_s(str, str_in.c_str(), sizeof(str));
-
-	int bin_hash[NO_OF_CHARS] = { 0 };
-	int ip_ind = 0, res_ind = 0;
-	char temp;
-
-	// In place removal of duplicate characters
-	while (*(str + ip_ind)) {
-		temp = *(str + ip_ind);
-		if (bin_hash[temp] == 0)
-		{
-			bin_hash[temp] = 1;
-			*(str + res_ind) = *(str + ip_ind);
-			res_ind++;
-		}
-		ip_ind++;
+// a set of characters, one bit per character
+struct char_set {
+	uint64_t bits[NO_OF_CHARS / 64] = { 0 };
+
+	void add(unsigned char c) {
+		bits[c >> 6] |= uint64_t(1) << (c & 63);
+	}
+
+	void remove(unsigned char c) {
+		bits[c >> 6] &= ~(uint64_t(1) << (c & 63));
+	}
+
+	bool contains(unsigned char c) const {
+		return (bits[c >> 6] & (uint64_t(1) << (c & 63))) != 0;
 	}
 
-	/// After above step string is stringiittg.
-	/// Removing extra iittg after string
-	*(str + res_ind) = '\0';
+	int count() const {
+		return popcount(bits[0]) + popcount(bits[1]) + popcount(bits[2]) + popcount(bits[3]);
+	}
+
+	int count_common(const char_set& other) const {
+		return popcount(bits[0] & other.bits[0]) + popcount(bits[1] & other.bits[1]) +
+			popcount(bits[2] & other.bits[2]) + popcount(bits[3] & other.bits[3]);
+	}
+
+	static int popcount(uint64_t v) {
+		v = v - ((v >> 1) & 0x5555555555555555ull);
+		v = (v & 0x3333333333333333ull) + ((v >> 2) & 0x3333333333333333ull);
+		v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+		return int((v * 0x0101010101010101ull) >> 56);
+	}
+};
+
+/// the part of a string that is rated: up to the first null character, and no more
+/// than MAX_STR - 1 characters
+static std::string_view rated_part(std::string_view str) {
+	const size_t nul = str.find('\0');
+
+	if (nul != std::string_view::npos)
+		str = str.substr(0, nul);
+
+	if (str.length() > MAX_STR - 1)
+		str = str.substr(0, MAX_STR - 1);
+
 	return str;
 }
 
-// determine number of duplicated characters in a string
-int number_of_duplicates(const std::string& str_in) {
-	return int(str_in.length()) - int(remove_duplicates(str_in).length());
+static unsigned char upper(char c) {
+	return (c >= 'a' && c <= 'z') ? (unsigned char)(c - 'a' + 'A') : (unsigned char)c;
 }
 
-// Quick and dirty swap of the address of 2 arrays of unsigned int
-void swap(unsigned** first, unsigned** second) {
-	unsigned* temp;
-	temp = *first;
-	*first = *second;
-	*second = temp;
+// determine number of duplicated characters in a string
+int number_of_duplicates(std::string_view str) {
+	char_set set;
+
+	for (char c : rated_part(str))
+		set.add((unsigned char)c);
+
+	return int(str.length()) - set.count();
 }
 
-/// A function which returns how similar 2 strings are
-/// Assumes that both point to 2 valid null terminated array of chars.
-/// Returns the similarity between them as a percentage
-float similarity(std::string str1_, std::string str2_) {
-	for (int i = 0; i < int(str1_.length()); i++)
-		str1_[i] = toupper(str1_[i]);
+/// longest common subsequence of a fixed first string and a second string that is fed one
+/// character at a time, ignoring case
+/// uses the bit-parallel algorithm of Allison and Dix over the first string, which must have
+/// fewer than MAX_STR characters, so the whole computation fits in a few words
+class lcs_matcher {
+public:
+	/// a zero bit marks a position of the first string that is part of the subsequence so far
+	struct state {
+		uint64_t v[MAX_STR / 64];
+	};
+
+	lcs_matcher(std::string_view str1) :
+		length_(str1.length()), words_(int((str1.length() + 63) / 64)) {
+		// match_[c] has bit k set where str1[k] is c; only the rows of characters in str1
+		// are used, so only those are cleared
+		for (char c : str1)
+			for (int w = 0; w < words_; w++)
+				match_[upper(c)][w] = 0;
+
+		for (size_t k = 0; k < str1.length(); k++)
+			match_[upper(str1[k])][k >> 6] |= uint64_t(1) << (k & 63);
+
+		for (char c : str1)
+			in_str1_.add(upper(c));
+	}
 
-	for (int i = 0; i < int(str2_.length()); i++)
-		str2_[i] = toupper(str2_[i]);
+	void start(state& s) const {
+		for (int w = 0; w < words_; w++)
+			s.v[w] = ~uint64_t(0);
+	}
 
-	// check if strings have same letters (method A)
-	auto temp1 = remove_duplicates(str1_) + remove_duplicates(str2_);
-	auto temp2 = remove_duplicates(temp1);
+	void step(state& s, char c) const {
+		const unsigned char u = upper(c);
 
-	float similarity = 2 * float(temp1.length() - temp2.length()) / float(temp1.length());
+		if (!in_str1_.contains(u))
+			return;	// no match, v stays the same
 
-	// check similarity (method B)
-	char str1[MAX_STR];
-	char str2[MAX_STR];
+		// v = (v + (v & m)) | (v & ~m), with the carry running across the words
+		uint64_t carry = 0;
+
+		for (int w = 0; w < words_; w++) {
+			const uint64_t m = match_[u][w];
+			const uint64_t x = s.v[w] & m;
+			const uint64_t sum = s.v[w] + x;
+			const uint64_t sum_carry = sum + carry;
+			carry = (sum < s.v[w]) || (sum_carry < sum) ? 1 : 0;
+			s.v[w] = sum_carry | (s.v[w] & ~m);
+		}
+	}
+
+	int length(const state& s) const {
+		int lcs = 0;
 
-	strncpy_s(str1, str1_.c_str(), sizeof(str1));
-	strncpy_s(str2, str2_.c_str(), sizeof(str2));
+		for (int w = 0; w < words_; w++) {
+			const size_t bits = (w + 1) * 64 <= (int)length_ ? 64 : length_ - w * 64;
+			const uint64_t mask = bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+			lcs += char_set::popcount(~s.v[w] & mask);
+		}
+
+		return lcs;
+	}
+
+private:
+	uint64_t match_[NO_OF_CHARS][MAX_STR / 64];
+	char_set in_str1_;
+	size_t length_;
+	int words_;
+};
+
+/// length of the longest common subsequence of two strings, ignoring case
+static int lcs_length(std::string_view str1, std::string_view str2) {
+	const lcs_matcher matcher(str1);
+	lcs_matcher::state s;
+	matcher.start(s);
+
+	for (char c : str2)
+		matcher.step(s, c);
+
+	return matcher.length(s);
+}
 
-	size_t len1 = strlen(str1), len2 = strlen(str2);
-	float lenLCS;
-	unsigned j, k, * previous, * next;
+/// similarity as a percentage, from the sets of (uppercase) characters of two strings, their
+/// lengths and the length of their longest common subsequence
+static float similarity(const char_set& set1, const char_set& set2, size_t len1, size_t len2,
+	int lcs) {
+	// check if strings have same letters (method A)
+	const int distinct = set1.count() + set2.count();
+	float similarity = 2 * float(set1.count_common(set2)) / float(distinct);
+
+	// check similarity (method B)
 	if (len1 == 0 || len2 == 0)
 		return 0;
-	previous = (unsigned*)calloc(len1 + 1, sizeof(unsigned));
-	next = (unsigned*)calloc(len1 + 1, sizeof(unsigned));
-	for (j = 0; j < len2; ++j) {
-		for (k = 1; k <= len1; ++k)
-			if (str1[k - 1] == str2[j])
-				next[k] = previous[k - 1] + 1;
-			else next[k] = previous[k] >= next[k - 1] ? previous[k] : next[k - 1];
-		swap(&previous, &next);
-	}
-	lenLCS = (float)previous[len1];
-	free(previous);
-	free(next);
+
+	float lenLCS = (float)lcs;
 
 	float similarity_2 = lenLCS /= len1;
 	return 100 * (2 * similarity / 3 + 1 * similarity_2 / 3);
 }
 
-/// password strength (version 5)
-/// scale 0-100
-/// also checks dictionary file in resource
-int password_strength(const std::string& username, const std::string& password, std::vector<std::string>& issues)
-{
-	if (password.empty())
-		return 0;
+/// A function which returns how similar 2 strings are, ignoring case
+/// Returns the similarity between them as a percentage
+/// does not allocate
+float similarity(std::string_view str1, std::string_view str2) {
+	str1 = rated_part(str1);
+	str2 = rated_part(str2);
 
-	double strength = 0;
+	char_set set1, set2;
 
-	// adjust strength based on similarity with username
-	float similarity_ = similarity(username, password);
+	for (char c : str1)
+		set1.add(upper(c));
 
-	if (similarity_ > 50) {
-		// high similarity, lower strength proportionally
-		strength = -int(similarity_ - 50);
-		issues.push_back("Username and password too similar");
-	}
+	for (char c : str2)
+		set2.add(upper(c));
 
-	int length = (int)password.length();
+	return similarity(set1, set2, str1.length(), str2.length(), lcs_length(str1, str2));
+}
 
-	// number of items of each type
+// scratch space kept from one rating to the next, so that rating many passwords does
+// not allocate for every password
+struct password_scratch {
+	std::vector<dictionary_match> matches;
+	std::vector<bool> covered;
+};
+
+// what the classic rules look at in a password
+struct password_features {
+	float similarity = 0;		// with the username, as a percentage
+	int length = 0;
 	int hits_lower = 0;
 	int hits_upper = 0;
 	int hits_digit = 0;
-	int hits_special = 0;
+	int duplicates = 0;			// number of duplicated characters
+	int in_dictionary = 0;		// the result of dictionary::SearchInDict
+	int hits_covered = 0;		// number of characters that are part of dictionary words
+	bool leet = false;			// some of the dictionary words are spelt with substitutions
+};
 
-	for (int i = 0; i < length; i++) {
-		const char char_ = password[i];
-		if (islower(char_)) hits_lower++;
-		if (isupper(char_)) hits_upper++;
-		if (isdigit(char_)) hits_digit++;
-	}
+/// classic password strength from the features of a non-empty password
+static int password_strength(const password_features& f, uint32_t& issues) {
+	using namespace liblec::cui;
 
-	hits_special = length - (hits_lower + hits_upper + hits_digit);
+	issues = 0;
+	double strength = 0;
 
-	if (hits_lower < 3) {
-		if (hits_lower == 0)
-			issues.push_back("No lowercase characters");
-		else
-			issues.push_back("Few lowercase characters");
+	// adjust strength based on similarity with username
+	if (f.similarity > 50) {
+		// high similarity, lower strength proportionally
+		strength = -int(f.similarity - 50);
+		issues |= password_issue::too_similar;
 	}
 
-	if (hits_upper < 3) {
-		if (hits_upper == 0)
-			issues.push_back("No uppercase characters");
-		else
-			issues.push_back("Few uppercase characters");
-	}
+	// number of items of each type
+	const int hits_lower = f.hits_lower;
+	const int hits_upper = f.hits_upper;
+	const int hits_digit = f.hits_digit;
+	const int hits_special = f.length - (hits_lower + hits_upper + hits_digit);
 
-	if (hits_special < 3) {
-		if (hits_special == 0)
-			issues.push_back("No special characters");
-		else
-			issues.push_back("Few special characters");
-	}
+	if (hits_lower < 3)
+		issues |= (hits_lower == 0) ? password_issue::no_lowercase : password_issue::few_lowercase;
 
-	if (hits_digit < 3) {
-		if (hits_digit == 0)
-			issues.push_back("No digits");
-		else
-			issues.push_back("Few digits");
-	}
+	if (hits_upper < 3)
+		issues |= (hits_upper == 0) ? password_issue::no_uppercase : password_issue::few_uppercase;
+
+	if (hits_special < 3)
+		issues |= (hits_special == 0) ? password_issue::no_special : password_issue::few_special;
+
+	if (hits_digit < 3)
+		issues |= (hits_digit == 0) ? password_issue::no_digits : password_issue::few_digits;
 
 	// check for duplicate characters
-	int dups_ = number_of_duplicates(password);
+	const int dups_ = f.duplicates;
 
 	if (dups_ > 2)
-		issues.push_back("Duplicate characters");
+		issues |= password_issue::duplicates;
 
 	// make calculations ////////////////////////////////////////////////////////////////////////
 
@@ -195,36 +277,118 @@ int password_strength(const std::string& username, const std::string& password,
 	if (strength > 100) strength = 100;
 
 	// check if word is in the dictionary
-
-	// load dictionary into memory
-	// NOTE: this function does nothing if the dictionary is already loaded into memory
-	dictionary::LoadDict();
-
-	const std::wstring sPassWrd = std::wstring(password.begin(), password.end());
-	int iRes = dictionary::SearchInDict(sPassWrd, false);
-
-	if (iRes == 1) {
+	if (f.in_dictionary == 1) {
 		strength = strength / 3;
-		issues.clear();
-		issues.push_back("Password vulnerable to dictionary attack");
+		issues = password_issue::dictionary_attack;
 	}
 	else
-		if (iRes == -1) {
+		if (f.in_dictionary == -1) {
 			strength = 0;
-			issues.clear();
-			issues.push_back("Failed to open dictionary resource");
+			issues = password_issue::no_dictionary;
 		}
+		else
+			if (f.hits_covered > 0) {
+				// lower strength in proportion to the share of the password made up of
+				// dictionary words, down to a third, as for a password that is a dictionary word
+				strength = strength * (1 - (2.0 / 3.0) * f.hits_covered / f.length);
+
+				issues |= f.leet ? password_issue::dictionary_words_leet : password_issue::dictionary_words;
+			}
 
 	// end calculations /////////////////////////////////////////////////////////////////////////
 
 	return (int)(strength + 0.5);	// convert to integer
 }
 
-liblec::cui::password_quality liblec::cui::password_rating(const std::string& username,
-	const std::string& password) {
-	password_quality quality;
+/// password strength (version 5)
+/// scale 0-100
+/// also checks dictionary file in resource
+/// issues receives liblec::cui::password_issue flags
+int password_strength(const std::string& username, const std::string& password, uint32_t& issues,
+	password_scratch& scratch)
+{
+	issues = 0;
+
+	if (password.empty())
+		return 0;
+
+	password_features f;
+	f.similarity = similarity(username, password);
+	f.length = (int)password.length();
+
+	for (int i = 0; i < f.length; i++) {
+		const char char_ = password[i];
+		if (islower(char_)) f.hits_lower++;
+		if (isupper(char_)) f.hits_upper++;
+		if (isdigit(char_)) f.hits_digit++;
+	}
 
-	quality.strength = password_strength(username, password, quality.issues);
+	f.duplicates = number_of_duplicates(password);
+
+	// load dictionary into memory
+	// NOTE: this function does nothing if the dictionary is already loaded into memory
+	dictionary::LoadDict();
+
+	f.in_dictionary = dictionary::SearchInDict(password, false);
+
+	if (f.in_dictionary == 0) {
+		// check for dictionary words inside the password
+		auto& matches = scratch.matches;
+
+		if (dictionary::FindInDict(password, matches) > 0) {
+			// mark the characters that are part of a dictionary word
+			auto& covered = scratch.covered;
+			covered.assign(password.length(), false);
+
+			for (const auto& m : matches) {
+				for (size_t i = m.begin; i < m.begin + m.length; i++)
+					covered[i] = true;
+
+				f.leet = f.leet || m.leet;
+			}
+
+			for (size_t i = 0; i < covered.size(); i++)
+				if (covered[i]) f.hits_covered++;
+		}
+	}
+
+	return password_strength(f, issues);
+}
+
+std::vector<std::string> liblec::cui::password_issues(uint32_t issues) {
+	static const char* descriptions[] = {
+		"Username and password too similar",
+		"No lowercase characters",
+		"Few lowercase characters",
+		"No uppercase characters",
+		"Few uppercase characters",
+		"No special characters",
+		"Few special characters",
+		"No digits",
+		"Few digits",
+		"Duplicate characters",
+		"Dictionary words",
+		"Dictionary words with common substitutions",
+		"Password vulnerable to dictionary attack",
+		"Failed to open dictionary resource",
+		"Keyboard patterns",
+		"Repeated characters",
+		"Sequences",
+		"Dates or years",
+	};
+
+	std::vector<std::string> issues_;
+
+	for (size_t i = 0; i < sizeof(descriptions) / sizeof(descriptions[0]); i++)
+		if (issues & (1u << i))
+			issues_.push_back(descriptions[i]);
+
+	return issues_;
+}
+
+/// set the issues and the summaries of a rating from its strength and issue flags
+static void set_summaries(liblec::cui::password_quality& quality, uint32_t issues, bool empty) {
+	quality.issues = liblec::cui::password_issues(issues);
 
 	for (size_t i = 0; i < quality.issues.size(); i++) {
 		const auto s = quality.issues[i];
@@ -235,7 +399,7 @@ liblec::cui::password_quality liblec::cui::password_rating(const std::string& us
 			quality.issues_summary += ", " + s;
 	}
 
-	if (!password.empty()) {
+	if (!empty) {
 		quality.rating_summary = "Strength = " + std::to_string(quality.strength) + "%";
 
 		if (quality.strength < 20)
@@ -259,6 +423,361 @@ liblec::cui::password_quality liblec::cui::password_rating(const std::string& us
 			}
 		}
 	}
+}
+
+liblec::cui::password_quality liblec::cui::password_rating(const std::string& username,
+	const std::string& password) {
+	return password_rating(username, password, password_engine::classic);
+}
+
+liblec::cui::password_quality liblec::cui::password_rating(const std::string& username,
+	const std::string& password, password_engine engine) {
+	password_quality quality;
+
+	uint32_t issues = 0;
+
+	if (engine == password_engine::entropy) {
+		dictionary::LoadDict();
+
+		password_entropy::scratch scratch;
+		quality.guesses_log10 = password_entropy::guesses_log10(username, password, issues, scratch);
+		quality.strength = password_entropy::strength(quality.guesses_log10);
+	}
+	else {
+		password_scratch scratch;
+		quality.strength = password_strength(username, password, issues, scratch);
+	}
+
+	set_summaries(quality, issues, password.empty());
+
+	return quality;
+}
+
+liblec::cui::password_batch_quality liblec::cui::password_rating_batch(const password_pair* pairs,
+	size_t count, unsigned thread_count) {
+	password_batch_quality quality;
+
+	if (pairs == nullptr || count == 0)
+		return quality;
+
+	quality.strength.resize(count);
+	quality.issues.resize(count);
+
+	// load the dictionary before the workers start
+	dictionary::LoadDict();
+
+	if (thread_count == 0)
+		thread_count = std::thread::hardware_concurrency();
+
+	if (thread_count == 0)
+		thread_count = 1;
+
+	// the pairs are handed out in chunks so that threads that finish early pick up more work,
+	// and so that each thread writes to its own stretch of the results
+	const size_t chunk = 256;
+	const size_t chunks = (count + chunk - 1) / chunk;
+
+	if (thread_count > chunks)
+		thread_count = unsigned(chunks);
+
+	std::atomic<size_t> next_chunk(0);
+
+	auto worker = [&]() {
+		password_scratch scratch;
+
+		for (;;) {
+			const size_t c = next_chunk.fetch_add(1, std::memory_order_relaxed);
+
+			if (c >= chunks)
+				break;
+
+			const size_t end = (c + 1) * chunk < count ? (c + 1) * chunk : count;
+
+			for (size_t i = c * chunk; i < end; i++) {
+				uint32_t issues = 0;
+				quality.strength[i] = (uint8_t)password_strength(pairs[i].username, pairs[i].password,
+					issues, scratch);
+				quality.issues[i] = issues;
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+
+	for (unsigned i = 1; i < thread_count; i++)
+		threads.emplace_back(worker);
+
+	// the calling thread does its share
+	worker();
+
+	for (auto& it : threads)
+		it.join();
+
+	return quality;
+}
+
+liblec::cui::password_batch_quality liblec::cui::password_rating_batch(
+	const std::vector<password_pair>& pairs, unsigned thread_count) {
+	return password_rating_batch(pairs.data(), pairs.size(), thread_count);
+}
+
+class liblec::cui::password_rater::password_rater_impl {
+public:
+	password_rater_impl(const std::string& username) {
+		// load dictionary into memory
+		// NOTE: this function does nothing if the dictionary is already loaded into memory
+		dictionary::LoadDict();
+		automaton_ = dictionary::GetAutomaton();
+
+		cursors_.emplace_back();
+		match_counts_.push_back(0);
+		lcs_.emplace_back();
+		set_username(username);
+	}
+
+	void set_username(const std::string& username) {
+		username_ = std::string(rated_part(username));
+
+		username_set_ = char_set();
+
+		for (char c : username_)
+			username_set_.add(upper(c));
+
+		matcher_.reset(new lcs_matcher(username_));
+
+		// run the rated part of the password through the new matcher
+		const size_t rated = lcs_.size() - 1;
+		lcs_.resize(1);
+		matcher_->start(lcs_[0]);
+
+		for (size_t k = 0; k < rated; k++) {
+			lcs_.push_back(lcs_.back());
+			matcher_->step(lcs_.back(), password_[k]);
+		}
+	}
+
+	void push_back(char c) {
+		const size_t pos = password_.length();
+		password_.push_back(c);
+
+		if (islower(c)) hits_lower_++;
+		if (isupper(c)) hits_upper_++;
+		if (isdigit(c)) hits_digit_++;
+
+		// the rated part stops at the first null character (see rated_part)
+		if (c == '\0' && first_nul_ == std::string::npos)
+			first_nul_ = pos;
+
+		if (rated(pos)) {
+			if (counts_[(unsigned char)c]++ == 0)
+				distinct_++;
+
+			if (upper_counts_[upper(c)]++ == 0)
+				password_set_.add(upper(c));
+
+			lcs_.push_back(lcs_.back());
+			matcher_->step(lcs_.back(), c);
+		}
+
+		// dictionary words ending at this character
+		covered_at_.push_back(-1);
+		cursors_.push_back(cursors_.back());
+
+		if (automaton_)
+			automaton_->step(cursors_.back(), c, pos, matches_);
+
+		for (size_t m = match_counts_.back(); m < matches_.size(); m++) {
+			for (size_t i = matches_[m].begin; i <= pos; i++) {
+				if (covered_at_[i] < 0) {
+					covered_at_[i] = int32_t(pos);
+					hits_covered_++;
+				}
+			}
+
+			if (matches_[m].leet)
+				leet_matches_++;
+		}
+
+		match_counts_.push_back(matches_.size());
+	}
+
+	void pop_back() {
+		if (password_.empty())
+			return;
+
+		const size_t pos = password_.length() - 1;
+		const char c = password_[pos];
+
+		if (islower(c)) hits_lower_--;
+		if (isupper(c)) hits_upper_--;
+		if (isdigit(c)) hits_digit_--;
+
+		if (rated(pos)) {
+			if (--counts_[(unsigned char)c] == 0)
+				distinct_--;
+
+			if (--upper_counts_[upper(c)] == 0)
+				password_set_.remove(upper(c));
+
+			lcs_.pop_back();
+		}
+
+		if (first_nul_ == pos)
+			first_nul_ = std::string::npos;
+
+		// uncover the characters that only the words ending at this character covered; no
+		// word is longer than the automaton's longest word
+		match_counts_.pop_back();
+
+		for (size_t m = match_counts_.back(); m < matches_.size(); m++)
+			if (matches_[m].leet)
+				leet_matches_--;
+
+		matches_.resize(match_counts_.back());
+		cursors_.pop_back();
+
+		const size_t reach = dictionary_automaton::max_length;
+
+		for (size_t i = pos + 1 > reach ? pos + 1 - reach : 0; i <= pos; i++) {
+			if (covered_at_[i] == int32_t(pos)) {
+				covered_at_[i] = -1;
+				hits_covered_--;
+			}
+		}
+
+		covered_at_.pop_back();
+		password_.pop_back();
+	}
+
+	const std::string& password() const {
+		return password_;
+	}
+
+	int strength(uint32_t& issues) const {
+		issues = 0;
+
+		if (password_.empty())
+			return 0;
+
+		password_features f;
+		f.similarity = similarity(username_set_, password_set_, username_.length(), lcs_.size() - 1,
+			matcher_->length(lcs_.back()));
+		f.length = (int)password_.length();
+		f.hits_lower = hits_lower_;
+		f.hits_upper = hits_upper_;
+		f.hits_digit = hits_digit_;
+		f.duplicates = f.length - distinct_;
+		f.in_dictionary = dictionary::SearchInDict(password_, false);
+		f.hits_covered = hits_covered_;
+		f.leet = leet_matches_ > 0;
+
+		return password_strength(f, issues);
+	}
+
+private:
+	/// whether the character at pos is part of the rated part of the password
+	bool rated(size_t pos) const {
+		return pos < MAX_STR - 1 && pos < first_nul_;
+	}
+
+	std::string username_;			// rated part of the username
+	char_set username_set_;			// its characters, in uppercase
+	std::unique_ptr<lcs_matcher> matcher_;
+	const dictionary_automaton* automaton_ = nullptr;
+
+	std::string password_;
+	size_t first_nul_ = std::string::npos;
+	int hits_lower_ = 0;
+	int hits_upper_ = 0;
+	int hits_digit_ = 0;
+
+	// characters of the rated part of the password
+	uint16_t counts_[NO_OF_CHARS] = { 0 };
+	uint16_t upper_counts_[NO_OF_CHARS] = { 0 };
+	int distinct_ = 0;
+	char_set password_set_;
+
+	// state after each prefix of the password, so that the last character can be removed;
+	// entry k is the state after k characters (of the rated part, for lcs_)
+	std::vector<lcs_matcher::state> lcs_;
+	std::vector<dictionary_automaton::cursor> cursors_;
+	std::vector<size_t> match_counts_;
+
+	std::vector<dictionary_match> matches_;
+	std::vector<int32_t> covered_at_;	// the character whose words first covered each character, or -1
+	int hits_covered_ = 0;
+	int leet_matches_ = 0;
+};
+
+liblec::cui::password_rater::password_rater() :
+	password_rater(std::string()) {}
+
+liblec::cui::password_rater::password_rater(const std::string& username) {
+	d_ = new password_rater_impl(username);
+}
+
+liblec::cui::password_rater::~password_rater() {
+	if (d_) {
+		delete d_;
+		d_ = nullptr;
+	}
+}
+
+void liblec::cui::password_rater::set_username(const std::string& username) {
+	d_->set_username(username);
+}
+
+void liblec::cui::password_rater::push_back(char c) {
+	d_->push_back(c);
+}
+
+void liblec::cui::password_rater::pop_back() {
+	d_->pop_back();
+}
+
+void liblec::cui::password_rater::assign(const std::string& password) {
+	const std::string& current = d_->password();
+
+	// keep the part the two passwords have in common
+	size_t common = 0;
+
+	while (common < current.length() && common < password.length() &&
+		current[common] == password[common])
+		common++;
+
+	while (current.length() > common)
+		d_->pop_back();
+
+	for (size_t i = common; i < password.length(); i++)
+		d_->push_back(password[i]);
+}
+
+void liblec::cui::password_rater::clear() {
+	assign(std::string());
+}
+
+const std::string& liblec::cui::password_rater::password() const {
+	return d_->password();
+}
+
+int liblec::cui::password_rater::strength() const {
+	uint32_t issues = 0;
+	return d_->strength(issues);
+}
+
+uint32_t liblec::cui::password_rater::issues() const {
+	uint32_t issues = 0;
+	d_->strength(issues);
+	return issues;
+}
+
+liblec::cui::password_quality liblec::cui::password_rater::quality() const {
+	password_quality quality;
+
+	uint32_t issues = 0;
+	quality.strength = d_->strength(issues);
+
+	set_summaries(quality, issues, d_->password().empty());
 
 	return quality;
 }
@@ -10,5 +10,5 @@
 
 #pragma once
 
-#define TEXTFILE	120	// custom type definition for text file
-#define IDTXT_DICT	121	// dictionary text file resource
+#define BINFILE		122	// custom type definition for binary file
+#define IDBIN_DICT	123	// compiled dictionary resource
@@ -0,0 +1,239 @@
+//
+// chart_axis_test.cpp - CChartAxis over extreme ranges
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "test.h"
+#include "cui_raw/cui_rawImpl/CChartAxis/CChartAxis.h"
+
+#include <cfloat>
+#include <limits>
+#include <cmath>
+#include <random>
+#include <set>
+#include <algorithm>
+
+namespace
+{
+	int iFailures = 0;
+
+	void report(const char *sWhat, double dLowest, double dHighest, int iMaxLines, const CChartAxis &axis)
+	{
+		if (iFailures++ < 10)
+			std::printf("%s: %.17g .. %.17g, %d lines -> [%.17g, %.17g] step %.17g, %d lines\n",
+				sWhat, dLowest, dHighest, iMaxLines, axis.Lower(), axis.Upper(), axis.Step(), axis.Lines());
+	}
+
+	// what any fitted axis must be
+	bool fits(double dLowest, double dHighest, int iMaxLines)
+	{
+		CChartAxis axis;
+
+		if (!axis.Calculate(dLowest, dHighest, iMaxLines))
+		{
+			report("not fitted", dLowest, dHighest, iMaxLines, axis);
+			return false;
+		}
+
+		const double dLow = std::min(dLowest, dHighest), dHigh = std::max(dLowest, dHighest);
+		const int iLines = axis.Lines();
+		bool bOk = true;
+
+		// within the line count, covering the values
+		bOk = bOk && iLines >= 1 && iLines <= std::max(iMaxLines, 1);
+		bOk = bOk && axis.Lower() <= dLow && axis.Upper() >= dHigh;
+		bOk = bOk && std::isfinite(axis.Lower()) && std::isfinite(axis.Upper());
+		bOk = bOk && axis.Step() > 0 && std::isfinite(axis.Step());
+
+		// a single value sits inside the axis, not on its edge, unless it is the largest
+		// double
+		if (dLow == dHigh && std::fabs(dLow) < DBL_MAX)
+			bOk = bOk && axis.Lower() < dLow && axis.Upper() > dHigh;
+
+		// not much looser than the values, give or take a step at each end
+		if (dLow != dHigh)
+			bOk = bOk && (axis.Upper() - axis.Lower()) / 5 <= (dHigh - dLow) + 2 * axis.Step() / 5;
+
+		// the gridlines go up from the lower limit to the upper one, all finite and labelled
+		std::set<std::wstring> labels;
+
+		for (int i = 0; i <= iLines; i++)
+		{
+			bOk = bOk && std::isfinite(axis.Value(i)) && !axis.Label(i).empty();
+			bOk = bOk && (i == 0 || axis.Value(i) >= axis.Value(i - 1));
+
+			// no -0 labels
+			bOk = bOk && !(axis.Value(i) == 0 && axis.Label(i)[0] == L'-');
+			labels.insert(axis.Label(i));
+		}
+
+		// the limits are the first and last gridlines, with a limit next to nothing shown as
+		// zero
+		bOk = bOk && (axis.Value(0) == axis.Lower() ||
+			(axis.Value(0) == 0 && std::fabs(axis.Lower()) * 1e9 < axis.Step()));
+		bOk = bOk && (axis.Value(iLines) == axis.Upper() ||
+			(axis.Value(iLines) == 0 && std::fabs(axis.Upper()) * 1e9 < axis.Step()));
+		bOk = bOk && axis.Label(-1).empty() && axis.Label(iLines + 1).empty();
+
+		// the labels tell the gridlines apart, unless the step is below the 15 decimal
+		// places of the labels
+		const double dMagnitude = std::max(std::fabs(axis.Lower()), std::fabs(axis.Upper()));
+
+		if (axis.Step() > dMagnitude * 1e-13)
+			bOk = bOk && labels.size() == size_t(iLines) + 1;
+
+		if (!bOk)
+			report("bad axis", dLowest, dHighest, iMaxLines, axis);
+
+		return bOk;
+	}
+}
+
+int main()
+{
+	// zero span
+	CHECK(fits(0, 0, 10));
+	CHECK(fits(5, 5, 10));
+	CHECK(fits(-3, -3, 10));
+	CHECK(fits(1e300, 1e300, 10));
+	CHECK(fits(-1e-300, -1e-300, 10));
+	CHECK(fits(7, 7, 1));
+	CHECK(fits(7, 7, 1000));
+
+	{
+		CChartAxis axis;
+		CHECK(axis.Calculate(0, 0, 10));
+		CHECK(axis.Lower() == -1 && axis.Upper() == 1);
+	}
+
+	// negative values only: no gridline above zero
+	for (double dHigh : { -3.0, -1e-12, -1e12, -1e-300, -1e300 })
+	{
+		for (double dScale : { 1.0, 1.5, 32.0, 1e6 })
+		{
+			const double dLow = dHigh * dScale;
+			CHECK(fits(dLow, dHigh, 10));
+
+			CChartAxis axis;
+			axis.Calculate(dLow, dHigh, 10);
+			CHECK(axis.Upper() <= 0);
+		}
+	}
+
+	{
+		// the upper limit rounds up to zero from below
+		CChartAxis axis;
+		CHECK(axis.Calculate(-97, -3, 10));
+		CHECK(axis.Lower() == -100 && axis.Upper() == 0);
+		CHECK(axis.Label(axis.Lines()) == L"0.0");
+		CHECK(axis.Label(0) == L"-100.0");
+	}
+
+	// denormals, down to the smallest double, and the smallest normalized doubles
+	const double dMinDenormal = std::numeric_limits<double>::denorm_min();
+
+	CHECK(fits(0, dMinDenormal, 10));
+	CHECK(fits(dMinDenormal, dMinDenormal, 10));
+	CHECK(fits(-dMinDenormal, dMinDenormal, 10));
+	CHECK(fits(-dMinDenormal, -dMinDenormal, 10));
+	CHECK(fits(0, 1000 * dMinDenormal, 10));
+	CHECK(fits(1e-310, 3e-310, 10));
+	CHECK(fits(1e-310, 1e-310, 10));
+	CHECK(fits(DBL_MIN, DBL_MIN, 10));
+	CHECK(fits(DBL_MIN, 2 * DBL_MIN, 10));
+	CHECK(fits(0, 1e-300, 10));
+
+	{
+		CChartAxis axis;
+		CHECK(axis.Calculate(1e-310, 3e-310, 10));
+		CHECK(axis.Label(axis.Lines()).find(L"e-310") != std::wstring::npos);
+	}
+
+	// huge magnitudes, up to the largest double
+	CHECK(fits(0, DBL_MAX, 10));
+	CHECK(fits(-DBL_MAX, 0, 10));
+	CHECK(fits(DBL_MAX, DBL_MAX, 10));
+	CHECK(fits(-DBL_MAX, -DBL_MAX, 10));
+	CHECK(fits(DBL_MAX / 2, DBL_MAX, 10));
+	CHECK(fits(-1e308, 1e307, 10));
+	CHECK(fits(0, 1e308, 10));
+	CHECK(fits(1e17, 1e17 + 16, 10));
+	CHECK(fits(1e15, 1e15 + 1, 10));
+
+	// a range wider than the largest double, and values that are not finite
+	{
+		CChartAxis axis;
+		CHECK(axis.Calculate(0, 10, 10));
+
+		CHECK(!axis.Calculate(-DBL_MAX, DBL_MAX, 10));
+		CHECK(!axis.Calculate(0, INFINITY, 10));
+		CHECK(!axis.Calculate(-INFINITY, 0, 10));
+		CHECK(!axis.Calculate(NAN, 1, 10));
+
+		// left as it was
+		CHECK(axis.Lower() == 0 && axis.Upper() == 10 && axis.Lines() == 10);
+
+		CHECK(!axis.SetLimits(-DBL_MAX, DBL_MAX, 10));
+		CHECK(!axis.SetLimits(0, NAN, 10));
+		CHECK(!axis.SetLimits(0, 1, 0));
+		CHECK(axis.Lower() == 0 && axis.Upper() == 10 && axis.Lines() == 10);
+
+		CHECK(axis.SetLimits(-DBL_MAX, 0, 4));
+		CHECK(axis.Lines() == 4 && std::isfinite(axis.Value(2)));
+	}
+
+	{
+		// one interval with limits that are not multiples of the step: the labels take
+		// another decimal place to differ
+		CChartAxis axis;
+		CHECK(axis.Calculate(1.8180818590818201e-26, 1.8207283357092211e-26, 1));
+		CHECK(axis.Lines() == 1 && axis.Label(0) != axis.Label(1));
+	}
+
+	// reversed limits and line counts below one
+	CHECK(fits(1, 0, 10));
+	CHECK(fits(0, 1, 0));
+	CHECK(fits(0, 1, -5));
+
+	// random ranges over every magnitude, and every line count a chart uses
+	{
+		std::mt19937_64 rng(1);
+		std::uniform_real_distribution<double> unit(-1, 1), exponent(-320, 307);
+		bool bAll = true;
+
+		for (int i = 0; i < 300000; i++)
+		{
+			const double dMagnitude = std::pow(10, exponent(rng));
+			const double dLow = unit(rng) * dMagnitude;
+			const double dWidth = std::fabs(unit(rng)) * dMagnitude * std::pow(10, (i % 3) * exponent(rng) / 40);
+			const double dHigh = dLow + dWidth;
+
+			if (!std::isfinite(dHigh) || !std::isfinite(dHigh - dLow))
+				continue;
+
+			bAll = fits(dLow, dHigh, 1 + i % 20) && bAll;
+		}
+
+		CHECK(bAll);
+	}
+
+	// the axis is kept for the same input, and refitted for new input
+	{
+		CChartAxis axis;
+		CHECK(axis.Calculate(0, 95, 10));
+		const std::wstring *pLabel = &axis.Label(3);
+		CHECK(axis.Calculate(95, 0, 10));
+		CHECK(&axis.Label(3) == pLabel && axis.Label(3) == L"30.0");
+
+		CHECK(axis.Calculate(0, 0.95, 10));
+		CHECK(axis.Label(3) == L"0.3");
+	}
+
+	CHECK(iFailures == 0);
+	return test::result("chart_axis_test");
+}
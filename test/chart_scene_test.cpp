@@ -0,0 +1,443 @@
+//
+// chart_scene_test.cpp - layouts CChartScene builds for bar, pie and line charts
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "test.h"
+#include "cui_raw/cui_rawImpl/CChartScene/CChartScene.h"
+
+#include <cmath>
+#include <random>
+
+typedef CChartScene::rect rect;
+
+namespace
+{
+	// a monospaced font: every character is 0.6 of the font size wide and lines are 1.5 of it
+	// high; a string wider than its layout wraps onto more lines
+	int iMeasured = 0;
+
+	void measure(const std::wstring &sText, float fFontSize, float fLayoutWidth, float fLayoutHeight,
+		float &fWidth, float &fHeight)
+	{
+		iMeasured++;
+		fWidth = sText.length() * fFontSize * 0.6f;
+		fHeight = fFontSize * 1.5f;
+
+		if (fLayoutWidth > 0 && fWidth > fLayoutWidth)
+		{
+			fHeight *= std::ceil(fWidth / fLayoutWidth);
+			fWidth = fLayoutWidth;
+		}
+
+		if (fLayoutHeight > 0 && fHeight > fLayoutHeight)
+			fHeight = fLayoutHeight;
+	}
+
+	// whether a is inside b, give or take the rounding of the layout to whole pixels
+	bool inside(const rect &a, const rect &b)
+	{
+		const float e = 1.0f;
+		return a.x >= b.x - e && a.y >= b.y - e && a.right() <= b.right() + e && a.bottom() <= b.bottom() + e;
+	}
+
+	bool finite(const rect &rc)
+	{
+		return std::isfinite(rc.x) && std::isfinite(rc.y) && std::isfinite(rc.width) && std::isfinite(rc.height);
+	}
+
+	// strings are placed within their layout
+	bool placed(const CChartScene::text &t)
+	{
+		return finite(t.rcLayout) && finite(t.rcText) && (t.bVertical || inside(t.rcText, t.rcLayout));
+	}
+
+	// the legend fits the space given to it, top to bottom, one item per label, or is empty
+	bool legend_ok(const CChartScene &scene, size_t iLabels)
+	{
+		const auto &vLegend = scene.Legend();
+
+		if (vLegend.empty())
+			return true;
+
+		bool bOk = vLegend.size() == iLabels;
+
+		for (size_t i = 0; i < vLegend.size() && bOk; i++)
+		{
+			bOk = inside(vLegend[i].rcHot, scene.Frame().rcLegend) &&
+				inside(vLegend[i].rcBlock, vLegend[i].rcHot) && placed(vLegend[i].label);
+
+			if (i > 0)
+				bOk = bOk && !vLegend[i].rcHot.intersects(vLegend[i - 1].rcHot) &&
+				vLegend[i].rcHot.y > vLegend[i - 1].rcHot.y;
+		}
+
+		return bOk;
+	}
+
+	CChartScene::chart make_chart(float fWidth, float fHeight)
+	{
+		CChartScene::chart info;
+		info.fWidth = fWidth;
+		info.fHeight = fHeight;
+		info.sFontName = L"Segoe UI";
+		info.sTitle = L"Monthly totals";
+		info.sXaxisLabel = L"Month";
+		info.sYaxisLabel = L"Total";
+		return info;
+	}
+
+	std::vector<CChartScene::item> make_items(std::mt19937 &rng, size_t iCount, double dLow, double dHigh)
+	{
+		std::uniform_real_distribution<double> value(dLow, dHigh);
+		std::vector<CChartScene::item> vItems(iCount);
+
+		for (size_t i = 0; i < iCount; i++)
+		{
+			vItems[i].dValue = value(rng);
+			vItems[i].iNumber = int(i + 1);
+			vItems[i].sLabel = L"item " + std::to_wstring(i + 1);
+		}
+
+		return vItems;
+	}
+
+	int iFailures = 0;
+
+	void fail(const char *sWhat, const CChartScene::chart &info, size_t iItems)
+	{
+		if (iFailures++ < 10)
+			std::printf("%s: %gx%g, %zu items\n", sWhat, info.fWidth, info.fHeight, iItems);
+	}
+
+	void check_bar_chart(const CChartScene::chart &info, const std::vector<CChartScene::item> &vItems)
+	{
+		CChartScene scene;
+		scene.BuildBarChart(info, vItems, measure);
+
+		const CChartScene::frame &frame = scene.Frame();
+		const CChartAxis &axis = scene.Axis();
+
+		if (!scene.IsValid(info))
+			fail("not valid after building", info, vItems.size());
+
+		// the frame: the plot within the markers, everything finite
+		if (!placed(frame.title) || !placed(frame.xAxisLabel) || !placed(frame.yAxisLabel) ||
+			!finite(frame.rcPlot) || !finite(frame.rcMarkers) || !finite(frame.rcLegend))
+			fail("frame not placed", info, vItems.size());
+
+		if (frame.rcPlot.width > 0 && frame.rcPlot.height > 0 && !inside(frame.rcPlot, frame.rcMarkers))
+			fail("plot outside the markers", info, vItems.size());
+
+		if (vItems.empty())
+		{
+			if (!scene.Bars().empty() || !scene.GridLines().empty() || !scene.Legend().empty())
+				fail("empty chart with bars", info, vItems.size());
+
+			return;
+		}
+
+		// one gridline per axis value, from the bottom of the plot up to the top (all at the
+		// bottom of a plot with no height), labelled with the axis labels
+		const auto &vGridLines = scene.GridLines();
+
+		if (vGridLines.size() != size_t(axis.Lines()) + 1)
+			fail("gridline count", info, vItems.size());
+
+		for (size_t i = 0; i < vGridLines.size(); i++)
+		{
+			const auto &line = vGridLines[i];
+
+			if (line.label.sText != axis.Label(int(i)) || !placed(line.label) ||
+				(i > 0 && line.fY > vGridLines[i - 1].fY) ||
+				line.fLeft != frame.rcPlot.x || line.fRight != frame.rcPlot.right())
+				fail("gridline", info, vItems.size());
+		}
+
+		if (std::fabs(vGridLines.front().fY - frame.rcPlot.bottom()) > 0.5f ||
+			std::fabs(vGridLines.back().fY - frame.rcPlot.y) > 0.5f)
+			fail("gridlines do not span the plot", info, vItems.size());
+
+		// one bar per item, left to right within the plot, standing on its bottom, as high as
+		// its value on the axis
+		const auto &vBars = scene.Bars();
+
+		if (vBars.size() != vItems.size())
+		{
+			fail("bar count", info, vItems.size());
+			return;
+		}
+
+		for (size_t i = 0; i < vBars.size(); i++)
+		{
+			const rect &rc = vBars[i].rc;
+
+			if (!finite(rc) || rc.width < 0 || rc.height < 0 ||
+				(frame.rcPlot.width > 0 && frame.rcPlot.height > 0 && !inside(rc, frame.rcPlot)) ||
+				std::fabs(rc.bottom() - std::floor(frame.rcPlot.bottom())) > 0.5f)
+				fail("bar outside the plot", info, vItems.size());
+
+			if (i > 0 && rc.x < vBars[i - 1].rc.right())
+				fail("bars overlap", info, vItems.size());
+
+			double dRatio = (vItems[i].dValue - axis.Lower()) / (axis.Upper() - axis.Lower());
+			dRatio = std::fmax(0, std::fmin(1, dRatio));
+
+			if (std::fabs(rc.height - dRatio * frame.rcPlot.height) > 1.0)
+				fail("bar height", info, vItems.size());
+
+			if (vBars[i].sTooltip != vItems[i].sLabel + L" - " + CChartAxis::Format(vItems[i].dValue, 1))
+				fail("bar tooltip", info, vItems.size());
+		}
+
+		// the category labels are all there, under their bars, or none are
+		const auto &vCategories = scene.Categories();
+
+		if (!vCategories.empty())
+		{
+			if (vCategories.size() != vItems.size())
+				fail("category count", info, vItems.size());
+
+			for (size_t i = 0; i < vCategories.size() && i < vBars.size(); i++)
+				if (vCategories[i].sText != std::to_wstring(vItems[i].iNumber) || !placed(vCategories[i]) ||
+					vCategories[i].rcLayout.y < frame.rcPlot.bottom() - 1)
+					fail("category label", info, vItems.size());
+		}
+
+		if (!legend_ok(scene, vItems.size()))
+			fail("bar chart legend", info, vItems.size());
+	}
+
+	void check_pie_chart(const CChartScene::chart &info, const std::vector<CChartScene::item> &vItems)
+	{
+		CChartScene scene;
+		scene.BuildPieChart(info, vItems, measure);
+
+		const CChartScene::pie &pie = scene.Pie();
+
+		if (pie.vSlices.size() != vItems.size())
+		{
+			fail("slice count", info, vItems.size());
+			return;
+		}
+
+		// a square to the left of the legend
+		if (pie.rc.width != pie.rc.height || !finite(pie.rc) ||
+			(pie.rc.width > 0 && pie.rc.right() > scene.Frame().rcLegend.x + 0.5f))
+			fail("pie placement", info, vItems.size());
+
+		double dTotal = 0;
+		bool bNegative = false;
+
+		for (const auto &it : vItems)
+		{
+			dTotal += it.dValue;
+			bNegative = bNegative || it.dValue < 0;
+		}
+
+		if (pie.bEmpty != !(dTotal > 0))
+			fail("empty pie", info, vItems.size());
+
+		// clockwise from the top, each slice starting where the last one ended, all the way
+		// round when no value is negative
+		double dSweep = 0;
+
+		for (size_t i = 0; i < pie.vSlices.size(); i++)
+		{
+			if (std::fabs(pie.vSlices[i].fAngle - (270 + dSweep)) > 0.01)
+				fail("slice angle", info, vItems.size());
+
+			dSweep += pie.vSlices[i].fSweep;
+		}
+
+		if (!pie.bEmpty && !bNegative && std::fabs(dSweep - 360) > 0.1)
+			fail("slices do not add up", info, vItems.size());
+
+		if (pie.bEmpty && dSweep != 0)
+			fail("empty pie with slices", info, vItems.size());
+
+		if (!legend_ok(scene, vItems.size()))
+			fail("pie chart legend", info, vItems.size());
+	}
+}
+
+int main()
+{
+	std::mt19937 rng(3);
+
+	// random sizes, item counts and values, positive, negative and mixed
+	for (int i = 0; i < 5000; i++)
+	{
+		const CChartScene::chart info = make_chart(float(150 + rng() % 1500), float(100 + rng() % 900));
+		const size_t iCount = rng() % 60;
+
+		const double ranges[][2] = { { 0, 1e4 }, { -1e3, 1e4 }, { -500, -1 }, { 1e-6, 2e-6 }, { 1e12, 1e15 } };
+		const auto &range = ranges[i % 5];
+
+		const auto vItems = make_items(rng, iCount, range[0], range[1]);
+		check_bar_chart(info, vItems);
+		check_pie_chart(info, vItems);
+	}
+
+	// controls smaller than their frame, and empty ones: nothing is laid out of bounds or
+	// not a number
+	for (float fWidth : { 0.0f, 1.0f, 10.0f, 60.0f })
+		for (float fHeight : { 0.0f, 1.0f, 10.0f, 40.0f })
+			for (size_t iCount : { size_t(0), size_t(1), size_t(5) })
+			{
+				const auto vItems = make_items(rng, iCount, 0, 100);
+				check_bar_chart(make_chart(fWidth, fHeight), vItems);
+				check_pie_chart(make_chart(fWidth, fHeight), vItems);
+			}
+
+	// equal values, one value, zeros
+	{
+		std::vector<CChartScene::item> vItems = make_items(rng, 4, 0, 1);
+
+		for (auto &it : vItems)
+			it.dValue = 42;
+
+		check_bar_chart(make_chart(800, 400), vItems);
+		check_pie_chart(make_chart(800, 400), vItems);
+
+		for (auto &it : vItems)
+			it.dValue = 0;
+
+		check_bar_chart(make_chart(800, 400), vItems);
+		check_pie_chart(make_chart(800, 400), vItems);
+
+		CChartScene scene;
+		scene.BuildPieChart(make_chart(800, 400), vItems, measure);
+		CHECK(scene.Pie().bEmpty);
+	}
+
+	// fixed limits instead of autoscaling
+	{
+		CChartScene::chart info = make_chart(800, 400);
+		info.bAutoScale = false;
+		info.dLowerLimit = -50;
+		info.dUpperLimit = 150;
+
+		const auto vItems = make_items(rng, 10, -100, 200);
+		check_bar_chart(info, vItems);
+
+		CChartScene scene;
+		scene.BuildBarChart(info, vItems, measure);
+		CHECK(scene.Axis().Lower() == -50 && scene.Axis().Upper() == 150 && scene.Axis().Lines() == 10);
+
+		// values past the limits are cut off at the edges of the plot
+		for (size_t i = 0; i < vItems.size(); i++)
+		{
+			const rect &rc = scene.Bars()[i].rc;
+
+			if (vItems[i].dValue <= -50)
+				CHECK(rc.height == 0);
+
+			if (vItems[i].dValue >= 150)
+				CHECK(std::fabs(rc.height - scene.Frame().rcPlot.height) <= 1);
+		}
+	}
+
+	// the legend is left out when its items don't all fit
+	{
+		const auto vItems = make_items(rng, 100, 0, 1);
+		CChartScene scene;
+		scene.BuildBarChart(make_chart(800, 300), vItems, measure);
+		CHECK(scene.Legend().empty());
+		CHECK(scene.Bars().size() == 100);
+
+		scene.BuildBarChart(make_chart(800, 300), make_items(rng, 3, 0, 1), measure);
+		CHECK(scene.Legend().size() == 3);
+	}
+
+	// the category labels are left out when the bar numbers don't all fit under the bars
+	{
+		CChartScene scene;
+		scene.BuildBarChart(make_chart(400, 300), make_items(rng, 200, 0, 1), measure);
+		CHECK(scene.Categories().empty());
+
+		scene.BuildBarChart(make_chart(1600, 300), make_items(rng, 5, 0, 1), measure);
+		CHECK(scene.Categories().size() == 5);
+	}
+
+	// a line chart: the frame and one legend item per series
+	{
+		const std::vector<std::wstring> vSeries = { L"cpu", L"memory", L"disk" };
+		const CChartScene::chart info = make_chart(900, 500);
+
+		CChartScene scene;
+		scene.BuildLineChart(info, vSeries, measure);
+
+		CHECK(scene.IsValid(info));
+		CHECK(legend_ok(scene, vSeries.size()) && scene.Legend().size() == 3);
+		CHECK(scene.Legend()[1].label.sText == L"memory");
+		CHECK(scene.Bars().empty() && scene.GridLines().empty());
+		CHECK(placed(scene.Frame().title) && scene.Frame().title.sText == info.sTitle);
+	}
+
+	// the scene is valid for the size and fonts it was built for, and not for others; the
+	// data is not compared, the chart rebuilds for that itself
+	{
+		const CChartScene::chart info = make_chart(640, 480);
+
+		CChartScene scene;
+		CHECK(!scene.IsValid(info));
+
+		scene.BuildBarChart(info, make_items(rng, 5, 0, 1), measure);
+		CHECK(scene.IsValid(info));
+
+		CChartScene::chart other = info;
+		other.fWidth += 1;
+		CHECK(!scene.IsValid(other));
+
+		other = info;
+		other.fHeight -= 1;
+		CHECK(!scene.IsValid(other));
+
+		other = info;
+		other.fFontSize += 1;
+		CHECK(!scene.IsValid(other));
+
+		other = info;
+		other.dFontScale = 1.25;
+		CHECK(!scene.IsValid(other));
+
+		other = info;
+		other.sFontName = L"Arial";
+		CHECK(!scene.IsValid(other));
+
+		other = info;
+		other.sTitle = L"another title";
+		CHECK(scene.IsValid(other));
+
+		// a rebuild for a new size measures the strings again
+		iMeasured = 0;
+		scene.BuildBarChart(make_chart(800, 600), make_items(rng, 5, 0, 1), measure);
+		CHECK(iMeasured > 0);
+		CHECK(scene.IsValid(make_chart(800, 600)) && !scene.IsValid(info));
+	}
+
+	// rectangles with no area overlap nothing
+	{
+		rect a, b;
+		a.width = a.height = 10;
+		b.x = b.y = 5;
+		b.width = b.height = 10;
+		CHECK(a.intersects(b) && b.intersects(a));
+
+		b.x = 10;
+		CHECK(!a.intersects(b));
+
+		b.x = 5;
+		b.width = 0;
+		CHECK(!a.intersects(b));
+	}
+
+	CHECK(iFailures == 0);
+	return test::result("chart_scene_test");
+}
@@ -0,0 +1,263 @@
+//
+// date_gen_test.cpp - the integer date_gen calendar against the old mktime path
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "test.h"
+#include "cui.h"
+#include "reference/date_gen.h"
+#include "time_stamp/civil_date.h"
+
+#include <cstdlib>
+#include <random>
+
+namespace date_gen = liblec::cui::date_gen;
+using date_gen::date;
+
+namespace
+{
+	using old_date = reference::date_gen::date;
+
+	bool operator==(const date &a, const date &b)
+	{
+		return a.day == b.day && a.month == b.month && a.year == b.year;
+	}
+
+	bool operator==(const date &a, const old_date &b)
+	{
+		return a.day == b.day && a.month == b.month && a.year == b.year;
+	}
+
+	old_date to_old(const date &dt)
+	{
+		return old_date{ dt.day, dt.month, dt.year };
+	}
+
+	void set_time_zone(const char *sZone)
+	{
+		setenv("TZ", sZone, 1);
+		tzset();
+	}
+
+	int iMismatches = 0;
+
+	void report(const char *sWhat, const date &dt)
+	{
+		if (iMismatches++ < 10)
+			std::printf("%s differs for %04d-%02d-%02d\n", sWhat, dt.year, dt.month, dt.day);
+	}
+
+	// every function of the old path against the new one for a date
+	void compare(const date &dt)
+	{
+		const old_date dt_ = to_old(dt);
+
+		if (date_gen::day_of_week(dt) != reference::date_gen::day_of_week(dt_))
+			report("day_of_week", dt);
+
+		if (!(date_gen::last_day_of_month(dt) == reference::date_gen::last_day_of_month(dt_)))
+			report("last_day_of_month", dt);
+
+		date start, end;
+		old_date start_, end_;
+
+		date_gen::get_week(dt, start, end);
+		reference::date_gen::get_week(dt_, start_, end_);
+
+		if (!(start == start_ && end == end_))
+			report("get_week", dt);
+
+		date_gen::get_month(dt, start, end);
+		reference::date_gen::get_month(dt_, start_, end_);
+
+		if (!(start == start_ && end == end_))
+			report("get_month", dt);
+
+		for (int n : { -400, -366, -31, -1, 0, 1, 27, 59, 365, 1000 })
+		{
+			date a = dt;
+			old_date b = dt_;
+			date_gen::add_days(a, n);
+			reference::date_gen::add_days(b, n);
+
+			if (!(a == b))
+				report("add_days", dt);
+		}
+	}
+}
+
+int main()
+{
+	// under UTC local midnight always exists, and the old path is exact
+	set_time_zone("UTC");
+
+	// days_from_civil is the day number mktime gives, for every day of 1900 - 2200, with the
+	// days 0 and 29 - 32 that mktime normalizes into the next or previous month
+	int iDays = 0;
+
+	for (int iYear = 1900; iYear <= 2200; iYear++)
+		for (int iMonth = 1; iMonth <= 12; iMonth++)
+			for (int iDay = 0; iDay <= 32; iDay++)
+			{
+				std::tm time_in = { 0, 0, 0, iDay, iMonth - 1, iYear - 1900 };
+				const std::time_t time_temp = std::mktime(&time_in);
+				const int days = civil_date::days_from_civil(iYear, iMonth, iDay);
+
+				CHECK(std::time_t(days) * 86400 == time_temp);
+				CHECK(civil_date::weekday_from_days(days) == time_in.tm_wday);
+
+				const auto c = civil_date::civil_from_days(days);
+				CHECK(c.year == time_in.tm_year + 1900 && c.month == time_in.tm_mon + 1 &&
+					c.day == time_in.tm_mday);
+
+				compare(date{ iDay, iMonth, iYear });
+				iDays++;
+			}
+
+	CHECK(iDays == 301 * 12 * 33);
+
+	// for_each_day and days_between walk the same days add_days steps through
+	{
+		const date first{ 1, 1, 1900 };
+		int n = 0;
+		bool bSame = true;
+
+		date_gen::for_each_day(first, date{ 31, 12, 2200 }, [&](const date &dt)
+		{
+			old_date expected = to_old(first);
+			reference::date_gen::add_days(expected, n);
+			bSame = bSame && dt == expected && date_gen::days_between(first, dt) == n;
+			n++;
+		});
+
+		CHECK(bSame);
+		CHECK(n == civil_date::days_from_civil(2201, 1, 1) - civil_date::days_from_civil(1900, 1, 1));
+	}
+
+	CHECK(iMismatches == 0);
+
+	// the formatting and parsing write what the old std::to_string and atoi code wrote
+	{
+		int iDifferent = 0;
+
+		for (int iYear = -200; iYear <= 12000; iYear += (iYear > 100 && iYear < 9900) ? 7 : 1)
+			for (int iMonth = -3; iMonth <= 101; iMonth++)
+				for (int iDay : { -11, -1, 0, 1, 9, 10, 31, 99, 100, 123 })
+					iDifferent += date_gen::to_string(date{ iDay, iMonth, iYear }) !=
+					reference::date_gen::to_string(old_date{ iDay, iMonth, iYear });
+
+		CHECK(iDifferent == 0);
+
+		std::mt19937 rng(5);
+		const char sAlphabet[] = " \t\n-+0123456789a\0x";
+		iDifferent = 0;
+
+		for (int i = 0; i < 500000; i++)
+		{
+			std::string s(rng() % 12, ' ');
+
+			for (auto &c : s)
+				c = sAlphabet[rng() % (sizeof(sAlphabet) - 1)];
+
+			iDifferent += !(date_gen::from_string(s) == reference::date_gen::from_string(s));
+		}
+
+		CHECK(iDifferent == 0);
+
+		// the cached local time, unless the second changes in between
+		for (int i = 0; i < 5; i++)
+		{
+			const std::string sBefore = reference::date_gen::time_stamp();
+			const std::string sNew = date_gen::time_stamp();
+
+			if (sBefore == reference::date_gen::time_stamp())
+			{
+				CHECK(sNew == sBefore);
+				CHECK(date_gen::today() == reference::date_gen::today());
+				break;
+			}
+		}
+	}
+
+	// the documented difference: where local midnight does not exist mktime fails, and the
+	// old path gave 1969-12-31, while the new one gives the calendar date
+	// America/Sao_Paulo observed daylight saving time from midnight, e.g. on 2018-11-04, and
+	// started its standard offset at midnight on 1914-01-01
+	set_time_zone("America/Sao_Paulo");
+
+	std::tm gap = { 0, 0, 0, 4, 10, 118 };
+	const std::time_t gap_time = std::mktime(&gap);
+	std::tm gap_out = { };
+	localtime_r(&gap_time, &gap_out);
+
+	if (gap_out.tm_hour != 1)
+	{
+		// the time zone database is not installed
+		std::printf("no time zone data for America/Sao_Paulo; the DST gap checks are skipped\n");
+		return test::result("date_gen_test");
+	}
+
+	{
+		// the daylight saving gap: the old path passes tm_isdst = 0, so the missing midnight
+		// is read as standard time and lands on 01:00 the same day; both paths agree
+		const date dt{ 4, 11, 2018 };
+		date a{ 3, 11, 2018 };
+		old_date b{ 3, 11, 2018 };
+		date_gen::add_days(a, 1);
+		reference::date_gen::add_days(b, 1);
+
+		CHECK(a == dt);
+		CHECK(dt == b);
+		CHECK(date_gen::day_of_week(dt) == 1);
+		CHECK(reference::date_gen::day_of_week(to_old(dt)) == 1);
+	}
+
+	{
+		// the offset change: mktime returns -1
+		const date dt{ 1, 1, 1914 };
+		std::tm time_in = { 0, 0, 0, 1, 0, 14 };
+		CHECK(std::mktime(&time_in) == std::time_t(-1));
+
+		date a{ 31, 12, 1913 };
+		old_date b{ 31, 12, 1913 };
+		date_gen::add_days(a, 1);
+		reference::date_gen::add_days(b, 1);
+
+		CHECK(a == dt);
+		CHECK(b.year == 1969 && b.month == 12 && b.day == 31);
+
+		// 1914-01-01 was a Thursday
+		CHECK(date_gen::day_of_week(dt) == 5);
+		CHECK(reference::date_gen::day_of_week(to_old(dt)) == 4);
+
+		// the first day of the next month fails, so the last day of the month does too
+		const date december{ 31, 12, 1913 };
+		CHECK(date_gen::last_day_of_month(date{ 1, 12, 1913 }) == december);
+		CHECK(!(december == reference::date_gen::last_day_of_month(old_date{ 1, 12, 1913 })));
+	}
+
+	// and everywhere else in the zone the two paths agree on the date
+	{
+		int iDifferent = 0;
+
+		for (int iYear = 1900; iYear <= 2200; iYear++)
+			for (int iMonth = 1; iMonth <= 12; iMonth++)
+				for (int iDay = 1; iDay <= civil_date::days_in_month(iYear, iMonth); iDay++)
+				{
+					date a{ iDay, iMonth, iYear };
+					old_date b = to_old(a);
+					date_gen::add_days(a, 0);
+					reference::date_gen::add_days(b, 0);
+					iDifferent += !(a == b);
+				}
+
+		CHECK(iDifferent == 1);
+	}
+
+	return test::result("date_gen_test");
+}
@@ -0,0 +1,246 @@
+//
+// dictionary_automaton_test.cpp - dictionary_automaton matches against a brute-force substring lookup
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "test.h"
+#include "password_rating/dictionary/dictionary_index.h"
+#include "password_rating/dictionary/dictionary_automaton.h"
+
+#include <set>
+#include <cctype>
+#include <utility>
+#include <tuple>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	typedef std::tuple<size_t, size_t, bool> match;	// begin, length, leet
+
+	// the letters a password character stands for, as the automaton documents them
+	std::string letters(char c)
+	{
+		if (c >= 'a' && c <= 'z')
+			return std::string(1, c);
+
+		if (c >= 'A' && c <= 'Z')
+			return std::string(1, char(c - 'A' + 'a'));
+
+		switch (c)
+		{
+		case '4': case '@': return "a";
+		case '8': return "b";
+		case '(': return "c";
+		case '3': return "e";
+		case '6': case '9': return "g";
+		case '1': case '!': case '|': return "il";
+		case '0': return "o";
+		case '5': case '$': return "s";
+		case '7': case '+': return "t";
+		case '%': return "x";
+		case '2': return "z";
+		default: return "";
+		}
+	}
+
+	bool is_letter(char c)
+	{
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+	}
+
+	// every substring that some reading of it spells a word; leet unless it spells one as it is
+	std::set<match> brute_force(const std::set<std::string> &words, const std::string &sPassword)
+	{
+		std::set<match> result;
+
+		for (size_t iBegin = 0; iBegin < sPassword.length(); iBegin++)
+		{
+			// the readings of the characters from iBegin on, and whether each needed a substitution
+			std::vector<std::pair<std::string, bool>> readings = { { "", false } };
+
+			for (size_t iEnd = iBegin; iEnd < sPassword.length() &&
+				iEnd - iBegin < dictionary_automaton::max_length && !readings.empty(); iEnd++)
+			{
+				const char c = sPassword[iEnd];
+				std::vector<std::pair<std::string, bool>> next;
+
+				for (const auto &reading : readings)
+					for (const char l : letters(c))
+						next.push_back({ reading.first + l, reading.second || !is_letter(c) });
+
+				readings.swap(next);
+
+				bool bFound = false, bPlain = false;
+
+				for (const auto &reading : readings)
+				{
+					if (words.count(reading.first))
+					{
+						bFound = true;
+						bPlain = bPlain || !reading.second;
+					}
+				}
+
+				if (bFound)
+					result.insert(match(iBegin, iEnd + 1 - iBegin, !bPlain));
+			}
+		}
+
+		return result;
+	}
+
+	std::set<match> found(const dictionary_automaton &automaton, const std::string &sPassword)
+	{
+		std::vector<dictionary_match> matches;
+		automaton.find(sPassword, matches);
+
+		std::set<match> result;
+
+		for (size_t i = 0; i < matches.size(); i++)
+		{
+			const dictionary_match &m = matches[i];
+			CHECK(result.insert(match(m.begin, m.length, m.leet)).second);
+
+			// in order of the position of their last character
+			if (i > 0)
+				CHECK(matches[i - 1].begin + matches[i - 1].length <= m.begin + m.length);
+		}
+
+		return result;
+	}
+}
+
+int main()
+{
+	// a small alphabet, so that words turn up inside random passwords and inside each other
+	const std::string sAlphabet = "abegilostz";
+	std::mt19937 rng(13);
+	std::uniform_int_distribution<size_t> letter(0, sAlphabet.length() - 1);
+	std::uniform_int_distribution<size_t> word_length(1, 9);
+
+	std::string sText;
+	std::set<std::string> words;
+
+	for (int i = 0; i < 3000; i++)
+	{
+		std::string sWord;
+		const size_t iLength = word_length(rng);
+
+		for (size_t k = 0; k < iLength; k++)
+			sWord += sAlphabet[letter(rng)];
+
+		// words are matched whatever their case in the word list
+		if (i % 5 == 0)
+			sWord[0] = char(sWord[0] - 'a' + 'A');
+
+		sText += sWord + "\n";
+
+		if (sWord.length() >= dictionary_automaton::min_length)
+		{
+			for (auto &c : sWord)
+				c = char(std::tolower(c));
+
+			words.insert(sWord);
+		}
+	}
+
+	// left out: short words, and words with characters other than letters
+	sText += "lo\ngo4l\nbe-st\n";
+
+	dictionary_index index;
+	CHECK(index.build(sText.data(), sText.size()));
+
+	dictionary_automaton automaton;
+	CHECK(automaton.empty());
+	CHECK(automaton.build(index));
+	CHECK(!automaton.empty());
+
+	for (size_t iLength = 0; iLength <= dictionary_automaton::max_length; iLength++)
+	{
+		size_t iCount = 0;
+
+		for (const auto &word : words)
+			iCount += word.length() == iLength;
+
+		CHECK(automaton.words_of_length(iLength) == iCount);
+	}
+
+	// passwords of letters in either case, the characters that stand for letters, and others;
+	// at most three of the characters that stand for two letters, so that no more readings are
+	// alive at once than the matcher tracks
+	const std::string sOther = "4@8(369057+%2$ #-_";
+	const std::string sAmbiguous = "1!|";
+	std::uniform_int_distribution<int> kind(0, 9);
+	std::uniform_int_distribution<size_t> password_length(0, 24);
+	int iMismatches = 0;
+	size_t iMatches = 0, iLeet = 0;
+
+	for (int i = 0; i < 20000; i++)
+	{
+		std::string sPassword;
+		const size_t iLength = password_length(rng);
+		int iAmbiguous = 0;
+
+		for (size_t k = 0; k < iLength; k++)
+		{
+			const int iKind = kind(rng);
+
+			if (iKind < 6)
+				sPassword += sAlphabet[letter(rng)];
+			else
+				if (iKind < 8)
+					sPassword += char(sAlphabet[letter(rng)] - 'a' + 'A');
+				else
+					if (iKind < 9 || iAmbiguous == 3)
+						sPassword += sOther[rng() % sOther.length()];
+					else
+					{
+						sPassword += sAmbiguous[rng() % sAmbiguous.length()];
+						iAmbiguous++;
+					}
+		}
+
+		const std::set<match> expected = brute_force(words, sPassword);
+		const std::set<match> actual = found(automaton, sPassword);
+
+		iMatches += expected.size();
+
+		for (const auto &it : expected)
+			iLeet += std::get<2>(it);
+
+		if (expected != actual && iMismatches++ < 10)
+			std::printf("\"%s\": %zu matches, brute force has %zu\n",
+				sPassword.c_str(), actual.size(), expected.size());
+
+		// matching one character at a time gives the same matches
+		dictionary_automaton::cursor c;
+		std::vector<dictionary_match> stepped, all;
+
+		for (size_t pos = 0; pos < sPassword.length(); pos++)
+			automaton.step(c, sPassword[pos], pos, stepped);
+
+		automaton.find(sPassword, all);
+		CHECK(stepped.size() == all.size());
+	}
+
+	CHECK(iMismatches == 0);
+
+	// the random passwords are only a test if they hold words, spelt both ways
+	CHECK(iMatches > 5000 && iLeet > 1000 && iMatches - iLeet > 1000);
+
+	// an empty automaton finds nothing
+	automaton.clear();
+	CHECK(automaton.empty());
+	std::vector<dictionary_match> matches(1);
+	automaton.find("anything", matches);
+	CHECK(matches.empty());
+
+	return test::result("dictionary_automaton_test");
+}
@@ -0,0 +1,104 @@
+//
+// dictionary_test.cpp - compiled dictionary images and loading them
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "test.h"
+#include "password_rating/dictionary/dictionary.h"
+
+#include <cstring>
+#include <fstream>
+#include <cstdio>
+
+int main()
+{
+	const std::string sText = "apple\r\nbanana\n\ncherry\napple\ndragonfruit";
+
+	dictionary_index index;
+	CHECK(index.build(sText.data(), sText.size()));
+	CHECK(index.size() == 4);
+
+	std::vector<char> vImage;
+	CHECK(index.save(vImage));
+	CHECK(dictionary_index::is_image(vImage.data(), vImage.size()));
+
+	// attach at every alignment, as a resource packed at any offset would be
+	std::vector<char> vBuffer(vImage.size() + 16);
+
+	for (size_t iOffset = 0; iOffset < 8; iOffset++)
+	{
+		// start from an 8 byte boundary
+		char* pBase = vBuffer.data() + (8 - reinterpret_cast<uintptr_t>(vBuffer.data()) % 8) % 8;
+		std::memcpy(pBase + iOffset, vImage.data(), vImage.size());
+
+		for (bool bVerify : { false, true })
+		{
+			dictionary_index attached;
+			CHECK(attached.attach(pBase + iOffset, vImage.size(), bVerify));
+			CHECK(attached.size() == 4);
+			CHECK(attached.contains("apple"));
+			CHECK(attached.contains("banana"));
+			CHECK(attached.contains("cherry"));
+			CHECK(attached.contains("dragonfruit"));
+			CHECK(!attached.contains("Apple"));
+			CHECK(!attached.contains("grape"));
+
+			// the index keeps working after it has been moved
+			dictionary_index moved(std::move(attached));
+			CHECK(moved.contains("cherry"));
+			CHECK(attached.empty());
+		}
+	}
+
+	// a damaged image is only caught when it is verified
+	std::vector<char> vDamaged = vImage;
+	vDamaged.back() ^= 1;
+
+	dictionary_index damaged;
+	CHECK(!damaged.attach(vDamaged.data(), vDamaged.size(), true));
+	CHECK(damaged.attach(vDamaged.data(), vDamaged.size(), false));
+
+	// truncated images and other versions are refused
+	CHECK(!damaged.attach(vImage.data(), vImage.size() - 1, false));
+	CHECK(!damaged.attach(vImage.data(), 16, false));
+
+	std::vector<char> vVersion = vImage;
+	vVersion[8]++;
+	CHECK(!damaged.attach(vVersion.data(), vVersion.size(), false));
+
+	// the dictionary loads a compiled file the same way it loads a word list
+	const std::string sFile = "dictionary_test.bin";
+
+	{
+		std::ofstream out(sFile, std::ios::binary);
+		out.write(vImage.data(), std::streamsize(vImage.size()));
+	}
+
+	CHECK(dictionary::LoadDict(sFile));
+	CHECK(dictionary::SearchInDict(std::string("bananas"), false) == 1);
+	CHECK(dictionary::SearchInDict(std::string("Cherry"), false) == 1);
+	CHECK(dictionary::SearchInDict(std::string("Cherry"), true) == 0);
+	CHECK(dictionary::SearchInDict(std::string("grape"), false) == 0);
+
+	{
+		std::ofstream out(sFile, std::ios::binary);
+		out.write(vDamaged.data(), std::streamsize(vDamaged.size()));
+	}
+
+	// files are always verified; the dictionary already loaded stays
+	CHECK(!dictionary::LoadDict(sFile));
+	CHECK(dictionary::SearchInDict(std::string("apple"), true) == 1);
+
+	std::remove(sFile.c_str());
+
+	// the full word list
+	CHECK(dictionary::LoadDict(std::string(CUI_ROOT) + "/resources/doc/dict.txt"));
+	CHECK(dictionary::SearchInDict(std::string("password"), false) == 1);
+
+	return test::result("dictionary_test");
+}
@@ -0,0 +1,254 @@
+//
+// hit_grid_test.cpp - CHitGrid queries against testing every rectangle
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "test.h"
+#include "cui_raw/cui_rawImpl/CHitGrid/CHitGrid.h"
+
+#include <random>
+#include <algorithm>
+
+namespace
+{
+	typedef CHitGrid::rect rect;
+
+	// what the grid stands in for: every rectangle tested in the order it was added, as with
+	// PtInRect, skipping the empty ones the grid ignores
+	void linear(const std::vector<rect> &vRects, long x, long y, std::vector<size_t> &vIDs)
+	{
+		vIDs.clear();
+
+		for (size_t i = 0; i < vRects.size(); i++)
+		{
+			const rect &rc = vRects[i];
+
+			if (rc.right > rc.left && rc.bottom > rc.top &&
+				x >= rc.left && x < rc.right && y >= rc.top && y < rc.bottom)
+				vIDs.push_back(i);
+		}
+	}
+
+	void fill(CHitGrid &grid, const std::vector<rect> &vRects)
+	{
+		grid.Clear();
+
+		for (size_t i = 0; i < vRects.size(); i++)
+			grid.Add(vRects[i], i);
+
+		grid.Build();
+	}
+
+	int iMismatches = 0;
+
+	void check_point(const CHitGrid &grid, const std::vector<rect> &vRects, long x, long y)
+	{
+		std::vector<size_t> vGrid, vLinear;
+		grid.Query(x, y, vGrid);
+		linear(vRects, x, y, vLinear);
+
+		if (vGrid != vLinear && iMismatches++ < 10)
+			std::printf("query (%ld, %ld): grid has %zu, linear has %zu\n", x, y, vGrid.size(), vLinear.size());
+	}
+
+	// the edges of every rectangle in vAt, one pixel either side, and the corners
+	void check_edges(const CHitGrid &grid, const std::vector<rect> &vRects, const std::vector<rect> &vAt)
+	{
+		for (const rect &rc : vAt)
+			for (long dx = -1; dx <= 1; dx++)
+				for (long dy = -1; dy <= 1; dy++)
+				{
+					check_point(grid, vRects, rc.left + dx, rc.top + dy);
+					check_point(grid, vRects, rc.right + dx, rc.bottom + dy);
+					check_point(grid, vRects, rc.left + dx, rc.bottom + dy);
+					check_point(grid, vRects, rc.right + dx, rc.top + dy);
+				}
+	}
+
+	void check_edges(const CHitGrid &grid, const std::vector<rect> &vRects)
+	{
+		check_edges(grid, vRects, vRects);
+	}
+
+	// a window of icons, as a page of buttons lays itself out; the last column and row are
+	// anchored to the right and bottom of the window
+	std::vector<rect> icons(long cx, long cy)
+	{
+		std::vector<rect> vRects;
+
+		for (long r = 0; r < 12; r++)
+			for (long c = 0; c < 10; c++)
+			{
+				rect rc;
+				rc.left = c == 9 ? cx - 84 : 20 + c * 70;
+				rc.top = r == 11 ? cy - 64 : 80 + r * 50;
+				rc.right = rc.left + 64;
+				rc.bottom = rc.top + 44;
+				vRects.push_back(rc);
+			}
+
+		// a caption bar across the whole width
+		vRects.push_back(rect{ 0, 0, cx, 30 });
+		return vRects;
+	}
+}
+
+int main()
+{
+	// nothing to query before Build, after Clear, or with only empty rectangles
+	{
+		CHitGrid grid;
+		std::vector<size_t> vIDs(3);
+
+		grid.Query(0, 0, vIDs);
+		CHECK(vIDs.empty());
+
+		grid.Add(rect{ 0, 0, 10, 10 }, 7);
+		CHECK(grid.Size() == 1);
+		grid.Query(5, 5, vIDs);
+		CHECK(vIDs.empty());
+
+		grid.Build();
+		grid.Query(5, 5, vIDs);
+		CHECK(vIDs.size() == 1 && vIDs[0] == 7);
+
+		grid.Clear();
+		CHECK(grid.Size() == 0);
+		grid.Query(5, 5, vIDs);
+		CHECK(vIDs.empty());
+
+		grid.Add(rect{ 10, 10, 10, 20 }, 1);
+		grid.Add(rect{ 10, 10, 20, 5 }, 2);
+		CHECK(grid.Size() == 0);
+		grid.Build();
+		grid.Query(10, 10, vIDs);
+		CHECK(vIDs.empty());
+	}
+
+	// half open rectangles: the right and bottom edges are outside
+	{
+		CHitGrid grid;
+		const std::vector<rect> vRects = { { 0, 0, 32, 32 }, { 32, 0, 64, 32 }, { 0, 32, 64, 64 } };
+		fill(grid, vRects);
+
+		std::vector<size_t> vIDs;
+		grid.Query(31, 31, vIDs);
+		CHECK(vIDs.size() == 1 && vIDs[0] == 0);
+		grid.Query(32, 31, vIDs);
+		CHECK(vIDs.size() == 1 && vIDs[0] == 1);
+		grid.Query(31, 32, vIDs);
+		CHECK(vIDs.size() == 1 && vIDs[0] == 2);
+		grid.Query(64, 0, vIDs);
+		CHECK(vIDs.empty());
+		grid.Query(0, 64, vIDs);
+		CHECK(vIDs.empty());
+		grid.Query(-1, 0, vIDs);
+		CHECK(vIDs.empty());
+	}
+
+	// rectangles that start and end on the borders of the 32 pixel cells, queried on and
+	// around every cell border
+	{
+		std::vector<rect> vRects;
+
+		for (long i = 0; i < 40; i++)
+			vRects.push_back(rect{ i * 32, (i % 5) * 32, i * 32 + 32 * (1 + i % 3), (i % 5) * 32 + 32 });
+
+		vRects.push_back(rect{ 0, 0, 40 * 32 + 64, 200 });
+
+		CHitGrid grid;
+		fill(grid, vRects);
+
+		for (long x = -2; x <= 42 * 32 + 2; x++)
+			for (long y = -2; y <= 202; y += (y % 32 <= 1 || y % 32 >= 31) ? 1 : 29)
+				check_point(grid, vRects, x, y);
+
+		check_edges(grid, vRects);
+	}
+
+	// random layouts, with overlaps, negative coordinates, empty rectangles, and bounds
+	// large enough for the cells to grow past 32 pixels
+	{
+		std::mt19937 rng(21);
+
+		for (int iLayout = 0; iLayout < 200; iLayout++)
+		{
+			const long iExtent = iLayout % 4 == 0 ? 200000 : 2000;
+			std::vector<rect> vRects(1 + rng() % 300);
+
+			for (auto &rc : vRects)
+			{
+				rc.left = long(rng() % iExtent) - iExtent / 4;
+				rc.top = long(rng() % iExtent) - iExtent / 4;
+				rc.right = rc.left + long(rng() % (iExtent / 8)) - 2;
+				rc.bottom = rc.top + long(rng() % (iExtent / 8)) - 2;
+			}
+
+			CHitGrid grid;
+			fill(grid, vRects);
+
+			for (int i = 0; i < 2000; i++)
+				check_point(grid, vRects, long(rng() % (iExtent * 3 / 2)) - iExtent / 2,
+					long(rng() % (iExtent * 3 / 2)) - iExtent / 2);
+
+			check_edges(grid, vRects);
+		}
+	}
+
+	// resizing the window moves the anchored controls; once the grid is rebuilt, as after
+	// WM_SIZE, the old positions no longer hit and the new ones do
+	{
+		CHitGrid grid;
+		std::vector<rect> vRects = icons(800, 700);
+		fill(grid, vRects);
+		check_edges(grid, vRects);
+
+		for (long cx : { 1200L, 640L, 1920L, 800L })
+		{
+			const long cy = cx * 7 / 8;
+			const std::vector<rect> vOld = vRects;
+			vRects = icons(cx, cy);
+			fill(grid, vRects);
+
+			// where the controls were, the grid holds what is there now
+			check_edges(grid, vRects);
+			check_edges(grid, vRects, vOld);
+
+			// the corner icon is at its new place only
+			std::vector<size_t> vIDs;
+			const rect &rcOld = vOld[119], &rcNew = vRects[119];
+
+			grid.Query(rcNew.left, rcNew.top, vIDs);
+			CHECK(std::find(vIDs.begin(), vIDs.end(), size_t(119)) != vIDs.end());
+
+			if (rcOld.left != rcNew.left)
+			{
+				grid.Query(rcOld.left, rcOld.top, vIDs);
+				CHECK(std::find(vIDs.begin(), vIDs.end(), size_t(119)) == vIDs.end());
+			}
+
+			// the caption spans the new width
+			grid.Query(cx - 1, 10, vIDs);
+			CHECK(vIDs.size() == 1 && vIDs[0] == 120);
+			grid.Query(cx, 10, vIDs);
+			CHECK(vIDs.empty());
+		}
+
+		// a Build without a Clear lays out what was added since as well
+		grid.Add(rect{ 5000, 5000, 5010, 5010 }, 500);
+		grid.Build();
+		std::vector<size_t> vIDs;
+		grid.Query(5005, 5005, vIDs);
+		CHECK(vIDs.size() == 1 && vIDs[0] == 500);
+		grid.Query(vRects[0].left, vRects[0].top, vIDs);
+		CHECK(vIDs.size() == 1 && vIDs[0] == 0);
+	}
+
+	CHECK(iMismatches == 0);
+	return test::result("hit_grid_test");
+}
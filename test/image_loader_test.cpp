@@ -0,0 +1,525 @@
+//
+// image_loader_test.cpp - CImageLoader stages against ResizeGdiplusBitmap, and its worker queue
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "test.h"
+#include "reference/resize_gdiplus_bitmap.h"
+#include "cui_raw/cui_rawImpl/CImageLoader/CImageLoader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <set>
+
+namespace
+{
+	typedef CImageLoader::pixels pixels;
+
+	pixels flat(int cx, int cy, std::uint32_t clr)
+	{
+		pixels image;
+		image.cx = cx;
+		image.cy = cy;
+		image.data.assign(size_t(cx) * size_t(cy), clr);
+		return image;
+	}
+
+	std::uint32_t channel(std::uint32_t p, int iShift)
+	{
+		return (p >> iShift) & 0xFF;
+	}
+
+	bool premultiplied(const pixels &image)
+	{
+		for (const auto &it : image.data)
+		{
+			const std::uint32_t a = it >> 24;
+
+			if (channel(it, 16) > a || channel(it, 8) > a || channel(it, 0) > a)
+				return false;
+		}
+
+		return true;
+	}
+
+	/*
+	** stands in for the GDI+ decoder
+	** "WxH" decodes to a W by H image, "bad" fails, "short" gives fewer pixels than it says,
+	** "empty" gives a 0 by 0 image; files starting with "wait" block until release is called
+	*/
+	class fake_decoder
+	{
+	public:
+		bool decode(const std::wstring &sFileName, pixels &image)
+		{
+			const int iRunning = ++m_iRunning;
+			int iMax = m_iMaxRunning;
+
+			while (iRunning > iMax && !m_iMaxRunning.compare_exchange_weak(iMax, iRunning))
+			{
+			}
+
+			m_iDecodes++;
+
+			if (sFileName.compare(0, 4, L"wait") == 0)
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_iWaiting++;
+				m_cv.notify_all();
+				m_cv.wait(lock, [this]() { return m_bReleased; });
+			}
+			else
+				std::this_thread::sleep_for(std::chrono::microseconds(200));
+
+			bool bResult = true;
+
+			if (sFileName == L"bad")
+				bResult = false;
+			else
+				if (sFileName == L"short")
+				{
+					image = flat(40, 30, 0xFF102030);
+					image.data.pop_back();
+				}
+				else
+					if (sFileName == L"empty")
+						image = pixels();
+					else
+					{
+						int cx = 400, cy = 300;
+						const size_t iX = sFileName.find(L'x');
+
+						if (iX != std::wstring::npos && sFileName.compare(0, 4, L"wait") != 0)
+						{
+							cx = std::stoi(sFileName.substr(0, iX));
+							cy = std::stoi(sFileName.substr(iX + 1));
+						}
+
+						// translucent, so the worker has to premultiply it
+						image = flat(cx, cy, 0x80FF4020);
+					}
+
+			m_iRunning--;
+			return bResult;
+		}
+
+		// wait until iCount decodes are blocked on a "wait" file
+		bool wait_for_blocked(int iCount)
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			return m_cv.wait_for(lock, std::chrono::seconds(10),
+				[&]() { return m_iWaiting >= iCount; });
+		}
+
+		void release()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_bReleased = true;
+			m_cv.notify_all();
+		}
+
+		int decodes() const { return m_iDecodes; }
+		int max_running() const { return m_iMaxRunning; }
+
+	private:
+		std::atomic<int> m_iRunning{ 0 };
+		std::atomic<int> m_iMaxRunning{ 0 };
+		std::atomic<int> m_iDecodes{ 0 };
+
+		std::mutex m_mutex;
+		std::condition_variable m_cv;
+		int m_iWaiting = 0;
+		bool m_bReleased = false;
+	};
+
+	// the keys the loader has notified, as the window messages would deliver them
+	class notifications
+	{
+	public:
+		void notify(std::uintptr_t key)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_keys.push_back(key);
+			m_iTotal++;
+			m_cv.notify_all();
+		}
+
+		std::vector<std::uintptr_t> take()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			std::vector<std::uintptr_t> keys;
+			keys.swap(m_keys);
+			return keys;
+		}
+
+		// wait until iCount notifications have arrived in all
+		bool wait_for(size_t iCount)
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			return m_cv.wait_for(lock, std::chrono::seconds(10),
+				[&]() { return m_iTotal >= iCount; });
+		}
+
+		size_t total()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_iTotal;
+		}
+
+	private:
+		std::mutex m_mutex;
+		std::condition_variable m_cv;
+		std::vector<std::uintptr_t> m_keys;
+		size_t m_iTotal = 0;
+	};
+
+	void test_fit()
+	{
+		int cx = 0, cy = 0;
+
+		CImageLoader::Fit(4000, 3000, 200, 200, cx, cy);
+		CHECK(cx == 200 && cy == 150);
+		CImageLoader::Fit(3000, 4000, 200, 200, cx, cy);
+		CHECK(cx == 150 && cy == 200);
+		CImageLoader::Fit(100, 50, 200, 200, cx, cy);
+		CHECK(cx == 100 && cy == 50);
+		CImageLoader::Fit(500, 500, 300, 200, cx, cy);
+		CHECK(cx == 200 && cy == 200);
+		CImageLoader::Fit(0, 5, 100, 100, cx, cy);
+		CHECK(cx == 0 && cy == 0);
+		CImageLoader::Fit(100, 100, 0, 100, cx, cy);
+		CHECK(cx == 0 && cy == 0);
+
+		// a thin image still shows as a line, where ResizeGdiplusBitmap would give it no height
+		CImageLoader::Fit(10000, 1, 100, 100, cx, cy);
+		CHECK(cx == 100 && cy == 1);
+
+		// the sizes image controls got from ResizeGdiplusBitmap
+		std::mt19937 rng(25);
+		std::uniform_int_distribution<int> image_size(1, 5000);
+		std::uniform_int_distribution<int> target_size(1, 1000);
+		int iMismatches = 0;
+
+		for (int i = 0; i < 200000; i++)
+		{
+			const int iWidth = image_size(rng) >> (i % 4), iHeight = image_size(rng) >> (i % 3);
+			const int iTargetWidth = target_size(rng), iTargetHeight = target_size(rng);
+
+			if (iWidth <= 0 || iHeight <= 0)
+				continue;
+
+			int iWidthOld = 0, iHeightOld = 0;
+			reference::resize_gdiplus_bitmap(iWidth, iHeight, iTargetWidth, iTargetHeight,
+				iWidthOld, iHeightOld);
+
+			CImageLoader::Fit(iWidth, iHeight, iTargetWidth, iTargetHeight, cx, cy);
+
+			// never bigger than the target or the image
+			CHECK(cx >= 1 && cy >= 1 && cx <= iTargetWidth && cy <= iTargetHeight);
+			CHECK(cx <= iWidth && cy <= iHeight);
+
+			if (iWidth <= iTargetWidth && iHeight <= iTargetHeight)
+			{
+				// an image that fits is kept as it is; going through the ratio could lose a pixel
+				CHECK(cx == iWidth && cy == iHeight);
+				CHECK(iWidthOld >= iWidth - 1 && iHeightOld >= iHeight - 1);
+				continue;
+			}
+
+			if (iWidthOld < 1 || iHeightOld < 1)
+			{
+				// the lines ResizeGdiplusBitmap lost
+				CHECK(cx == std::max(iWidthOld, 1) && cy == std::max(iHeightOld, 1));
+				continue;
+			}
+
+			if ((cx != iWidthOld || cy != iHeightOld) && iMismatches++ < 10)
+				std::printf("fit %dx%d in %dx%d: %dx%d, ResizeGdiplusBitmap %dx%d\n",
+					iWidth, iHeight, iTargetWidth, iTargetHeight, cx, cy, iWidthOld, iHeightOld);
+		}
+
+		CHECK(iMismatches == 0);
+	}
+
+	void test_resize()
+	{
+		// a flat color stays flat
+		pixels image = flat(7, 5, 0xFF336699);
+		pixels out = CImageLoader::Resize(image, 3, 2);
+		CHECK(out.cx == 3 && out.cy == 2 && out.data.size() == 6);
+
+		for (const auto &it : out.data)
+			CHECK(it == 0xFF336699);
+
+		// the same size gives the same pixels
+		image = flat(3, 3, 0xFF000000);
+		image.data[4] = 0xFFFFFFFF;
+		out = CImageLoader::Resize(image, 3, 3);
+		CHECK(out.data == image.data);
+
+		// black and white average to grey
+		image.cx = 2;
+		image.cy = 1;
+		image.data = { 0xFF000000, 0xFFFFFFFF };
+		out = CImageLoader::Resize(image, 1, 1);
+		CHECK(out.data.size() == 1 && (out.data[0] == 0xFF808080 || out.data[0] == 0xFF7F7F7F));
+
+		// a checkerboard halves to grey; at 3x3 the corner covers 2.25 pixels, one of them white
+		image.cx = 4;
+		image.cy = 4;
+		image.data.clear();
+
+		for (int y = 0; y < 4; y++)
+			for (int x = 0; x < 4; x++)
+				image.data.push_back(((x + y) & 1) ? 0xFFFFFFFF : 0xFF000000);
+
+		out = CImageLoader::Resize(image, 2, 2);
+
+		for (const auto &it : out.data)
+			CHECK(channel(it, 8) == 127 || channel(it, 8) == 128);
+
+		out = CImageLoader::Resize(image, 3, 3);
+		CHECK(out.data.size() == 9 && channel(out.data[0], 8) == 96);
+
+		// the whole of the image is covered, the last row and column included
+		image = flat(10, 10, 0xFF000000);
+
+		for (int i = 0; i < 10; i++)
+			image.data[size_t(i) * 10 + 9] = image.data[90 + size_t(i)] = 0xFFFFFFFF;
+
+		out = CImageLoader::Resize(image, 5, 5);
+		CHECK(channel(out.data[24], 0) > 128 && channel(out.data[0], 0) == 0);
+
+		// nothing to resize
+		CHECK(CImageLoader::Resize(image, 0, 5).data.empty());
+		CHECK(CImageLoader::Resize(pixels(), 5, 5).data.empty());
+		image.data.pop_back();
+		CHECK(CImageLoader::Resize(image, 5, 5).data.empty());
+	}
+
+	void test_premultiply()
+	{
+		pixels image;
+		image.cx = 4;
+		image.cy = 1;
+		image.data = { 0x80FF0000, 0xFF123456, 0x00FFFFFF, 0x40808080 };
+		CImageLoader::Premultiply(image);
+		CHECK(image.data[0] == 0x80800000);
+		CHECK(image.data[1] == 0xFF123456);
+		CHECK(image.data[2] == 0x00000000);
+		CHECK(image.data[3] == 0x40202020);
+
+		// resizing premultiplied pixels keeps them premultiplied
+		std::mt19937 rng(7);
+		image = flat(97, 61, 0);
+
+		for (auto &it : image.data)
+			it = std::uint32_t(rng());
+
+		CImageLoader::Premultiply(image);
+		CHECK(premultiplied(image));
+
+		for (int cx = 1; cx <= 97; cx += 8)
+			for (int cy = 1; cy <= 61; cy += 6)
+				CHECK(premultiplied(CImageLoader::Resize(image, cx, cy)));
+	}
+
+	// what the worker does to what the decoder gives it
+	void test_decode()
+	{
+		fake_decoder decoder;
+		notifications notified;
+
+		CImageLoader loader([&](const std::wstring &sFileName, pixels &image)
+		{
+			return decoder.decode(sFileName, image);
+		}, [&](std::uintptr_t key) { notified.notify(key); }, 2, 16);
+
+		loader.Request(1, L"400x300", 100, 100);	// shrunk
+		loader.Request(2, L"40x30", 100, 100);		// kept as it is
+		loader.Request(3, L"bad", 100, 100);
+		loader.Request(4, L"short", 100, 100);
+		loader.Request(5, L"empty", 100, 100);
+		loader.Request(6, L"400x300", 0, 100);		// nowhere to draw it
+		loader.Request(7, L"1x1000", 100, 100);		// a line
+
+		CHECK(notified.wait_for(7));
+
+		pixels image;
+		CHECK(loader.Collect(1, image));
+		CHECK(image.cx == 100 && image.cy == 75 && image.data.size() == 7500);
+		CHECK(image.data.front() == 0x80802010 && premultiplied(image));
+
+		CHECK(loader.Collect(2, image));
+		CHECK(image.cx == 40 && image.cy == 30 && image.data.size() == 1200);
+		CHECK(image.data.back() == 0x80802010);
+
+		// the ones that cannot be drawn are collected as empty images
+		for (std::uintptr_t key = 3; key <= 6; key++)
+		{
+			image = flat(1, 1, 0);
+			CHECK(loader.Collect(key, image));
+			CHECK(image.data.empty());
+		}
+
+		CHECK(loader.Collect(7, image));
+		CHECK(image.cx == 1 && image.cy == 100);
+
+		CHECK(!loader.Collect(1, image));
+		CHECK(!loader.Collect(99, image));
+	}
+
+	void test_queue()
+	{
+		fake_decoder decoder;
+		notifications notified;
+
+		{
+			CImageLoader loader([&](const std::wstring &sFileName, pixels &image)
+			{
+				return decoder.decode(sFileName, image);
+			}, [&](std::uintptr_t key) { notified.notify(key); }, 3, 5);
+
+			// many requests, asked for twice, some cancelled and one replaced
+			for (std::uintptr_t key = 1; key <= 200; key++)
+				loader.Request(key, key == 7 ? L"bad" : L"400x300", 100, 100);
+
+			for (std::uintptr_t key = 1; key <= 200; key++)
+				loader.Request(key, key == 7 ? L"bad" : L"400x300", 100, 100);
+
+			for (std::uintptr_t key = 150; key <= 200; key++)
+				loader.Cancel(key);
+
+			loader.Request(10, L"400x300", 50, 50);
+
+			// collect like the UI thread would
+			std::set<std::uintptr_t> collected;
+			pixels image;
+			const auto start = std::chrono::steady_clock::now();
+
+			while (collected.size() < 149 &&
+				std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+			{
+				for (const auto &key : notified.take())
+				{
+					if (!loader.Collect(key, image))
+						continue;
+
+					collected.insert(key);
+
+					if (key == 7)
+						CHECK(image.data.empty());
+					else
+						if (key == 10)
+							CHECK(image.cx == 50 && image.cy == 37);
+						else
+							CHECK(image.cx == 100 && image.cy == 75);
+
+					CHECK(!loader.Collect(key, image));
+				}
+
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+
+			CHECK(collected.size() == 149);
+			CHECK(*collected.rbegin() < 150);
+			CHECK(decoder.max_running() <= 3);
+
+			// the repeated requests were not decoded again
+			CHECK(decoder.decodes() <= 200);
+
+			// no more than five images wait to be collected
+			const size_t iBefore = notified.total();
+			notified.take();
+
+			for (std::uintptr_t key = 1000; key < 1020; key++)
+				loader.Request(key, L"40x30", 10, 10);
+
+			CHECK(notified.wait_for(iBefore + 5));
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			CHECK(notified.total() == iBefore + 5);
+
+			// collecting them makes room for the rest
+			for (const auto &key : notified.take())
+				CHECK(loader.Collect(key, image));
+
+			CHECK(notified.wait_for(iBefore + 10));
+
+			// cancelling a waiting image makes room too
+			std::vector<std::uintptr_t> keys = notified.take();
+			CHECK(!keys.empty());
+
+			for (const auto &key : keys)
+				loader.Cancel(key);
+
+			CHECK(notified.wait_for(iBefore + 15));
+
+			// leave work outstanding for the destructor
+			for (std::uintptr_t key = 2000; key < 2100; key++)
+				loader.Request(key, L"400x300", 10, 10);
+		}
+
+		CHECK(decoder.max_running() <= 3);
+	}
+
+	// requests that change while their image is being decoded
+	void test_in_progress()
+	{
+		fake_decoder decoder;
+		notifications notified;
+
+		CImageLoader loader([&](const std::wstring &sFileName, pixels &image)
+		{
+			return decoder.decode(sFileName, image);
+		}, [&](std::uintptr_t key) { notified.notify(key); }, 2, 4);
+
+		loader.Request(1, L"wait 1", 100, 100);
+		loader.Request(2, L"wait 2", 100, 100);
+		CHECK(decoder.wait_for_blocked(2));
+
+		// asking again while it is decoded does nothing
+		loader.Request(1, L"wait 1", 100, 100);
+
+		// a replaced image is thrown away, and a cancelled one is never delivered
+		loader.Request(1, L"40x30", 20, 20);
+		loader.Cancel(2);
+		decoder.release();
+
+		CHECK(notified.wait_for(1));
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+		const std::vector<std::uintptr_t> keys = notified.take();
+		CHECK(keys.size() == 1 && keys[0] == 1);
+		CHECK(decoder.decodes() == 3);
+
+		pixels image;
+		CHECK(loader.Collect(1, image));
+		CHECK(image.cx == 20 && image.cy == 15);
+		CHECK(!loader.Collect(2, image));
+
+		// the two dropped images left no slots taken
+		for (std::uintptr_t key = 10; key < 14; key++)
+			loader.Request(key, L"40x30", 20, 20);
+
+		CHECK(notified.wait_for(5));
+	}
+}
+
+int main()
+{
+	test_fit();
+	test_resize();
+	test_premultiply();
+	test_decode();
+	test_queue();
+	test_in_progress();
+
+	return test::result("image_loader_test");
+}
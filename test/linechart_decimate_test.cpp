@@ -0,0 +1,165 @@
+//
+// linechart_decimate_test.cpp - ClinechartDecimate::MinMax against the buckets it documents
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "test.h"
+#include "cui_raw/cui_rawImpl/LineChart/CLineChartDecimate.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+namespace
+{
+	int iMismatches = 0;
+
+	void report(const char *sWhat, size_t iCount, size_t iBuckets)
+	{
+		if (iMismatches++ < 10)
+			std::printf("%zu points in %zu buckets: %s\n", iCount, iBuckets, sWhat);
+	}
+
+	// whether some kept index in [iStart, iEnd) has the value dValue
+	bool kept(const std::vector<double> &vValues, const std::vector<size_t> &vIndices,
+		size_t iStart, size_t iEnd, double dValue)
+	{
+		for (size_t i : vIndices)
+			if (i >= iStart && i < iEnd && vValues[i] == dValue)
+				return true;
+
+		return false;
+	}
+
+	void check(const std::vector<double> &vValues, size_t iBuckets)
+	{
+		const size_t iCount = vValues.size();
+
+		std::vector<size_t> vIndices = { 42 };	// whatever was there is replaced
+		ClinechartDecimate::MinMax(vValues.data(), iCount, iBuckets, vIndices);
+
+		if (iCount == 0)
+		{
+			if (!vIndices.empty())
+				report("indices for no points", iCount, iBuckets);
+
+			return;
+		}
+
+		// every point when there is room for them all
+		if (iBuckets == 0 || iCount <= 2 * iBuckets)
+		{
+			bool bAll = vIndices.size() == iCount;
+
+			for (size_t i = 0; bAll && i < iCount; i++)
+				bAll = vIndices[i] == i;
+
+			if (!bAll)
+				report("not every point kept", iCount, iBuckets);
+
+			return;
+		}
+
+		if (vIndices.size() > 2 * iBuckets)
+			report("more than two points per bucket", iCount, iBuckets);
+
+		if (vIndices.front() != 0 || vIndices.back() != iCount - 1)
+			report("first or last point dropped", iCount, iBuckets);
+
+		for (size_t i = 1; i < vIndices.size(); i++)
+		{
+			if (vIndices[i] <= vIndices[i - 1] || vIndices[i] >= iCount)
+			{
+				report("indices not strictly ascending", iCount, iBuckets);
+				break;
+			}
+		}
+
+		// points 1 to iCount - 2 in iBuckets - 1 buckets
+		const size_t iInner = iCount - 2;
+		const size_t iInnerBuckets = iBuckets - 1;
+
+		for (size_t b = 0; b < iInnerBuckets; b++)
+		{
+			const size_t iStart = 1 + (b * iInner) / iInnerBuckets;
+			const size_t iEnd = 1 + ((b + 1) * iInner) / iInnerBuckets;
+
+			const auto range = std::minmax_element(vValues.begin() + iStart, vValues.begin() + iEnd);
+
+			if (!kept(vValues, vIndices, iStart, iEnd, *range.first) ||
+				!kept(vValues, vIndices, iStart, iEnd, *range.second))
+			{
+				report("a bucket's lowest or highest point dropped", iCount, iBuckets);
+				break;
+			}
+		}
+	}
+}
+
+int main()
+{
+	std::mt19937 rng(7);
+	std::uniform_real_distribution<double> noise(-1, 1);
+
+	const size_t counts[] = { 0, 1, 2, 3, 4, 5, 7, 16, 17, 100, 799, 800, 1600, 1601, 5000, 100000 };
+	const size_t buckets[] = { 0, 1, 2, 3, 7, 50, 799, 800 };
+
+	for (size_t iCount : counts)
+	{
+		// a wave with noise, a ramp, a flat line, and spikes in a flat line
+		std::vector<double> vWave(iCount), vRamp(iCount), vFlat(iCount, 5), vSpikes(iCount, 0);
+
+		for (size_t i = 0; i < iCount; i++)
+		{
+			vWave[i] = 50 + 40 * std::sin(i * 0.01) + 5 * noise(rng);
+			vRamp[i] = double(i);
+
+			if (rng() % 97 == 0)
+				vSpikes[i] = rng() % 2 ? 100 : -100;
+		}
+
+		for (size_t iBuckets : buckets)
+		{
+			check(vWave, iBuckets);
+			check(vRamp, iBuckets);
+			check(vFlat, iBuckets);
+			check(vSpikes, iBuckets);
+		}
+	}
+
+	// random sizes
+	for (int i = 0; i < 2000; i++)
+	{
+		std::vector<double> vValues(rng() % 3000);
+
+		for (auto &it : vValues)
+			it = noise(rng);
+
+		check(vValues, rng() % 400);
+	}
+
+	CHECK(iMismatches == 0);
+
+	// the extremes of the whole series survive as well
+	std::vector<double> vValues(100000);
+
+	for (auto &it : vValues)
+		it = noise(rng);
+
+	vValues[31337] = 10;
+	vValues[77777] = -10;
+
+	std::vector<size_t> vIndices;
+	ClinechartDecimate::MinMax(vValues.data(), vValues.size(), 800, vIndices);
+	CHECK(vIndices.size() <= 1600);
+	CHECK(std::find(vIndices.begin(), vIndices.end(), 31337) != vIndices.end());
+	CHECK(std::find(vIndices.begin(), vIndices.end(), 77777) != vIndices.end());
+
+	return test::result("linechart_decimate_test");
+}
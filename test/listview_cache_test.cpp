@@ -0,0 +1,300 @@
+//
+// listview_cache_test.cpp - ClistviewCacheT slots, invalidation, hints and row providers
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "test.h"
+#include "cui_raw/cui_rawImpl/CListView/CListViewCache.h"
+
+#include <random>
+#include <string>
+
+typedef ClistviewCacheT<char> cache_t;
+
+namespace
+{
+	// a provider of "row.column" cells, a custom color on even rows, that counts its calls
+	struct counting_provider
+	{
+		std::vector<int> vFetched;
+		int iVersion = 0;	// changes the text, as new data would
+
+		cache_t::provider get()
+		{
+			return [this](int iRowNumber, cache_t::row &cells)
+			{
+				vFetched.push_back(iRowNumber);
+
+				for (size_t c = 0; c < cells.size(); c++)
+				{
+					cells[c].sText = std::to_string(iRowNumber) + "." + std::to_string(c);
+
+					if (iVersion)
+						cells[c].sText += "v" + std::to_string(iVersion);
+
+					cells[c].bCustom = iRowNumber % 2 == 0;
+					cells[c].clrText = cells[c].bCustom ? 0x0000FF : 0;
+				}
+			};
+		}
+	};
+
+	std::string text(cache_t &cache, int iRow, int iCol)
+	{
+		const cache_t::cell *pCell = cache.GetCell(iRow, iCol);
+		return pCell ? pCell->sText : "(none)";
+	}
+
+	void test_lookup()
+	{
+		counting_provider rows;
+		cache_t cache(8);
+
+		// nothing without a provider
+		cache.SetNumOfCols(3);
+		cache.SetRowCount(100);
+		CHECK(cache.GetRow(0) == nullptr);
+
+		cache.SetProvider(rows.get());
+		CHECK(cache.GetRowCount() == 100 && cache.GetNumOfCols() == 3);
+
+		// out of range
+		CHECK(cache.GetRow(-1) == nullptr);
+		CHECK(cache.GetRow(100) == nullptr);
+		CHECK(cache.GetCell(0, -1) == nullptr);
+		CHECK(cache.GetCell(0, 3) == nullptr);
+		CHECK(rows.vFetched.empty());
+
+		// a row is fetched once, then every cell comes from the cache
+		CHECK(text(cache, 5, 0) == "5.0");
+		CHECK(text(cache, 5, 2) == "5.2");
+		CHECK(cache.GetCell(4, 1)->bCustom && cache.GetCell(4, 1)->clrText == 0x0000FF);
+		CHECK(!cache.GetCell(5, 1)->bCustom && cache.GetCell(5, 1)->clrText == 0);
+		CHECK(rows.vFetched == std::vector<int>({ 5, 4 }));
+		CHECK(cache.Misses() == 2 && cache.Hits() == 4);
+
+		const cache_t::row *pRow = cache.GetRow(5);
+		CHECK(pRow && pRow->size() == 3);
+		CHECK(cache.Hits() == 5);
+	}
+
+	void test_slots()
+	{
+		counting_provider rows;
+		cache_t cache(8);
+		cache.SetNumOfCols(2);
+		cache.SetRowCount(1000);
+		cache.SetProvider(rows.get());
+
+		// rows 3 and 11 share a slot; fetching one evicts the other
+		const cache_t::row *pRow3 = cache.GetRow(3);
+		const cache_t::row *pRow11 = cache.GetRow(11);
+		CHECK(pRow3 == pRow11);
+		CHECK(text(cache, 11, 1) == "11.1");
+		CHECK(text(cache, 3, 1) == "3.1");
+		CHECK(rows.vFetched == std::vector<int>({ 3, 11, 3 }));
+
+		// rows that don't share a slot stay cached together
+		for (int r = 0; r < 8; r++)
+			cache.GetRow(r);
+
+		rows.vFetched.clear();
+
+		for (int r = 7; r >= 0; r--)
+			CHECK(text(cache, r, 0) == std::to_string(r) + ".0");
+
+		CHECK(rows.vFetched.empty());
+
+		// a slot keeps its storage when it is reused for another row
+		const std::string *pText = &cache.GetCell(1, 0)->sText;
+		const char *pChars = pText->data();
+		CHECK(text(cache, 9, 0) == "9.0");
+		CHECK(&cache.GetCell(9, 0)->sText == pText);
+		CHECK(cache.GetCell(9, 0)->sText.data() == pChars);
+
+		// and is cleared before the provider fills it, so nothing is left from the last row
+		cache_t plain(4);
+		plain.SetNumOfCols(2);
+		plain.SetRowCount(10);
+		plain.SetProvider([](int iRowNumber, cache_t::row &cells)
+		{
+			for (auto &it : cells)
+				CHECK(it.sText.empty() && !it.bCustom && it.clrText == 0);
+
+			if (iRowNumber == 1)
+			{
+				cells[1].sText = "only on row 1";
+				cells[1].bCustom = true;
+				cells[1].clrText = 0x123456;
+			}
+		});
+
+		CHECK(plain.GetCell(1, 1)->bCustom);
+		CHECK(plain.GetCell(5, 1)->sText.empty() && !plain.GetCell(5, 1)->bCustom);
+
+		// a random access pattern always gives the right row
+		std::mt19937 rng(2);
+
+		for (int i = 0; i < 10000; i++)
+		{
+			const int r = int(rng() % 1000);
+			const int c = int(rng() % 2);
+			CHECK(text(cache, r, c) == std::to_string(r) + "." + std::to_string(c));
+		}
+
+		CHECK(cache.Hits() + cache.Misses() >= 10000);
+	}
+
+	void test_invalidate()
+	{
+		counting_provider rows;
+		cache_t cache(16);
+		cache.SetNumOfCols(1);
+		cache.SetRowCount(100);
+		cache.SetProvider(rows.get());
+
+		for (int r = 0; r < 10; r++)
+			cache.GetRow(r);
+
+		// a single row
+		rows.iVersion = 1;
+		rows.vFetched.clear();
+		cache.Invalidate(4);
+		CHECK(text(cache, 4, 0) == "4.0v1");
+		CHECK(text(cache, 5, 0) == "5.0");
+		CHECK(rows.vFetched == std::vector<int>({ 4 }));
+
+		// a row that is not cached, or whose slot holds another row, leaves the slot alone
+		cache.Invalidate(20);	// shares a slot with row 4
+		cache.Invalidate(-1);
+		cache.Invalidate(99);
+		rows.vFetched.clear();
+		CHECK(text(cache, 4, 0) == "4.0v1");
+		CHECK(rows.vFetched.empty());
+
+		// every row
+		rows.iVersion = 2;
+		cache.Invalidate();
+
+		for (int r = 0; r < 10; r++)
+			CHECK(text(cache, r, 0) == std::to_string(r) + ".0v2");
+
+		CHECK(rows.vFetched.size() == 10);
+
+		// so do a new row count, column count and provider
+		rows.vFetched.clear();
+		cache.SetRowCount(50);
+		CHECK(text(cache, 0, 0) == "0.0v2");
+		CHECK(cache.GetRow(50) == nullptr);
+		cache.SetNumOfCols(2);
+		CHECK(text(cache, 0, 1) == "0.1v2");
+		cache.SetProvider(rows.get());
+		CHECK(text(cache, 0, 1) == "0.1v2");
+		CHECK(rows.vFetched == std::vector<int>({ 0, 0, 0 }));
+
+		// negative counts are taken as zero
+		cache.SetRowCount(-5);
+		CHECK(cache.GetRowCount() == 0 && cache.GetRow(0) == nullptr);
+		cache.SetNumOfCols(-1);
+		CHECK(cache.GetNumOfCols() == 0);
+	}
+
+	void test_hint()
+	{
+		counting_provider rows;
+		cache_t cache(8);
+		cache.SetNumOfCols(1);
+		cache.SetRowCount(20);
+		cache.SetProvider(rows.get());
+
+		cache.Hint(2, 5);
+		CHECK(rows.vFetched == std::vector<int>({ 2, 3, 4, 5 }));
+
+		// hinted rows are cached
+		rows.vFetched.clear();
+		CHECK(text(cache, 3, 0) == "3.0");
+		CHECK(rows.vFetched.empty());
+
+		// clamped to the rows there are
+		cache.Hint(-3, 1);
+		CHECK(rows.vFetched == std::vector<int>({ 0, 1 }));
+		rows.vFetched.clear();
+		cache.Hint(17, 40);
+		CHECK(rows.vFetched == std::vector<int>({ 17, 18, 19 }));
+
+		// and to the number of slots, so that a long range doesn't evict its own rows
+		rows.vFetched.clear();
+		cache.Invalidate();
+		cache.Hint(0, 19);
+		CHECK(rows.vFetched.size() == 8 && rows.vFetched.front() == 0 && rows.vFetched.back() == 7);
+
+		// empty ranges
+		rows.vFetched.clear();
+		cache.Hint(5, 4);
+		cache.Hint(30, 40);
+		cache.SetRowCount(0);
+		cache.Hint(0, 10);
+		CHECK(rows.vFetched.empty());
+	}
+
+	// the provider may resize the cells it is given; the row keeps the number of columns
+	void test_provider_resizing()
+	{
+		cache_t cache(4);
+		cache.SetNumOfCols(3);
+		cache.SetRowCount(10);
+		cache.SetProvider([](int iRowNumber, cache_t::row &cells)
+		{
+			CHECK(cells.size() == 3);
+
+			if (iRowNumber == 0)
+			{
+				// more cells than columns
+				cells.resize(5);
+
+				for (auto &it : cells)
+					it.sText = "wide";
+			}
+			else
+				if (iRowNumber == 1)
+				{
+					// fewer
+					cells.resize(1);
+					cells[0].sText = "narrow";
+				}
+				else
+					cells.clear();
+		});
+
+		const cache_t::row *pRow = cache.GetRow(0);
+		CHECK(pRow && pRow->size() == 3 && (*pRow)[2].sText == "wide");
+		CHECK(cache.GetCell(0, 3) == nullptr);
+
+		pRow = cache.GetRow(1);
+		CHECK(pRow && pRow->size() == 3);
+		CHECK((*pRow)[0].sText == "narrow" && (*pRow)[1].sText.empty() && (*pRow)[2].sText.empty());
+
+		pRow = cache.GetRow(2);
+		CHECK(pRow && pRow->size() == 3 && (*pRow)[1].sText.empty());
+
+		// the slot that held the wide row is back to three cells when it is reused
+		pRow = cache.GetRow(4);
+		CHECK(pRow && pRow->size() == 3);
+	}
+}
+
+int main()
+{
+	test_lookup();
+	test_slots();
+	test_invalidate();
+	test_hint();
+	test_provider_resizing();
+
+	return test::result("listview_cache_test");
+}
@@ -0,0 +1,136 @@
+//
+// listview_sort_test.cpp - ClistviewSortT against the order listview columns used to sort in
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "test.h"
+#include "reference/listview_compare.h"
+#include "cui_raw/cui_rawImpl/CListView/CListViewSort.h"
+
+#include <random>
+#include <algorithm>
+
+typedef ClistviewSortT<char> sorter;
+
+namespace
+{
+	std::vector<std::string> sorted(const std::vector<std::string> &vRows,
+		sorter::enType type, bool bAscending)
+	{
+		std::vector<const std::string*> vText;
+
+		for (auto &it : vRows)
+			vText.push_back(&it);
+
+		std::vector<std::string> vOut;
+
+		for (int i : sorter::Sort(vText, type, bAscending))
+			vOut.push_back(vRows[i]);
+
+		return vOut;
+	}
+
+	std::string word(std::mt19937 &rng)
+	{
+		static const char alphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+		std::string s(1 + rng() % 8, ' ');
+
+		for (auto &c : s)
+			c = alphabet[rng() % (sizeof(alphabet) - 1)];
+
+		return s;
+	}
+
+	std::string lower(std::string s)
+	{
+		for (auto &c : s)
+			c = (char)std::tolower((unsigned char)c);
+
+		return s;
+	}
+}
+
+int main()
+{
+	std::mt19937 rng(3);
+
+	// text sorts in the same order as the old comparator, in both directions
+	for (int iRound = 0; iRound < 50; iRound++)
+	{
+		std::vector<std::string> vRows(1 + rng() % 300);
+
+		for (auto &it : vRows)
+			it = word(rng);
+
+		for (bool bAscending : { true, false })
+		{
+			std::vector<std::string> vOld = vRows;
+			std::stable_sort(vOld.begin(), vOld.end(), [bAscending](const std::string &a, const std::string &b)
+			{
+				return reference::listview_compare(a, b, bAscending) < 0;
+			});
+
+			const std::vector<std::string> vNew = sorted(vRows, sorter::String, bAscending);
+
+			// rows that differ only in case may be in either order
+			bool bSame = vNew.size() == vOld.size();
+
+			for (size_t i = 0; bSame && i < vNew.size(); i++)
+				bSame = lower(vNew[i]) == lower(vOld[i]);
+
+			CHECK(bSame);
+		}
+	}
+
+	// the first click of a column puts text from Z to A
+	CHECK((sorted({ "apple", "Cherry", "banana" }, sorter::String, true) ==
+		std::vector<std::string>{ "Cherry", "banana", "apple" }));
+	CHECK((sorted({ "apple", "Cherry", "banana" }, sorter::Char, false) ==
+		std::vector<std::string>{ "apple", "banana", "Cherry" }));
+
+	// empty cells go last, and first when sorting the other way
+	CHECK((sorted({ "", "b", "a", "" }, sorter::String, true) ==
+		std::vector<std::string>{ "b", "a", "", "" }));
+	CHECK((sorted({ "", "b", "a", "" }, sorter::String, false) ==
+		std::vector<std::string>{ "", "", "a", "b" }));
+
+	// numbers and dates go the same way as text but are compared by value
+	CHECK((sorted({ "9", "10", "-3", "100" }, sorter::String, true) ==
+		std::vector<std::string>{ "100", "10", "9", "-3" }));
+	CHECK((sorted({ "9", "10", "-3", "100" }, sorter::Int, false) ==
+		std::vector<std::string>{ "-3", "9", "10", "100" }));
+	CHECK((sorted({ "2.5", "10.25", "-1e3" }, sorter::Float, true) ==
+		std::vector<std::string>{ "10.25", "2.5", "-1e3" }));
+	CHECK((sorted({ "01/02/2020", "2019-12-31", "31-01-2020" }, sorter::String, true) ==
+		std::vector<std::string>{ "01/02/2020", "31-01-2020", "2019-12-31" }));
+
+	// a column that is not all numbers sorts as text
+	CHECK((sorted({ "9", "10", "x" }, sorter::String, true) ==
+		std::vector<std::string>{ "x", "9", "10" }));
+
+	// in a number column, text that isn't a number goes before the numbers
+	CHECK((sorted({ "9", "x", "10" }, sorter::Int, true) ==
+		std::vector<std::string>{ "x", "10", "9" }));
+
+	// decimals in an integer column are compared as numbers, not as text
+	CHECK((sorted({ "9", "10.5", "2.25", "-1" }, sorter::Int, false) ==
+		std::vector<std::string>{ "-1", "2.25", "9", "10.5" }));
+	CHECK((sorted({ "9", "x", "10.5" }, sorter::Int, true) ==
+		std::vector<std::string>{ "x", "10.5", "9" }));
+
+	// integers too large for a double keep their order
+	CHECK((sorted({ "900000000000000001", "900000000000000002", "900000000000000000" },
+		sorter::Int, false) == std::vector<std::string>{ "900000000000000000",
+		"900000000000000001", "900000000000000002" }));
+
+	// rows with equal keys keep their order
+	CHECK((sorted({ "b", "A", "a", "B" }, sorter::Char, true) ==
+		std::vector<std::string>{ "b", "B", "A", "a" }));
+
+	return test::result("listview_sort_test");
+}
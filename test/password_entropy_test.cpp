@@ -0,0 +1,127 @@
+//
+// password_entropy_test.cpp - the patterns password_entropy finds, and the sequence it settles on
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "test.h"
+#include "cui.h"
+#include "password_rating/password_entropy.h"
+#include "password_rating/dictionary/dictionary.h"
+
+#include <cmath>
+#include <string>
+
+using namespace liblec::cui;
+
+namespace
+{
+	password_entropy::scratch s;
+
+	double guesses(const std::string &sPassword, uint32_t &issues, const std::string &sUsername = "")
+	{
+		return password_entropy::guesses_log10(sUsername, sPassword, issues, s);
+	}
+
+	double guesses(const std::string &sPassword)
+	{
+		uint32_t issues = 0;
+		return guesses(sPassword, issues);
+	}
+
+	// the issues of a password, and whether its guesses are below brute force over its length
+	uint32_t issues_of(const std::string &sPassword, const std::string &sUsername = "")
+	{
+		uint32_t issues = 0;
+		const double dGuesses = guesses(sPassword, issues, sUsername);
+
+		if (dGuesses >= double(sPassword.length()))
+			std::printf("\"%s\": %.2f, no better than brute force\n", sPassword.c_str(), dGuesses);
+
+		CHECK(dGuesses < double(sPassword.length()));
+		return issues;
+	}
+
+	// a password with no patterns in it is brute force: ten guesses per character
+	const std::string sRandom = "mq8#Vd2Lpz";
+}
+
+int main()
+{
+	uint32_t issues = 0;
+
+	// without the dictionary, only the dictionary is left out
+	guesses("password", issues);
+	CHECK(issues == password_issue::no_dictionary);
+
+	if (!dictionary::LoadDict(CUI_ROOT "/resources/doc/dict.txt"))
+	{
+		std::printf("cannot load %s\n", CUI_ROOT "/resources/doc/dict.txt");
+		return 1;
+	}
+
+	CHECK(guesses("", issues) == 0 && issues == 0);
+	CHECK(std::fabs(guesses(sRandom, issues) - double(sRandom.length())) < 1e-9);
+	CHECK(issues == 0);
+
+	// keyboard walks, on qwerty and on the keypad
+	CHECK(issues_of("qwerty") == password_issue::keyboard_patterns);
+	CHECK(issues_of("zxcvbnm") == password_issue::keyboard_patterns);
+	CHECK(issues_of("qwertyuiop") == password_issue::keyboard_patterns);
+	CHECK(issues_of("1qaz2wsx") == password_issue::keyboard_patterns);
+	CHECK(issues_of("74123") == password_issue::keyboard_patterns);
+
+	// the cheapest sequence for a walk is the walk: well below a random string of its length,
+	// and shifting the whole walk costs a little
+	CHECK(guesses("qwerty") < guesses(sRandom.substr(0, 6)) - 2);
+	CHECK(guesses("QWERTY") > guesses("qwerty"));
+	CHECK(guesses("qwertyuiop") > guesses("qwerty"));
+
+	// repeats, of a character and of a run of them
+	CHECK(issues_of("aaaaaaaa") == password_issue::repeats);
+	CHECK(issues_of("abcabcabc") == password_issue::repeats);
+	CHECK(guesses("aaaaaaaa") < guesses("abcabcabc"));
+
+	// sequences, up and down, in steps of one or more
+	CHECK(issues_of("abcdefgh") == password_issue::sequences);
+	CHECK(issues_of("13579") == password_issue::sequences);
+	CHECK(issues_of("97531") == password_issue::sequences);
+	CHECK(guesses("97531") > guesses("13579"));
+
+	// dates, with and without separators, and years on their own
+	CHECK(issues_of("19850612") == password_issue::dates);
+	CHECK(issues_of("06/12/1985") == password_issue::dates);
+	CHECK(issues_of("1985-06-12") == password_issue::dates);
+	CHECK(issues_of("12.06.85") == password_issue::dates);
+	CHECK(issues_of("1985") == password_issue::dates);
+
+	// the date is the cheapest reading of 19850612, by more than a thousandfold over its digits
+	CHECK(guesses("19850612") < 8 - 3);
+
+	// dictionary words, whole and spelt with substitutions; a whole password in the dictionary
+	// is reported as a dictionary attack rather than as the word in it
+	CHECK(issues_of("password") == password_issue::dictionary_attack);
+	CHECK(issues_of("p4ssw0rd") == password_issue::dictionary_words_leet);
+	CHECK(guesses("p4ssw0rd") > guesses("password"));
+	CHECK(issues_of("P@ssw0rd1985") == (password_issue::dictionary_words_leet | password_issue::dates));
+
+	// the username
+	CHECK(issues_of("alecmus2020", "alecmus") == (password_issue::too_similar | password_issue::dates));
+	CHECK(issues_of("xAlecMusx", "alecmus") & password_issue::too_similar);
+
+	// only the first max_length characters are matched; the rest are brute force
+	const std::string sLong(password_entropy::max_length, 'a');
+	CHECK(std::fabs(guesses(sLong + "xk3") - (guesses(sLong) + 3)) < 1e-9);
+
+	// 7.5 points per factor of ten
+	CHECK(password_entropy::strength(-1) == 0);
+	CHECK(password_entropy::strength(0) == 0);
+	CHECK(password_entropy::strength(12) == 90);
+	CHECK(password_entropy::strength(20) == 100);
+
+	return test::result("password_entropy_test");
+}
@@ -0,0 +1,174 @@
+//
+// password_rater_test.cpp - random edits to the incremental password_rater, checked against full ratings
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "test.h"
+#include "cui.h"
+#include "password_rating/dictionary/dictionary.h"
+
+#include <random>
+
+using namespace liblec::cui;
+
+namespace
+{
+	// characters that make dictionary words, leet spellings, duplicates and every character class
+	const std::string sAlphabet = "abcdeosilt0@4!1$ABCDEOPASSWORDpassword123summer_-. \t~";
+
+	std::string random_string(std::mt19937 &rng, size_t iMaxLength)
+	{
+		std::string s(rng() % (iMaxLength + 1), ' ');
+
+		for (auto &c : s)
+			c = sAlphabet[rng() % sAlphabet.length()];
+
+		return s;
+	}
+
+	int iMismatches = 0;
+
+	// the rater must give exactly what a full rating of the same pair gives
+	void compare(const password_rater &rater, const std::string &sUsername, const std::string &sPassword)
+	{
+		CHECK(rater.password() == sPassword);
+
+		const password_quality expected = password_rating(sUsername, sPassword, password_engine::classic);
+		const password_quality actual = rater.quality();
+
+		const bool bSame = actual.strength == expected.strength &&
+			actual.issues == expected.issues &&
+			actual.rating_summary == expected.rating_summary &&
+			actual.issues_summary == expected.issues_summary &&
+			rater.strength() == expected.strength &&
+			password_issues(rater.issues()) == expected.issues;
+
+		if (!bSame && iMismatches++ < 10)
+			std::printf("username \"%s\", password \"%s\": rater %d [%s], full %d [%s]\n",
+				sUsername.c_str(), sPassword.c_str(),
+				actual.strength, actual.issues_summary.c_str(),
+				expected.strength, expected.issues_summary.c_str());
+
+		CHECK(bSame);
+	}
+}
+
+int main()
+{
+	if (!dictionary::LoadDict(CUI_ROOT "/resources/doc/dict.txt"))
+	{
+		std::printf("cannot load %s\n", CUI_ROOT "/resources/doc/dict.txt");
+		return 1;
+	}
+
+	std::mt19937 rng(17);
+
+	for (int iSequence = 0; iSequence < 2000; iSequence++)
+	{
+		std::string sUsername = random_string(rng, 12);
+		std::string sPassword;
+
+		password_rater rater(sUsername);
+		compare(rater, sUsername, sPassword);
+
+		for (int iEdit = 0; iEdit < 40; iEdit++)
+		{
+			const size_t iAt = rng() % (sPassword.length() + 1);
+			const size_t iCount = std::min<size_t>(rng() % 4, sPassword.length() - iAt);
+
+			switch (rng() % 8)
+			{
+			case 0:
+			case 1:
+				// typing at the end
+			{
+				const char c = sAlphabet[rng() % sAlphabet.length()];
+				rater.push_back(c);
+				sPassword.push_back(c);
+			}
+			break;
+
+			case 2:
+				// deleting at the end
+				rater.pop_back();
+
+				if (!sPassword.empty())
+					sPassword.pop_back();
+				break;
+
+			case 3:
+				// insert anywhere
+				sPassword.insert(iAt, random_string(rng, 4));
+				rater.assign(sPassword);
+				break;
+
+			case 4:
+				// erase anywhere
+				sPassword.erase(iAt, iCount);
+				rater.assign(sPassword);
+				break;
+
+			case 5:
+				// replace anywhere, e.g. a paste over a selection
+				sPassword.replace(iAt, iCount, random_string(rng, 4));
+				rater.assign(sPassword);
+				break;
+
+			case 6:
+				// a new username; the password is kept
+				sUsername = random_string(rng, 12);
+				rater.set_username(sUsername);
+				break;
+
+			default:
+				if (rng() % 4 == 0)
+				{
+					rater.clear();
+					sPassword.clear();
+				}
+				else
+					// the same text again
+					rater.assign(sPassword);
+				break;
+			}
+
+			compare(rater, sUsername, sPassword);
+		}
+	}
+
+	// long passwords and usernames
+	{
+		std::string sUsername(300, 'u');
+		password_rater rater(sUsername);
+		std::string sPassword;
+
+		for (int i = 0; i < 400; i++)
+		{
+			const char c = sAlphabet[i % sAlphabet.length()];
+			rater.push_back(c);
+			sPassword.push_back(c);
+
+			if (i % 25 == 0)
+				compare(rater, sUsername, sPassword);
+		}
+
+		while (!sPassword.empty())
+		{
+			rater.pop_back();
+			sPassword.pop_back();
+
+			if (sPassword.length() % 25 == 0)
+				compare(rater, sUsername, sPassword);
+		}
+
+		rater.pop_back();
+		compare(rater, sUsername, sPassword);
+	}
+
+	return test::result("password_rater_test");
+}
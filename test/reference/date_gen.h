@@ -0,0 +1,145 @@
+//
+// date_gen.h - date_gen as it was before it stopped calling mktime and std::to_string
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <ctime>
+#include <string>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace reference::date_gen
+{
+	// a type of its own, so that calls are not ambiguous with liblec::cui::date_gen
+	struct date {
+		int day = 1;
+		int month = 1;
+		int year = 2019;
+	};
+
+	// the MSVC function the old code called
+	inline int localtime_s(std::tm* time_out, const std::time_t* time_in)
+	{
+		return localtime_r(time_in, time_out) ? 0 : 1;
+	}
+
+	/*
+	** the functions below are the old ones with only the namespace added
+	*/
+	inline std::string time_stamp() {
+		std::time_t time_temp = time(0);
+		std::tm time_out = { };
+		localtime_s(&time_out, &time_temp);
+
+		std::string year = std::to_string(time_out.tm_year + 1900);
+		std::string month = std::to_string(time_out.tm_mon + 1);
+		std::string day = std::to_string(time_out.tm_mday);
+		std::string hour = std::to_string(time_out.tm_hour);
+		std::string minute = std::to_string(time_out.tm_min);
+		std::string second = std::to_string(time_out.tm_sec);
+
+		for (size_t i = year.length(); i < 4; i++) year = "0" + year;
+		for (size_t i = month.length(); i < 2; i++) month = "0" + month;
+		for (size_t i = day.length(); i < 2; i++) day = "0" + day;
+		for (size_t i = hour.length(); i < 2; i++) hour = "0" + hour;
+		for (size_t i = minute.length(); i < 2; i++) minute = "0" + minute;
+		for (size_t i = second.length(); i < 2; i++) second = "0" + second;
+
+		return std::string(year + month + day + " " + hour + ":" + minute + ":" + second);
+	}
+
+	inline std::string to_string(const date& dt) {
+		auto day = std::to_string(dt.day);
+		auto month = std::to_string(dt.month);
+		auto year = std::to_string(dt.year);
+
+		for (size_t i = day.length(); i < 2; i++) day = "0" + day;
+		for (size_t i = month.length(); i < 2; i++) month = "0" + month;
+		for (size_t i = year.length(); i < 4; i++) year = "0" + year;
+
+		return (year + month + day);
+	}
+
+	inline date from_string(const std::string& dt) {
+		date dt_ = { 1, 1, 2019 };
+		try {
+			dt_.day = atoi(dt.substr(6, 2).c_str());
+			dt_.month = atoi(dt.substr(4, 2).c_str());
+			dt_.year = atoi(dt.substr(0, 4).c_str());
+		}
+		catch (const std::exception&) {}
+		return dt_;
+	}
+
+	inline date today() {
+		std::time_t time_temp = time(0);
+		std::tm time_out = { };
+		localtime_s(&time_out, &time_temp);
+
+		date dt;
+		dt.day = time_out.tm_mday;
+		dt.month = time_out.tm_mon + 1;
+		dt.year = time_out.tm_year + 1900;
+		return dt;
+	}
+
+	inline date last_day_of_month(const date& dt) {
+		struct tm when = { 0, 0, 0, 1 };
+
+		if (dt.month == 12) {
+			when.tm_mon = 0;
+			when.tm_year = dt.year - 1900 + 1;
+		}
+		else {
+			when.tm_mon = dt.month;
+			when.tm_year = dt.year - 1900;
+		}
+
+		// get the first day of the next month and subtract one day
+		const time_t lastday = mktime(&when) - 86400;
+		localtime_s(&when, &lastday);
+		return date{ when.tm_mday, when.tm_mon + 1, when.tm_year + 1900 };
+	}
+
+	inline int day_of_week(date dt) {
+		std::tm time_in = { 0, 0, 0, dt.day, dt.month - 1, dt.year - 1900 };
+		std::time_t time_temp = std::mktime(&time_in);
+		std::tm time_out = { };
+		localtime_s(&time_out, &time_temp);
+		return time_out.tm_wday + 1;
+	}
+
+	inline void add_days(date& dt, int n) {
+		std::tm time_in = { 0, 0, 0, dt.day, dt.month - 1, dt.year - 1900 };
+		time_in.tm_mday += n;
+
+		std::time_t time_temp = std::mktime(&time_in);
+		std::tm time_out = { };
+		localtime_s(&time_out, &time_temp);
+
+		dt.day = time_out.tm_mday;
+		dt.month = time_out.tm_mon + 1;
+		dt.year = time_out.tm_year + 1900;
+	}
+
+	inline void get_week(const date& dt, date& start, date& end) {
+		start = end = dt;
+		const auto d = day_of_week(dt);
+		add_days(start, 0 - d);
+		add_days(end, 6 - d);
+	}
+
+	inline void get_month(const date& dt, date& start, date& end) {
+		start = end = dt;
+		const auto d = dt.day;
+		add_days(start, 1 - d);
+		end = last_day_of_month(dt);
+	}
+}
@@ -0,0 +1,56 @@
+//
+// dictionary_search.h - how dictionary words were looked up before the dictionary was indexed
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <string>
+#include <cstring>
+#include <cctype>
+
+namespace reference
+{
+	// searchforword from the old dictionary.cpp: a substring search of the whole word list
+	inline int searchforword(const char* ccSource, const char* ccToFind, bool bCasesensitive)
+	{
+		if (bCasesensitive == true)
+		{
+			if (std::strstr(ccSource, ccToFind) != NULL) return 1;
+		}
+		else
+		{
+			std::string m_sToFind(ccToFind);
+
+			for (int i = 0; i < (int)m_sToFind.length(); i++)
+				m_sToFind[i] = std::tolower(m_sToFind[i]);
+
+			if (std::strstr(ccSource, m_sToFind.c_str()) != NULL)
+				return 1;
+
+			if (!m_sToFind.empty())
+				m_sToFind[0] = std::toupper(m_sToFind[0]);
+
+			if (std::strstr(ccSource, m_sToFind.c_str()) != NULL)
+				return 1;
+		}
+
+		return 0;
+	}
+
+	// dictionary::SearchInDict from the old dictionary.cpp
+	inline int SearchInDict(const char* dict_buffer, const std::string& sWord, bool bCasesensitive)
+	{
+		if (dict_buffer == NULL) return -1;
+
+		if (sWord.length() > 1 && std::tolower(sWord[sWord.length() - 1]) == 's')
+			return searchforword(dict_buffer, sWord.substr(0, sWord.length() - 1).c_str(), bCasesensitive);
+
+		return searchforword(dict_buffer, sWord.c_str(), bCasesensitive);
+	}
+}
@@ -0,0 +1,58 @@
+//
+// listview_compare.h - the comparator listview columns were sorted with before ClistviewSortT
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <strings.h>
+
+namespace reference
+{
+	/*
+	** cui_rawImpl::CompareListItems with the control replaced by the text of the two cells
+	** the text is copied into 256 character buffers for every comparison as
+	** ListView_GetItemText did, and compared with a case-insensitive compare in place of
+	** lstrcmpi
+	** the numeric branch never matched: sBuf1 was built from the whole 256 character buffer,
+	** so it was never equal to the short string of the number; every column sorted as text
+	*/
+	inline int listview_compare(const std::string &s1, const std::string &s2, bool bSortAscending)
+	{
+		char szBuf1[256], szBuf2[256];
+		std::memset(szBuf1, 0, sizeof(szBuf1));
+		std::memset(szBuf2, 0, sizeof(szBuf2));
+		std::strncpy(szBuf1, s1.c_str(), sizeof(szBuf1) - 1);
+		std::strncpy(szBuf2, s2.c_str(), sizeof(szBuf2) - 1);
+
+		std::string sBuf1(szBuf1, 256);
+		std::string sBuf2(szBuf2, 256);
+
+		int dBuf1 = std::atoi(szBuf1);
+		int dBuf2 = std::atoi(szBuf2);
+
+		std::string sBuf1_a = std::to_string(dBuf1);
+		std::string sBuf2_a = std::to_string(dBuf2);
+
+		if (sBuf1 == sBuf1_a && sBuf2 == sBuf2_a)
+		{
+			if (bSortAscending)
+				return (dBuf1 > dBuf2);
+			else
+				return (dBuf1 < dBuf2);
+		}
+
+		if (bSortAscending)
+			return (strcasecmp(szBuf1, szBuf2) * -1);
+		else
+			return (strcasecmp(szBuf1, szBuf2));
+	}
+}
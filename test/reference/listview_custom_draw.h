@@ -0,0 +1,84 @@
+//
+// listview_custom_draw.h - the cell lookup HandleCustomDraw made before ClistviewStyles
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace reference
+{
+	// cui_raw::listviewItem, listviewRow and listviewColumn with the fields the lookup used
+	struct listviewItem
+	{
+		int iRowNumber = 0;
+		std::string sColumnName;
+		std::string sItemData;
+		bool bCustom = false;
+		std::uint32_t clrText = 0;
+	};
+
+	struct listviewRow
+	{
+		std::vector<listviewItem> vItems;
+	};
+
+	struct listviewColumn
+	{
+		int iColumnID = 0;
+		int iWidth = 0;
+		std::string sColumnName;
+		bool bBarChart = false;
+		int iBarChartMax = 100;
+		std::uint32_t clrBarChart = 0;
+		std::uint32_t clrText = 0;
+	};
+
+	/*
+	** the CDDS_SUBITEMPREPAINT stage of the old HandleCustomDraw, without the painting
+	** the rows and columns were passed by value, on every call
+	** returns true if the cell has a custom color, and sets bBarChart for bar chart columns
+	*/
+	inline bool custom_draw(std::vector<listviewRow> lvRows, std::vector<listviewColumn> lvColumns,
+		int iRow, int iColumn, std::uint32_t &clrText, bool &bBarChart)
+	{
+		bBarChart = false;
+
+		// check if this item requires custom drawing
+		for (size_t m_iRow = 0; m_iRow < lvRows.size(); m_iRow++)
+		{
+			if (m_iRow == size_t(iRow))
+			{
+				for (size_t m_iColumn = 0; m_iColumn < lvRows[m_iRow].vItems.size(); m_iColumn++)
+				{
+					if (m_iColumn == size_t(iColumn))
+					{
+						if (lvRows[m_iRow].vItems[m_iColumn].bCustom)
+						{
+							clrText = lvRows[m_iRow].vItems[m_iColumn].clrText;
+							return true;
+						}
+						else
+							clrText = 0;
+					}
+				}
+			}
+		}
+
+		for (size_t i = 0; i < lvColumns.size(); i++)
+		{
+			if (lvColumns[i].bBarChart && lvColumns[i].iColumnID == iColumn)
+				bBarChart = true;
+		}
+
+		return false;
+	}
+}
@@ -0,0 +1,274 @@
+//
+// make_shadow.h - CShadow::MakeShadow before the region rectangles and the separable blur
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include "cui_raw/cui_rawImpl/CShadow/CShadowImage.h"
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+namespace reference
+{
+	/*
+	** the old MakeShadow, line for line, with PtInRegion answered from the region's rectangles
+	** and the min and max macros spelt std::min and std::max
+	**
+	** the old edge scan stopped looking for the end of a line nSize pixels short of its start,
+	** and set neither end of a line the region does not cover, so those lines were left with
+	** whatever was in memory; the arrays are zeroed here so that such lines are at least
+	** repeatable. With bFullScan, the end is looked for all the way to the start and lines the
+	** region does not cover are set empty, which is what CShadowImage does
+	*/
+	inline void make_shadow(uint32_t *pShadBits, int iParentWidth, int iParentHeight,
+		const std::vector<CShadowImage::rect> &vRegion, const CShadowImage::properties &shadow,
+		bool bFullScan = false)
+	{
+		const int m_nSize = shadow.nSize;
+		const int m_nSharpness = shadow.nSharpness;
+		const unsigned char m_nDarkness = (unsigned char)shadow.nDarkness;
+		const int m_nxOffset = shadow.nxOffset;
+		const int m_nyOffset = shadow.nyOffset;
+		const uint32_t m_Color = shadow.clr;
+
+		auto PtInRegion = [&](int x, int y)
+		{
+			for (const auto &it : vRegion)
+				if (x >= it.left && x < it.right && y >= it.top && y < it.bottom)
+					return true;
+
+			return false;
+		};
+
+		auto PreMultiply = [](uint32_t cl, unsigned char nAlpha)
+		{
+			return CShadowImage::PreMultiply(cl, nAlpha);
+		};
+
+		struct size_ { int cx, cy; };
+
+		// Determine the Start and end point of each horizontal scan line
+		size_ szParent = { iParentWidth, iParentHeight };
+		size_ szShadow = { szParent.cx + 2 * m_nSize, szParent.cy + 2 * m_nSize };
+
+		// Extra 2 lines (set to be empty) in ptAnchors are used in dilation
+		int nAnchors = std::max(szParent.cy, szShadow.cy);	// # of anchor points pares
+		int(*ptAnchors)[2] = new int[nAnchors + 2][2]();
+		int(*ptAnchorsOri)[2] = new int[szParent.cy][2]();	// anchor points, will not modify during erosion
+		ptAnchors[0][0] = szParent.cx;
+		ptAnchors[0][1] = 0;
+		ptAnchors[nAnchors + 1][0] = szParent.cx;
+		ptAnchors[nAnchors + 1][1] = 0;
+
+		if (m_nSize > 0)
+		{
+			// Put the parent window anchors at the center
+			for (int i = 0; i < m_nSize; i++)
+			{
+				ptAnchors[i + 1][0] = szParent.cx;
+				ptAnchors[i + 1][1] = 0;
+				ptAnchors[szShadow.cy - i][0] = szParent.cx;
+				ptAnchors[szShadow.cy - i][1] = 0;
+			}
+
+			ptAnchors += m_nSize;
+		}
+
+		for (int i = 0; i < szParent.cy; i++)
+		{
+			// find start point
+			int j = 0;
+
+			for (j = 0; j < szParent.cx; j++)
+			{
+				if (PtInRegion(j, i))
+				{
+					ptAnchors[i + 1][0] = j + m_nSize;
+					ptAnchorsOri[i][0] = j;
+					break;
+				}
+			}
+
+			if (j >= szParent.cx)
+			{
+				// Start point not found
+				ptAnchors[i + 1][0] = szParent.cx;
+				ptAnchorsOri[i][1] = 0;
+				ptAnchors[i + 1][0] = szParent.cx;
+				ptAnchorsOri[i][1] = 0;
+
+				if (bFullScan)
+				{
+					ptAnchors[i + 1][1] = 0;
+					ptAnchorsOri[i][0] = szParent.cx;
+				}
+			}
+			else
+			{
+				// find end point
+				for (j = szParent.cx - 1; j >= (bFullScan ? ptAnchorsOri[i][0] : ptAnchors[i + 1][0]); j--)
+				{
+					if (PtInRegion(j, i))
+					{
+						ptAnchors[i + 1][1] = j + 1 + m_nSize;
+						ptAnchorsOri[i][1] = j + 1;
+						break;
+					}
+				}
+			}
+		}
+
+		if (m_nSize > 0)
+			ptAnchors -= m_nSize;	// Restore pos of ptAnchors for erosion
+
+		int(*ptAnchorsTmp)[2] = new int[nAnchors + 2][2]();	// Store the result of erosion
+
+		// First and last line should be empty
+		ptAnchorsTmp[0][0] = szParent.cx;
+		ptAnchorsTmp[0][1] = 0;
+		ptAnchorsTmp[nAnchors + 1][0] = szParent.cx;
+		ptAnchorsTmp[nAnchors + 1][1] = 0;
+
+		/*
+		** STEP 2:
+		** perform morphologic erosion
+		*/
+
+		for (int i = 0; i < m_nSharpness - m_nSize; i++)
+		{
+			for (int j = 1; j < nAnchors + 1; j++)
+			{
+				ptAnchorsTmp[j][0] = std::max(ptAnchors[j - 1][0], std::max(ptAnchors[j][0], ptAnchors[j + 1][0])) + 1;
+				ptAnchorsTmp[j][1] = std::min(ptAnchors[j - 1][1], std::min(ptAnchors[j][1], ptAnchors[j + 1][1])) - 1;
+			}
+
+			// Exchange ptAnchors and ptAnchorsTmp;
+			int(*ptAnchorsXange)[2] = ptAnchorsTmp;
+			ptAnchorsTmp = ptAnchors;
+			ptAnchors = ptAnchorsXange;
+		}
+
+		/*
+		** STEP 3:
+		** perform morphologic dilation
+		*/
+
+		ptAnchors += (m_nSize < 0 ? -m_nSize : 0) + 1;	// now coordinates in ptAnchors are same as in shadow window
+
+		// Generate the kernel
+		int nKernelSize = m_nSize > m_nSharpness ? m_nSize : m_nSharpness;
+		int nCenterSize = m_nSize > m_nSharpness ? (m_nSize - m_nSharpness) : 0;
+		uint32_t *pKernel = new uint32_t[(2 * nKernelSize + 1) * (2 * nKernelSize + 1)];
+		uint32_t *pKernelIter = pKernel;
+
+		for (int i = 0; i <= 2 * nKernelSize; i++)
+		{
+			for (int j = 0; j <= 2 * nKernelSize; j++)
+			{
+				double dLength = sqrt((i - nKernelSize) * (i - nKernelSize) + (j - nKernelSize) * (double)(j - nKernelSize));
+
+				if (dLength < nCenterSize)
+					*pKernelIter = (uint32_t)m_nDarkness << 24 | PreMultiply(m_Color, m_nDarkness);
+				else
+					if (dLength <= nKernelSize)
+					{
+						uint32_t nFactor = ((uint32_t)((1 - (dLength - nCenterSize) / (m_nSharpness + 1)) * m_nDarkness));
+						*pKernelIter = nFactor << 24 | PreMultiply(m_Color, (unsigned char)nFactor);
+					}
+					else
+						*pKernelIter = 0;
+
+				pKernelIter++;
+			}
+		}
+
+		// Generate blurred border
+		for (int i = nKernelSize; i < szShadow.cy - nKernelSize; i++)
+		{
+			int j = 0;
+
+			if (ptAnchors[i][0] < ptAnchors[i][1])
+			{
+				// Start of line
+				for (j = ptAnchors[i][0]; j < std::min(std::max(ptAnchors[i - 1][0], ptAnchors[i + 1][0]) + 1, ptAnchors[i][1]); j++)
+				{
+					for (int k = 0; k <= 2 * nKernelSize; k++)
+					{
+						uint32_t *pPixel = pShadBits + (szShadow.cy - i - 1 + nKernelSize - k) * szShadow.cx + j - nKernelSize;
+						uint32_t *pKernelPixel = pKernel + k * (2 * nKernelSize + 1);
+
+						for (int l = 0; l <= 2 * nKernelSize; l++)
+						{
+							if (*pPixel < *pKernelPixel)
+								*pPixel = *pKernelPixel;
+
+							pPixel++;
+							pKernelPixel++;
+						}
+					}
+				} // for() start of line
+
+				// End of line
+				for (j = std::max(j, std::min(ptAnchors[i - 1][1], ptAnchors[i + 1][1]) - 1); j < ptAnchors[i][1]; j++)
+				{
+					for (int k = 0; k <= 2 * nKernelSize; k++)
+					{
+						uint32_t *pPixel = pShadBits +
+							(szShadow.cy - i - 1 + nKernelSize - k) * szShadow.cx + j - nKernelSize;
+						uint32_t *pKernelPixel = pKernel + k * (2 * nKernelSize + 1);
+						for (int l = 0; l <= 2 * nKernelSize; l++)
+						{
+							if (*pPixel < *pKernelPixel)
+								*pPixel = *pKernelPixel;
+							pPixel++;
+							pKernelPixel++;
+						}
+					}
+				} // for() end of line
+			}
+		} // for() Generate blurred border
+
+		// Erase unwanted parts and complement missing
+		uint32_t clCenter = (uint32_t)m_nDarkness << 24 | PreMultiply(m_Color, m_nDarkness);
+
+		for (int i = std::min(nKernelSize, std::max(m_nSize - m_nyOffset, 0)); i < std::max(szShadow.cy - nKernelSize, std::min(szParent.cy + m_nSize - m_nyOffset, szParent.cy + 2 * m_nSize)); i++)
+		{
+			uint32_t *pLine = pShadBits + (szShadow.cy - i - 1) * szShadow.cx;
+
+			if (i - m_nSize + m_nyOffset < 0 || i - m_nSize + m_nyOffset >= szParent.cy)
+			{
+				// Line is not covered by parent window
+				for (int j = ptAnchors[i][0]; j < ptAnchors[i][1]; j++)
+				{
+					*(pLine + j) = clCenter;
+				}
+			}
+			else
+			{
+				for (int j = ptAnchors[i][0]; j < std::min(ptAnchorsOri[i - m_nSize + m_nyOffset][0] + m_nSize - m_nxOffset, ptAnchors[i][1]); j++)
+					*(pLine + j) = clCenter;
+
+				for (int j = std::max(ptAnchorsOri[i - m_nSize + m_nyOffset][0] + m_nSize - m_nxOffset, 0); j < std::min(ptAnchorsOri[i - m_nSize + m_nyOffset][1] + m_nSize - m_nxOffset, szShadow.cx); j++)
+					*(pLine + j) = 0;
+
+				for (int j = std::max(ptAnchorsOri[i - m_nSize + m_nyOffset][1] + m_nSize - m_nxOffset, ptAnchors[i][0]); j < ptAnchors[i][1]; j++)
+					*(pLine + j) = clCenter;
+			}
+		}
+
+		// Delete used resources
+		delete[](ptAnchors - (m_nSize < 0 ? -m_nSize : 0) - 1);
+		delete[] ptAnchorsTmp;
+		delete[] ptAnchorsOri;
+		delete[] pKernel;
+	}
+}
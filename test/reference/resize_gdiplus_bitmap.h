@@ -0,0 +1,68 @@
+//
+// resize_gdiplus_bitmap.h - the sizing rules of ResizeGdiplusBitmap, without GDI+
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+namespace reference
+{
+	/*
+	** the size ResizeGdiplusBitmap gives an old_width by old_height bitmap in a target of
+	** iWidth by iHeight, with bStretch and bEnlargeIfSmaller false as image controls call it
+	*/
+	inline void resize_gdiplus_bitmap(int old_width, int old_height, int iWidth, int iHeight,
+		int &iWidthOut, int &iHeightOut)
+	{
+		double ratio = ((double)old_width) / ((double)old_height);
+
+		if (old_width < iWidth && old_height < iHeight)
+		{
+			// both sides of the image are smaller than the target dimensions, preserve size
+			iWidth = old_width;
+			iHeight = old_height;
+		}
+
+		const int control_w = iWidth;
+		const int control_h = iHeight;
+
+		if (ratio == 1)
+		{
+			if (iWidth > iHeight)
+				iWidth = iHeight;
+			else
+				iHeight = iWidth;
+		}
+		else
+		{
+			if (old_width > old_height)
+			{
+				iHeight = (int)(iWidth / ratio);
+
+				if (iHeight > control_h)
+				{
+					iHeight = control_h;
+					iWidth = (int)(iHeight * ratio);
+				}
+			}
+			else
+			{
+				iWidth = (int)(iHeight * ratio);
+
+				if (iWidth > control_w)
+				{
+					iWidth = control_w;
+					iHeight = (int)(iWidth / ratio);
+				}
+			}
+		}
+
+		iWidthOut = iWidth;
+		iHeightOut = iHeight;
+	}
+}
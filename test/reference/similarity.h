@@ -0,0 +1,114 @@
+//
+// similarity.h - similarity() as password_rating.cpp had it before it stopped allocating
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+
+namespace reference
+{
+	// the MSVC function the old code called
+	inline int strncpy_s(char* dest, const char* src, size_t size)
+	{
+		std::strncpy(dest, src, size - 1);
+		dest[size - 1] = '\0';
+		return 0;
+	}
+
+	/*
+	** the functions below are the old ones with only the namespace added
+	** they index tables with plain char, so they are only defined for characters 1 - 127
+	*/
+#define MAX_STR	256
+#define NO_OF_CHARS 256
+
+	inline std::string remove_duplicates(const std::string& str_in) {
+		char str[NO_OF_CHARS];
+		strncpy_s(str, str_in.c_str(), sizeof(str));
+
+		int bin_hash[NO_OF_CHARS] = { 0 };
+		int ip_ind = 0, res_ind = 0;
+		char temp;
+
+		// In place removal of duplicate characters
+		while (*(str + ip_ind)) {
+			temp = *(str + ip_ind);
+			if (bin_hash[(unsigned char)temp] == 0)
+			{
+				bin_hash[(unsigned char)temp] = 1;
+				*(str + res_ind) = *(str + ip_ind);
+				res_ind++;
+			}
+			ip_ind++;
+		}
+
+		*(str + res_ind) = '\0';
+		return str;
+	}
+
+	inline int number_of_duplicates(const std::string& str_in) {
+		return int(str_in.length()) - int(remove_duplicates(str_in).length());
+	}
+
+	inline void swap(unsigned** first, unsigned** second) {
+		unsigned* temp;
+		temp = *first;
+		*first = *second;
+		*second = temp;
+	}
+
+	inline float similarity(std::string str1_, std::string str2_) {
+		for (int i = 0; i < int(str1_.length()); i++)
+			str1_[i] = toupper(str1_[i]);
+
+		for (int i = 0; i < int(str2_.length()); i++)
+			str2_[i] = toupper(str2_[i]);
+
+		// check if strings have same letters (method A)
+		auto temp1 = remove_duplicates(str1_) + remove_duplicates(str2_);
+		auto temp2 = remove_duplicates(temp1);
+
+		float similarity = 2 * float(temp1.length() - temp2.length()) / float(temp1.length());
+
+		// check similarity (method B)
+		char str1[MAX_STR];
+		char str2[MAX_STR];
+
+		strncpy_s(str1, str1_.c_str(), sizeof(str1));
+		strncpy_s(str2, str2_.c_str(), sizeof(str2));
+
+		size_t len1 = strlen(str1), len2 = strlen(str2);
+		float lenLCS;
+		unsigned j, k, * previous, * next;
+		if (len1 == 0 || len2 == 0)
+			return 0;
+		previous = (unsigned*)calloc(len1 + 1, sizeof(unsigned));
+		next = (unsigned*)calloc(len1 + 1, sizeof(unsigned));
+		for (j = 0; j < len2; ++j) {
+			for (k = 1; k <= len1; ++k)
+				if (str1[k - 1] == str2[j])
+					next[k] = previous[k - 1] + 1;
+				else next[k] = previous[k] >= next[k - 1] ? previous[k] : next[k - 1];
+			swap(&previous, &next);
+		}
+		lenLCS = (float)previous[len1];
+		free(previous);
+		free(next);
+
+		float similarity_2 = lenLCS /= len1;
+		return 100 * (2 * similarity / 3 + 1 * similarity_2 / 3);
+	}
+
+#undef MAX_STR
+#undef NO_OF_CHARS
+}
@@ -0,0 +1,194 @@
+//
+// shadow_test.cpp - CShadowImage against the shadow algorithm it replaced, pixel for pixel
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "test.h"
+#include "reference/make_shadow.h"
+#include "cui_raw/cui_rawImpl/CShadow/CShadowImage.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+	typedef CShadowImage::rect rect;
+	typedef CShadowImage::properties properties;
+
+	std::mt19937 rng(9);
+
+	int random(int iFrom, int iTo)
+	{
+		return std::uniform_int_distribution<int>(iFrom, iTo)(rng);
+	}
+
+	/*
+	** a window region as GetRegionData gives it: a band of rectangles per run of lines
+	** the shape is a rounded rectangle, with a notch cut out of some lines so that they are
+	** made of two rectangles
+	*/
+	std::vector<rect> rounded(int cx, int cy, int iRadius, bool bNotches)
+	{
+		std::vector<rect> vRegion;
+
+		for (int y = 0; y < cy; y++)
+		{
+			int iInset = 0;
+			const int dy = y < iRadius ? iRadius - y : (y >= cy - iRadius ? y - (cy - iRadius - 1) : 0);
+
+			if (dy > 0)
+				iInset = iRadius - (int)std::sqrt(double(iRadius * iRadius - (dy - 1) * (dy - 1)));
+
+			const int iLeft = iInset;
+			const int iRight = cx - iInset;
+
+			if (bNotches && iRight - iLeft > 4 && y % 7 == 3)
+			{
+				const int iMid = (iLeft + iRight) / 2;
+				vRegion.push_back({ iLeft, y, iMid - 1, y + 1 });
+				vRegion.push_back({ iMid + 1, y, iRight, y + 1 });
+			}
+			else
+				vRegion.push_back({ iLeft, y, iRight, y + 1 });
+		}
+
+		return vRegion;
+	}
+
+	properties random_properties()
+	{
+		properties shadow;
+		shadow.nSize = random(-20, 20);
+		shadow.nSharpness = random(0, 20);
+		shadow.nDarkness = random(0, 255);
+		shadow.nxOffset = random(-20, 20);
+		shadow.nyOffset = random(-20, 20);
+		shadow.clr = std::uint32_t(rng()) & 0xffffff;
+		return shadow;
+	}
+
+	// whether every line is covered, from its leftmost to its rightmost pixel, by more than nSize pixels
+	bool wide(const std::vector<rect> &vRegion, int cy, int nSize)
+	{
+		std::vector<int> vLeft(cy, 1 << 30), vRight(cy, -1);
+
+		for (const auto &it : vRegion)
+		{
+			for (int y = it.top; y < it.bottom; y++)
+			{
+				vLeft[y] = it.left < vLeft[y] ? it.left : vLeft[y];
+				vRight[y] = it.right > vRight[y] ? it.right : vRight[y];
+			}
+		}
+
+		for (int y = 0; y < cy; y++)
+			if (vRight[y] - vLeft[y] <= (nSize > 0 ? nSize : 0))
+				return false;
+
+		return true;
+	}
+
+	int iMismatches = 0;
+
+	// the whole bitmap, as UpdateShadow would hand it to UpdateLayeredWindow
+	void compare(int cx, int cy, const std::vector<rect> &vRegion, const properties &shadow, bool bFullScan)
+	{
+		const int cxShadow = cx + 2 * shadow.nSize;
+		const int cyShadow = cy + 2 * shadow.nSize;
+
+		std::vector<std::uint32_t> vOld((size_t)cxShadow * cyShadow, 0), vNew(vOld.size(), 0);
+		reference::make_shadow(vOld.data(), cx, cy, vRegion, shadow, bFullScan);
+		CShadowImage::Make(vNew.data(), cx, cy, vRegion, shadow);
+
+		if (vOld != vNew && iMismatches++ < 10)
+		{
+			size_t i = 0;
+
+			while (vOld[i] == vNew[i])
+				i++;
+
+			std::printf("%dx%d, size %d, sharpness %d, darkness %d, offset (%d, %d)%s: "
+				"pixel (%d, %d) is %08x, was %08x\n", cx, cy, shadow.nSize, shadow.nSharpness,
+				shadow.nDarkness, shadow.nxOffset, shadow.nyOffset, bFullScan ? ", full scan" : "",
+				int(i % cxShadow), int(i / cxShadow), vNew[i], vOld[i]);
+		}
+	}
+}
+
+int main()
+{
+	// the defaults CShadow starts with, on a plain window
+	properties shadow;
+	shadow.nSize = 0;
+	shadow.nSharpness = 5;
+	shadow.nDarkness = 100;
+	shadow.nxOffset = 5;
+	shadow.nyOffset = 5;
+	shadow.clr = 0;
+
+	compare(640, 480, { { 0, 0, 640, 480 } }, shadow, false);
+
+	// every line covered, and wider than the shadow size, as the old edge scan needed; the
+	// output must not change at all
+	int iCompared = 0;
+
+	for (int i = 0; i < 1500; i++)
+	{
+		shadow = random_properties();
+
+		const int iMin = (shadow.nSize > 0 ? shadow.nSize : -2 * shadow.nSize) + 1;
+		const int cx = random(iMin, iMin + 150) + (random(0, 9) == 0 ? 400 : 0);
+		const int cy = random(iMin, iMin + 120);
+		const int iRadius = random(0, 2) ? 0 : random(0, (cx < cy ? cx : cy) / 2);
+
+		std::vector<rect> vRegion = rounded(cx, cy, iRadius, random(0, 1) != 0);
+
+		if (!wide(vRegion, cy, shadow.nSize))
+			continue;
+
+		compare(cx, cy, vRegion, shadow, false);
+		iCompared++;
+	}
+
+	CHECK(iCompared > 1000);
+	CHECK(iMismatches == 0);
+	iMismatches = 0;
+
+	/*
+	** the intended change: lines narrower than the shadow size, and lines the region does not
+	** cover, are now taken from the region as it is; the old scan left the end of such a line
+	** unset. With that corrected, and only that, the output is the same
+	*/
+	for (int i = 0; i < 1500; i++)
+	{
+		shadow = random_properties();
+
+		const int iMin = (shadow.nSize > 0 ? 0 : -2 * shadow.nSize) + 1;
+		const int cx = random(iMin, iMin + 100);
+		const int cy = random(iMin, iMin + 100);
+
+		// a few lines of random width, some of them missing
+		std::vector<rect> vRegion;
+
+		for (int y = 0; y < cy; y++)
+		{
+			if (random(0, 9) == 0)
+				continue;
+
+			const int iLeft = random(0, cx - 1);
+			vRegion.push_back({ iLeft, y, random(iLeft + 1, cx), y + 1 });
+		}
+
+		compare(cx, cy, vRegion, shadow, true);
+	}
+
+	CHECK(iMismatches == 0);
+
+	return test::result("shadow_test");
+}
@@ -0,0 +1,101 @@
+//
+// similarity_test.cpp - randomized differential test of similarity() against the old implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "test.h"
+#include "reference/similarity.h"
+
+#include <string_view>
+#include <random>
+
+// password_rating.cpp
+float similarity(std::string_view str1, std::string_view str2);
+int number_of_duplicates(std::string_view str);
+
+namespace
+{
+	// same bits, so that the scores, and the strengths computed from them, are identical
+	bool identical(float a, float b)
+	{
+		return std::memcmp(&a, &b, sizeof(a)) == 0;
+	}
+
+	int iMismatches = 0;
+
+	void compare(const std::string &a, const std::string &b)
+	{
+		const float old_score = reference::similarity(a, b);
+		const float new_score = similarity(a, b);
+
+		if (!identical(old_score, new_score))
+		{
+			if (iMismatches++ < 10)
+				std::printf("similarity(\"%s\", \"%s\"): old %.9g, new %.9g\n",
+					a.c_str(), b.c_str(), old_score, new_score);
+		}
+
+		CHECK(identical(old_score, new_score));
+		CHECK(reference::number_of_duplicates(b) == number_of_duplicates(b));
+	}
+}
+
+int main()
+{
+	// the alphabets: few letters so that the subsequences are long, every printable character,
+	// case only, and any character the old code handles (1 - 127)
+	const std::string alphabets[] = {
+		"abcABC",
+		"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789!@#$%",
+		"aA",
+	};
+
+	std::mt19937 rng(42);
+
+	auto make = [&](size_t iMaxLength)
+	{
+		std::string s(rng() % (iMaxLength + 1), ' ');
+		const int iMode = rng() % 4;
+
+		for (auto &c : s)
+			c = iMode == 3 ? char(1 + rng() % 127) : alphabets[iMode][rng() % alphabets[iMode].length()];
+
+		return s;
+	};
+
+	for (int i = 0; i < 300000; i++)
+	{
+		// mostly password sized, with some near and past the 255 character limit, which
+		// spans several words of the bit-parallel LCS
+		const size_t iMaxLength = i % 10 == 0 ? 300 : (i % 3 == 0 ? 130 : 20);
+
+		std::string a = make(iMaxLength), b = make(iMaxLength);
+
+		// passwords that contain the username
+		if (rng() % 5 == 0)
+			b = a + b;
+
+		// everything after a null character is ignored
+		if (rng() % 20 == 0)
+			a += std::string(1, '\0') + "xyz";
+
+		compare(a, b);
+	}
+
+	// edges
+	compare("", "");
+	compare("", "password");
+	compare("username", "");
+	compare("abc", "ABC");
+	compare(std::string(255, 'a'), std::string(255, 'A'));
+	compare(std::string(256, 'a'), std::string(300, 'a'));
+	compare(std::string(64, 'x') + "y", "y" + std::string(64, 'x'));
+	compare(std::string(128, 'q'), std::string(63, 'q') + "z" + std::string(64, 'q'));
+
+	return test::result("similarity_test");
+}
@@ -0,0 +1,44 @@
+//
+// test.h - minimal checks for the Linux tests of the portable modules
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <cstdio>
+
+namespace test
+{
+	inline int &failures()
+	{
+		static int iFailures = 0;
+		return iFailures;
+	}
+
+	// the exit code of a test program
+	inline int result(const char *sName)
+	{
+		if (failures())
+			std::printf("%s: %d check(s) failed\n", sName, failures());
+		else
+			std::printf("%s: ok\n", sName);
+
+		return failures() ? 1 : 0;
+	}
+}
+
+// record a failed check and carry on, so one run shows every failure
+#define CHECK(x) \
+	do \
+	{ \
+		if (!(x)) \
+		{ \
+			std::printf("%s(%d): CHECK(%s) failed\n", __FILE__, __LINE__, #x); \
+			test::failures()++; \
+		} \
+	} while (0)
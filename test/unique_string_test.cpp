@@ -0,0 +1,272 @@
+//
+// unique_string_test.cpp - format, ordering and collision tests of unique_string and random_stream
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "test.h"
+#include "cui.h"
+#include "unique_string/random_stream.h"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <unordered_set>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/wait.h>
+
+using namespace liblec::cui;
+
+namespace
+{
+	bool is_hex(char c)
+	{
+		return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f');
+	}
+
+	int hex_value(char c)
+	{
+		return c <= '9' ? c - '0' : c - 'a' + 10;
+	}
+
+	// 8-4-4-4-12 lowercase hexadecimal digits, with the version and the 10 variant (RFC 9562)
+	bool conforms(const std::string &s, char version)
+	{
+		if (s.length() != 36)
+			return false;
+
+		for (size_t i = 0; i < s.length(); i++)
+			if (i == 8 || i == 13 || i == 18 || i == 23 ? s[i] != '-' : !is_hex(s[i]))
+				return false;
+
+		return s[14] == version && (hex_value(s[19]) & 0xC) == 0x8;
+	}
+
+	// the Unix time in milliseconds at the front of a version 7 UUID
+	uint64_t timestamp(const std::string &s)
+	{
+		uint64_t ms = 0;
+
+		for (size_t i = 0; i < 13; i++)
+			if (i != 8)
+				ms = (ms << 4) | uint64_t(hex_value(s[i]));
+
+		return ms;
+	}
+
+	uint64_t now_ms()
+	{
+		return uint64_t(std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count());
+	}
+
+	// the ids a forked child makes, read back through a pipe
+	std::vector<std::string> child_ids(size_t iCount)
+	{
+		int fd[2];
+
+		if (pipe(fd) != 0)
+			return {};
+
+		const pid_t pid = fork();
+
+		if (pid == 0)
+		{
+			close(fd[0]);
+
+			for (size_t i = 0; i < iCount; i++)
+			{
+				std::array<char, 36> buffer;
+				unique_string(buffer, uuid_version::v4);
+
+				if (write(fd[1], buffer.data(), buffer.size()) != ssize_t(buffer.size()))
+					_exit(1);
+			}
+
+			_exit(0);
+		}
+
+		close(fd[1]);
+		std::vector<std::string> vIds;
+		char buffer[36];
+
+		while (vIds.size() < iCount && read(fd[0], buffer, sizeof(buffer)) == ssize_t(sizeof(buffer)))
+			vIds.emplace_back(buffer, sizeof(buffer));
+
+		close(fd[0]);
+
+		int iStatus = 0;
+		waitpid(pid, &iStatus, 0);
+		return vIds;
+	}
+}
+
+int main()
+{
+	// ChaCha20 block function test vector (RFC 8439, 2.3.2)
+	{
+		uint32_t key[8];
+		uint8_t key_bytes[32];
+
+		for (int i = 0; i < 32; i++)
+			key_bytes[i] = uint8_t(i);
+
+		for (int i = 0; i < 8; i++)
+			key[i] = uint32_t(key_bytes[4 * i]) | uint32_t(key_bytes[4 * i + 1]) << 8 |
+			uint32_t(key_bytes[4 * i + 2]) << 16 | uint32_t(key_bytes[4 * i + 3]) << 24;
+
+		const uint32_t nonce[3] = { 0x09000000, 0x4a000000, 0x00000000 };
+
+		const uint8_t expected[64] = {
+			0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15, 0x50, 0x0f, 0xdd, 0x1f, 0xa3, 0x20, 0x71, 0xc4,
+			0xc7, 0xd1, 0xf4, 0xc7, 0x33, 0xc0, 0x68, 0x03, 0x04, 0x22, 0xaa, 0x9a, 0xc3, 0xd4, 0x6c, 0x4e,
+			0xd2, 0x82, 0x64, 0x46, 0x07, 0x9f, 0xaa, 0x09, 0x14, 0xc2, 0xd7, 0x05, 0xd9, 0x8b, 0x02, 0xa2,
+			0xb5, 0x12, 0x9c, 0xd1, 0xde, 0x16, 0x4e, 0xb9, 0xcb, 0xd0, 0x83, 0xe8, 0xa2, 0x50, 0x3c, 0x4e,
+		};
+
+		uint8_t out[64];
+		random_stream::chacha20_block(key, 1, nonce, out);
+		CHECK(std::memcmp(out, expected, sizeof(out)) == 0);
+	}
+
+	// the format of both versions, through every overload
+	{
+		bool bConforms = true;
+
+		for (int i = 0; i < 10000; i++)
+		{
+			std::array<char, 36> buffer;
+			unique_string(buffer, uuid_version::v7);
+
+			bConforms = bConforms &&
+				conforms(unique_string(), '4') &&
+				conforms(unique_string(uuid_version::v4), '4') &&
+				conforms(unique_string(uuid_version::v7), '7') &&
+				conforms(std::string(buffer.data(), buffer.size()), '7');
+		}
+
+		for (auto version : { uuid_version::v4, uuid_version::v7 })
+			for (auto &it : unique_strings(1000, version))
+				bConforms = bConforms && conforms(it, version == uuid_version::v4 ? '4' : '7');
+
+		CHECK(bConforms);
+
+		const std::string sShort = unique_string_short();
+		CHECK(sShort.length() == 8 && std::all_of(sShort.begin(), sShort.end(), is_hex));
+	}
+
+	// the 122 random bits of version 4 are each set about half the time
+	{
+		const int iCount = 100000;
+		int counts[32] = { };
+
+		for (int i = 0; i < iCount; i++)
+		{
+			const std::string s = unique_string(uuid_version::v4);
+			int k = 0;
+
+			for (size_t j = 0; j < s.length(); j++)
+				if (s[j] != '-')
+					counts[k++] += hex_value(s[j]) & 1;
+		}
+
+		// the low bit of every digit is random except in the version digit (12); the variant
+		// only takes the top two bits of digit 16
+		for (int k = 0; k < 32; k++)
+			if (k != 12)
+				CHECK(counts[k] > iCount * 45 / 100 && counts[k] < iCount * 55 / 100);
+	}
+
+	// version 7 ids start with the time, and sort in the order a thread makes them, also when
+	// many are made within the same millisecond
+	{
+		const uint64_t before = now_ms();
+		std::string sPrevious = unique_string(uuid_version::v7);
+		bool bOrdered = true;
+
+		for (int i = 0; i < 1000000; i++)
+		{
+			std::string s = unique_string(uuid_version::v7);
+			bOrdered = bOrdered && s > sPrevious;
+			sPrevious.swap(s);
+		}
+
+		const uint64_t after = now_ms();
+		CHECK(bOrdered);
+
+		// the counter may run ahead of the clock by a few milliseconds when it overflows
+		CHECK(timestamp(sPrevious) >= before && timestamp(sPrevious) <= after + 1000);
+
+		const std::vector<std::string> vIds = unique_strings(100000, uuid_version::v7);
+		CHECK(std::is_sorted(vIds.begin(), vIds.end()));
+		CHECK(std::adjacent_find(vIds.begin(), vIds.end()) == vIds.end());
+	}
+
+	// no collisions across threads, each with its own stream
+	for (auto version : { uuid_version::v4, uuid_version::v7 })
+	{
+		const unsigned iThreads = 8;
+		const size_t iPerThread = 100000;
+		std::vector<std::vector<std::string>> vIds(iThreads);
+		std::vector<std::thread> vThreads;
+
+		for (unsigned t = 0; t < iThreads; t++)
+			vThreads.emplace_back([&, t]()
+			{
+				vIds[t].reserve(iPerThread);
+
+				for (size_t i = 0; i < iPerThread / 2; i++)
+					vIds[t].push_back(unique_string(version));
+
+				for (auto &it : unique_strings(iPerThread / 2, version))
+					vIds[t].push_back(it);
+			});
+
+		for (auto &it : vThreads)
+			it.join();
+
+		std::unordered_set<std::string> seen;
+		size_t iCollisions = 0;
+
+		for (auto &list : vIds)
+			for (auto &it : list)
+				iCollisions += !seen.insert(it).second;
+
+		CHECK(seen.size() + iCollisions == iThreads * iPerThread);
+		CHECK(iCollisions == 0);
+	}
+
+	// a forked child rekeys its stream, so that it does not make the ids its parent makes,
+	// whether or not the parent had used its stream before the fork
+	for (int iRound = 0; iRound < 2; iRound++)
+	{
+		if (iRound == 1)
+			unique_string();
+
+		const std::vector<std::string> vChild = child_ids(64);
+		CHECK(vChild.size() == 64);
+
+		std::unordered_set<std::string> parent;
+
+		for (int i = 0; i < 64; i++)
+			parent.insert(unique_string());
+
+		size_t iShared = 0;
+
+		for (auto &it : vChild)
+			iShared += parent.count(it);
+
+		CHECK(iShared == 0);
+
+		// and two children of the same parent differ too
+		const std::vector<std::string> vSecond = child_ids(64);
+		CHECK(vSecond.size() == 64 && vSecond != vChild);
+	}
+
+	return test::result("unique_string_test");
+}
@@ -0,0 +1,81 @@
+//
+// civil_date.h - integer calendar arithmetic
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+/// calendar arithmetic on the proleptic Gregorian calendar with plain integers, after Howard
+/// Hinnant's days_from_civil and civil_from_days algorithms
+/// unlike mktime and localtime these take no locks, do not consult the time zone and work for
+/// any year, so they are safe to call in tight loops
+namespace civil_date {
+	/// floor division, for the negative years and days that come up in normalization
+	constexpr int floor_div(int a, int b) {
+		return (a >= 0 ? a : a - b + 1) / b;
+	}
+
+	constexpr bool is_leap_year(int year) {
+		return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+	}
+
+	/// number of days in a month (1 - 12)
+	constexpr int days_in_month(int year, int month) {
+		return month == 2 ? (is_leap_year(year) ? 29 : 28) :
+			(month == 4 || month == 6 || month == 9 || month == 11) ? 30 : 31;
+	}
+
+	/// number of days from 1970-01-01 to a date
+	/// the day may be out of range, e.g. 0 for the last day of the previous month, and so may
+	/// the month, e.g. 13 for January of the next year, as with mktime
+	constexpr int days_from_civil(int year, int month, int day) {
+		// bring the month into 1 - 12
+		year += floor_div(month - 1, 12);
+		month -= 12 * floor_div(month - 1, 12);
+
+		// count years from March, so that the leap day is the last day of the year
+		year -= month <= 2;
+		const int era = floor_div(year, 400);
+		const int yoe = year - era * 400;											// [0, 399]
+		const int doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5;		// [0, 365]
+		const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;						// [0, 146096]
+		return era * 146097 + doe - 719468 + (day - 1);
+	}
+
+	struct civil {
+		int year;
+		int month;
+		int day;
+	};
+
+	/// the date a number of days after 1970-01-01
+	constexpr civil civil_from_days(int days) {
+		days += 719468;
+		const int era = floor_div(days, 146097);
+		const int doe = days - era * 146097;										// [0, 146096]
+		const int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;		// [0, 399]
+		const int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);					// [0, 365]
+		const int mp = (5 * doy + 2) / 153;											// [0, 11]
+		const int day = doy - (153 * mp + 2) / 5 + 1;								// [1, 31]
+		const int month = mp < 10 ? mp + 3 : mp - 9;								// [1, 12]
+		return civil{ yoe + era * 400 + (month <= 2), month, day };
+	}
+
+	/// day of the week, 0 for Sunday to 6 for Saturday, as tm_wday
+	constexpr int weekday_from_days(int days) {
+		// 1970-01-01 was a Thursday
+		return days >= -4 ? (days + 4) % 7 : (days + 5) % 7 + 6;
+	}
+
+	static_assert(days_from_civil(1970, 1, 1) == 0, "civil_date: epoch");
+	static_assert(days_from_civil(2000, 3, 1) == 11017, "civil_date: leap century");
+	static_assert(days_from_civil(2019, 13, 1) == days_from_civil(2020, 1, 1), "civil_date: month overflow");
+	static_assert(days_from_civil(2020, 3, 0) == days_from_civil(2020, 2, 29), "civil_date: day zero");
+	static_assert(civil_from_days(-1).year == 1969 && civil_from_days(-1).day == 31, "civil_date: before epoch");
+	static_assert(weekday_from_days(0) == 4 && weekday_from_days(-5) == 6, "civil_date: weekday");
+}
@@ -9,32 +9,96 @@
 //
 
 #include "../cui.h"
+#include "civil_date.h"
 #include <ctime>
+#include <array>
+
+// "00" to "99", so that two digits are written at a time
+static const char digits[] =
+	"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+	"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+/// write a value from 0 to 99 as two digits
+static void write_2(char* p, int v) {
+	p[0] = digits[2 * v];
+	p[1] = digits[2 * v + 1];
+}
 
-namespace liblec::cui::date_gen {
-	std::string time_stamp() {
-		std::time_t time_temp = time(0);
-		std::tm time_out = { };
-		localtime_s(&time_out, &time_temp);
+/// write a value from 0 to 9999 as four digits
+static void write_4(char* p, int v) {
+	write_2(p, v / 100);
+	write_2(p + 2, v % 100);
+}
 
-		std::string year = std::to_string(time_out.tm_year + 1900);
-		std::string month = std::to_string(time_out.tm_mon + 1);
-		std::string day = std::to_string(time_out.tm_mday);
-		std::string hour = std::to_string(time_out.tm_hour);
-		std::string minute = std::to_string(time_out.tm_min);
-		std::string second = std::to_string(time_out.tm_sec);
+/// the current local time, from a per-thread cache that is only refreshed when the second
+/// changes, so that stamping many lines a second calls localtime_s once a second
+static const std::tm& local_time() {
+	static thread_local std::time_t cached_time = -1;
+	static thread_local std::tm cached_tm = { };
+
+	const std::time_t time_temp = time(0);
+
+	if (time_temp != cached_time) {
+#if defined(_WIN32)
+		localtime_s(&cached_tm, &time_temp);
+#else
+		localtime_r(&time_temp, &cached_tm);
+#endif
+		cached_time = time_temp;
+	}
 
-		for (size_t i = year.length(); i < 4; i++) year = "0" + year;
-		for (size_t i = month.length(); i < 2; i++) month = "0" + month;
-		for (size_t i = day.length(); i < 2; i++) day = "0" + day;
-		for (size_t i = hour.length(); i < 2; i++) hour = "0" + hour;
-		for (size_t i = minute.length(); i < 2; i++) minute = "0" + minute;
-		for (size_t i = second.length(); i < 2; i++) second = "0" + second;
+	return cached_tm;
+}
+
+/// read a field of a date string the way atoi reads it: leading white space, an optional
+/// sign, then digits up to the first other character
+static int read_field(const char* p, const char* end) {
+	while (p < end && (*p == ' ' || (*p >= '\t' && *p <= '\r')))
+		p++;
+
+	bool negative = false;
+
+	if (p < end && (*p == '+' || *p == '-'))
+		negative = *p++ == '-';
+
+	int value = 0;
+
+	while (p < end && *p >= '0' && *p <= '9')
+		value = value * 10 + (*p++ - '0');
 
-		return std::string(year + month + day + " " + hour + ":" + minute + ":" + second);
+	return negative ? -value : value;
+}
+
+namespace liblec::cui::date_gen {
+	std::string time_stamp() {
+		std::array<char, 17> buffer;
+		time_stamp(buffer);
+		return std::string(buffer.data(), buffer.size());
+	}
+
+	void time_stamp(std::array<char, 17>& buffer) {
+		const std::tm& time_out = local_time();
+
+		char* p = buffer.data();
+		write_4(p, (time_out.tm_year + 1900) % 10000);
+		write_2(p + 4, time_out.tm_mon + 1);
+		write_2(p + 6, time_out.tm_mday);
+		p[8] = ' ';
+		write_2(p + 9, time_out.tm_hour);
+		p[11] = ':';
+		write_2(p + 12, time_out.tm_min);
+		p[14] = ':';
+		write_2(p + 15, time_out.tm_sec);
 	}
 
 	std::string to_string(const date& dt) {
+		std::array<char, 8> buffer;
+
+		if (to_string(dt, buffer))
+			return std::string(buffer.data(), buffer.size());
+
+		// a date that does not fit in eight digits
 		auto day = std::to_string(dt.day);
 		auto month = std::to_string(dt.month);
 		auto year = std::to_string(dt.year);
@@ -46,21 +110,38 @@ namespace liblec::cui::date_gen {
 		return (year + month + day);
 	}
 
+	bool to_string(const date& dt, std::array<char, 8>& buffer) {
+		if (dt.day < 0 || dt.day > 99 || dt.month < 0 || dt.month > 99 ||
+			dt.year < 0 || dt.year > 9999)
+			return false;
+
+		write_4(buffer.data(), dt.year);
+		write_2(buffer.data() + 4, dt.month);
+		write_2(buffer.data() + 6, dt.day);
+		return true;
+	}
+
 	date from_string(const std::string& dt) {
 		date dt_ = { 1, 1, 2019 };
-		try {
-			dt_.day = atoi(dt.substr(6, 2).c_str());
-			dt_.month = atoi(dt.substr(4, 2).c_str());
-			dt_.year = atoi(dt.substr(0, 4).c_str());
-		}
-		catch (const std::exception&) {}
+
+		// the day is read from the seventh character on
+		if (dt.length() < 6)
+			return dt_;
+
+		const char* p = dt.c_str();
+		const char* end = p + dt.length();
+		auto field = [&](size_t pos, size_t length) {
+			return read_field(p + pos, pos + length < dt.length() ? p + pos + length : end);
+		};
+
+		dt_.day = field(6, 2);
+		dt_.month = field(4, 2);
+		dt_.year = field(0, 4);
 		return dt_;
 	}
 
 	date today() {
-		std::time_t time_temp = time(0);
-		std::tm time_out = { };
-		localtime_s(&time_out, &time_temp);
+		const std::tm& time_out = local_time();
 
 		date dt;
 		dt.day = time_out.tm_mday;
@@ -69,56 +150,38 @@ namespace liblec::cui::date_gen {
 		return dt;
 	}
 
-	date last_day_of_month(const date& dt) {
-		struct tm when = { 0, 0, 0, 1 };
+	// number of days from 1970-01-01, normalizing out of range days and months as mktime does
+	static int to_days(const date& dt) {
+		return civil_date::days_from_civil(dt.year, dt.month, dt.day);
+	}
 
-		if (dt.month == 12) {
-			when.tm_mon = 0;
-			when.tm_year = dt.year - 1900 + 1;
-		}
-		else {
-			when.tm_mon = dt.month;
-			when.tm_year = dt.year - 1900;
-		}
+	static date from_days(int days) {
+		const auto c = civil_date::civil_from_days(days);
+		return date{ c.day, c.month, c.year };
+	}
 
-		// get the first day of the next month and subtract one day
-		const time_t lastday = mktime(&when) - 86400;
-		localtime_s(&when, &lastday);
-		return date{ when.tm_mday, when.tm_mon + 1, when.tm_year + 1900 };
+	date last_day_of_month(const date& dt) {
+		// the day before the first day of the next month
+		return from_days(civil_date::days_from_civil(dt.year, dt.month + 1, 1) - 1);
 	}
 
 	int day_of_week(date dt) {
-		std::tm time_in = { 0, 0, 0, dt.day, dt.month - 1, dt.year - 1900 };
-		std::time_t time_temp = std::mktime(&time_in);
-		std::tm time_out = { };
-		localtime_s(&time_out, &time_temp);
-		return time_out.tm_wday + 1;
+		return civil_date::weekday_from_days(to_days(dt)) + 1;
 	}
 
 	void add_days(date& dt, int n) {
-		std::tm time_in = { 0, 0, 0, dt.day, dt.month - 1, dt.year - 1900 };
-		time_in.tm_mday += n;
-
-		std::time_t time_temp = std::mktime(&time_in);
-		std::tm time_out = { };
-		localtime_s(&time_out, &time_temp);
-
-		dt.day = time_out.tm_mday;
-		dt.month = time_out.tm_mon + 1;
-		dt.year = time_out.tm_year + 1900;
+		dt = from_days(to_days(dt) + n);
 	}
 
 	void get_week(const date& dt, date& start, date& end) {
-		start = end = dt;
-		const auto d = day_of_week(dt);
-		add_days(start, 0 - d);
-		add_days(end, 6 - d);
+		const int days = to_days(dt);
+		const auto d = civil_date::weekday_from_days(days) + 1;
+		start = from_days(days - d);
+		end = from_days(days + 6 - d);
 	}
 
 	void get_month(const date& dt, date& start, date& end) {
-		start = end = dt;
-		const auto d = dt.day;
-		add_days(start, 1 - d);
+		start = from_days(to_days(dt) + 1 - dt.day);
 		end = last_day_of_month(dt);
 	}
 
@@ -126,4 +189,41 @@ namespace liblec::cui::date_gen {
 		start = { 1, 1, dt.year };
 		end = { 31, 12, dt.year };
 	}
+
+	int days_between(const date& from, const date& to) {
+		return to_days(to) - to_days(from);
+	}
+
+	void for_each_day(const date& first, const date& last, const std::function<void(const date&)>& fn) {
+		if (!fn)
+			return;
+
+		const int last_ = to_days(last);
+		int days = to_days(first);
+
+		if (days > last_)
+			return;
+
+		// step through the days without converting each one back from a day number
+		date dt = from_days(days);
+		int month_length = civil_date::days_in_month(dt.year, dt.month);
+
+		for (;;) {
+			fn(dt);
+
+			if (days++ == last_)
+				break;
+
+			if (++dt.day > month_length) {
+				dt.day = 1;
+
+				if (++dt.month > 12) {
+					dt.month = 1;
+					dt.year++;
+				}
+
+				month_length = civil_date::days_in_month(dt.year, dt.month);
+			}
+		}
+	}
 }
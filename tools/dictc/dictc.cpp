@@ -0,0 +1,89 @@
+//
+// dictc.cpp - dictionary compiler
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+/// compiles a newline separated word list into the image that the password rating
+/// dictionary uses in place (see dictionary_index::save)
+/// usage: dictc <word list> <compiled dictionary>
+
+#include "../../password_rating/dictionary/dictionary_index.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+	if (argc != 3) {
+		fprintf(stderr, "usage: dictc <word list> <compiled dictionary>\n");
+		return 2;
+	}
+
+	std::ifstream in(argv[1], std::ios::binary);
+
+	if (!in) {
+		fprintf(stderr, "dictc: cannot open %s\n", argv[1]);
+		return 1;
+	}
+
+	const std::vector<char> text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+	dictionary_index index;
+
+	if (!index.build(text.data(), text.size())) {
+		fprintf(stderr, "dictc: %s has no words\n", argv[1]);
+		return 1;
+	}
+
+	std::vector<char> image;
+
+	if (!index.save(image)) {
+		fprintf(stderr, "dictc: failed to compile %s\n", argv[1]);
+		return 1;
+	}
+
+	// check the image before writing it: attach to it and look up every word
+	dictionary_index check;
+
+	if (!check.attach(image.data(), image.size(), true) || check.size() != index.size()) {
+		fprintf(stderr, "dictc: compiled image failed verification\n");
+		return 1;
+	}
+
+	size_t start = 0;
+
+	while (start < text.size() && text[start] != '\0') {
+		size_t end = start;
+
+		while (end < text.size() && text[end] != '\n' && text[end] != '\0')
+			end++;
+
+		size_t length = end - start;
+
+		if (length > 0 && text[start + length - 1] == '\r')
+			length--;
+
+		if (length > 0 && length <= 65535 && !check.contains(text.data() + start, length)) {
+			fprintf(stderr, "dictc: compiled image is missing '%.*s'\n", (int)length, text.data() + start);
+			return 1;
+		}
+
+		start = end + 1;
+	}
+
+	std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+
+	if (!out.write(image.data(), image.size())) {
+		fprintf(stderr, "dictc: cannot write %s\n", argv[2]);
+		return 1;
+	}
+
+	printf("dictc: %zu words, %zu bytes written to %s\n", index.size(), image.size(), argv[2]);
+	return 0;
+}
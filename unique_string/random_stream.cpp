@@ -0,0 +1,197 @@
+//
+// random_stream.cpp - random byte stream implementation
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#include "random_stream.h"
+
+#include <cstring>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <functional>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#include <bcrypt.h>
+#pragma comment(lib, "bcrypt.lib")
+#else
+#include <cstdio>
+#include <sys/random.h>
+#include <pthread.h>
+#endif
+
+/// number of times the process has been forked into the current process
+/// a child starts with copies of its parent's streams, keys included; a stream that sees a
+/// newer generation than its key is from rekeys before handing out any bytes
+static std::atomic<unsigned> fork_generation(0);
+
+#if !defined(_WIN32)
+static void on_fork_child() {
+	fork_generation.fetch_add(1, std::memory_order_relaxed);
+}
+#endif
+
+static uint32_t rotl(uint32_t v, int c) {
+	return (v << c) | (v >> (32 - c));
+}
+
+static void quarter_round(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d) {
+	a += b; d ^= a; d = rotl(d, 16);
+	c += d; b ^= c; b = rotl(b, 12);
+	a += b; d ^= a; d = rotl(d, 8);
+	c += d; b ^= c; b = rotl(b, 7);
+}
+
+void random_stream::chacha20_block(const uint32_t key[8], uint32_t counter, const uint32_t nonce[3],
+	uint8_t out[64]) {
+	// "expand 32-byte k"
+	const uint32_t input[16] = {
+		0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+		key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+		counter, nonce[0], nonce[1], nonce[2]
+	};
+
+	uint32_t x[16];
+
+	for (int i = 0; i < 16; i++)
+		x[i] = input[i];
+
+	for (int i = 0; i < 10; i++) {
+		// column rounds
+		quarter_round(x[0], x[4], x[8], x[12]);
+		quarter_round(x[1], x[5], x[9], x[13]);
+		quarter_round(x[2], x[6], x[10], x[14]);
+		quarter_round(x[3], x[7], x[11], x[15]);
+
+		// diagonal rounds
+		quarter_round(x[0], x[5], x[10], x[15]);
+		quarter_round(x[1], x[6], x[11], x[12]);
+		quarter_round(x[2], x[7], x[8], x[13]);
+		quarter_round(x[3], x[4], x[9], x[14]);
+	}
+
+	// serialize little-endian, whatever the byte order of the machine
+	for (int i = 0; i < 16; i++) {
+		const uint32_t v = x[i] + input[i];
+		out[4 * i] = uint8_t(v);
+		out[4 * i + 1] = uint8_t(v >> 8);
+		out[4 * i + 2] = uint8_t(v >> 16);
+		out[4 * i + 3] = uint8_t(v >> 24);
+	}
+}
+
+bool random_stream::system_random(void* buffer, size_t size) {
+#if defined(_WIN32)
+	return BCryptGenRandom(nullptr, reinterpret_cast<PUCHAR>(buffer), (ULONG)size,
+		BCRYPT_USE_SYSTEM_PREFERRED_RNG) == 0;
+#else
+	uint8_t* p = reinterpret_cast<uint8_t*>(buffer);
+
+	while (size > 0) {
+		const ssize_t n = getrandom(p, size, 0);
+
+		if (n <= 0)
+			break;
+
+		p += n;
+		size -= size_t(n);
+	}
+
+	if (size == 0)
+		return true;
+
+	// fall back to the random device
+	FILE* f = fopen("/dev/urandom", "rb");
+
+	if (!f)
+		return false;
+
+	const bool result = fread(p, 1, size, f) == size;
+	fclose(f);
+	return result;
+#endif
+}
+
+random_stream::random_stream() :
+	counter_(0), used_(sizeof(block_)), fork_generation_(0) {
+#if !defined(_WIN32)
+	// registered once, before any stream hands out bytes
+	static const int registered = pthread_atfork(nullptr, nullptr, on_fork_child);
+	(void)registered;
+#endif
+
+	rekey();
+}
+
+random_stream::~random_stream() {
+	// don't leave the key behind in memory
+	volatile uint8_t* p = reinterpret_cast<volatile uint8_t*>(key_);
+
+	for (size_t i = 0; i < sizeof(key_); i++)
+		p[i] = 0;
+}
+
+void random_stream::rekey() {
+	uint32_t seed[11];
+
+	if (!system_random(seed, sizeof(seed))) {
+		// no system generator; this should not happen, but make the best of what there is
+		std::random_device rd;
+
+		for (auto& it : seed)
+			it = rd();
+
+		seed[0] ^= uint32_t(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+		seed[1] ^= uint32_t(std::hash<std::thread::id>()(std::this_thread::get_id()));
+	}
+
+	memcpy(key_, seed, sizeof(key_));
+	memcpy(nonce_, seed + 8, sizeof(nonce_));
+	counter_ = 0;
+	used_ = sizeof(block_);
+	fork_generation_ = fork_generation.load(std::memory_order_relaxed);
+}
+
+void random_stream::refill() {
+	if (counter_ == UINT32_MAX)
+		rekey();
+
+	chacha20_block(key_, counter_++, nonce_, block_);
+	used_ = 0;
+}
+
+void random_stream::fill(void* buffer, size_t size) {
+	// the process was forked since the key was made; the parent goes on with the same key,
+	// and so would this process, including the unused bytes of the current block
+	if (fork_generation_ != fork_generation.load(std::memory_order_relaxed))
+		rekey();
+
+	uint8_t* p = reinterpret_cast<uint8_t*>(buffer);
+
+	while (size > 0) {
+		if (used_ == sizeof(block_))
+			refill();
+
+		const size_t n = size < sizeof(block_) - used_ ? size : sizeof(block_) - used_;
+		memcpy(p, block_ + used_, n);
+
+		// bytes are never handed out twice
+		memset(block_ + used_, 0, n);
+
+		used_ += n;
+		p += n;
+		size -= n;
+	}
+}
+
+random_stream& random_stream::this_thread() {
+	static thread_local random_stream stream;
+	return stream;
+}
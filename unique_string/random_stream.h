@@ -0,0 +1,50 @@
+//
+// random_stream.h - random byte stream interface
+//
+// cui framework, part of the liblec library
+// Copyright (c) 2016 Alec Musasa (alecmus at live dot com)
+//
+// Released under the MIT license. For full details see the
+// file LICENSE.txt
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/// cryptographically secure stream of random bytes: the ChaCha20 key stream (RFC 8439), keyed
+/// from the operating system's random number generator
+/// a stream is meant to be used by one thread; the stream is rekeyed from the operating system
+/// before its block counter runs out, and, where there is fork, in a child process before it
+/// hands out any bytes, so that parent and child never share a key stream
+class random_stream {
+public:
+	random_stream();
+	~random_stream();
+
+	/// fill a buffer with random bytes
+	void fill(void* buffer, size_t size);
+
+	/// the random stream of the calling thread
+	static random_stream& this_thread();
+
+	/// fill a buffer from the operating system's random number generator
+	/// returns false if the generator could not be used
+	static bool system_random(void* buffer, size_t size);
+
+	/// compute one ChaCha20 block
+	static void chacha20_block(const uint32_t key[8], uint32_t counter, const uint32_t nonce[3],
+		uint8_t out[64]);
+
+private:
+	void rekey();
+	void refill();
+
+	uint32_t key_[8];
+	uint32_t nonce_[3];
+	uint32_t counter_;
+	uint8_t block_[64];
+	size_t used_;	// bytes of block_ already handed out
+	unsigned fork_generation_;	// forks the key is from; see fill
+};
@@ -9,32 +9,126 @@
 //
 
 #include "../cui.h"
+#include "random_stream.h"
 
-// for UuidToString, RpcStringFree
-#include <rpc.h>
-#pragma comment(lib, "rpcrt4.lib")
+#include <chrono>
+
+// "00" to "ff", so that a byte is written as two hexadecimal digits at a time
+static const char hex_digits[] =
+	"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+	"202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+	"404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+	"606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+	"808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+	"a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+	"c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+	"e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+static void write_hex(char* p, const uint8_t* bytes, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		p[2 * i] = hex_digits[2 * bytes[i]];
+		p[2 * i + 1] = hex_digits[2 * bytes[i] + 1];
+	}
+}
+
+/// turn 16 random bytes into a UUID of the given version (RFC 9562)
+static void make_uuid(uint8_t bytes[16], liblec::cui::uuid_version version) {
+	if (version == liblec::cui::uuid_version::v7) {
+		// 48 bits of Unix time in milliseconds, then a 12 bit counter so that the ids a thread
+		// makes within the same millisecond still sort in the order they were made
+		static thread_local uint64_t last_ms = 0;
+		static thread_local uint16_t counter = 0;
+
+		const uint64_t ms = uint64_t(std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count());
+
+		if (ms > last_ms) {
+			last_ms = ms;
+
+			// start at a random value in the lower half, leaving room to count up
+			counter = uint16_t(((bytes[6] << 8) | bytes[7]) & 0x07FF);
+		}
+		else {
+			// same millisecond, or the clock went back
+			if (++counter > 0x0FFF) {
+				last_ms++;
+				counter = uint16_t(((bytes[6] << 8) | bytes[7]) & 0x07FF);
+			}
+		}
+
+		for (int i = 0; i < 6; i++)
+			bytes[i] = uint8_t(last_ms >> (8 * (5 - i)));
+
+		bytes[6] = uint8_t(0x70 | (counter >> 8));
+		bytes[7] = uint8_t(counter);
+	}
+	else
+		bytes[6] = uint8_t(0x40 | (bytes[6] & 0x0F));
+
+	// variant 10
+	bytes[8] = uint8_t(0x80 | (bytes[8] & 0x3F));
+}
+
+/// write a UUID in the form of UuidToString: 8-4-4-4-12 lowercase hexadecimal digits
+static void format_uuid(const uint8_t bytes[16], char* p) {
+	write_hex(p, bytes, 4);
+	p[8] = '-';
+	write_hex(p + 9, bytes + 4, 2);
+	p[13] = '-';
+	write_hex(p + 14, bytes + 6, 2);
+	p[18] = '-';
+	write_hex(p + 19, bytes + 8, 2);
+	p[23] = '-';
+	write_hex(p + 24, bytes + 10, 6);
+}
 
 std::string cui_api liblec::cui::unique_string() {
-	std::string sUUID;
+	return unique_string(uuid_version::v4);
+}
 
-	UUID uuid;
-	UuidCreate(&uuid);
-	RPC_CSTR uuidStr;
-	RPC_STATUS status = UuidToStringA(&uuid, &uuidStr);
-	sUUID += reinterpret_cast<char*>(uuidStr);
-	RpcStringFreeA(&uuidStr);
+std::string cui_api liblec::cui::unique_string(uuid_version version) {
+	std::array<char, 36> buffer;
+	unique_string(buffer, version);
+	return std::string(buffer.data(), buffer.size());
+}
 
-	return sUUID;
+void cui_api liblec::cui::unique_string(std::array<char, 36>& buffer, uuid_version version) {
+	uint8_t bytes[16];
+	random_stream::this_thread().fill(bytes, sizeof(bytes));
+	make_uuid(bytes, version);
+	format_uuid(bytes, buffer.data());
 }
 
-std::string cui_api liblec::cui::unique_string_short() {
-	std::string uuid = unique_string();
+std::vector<std::string> cui_api liblec::cui::unique_strings(size_t n, uuid_version version) {
+	std::vector<std::string> uuids;
+	uuids.reserve(n);
+
+	auto& stream = random_stream::this_thread();
+
+	// draw the random bytes for many ids at a time
+	const size_t batch = 64;
+	uint8_t bytes[batch][16];
 
-	const auto idx = uuid.find('-');
+	while (uuids.size() < n) {
+		const size_t count = n - uuids.size() < batch ? n - uuids.size() : batch;
+		stream.fill(bytes, count * 16);
 
-	if (idx != std::string::npos) {
-		return uuid.substr(0, idx);
+		for (size_t i = 0; i < count; i++) {
+			make_uuid(bytes[i], version);
+			uuids.emplace_back(size_t(36), '\0');
+			format_uuid(bytes[i], &uuids.back()[0]);
+		}
 	}
-	else
-		return uuid;
+
+	return uuids;
+}
+
+std::string cui_api liblec::cui::unique_string_short() {
+	// the first group of a version 4 UUID, which is all random
+	uint8_t bytes[4];
+	random_stream::this_thread().fill(bytes, sizeof(bytes));
+
+	char buffer[8];
+	write_hex(buffer, bytes, sizeof(bytes));
+	return std::string(buffer, sizeof(buffer));
 }